@@ -86,6 +86,69 @@ static void BM_ImpliedVolatilityNewtonRaphson(benchmark::State& state) {
     }
 }
 
+// Benchmark for implied volatility calculation with Brent's method
+static void BM_ImpliedVolatilityBrent(benchmark::State& state) {
+    bool is_call = state.range(0) == 1;  // Parameterize call/put
+    double S = 100.0;       // Asset price
+    double K = state.range(1);           // Parameterize strike price
+    double T = 1.0;         // Time to expiry (1 year)
+    double r = 0.05;        // Risk-free rate
+    double original_vol = 0.2;  // Original volatility
+
+    // Calculate the option price first
+    double option_price = black_scholes_price(is_call, S, K, T, r, original_vol);
+
+    for (auto _ : state) {
+        double implied_vol = calculate_implied_volatility(
+            is_call, S, K, T, r, option_price,
+            ImpliedVolatilityMethod::BRENT
+        );
+        benchmark::DoNotOptimize(implied_vol);
+    }
+}
+
+// Benchmark for implied volatility calculation with the higher-order Householder methods
+// Args: [is_call, strike_price, method]
+static void BM_ImpliedVolatilityHigherOrder(benchmark::State& state) {
+    bool is_call = state.range(0) == 1;  // Parameterize call/put
+    double S = 100.0;       // Asset price
+    double K = state.range(1);           // Parameterize strike price
+    double T = 1.0;         // Time to expiry (1 year)
+    double r = 0.05;        // Risk-free rate
+    double original_vol = 0.2;  // Original volatility
+    ImpliedVolatilityMethod method = state.range(2) == 3 ? ImpliedVolatilityMethod::HOUSEHOLDER
+                                                         : ImpliedVolatilityMethod::HALLEY;
+
+    // Calculate the option price first
+    double option_price = black_scholes_price(is_call, S, K, T, r, original_vol);
+
+    for (auto _ : state) {
+        double implied_vol = calculate_implied_volatility(
+            is_call, S, K, T, r, option_price, method
+        );
+        benchmark::DoNotOptimize(implied_vol);
+    }
+}
+
+// Benchmark for the fixed-length batch bisection over a chain of strikes
+// Args: [options]
+static void BM_ImpliedVolatilityBatchBisection(benchmark::State& state) {
+    OptionBatch batch;
+    std::vector<double> prices;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        bool is_call = i % 2 == 0;
+        double K = 70.0 + static_cast<double>(i % 61);  // Strikes 70 to 130
+        batch.push_back(is_call, 100.0, K, 0.5, 0.05);
+        prices.push_back(black_scholes_price(is_call, 100.0, K, 0.5, 0.05, 0.25));
+    }
+
+    for (auto _ : state) {
+        std::vector<double> implied_vol = black_scholes_implied_volatility_batch(batch, prices);
+        benchmark::DoNotOptimize(implied_vol.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
 // At-the-money benchmark
 BENCHMARK(BM_BlackScholesPriceCall);
 BENCHMARK(BM_BlackScholesPricePut);
@@ -111,6 +174,29 @@ BENCHMARK(BM_ImpliedVolatilityNewtonRaphson)
     ->Args({0, 110})   // In-the-money Put
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK(BM_ImpliedVolatilityBrent)
+    ->Args({1, 100})   // ATM Call
+    ->Args({0, 100})   // ATM Put
+    ->Args({1, 90})    // In-the-money Call
+    ->Args({1, 110})   // Out-of-the-money Call
+    ->Args({0, 90})    // Out-of-the-money Put
+    ->Args({0, 110})   // In-the-money Put
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_ImpliedVolatilityHigherOrder)
+    ->Args({1, 100, 2})   // ATM Call, Halley
+    ->Args({1, 70, 2})    // Deep in-the-money Call, Halley
+    ->Args({1, 140, 2})   // Deep out-of-the-money Call, Halley
+    ->Args({1, 100, 3})   // ATM Call, Householder
+    ->Args({1, 70, 3})    // Deep in-the-money Call, Householder
+    ->Args({1, 140, 3})   // Deep out-of-the-money Call, Householder
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_ImpliedVolatilityBatchBisection)
+    ->Arg(8)      // One block of lanes
+    ->Arg(1024)   // A full chain
+    ->Unit(benchmark::kMicrosecond);
+
 // Additional benchmarks for different time scenarios
 static void BM_ImpliedVolatilityTimeScenarios(benchmark::State& state) {
     bool is_call = true;
@@ -1,4 +1,6 @@
 #include "src/core/black_scholes.h"
+#include "src/io/compact_option.h"
+#include "src/io/csv_reader.h"
 #include "src/io/file_io.h"
 #include <benchmark/benchmark.h>
 #include <fstream>
@@ -288,6 +290,96 @@ static void BM_CLIBatchProcessing(benchmark::State& state) {
     state.counters["Batch"] = num_options;
 }
 
+// Benchmark for reading a wide vendor-style CSV where only six columns are needed
+// Args: [num_options, extra_columns]
+static void BM_WideCSVReading(benchmark::State& state) {
+    int num_options = state.range(0);
+    int extra_columns = state.range(1);
+    std::string temp_file = "temp_benchmark_wide.csv";
+
+    // Interleave unneeded columns before and after the mapped ones
+    {
+        std::ofstream file(temp_file);
+        file << "Type,Asset,Strike";
+        for (int c = 0; c < extra_columns; ++c) {
+            file << ",Extra" << c;
+        }
+        file << ",Time,Rate,Price\n";
+        for (int i = 0; i < num_options; ++i) {
+            file << (i % 2 == 0 ? "Call" : "Put") << "," << 100 + i % 7 << "," << 100;
+            for (int c = 0; c < extra_columns; ++c) {
+                file << "," << 1000.125 + c;
+            }
+            file << ",0.5,0.03,4.25\n";
+        }
+    }
+
+    for (auto _ : state) {
+        auto options = read_csv(temp_file, CsvColumnMap());
+        benchmark::DoNotOptimize(options.data());
+    }
+
+    // Cleanup
+    std::remove(temp_file.c_str());
+
+    state.counters["Batch"] = num_options;
+    state.counters["Columns"] = 6 + extra_columns;
+}
+
+// Benchmark for a bandwidth-bound pass (intrinsic value) over different record layouts
+// Args: [num_options, layout] with layout 0 = OptionData, 1 = PackedOption, 2 = OptionColumns
+static void BM_RecordLayoutScan(benchmark::State& state) {
+    auto num_options = static_cast<std::size_t>(state.range(0));
+    int layout = static_cast<int>(state.range(1));
+
+    std::vector<OptionData> options(num_options);
+    for (std::size_t i = 0; i < num_options; ++i) {
+        options[i].is_call = i % 2 == 0;
+        options[i].asset_price = 100.0 + static_cast<double>(i % 17);
+        options[i].strike_price = 90.0 + static_cast<double>(i % 23);
+        options[i].time_to_expiry = 0.5;
+        options[i].risk_free_rate = 0.03;
+        options[i].option_price = 4.25;
+    }
+    std::vector<PackedOption> packed;
+    for (const OptionData& option : options) {
+        packed.push_back(pack_option(option));
+    }
+    OptionColumns columns = to_columns(options);
+
+    std::size_t bytes_per_row = 0;
+    for (auto _ : state) {
+        double total = 0;
+        if (layout == 0) {
+            bytes_per_row = sizeof(OptionData);
+            for (const OptionData& option : options) {
+                double payoff = option.asset_price - option.strike_price;
+                total += std::max(option.is_call ? payoff : -payoff, 0.0);
+            }
+        } else if (layout == 1) {
+            bytes_per_row = sizeof(PackedOption);
+            for (const PackedOption& option : packed) {
+                double payoff = option.asset_price - option.strike_price;
+                total += std::max((option.flags & option_flags::kCall) != 0 ? payoff : -payoff,
+                                  0.0);
+            }
+        } else {
+            // Only the three columns read are moved through the cache
+            bytes_per_row = 2 * sizeof(double) + 1;
+            for (std::size_t i = 0; i < columns.size(); ++i) {
+                double payoff = columns.asset_price[i] - columns.strike_price[i];
+                total += std::max(
+                    (columns.flags[i] & option_flags::kCall) != 0 ? payoff : -payoff, 0.0);
+            }
+        }
+        benchmark::DoNotOptimize(total);
+    }
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * num_options *
+                                                      bytes_per_row));
+    state.counters["BytesPerRow"] = static_cast<double>(bytes_per_row);
+}
+
 // Register benchmarks with different batch sizes
 // Args: [num_options]
 BENCHMARK(BM_CSVFileProcessing)
@@ -319,5 +411,16 @@ BENCHMARK(BM_CLIBatchProcessing)
     ->Args({10000})   // Large batch
     ->Unit(benchmark::kMillisecond);
 
+BENCHMARK(BM_WideCSVReading)
+    ->Args({100000, 0})   // Narrow file
+    ->Args({100000, 30})  // Vendor-width file
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_RecordLayoutScan)
+    ->Args({4000000, 0})  // OptionData rows
+    ->Args({4000000, 1})  // PackedOption rows
+    ->Args({4000000, 2})  // Columns
+    ->Unit(benchmark::kMillisecond);
+
 BENCHMARK_MAIN();
 
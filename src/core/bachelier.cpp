@@ -0,0 +1,180 @@
+#include "bachelier.h"
+
+#include "black_scholes.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace iv_calculator {
+    namespace core {
+        namespace {
+            constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+            constexpr double kInvSqrt2Pi = 0.3989422804014327;
+            constexpr double kSqrt2Pi = 2.5066282746310002;
+
+            // Undiscounted Bachelier price on the forward
+            double forward_price(double theta, double F, double K, double T, double sigma) {
+                double moneyness = theta * (F - K);
+                double std_dev = sigma * std::sqrt(T);
+                if (std_dev <= 0) {
+                    return std::max(moneyness, 0.0);
+                }
+                double d = moneyness / std_dev;
+                return moneyness * norm_cdf(d) + std_dev * norm_pdf(d);
+            }
+
+            // Jaeckel's closed-form inversion of the undiscounted forward price
+            // Returns NaN when the price lies outside the no-arbitrage bounds
+            double forward_implied_volatility(double theta, double F, double K, double T,
+                                              double price) {
+                double intrinsic = std::max(theta * (F - K), 0.0);
+                if (!(price >= intrinsic) || !std::isfinite(price)) {
+                    return kNaN;
+                }
+
+                // Work with the out-of-the-money equivalent (time value) of the option
+                double time_value = price - intrinsic;
+                double moneyness = std::abs(F - K);
+                if (time_value <= 0) {
+                    return 0.0;
+                }
+                if (moneyness <= 1e-8 * time_value) {
+                    // At the money: price = sigma * sqrt(T) / sqrt(2 * pi) - |F - K| / 2
+                    return kSqrt2Pi * (time_value + 0.5 * moneyness) / std::sqrt(T);
+                }
+
+                // Solve Phi~(x) = Phi(x) + phi(x) / x = phi_star for x < 0
+                double phi_star = -time_value / moneyness;
+                double x_bar = NAN;
+                if (phi_star < -0.001882039271) {
+                    double g = 1.0 / (phi_star - 0.5);
+                    double g2 = g * g;
+                    double xi_bar =
+                        (0.032114372355 -
+                         g2 * (0.016969777977 - g2 * (2.6207332461e-3 - 9.6066952861e-5 * g2))) /
+                        (1.0 - g2 * (0.6635646938 - g2 * (0.14528712196 - 0.010472855461 * g2)));
+                    x_bar = g * (kInvSqrt2Pi + xi_bar * g2);
+                } else {
+                    double h = std::sqrt(-std::log(-phi_star));
+                    x_bar = (9.4883409779 - h * (9.6320903635 - h * (0.58556997323 + 2.1464093351 * h))) /
+                            (1.0 - h * (0.65174820867 + h * (1.5120247828 + 6.6437847132e-5 * h)));
+                }
+
+                // One Householder step of third order brings the result to machine precision
+                double q = (norm_cdf(x_bar) + norm_pdf(x_bar) / x_bar - phi_star) / norm_pdf(x_bar);
+                double x2 = x_bar * x_bar;
+                double x_star =
+                    x_bar + 3.0 * q * x2 * (2.0 - q * x_bar * (2.0 + x2)) /
+                                (6.0 + q * x_bar *
+                                           (-12.0 + x_bar * (6.0 * q +
+                                                             x_bar * (-6.0 + q * x_bar * (3.0 + x2)))));
+
+                return moneyness / std::abs(x_star * std::sqrt(T));
+            }
+
+            double implied_volatility_or_nan(bool is_call, double S, double K, double T, double r,
+                                             double option_price) {
+                if (!(T > 0) || !std::isfinite(S) || !std::isfinite(K) || !std::isfinite(r)) {
+                    return kNaN;
+                }
+                double discount = std::exp(-r * T);
+                return forward_implied_volatility(is_call ? 1.0 : -1.0, S / discount, K, T,
+                                                  option_price / discount);
+            }
+        }  // namespace
+
+        PricingModel parse_pricing_model(std::string_view name) {
+            std::string lower;
+            for (char c : name) {
+                if (c != '-' && c != '_' && c != ' ') {
+                    lower.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+                }
+            }
+
+            if (lower == "blackscholes" || lower == "bs" || lower == "lognormal") {
+                return PricingModel::BLACK_SCHOLES;
+            }
+            if (lower == "bachelier" || lower == "normal") {
+                return PricingModel::BACHELIER;
+            }
+            throw std::invalid_argument("Unknown pricing model: " + std::string(name));
+        }
+
+        const char* pricing_model_name(PricingModel model) {
+            return model == PricingModel::BACHELIER ? "Bachelier" : "BlackScholes";
+        }
+
+        double bachelier_price(bool is_call, double S, double K, double T, double r,
+                               double sigma) {
+            // Input validation
+            if (T <= 0 || sigma < 0) {
+                throw std::invalid_argument("Invalid input parameters");
+            }
+
+            double discount = std::exp(-r * T);
+            return discount * forward_price(is_call ? 1.0 : -1.0, S / discount, K, T, sigma);
+        }
+
+        double bachelier_vega(double S, double K, double T, double r, double sigma) {
+            // Input validation
+            if (T <= 0 || sigma <= 0) {
+                throw std::invalid_argument("Invalid input parameters");
+            }
+
+            double discount = std::exp(-r * T);
+            double d = (S / discount - K) / (sigma * std::sqrt(T));
+            return discount * std::sqrt(T) * norm_pdf(d);
+        }
+
+        double bachelier_implied_volatility(bool is_call, double S, double K, double T, double r,
+                                            double option_price) {
+            if (T <= 0) {
+                throw std::invalid_argument("Invalid input parameters");
+            }
+
+            double sigma = implied_volatility_or_nan(is_call, S, K, T, r, option_price);
+            if (std::isnan(sigma)) {
+                throw std::invalid_argument("Option price is outside the no-arbitrage bounds");
+            }
+            return sigma;
+        }
+
+        std::vector<double> bachelier_price_batch(const OptionBatch& batch,
+                                                  const std::vector<double>& volatility) {
+            if (volatility.size() != batch.size()) {
+                throw std::invalid_argument("Volatility count does not match batch size");
+            }
+
+            std::vector<double> prices(batch.size());
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                double T = batch.time_to_expiry[i];
+                double sigma = volatility[i];
+                double discount = std::exp(-batch.risk_free_rate[i] * T);
+                double theta = batch.is_call[i] != 0 ? 1.0 : -1.0;
+                double price = discount * forward_price(theta, batch.asset_price[i] / discount,
+                                                        batch.strike_price[i], T, sigma);
+                prices[i] = (T > 0 && sigma >= 0) ? price : kNaN;
+            }
+            return prices;
+        }
+
+        std::vector<double> bachelier_implied_volatility_batch(
+            const OptionBatch& batch, const std::vector<double>& option_price) {
+            if (option_price.size() != batch.size()) {
+                throw std::invalid_argument("Price count does not match batch size");
+            }
+
+            std::vector<double> volatility(batch.size());
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                volatility[i] = implied_volatility_or_nan(
+                    batch.is_call[i] != 0, batch.asset_price[i], batch.strike_price[i],
+                    batch.time_to_expiry[i], batch.risk_free_rate[i], option_price[i]);
+            }
+            return volatility;
+        }
+    }  // namespace core
+}  // namespace iv_calculator
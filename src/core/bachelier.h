@@ -0,0 +1,102 @@
+#pragma once
+
+#include "src/core/option_batch.h"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace iv_calculator::core {
+    /**
+     * @brief Enumeration of option pricing models
+     */
+    enum class PricingModel : std::uint8_t {
+        BLACK_SCHOLES,  ///< Lognormal model, requires positive asset and strike prices
+        BACHELIER       ///< Normal model, allows negative or zero asset and strike prices
+    };
+
+    /**
+     * @brief Parse a pricing model name
+     *
+     * Accepts "black-scholes", "blackscholes", "bs", "lognormal", "bachelier" and "normal"
+     * in any letter case.
+     *
+     * @param name Model name
+     * @return PricingModel Parsed model
+     */
+    PricingModel parse_pricing_model(std::string_view name);
+
+    /**
+     * @brief Get the display name of a pricing model
+     *
+     * @param model Pricing model
+     * @return const char* "BlackScholes" or "Bachelier"
+     */
+    const char* pricing_model_name(PricingModel model);
+
+    /**
+     * @brief Calculate option price using the Bachelier (normal) model
+     *
+     * The forward S * exp(r * T) follows an arithmetic Brownian motion with
+     * absolute volatility sigma, so S and K may be zero or negative.
+     *
+     * @param is_call True for Call option, False for Put option
+     * @param S Current price of the underlying asset
+     * @param K Strike price
+     * @param T Time to expiration in years
+     * @param r Risk-free interest rate
+     * @param sigma Normal (absolute) volatility of the underlying asset
+     * @return double Option price
+     */
+    double bachelier_price(bool is_call, double S, double K, double T, double r, double sigma);
+
+    /**
+     * @brief Calculate option's vega under the Bachelier model
+     *
+     * @param S Current price of the underlying asset
+     * @param K Strike price
+     * @param T Time to expiration in years
+     * @param r Risk-free interest rate
+     * @param sigma Normal (absolute) volatility of the underlying asset
+     * @return double Price change per unit of normal volatility
+     */
+    double bachelier_vega(double S, double K, double T, double r, double sigma);
+
+    /**
+     * @brief Calculate implied normal volatility in closed form
+     *
+     * Uses Jaeckel's rational approximation ("Implied Normal Volatility", 2017)
+     * followed by one Householder step, so no iteration is needed.
+     *
+     * @param is_call True for Call option, False for Put option
+     * @param S Current price of the underlying asset
+     * @param K Strike price
+     * @param T Time to expiration in years
+     * @param r Risk-free interest rate
+     * @param option_price Market price of the option
+     * @return double Implied normal volatility
+     */
+    double bachelier_implied_volatility(bool is_call, double S, double K, double T, double r,
+                                        double option_price);
+
+    /**
+     * @brief Calculate Bachelier prices of many options
+     *
+     * @param batch Options to price
+     * @param volatility Normal volatility of each option
+     * @return std::vector<double> Option prices in batch order, NaN for invalid inputs
+     */
+    std::vector<double> bachelier_price_batch(const OptionBatch& batch,
+                                              const std::vector<double>& volatility);
+
+    /**
+     * @brief Calculate implied normal volatilities of many options
+     *
+     * @param batch Options to invert
+     * @param option_price Market price of each option
+     * @return std::vector<double> Implied normal volatilities in batch order, NaN for
+     * prices outside the no-arbitrage bounds
+     */
+    std::vector<double> bachelier_implied_volatility_batch(const OptionBatch& batch,
+                                                           const std::vector<double>& option_price);
+}  // namespace iv_calculator::core
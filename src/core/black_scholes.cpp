@@ -1,8 +1,12 @@
 #include "black_scholes.h"
 
+#include <algorithm>
+#include <array>
+#include <cctype>
 #include <cmath>
 #include <limits>
 #include <stdexcept>
+#include <string>
 
 namespace iv_calculator {
     namespace core {
@@ -45,161 +49,995 @@ namespace iv_calculator {
                    100.0;  // Divided by 100 to convert to percentage points
         }
 
-        double calculate_implied_volatility(bool is_call, double S, double K, double T, double r,
-                                            double option_price, ImpliedVolatilityMethod method) {
-            // Choose the appropriate method based on the parameter
-            switch (method) {
-                case ImpliedVolatilityMethod::NEWTON_RAPHSON:
-                    try {
-                        return newton_raphson_implied_volatility(is_call, S, K, T, r, option_price);
-                    } catch (const std::runtime_error&) {
-                        // If Newton-Raphson fails, fall back to bisection method
-                        return bisection_implied_volatility(is_call, S, K, T, r, option_price);
-                    }
-                case ImpliedVolatilityMethod::BISECTION:
-                default:
-                    return bisection_implied_volatility(is_call, S, K, T, r, option_price);
+        double black_scholes_vomma(double S, double K, double T, double r, double sigma) {
+            // Input validation
+            if (S <= 0 || K <= 0 || T <= 0 || sigma <= 0) {
+                throw std::invalid_argument("Invalid input parameters");
             }
+
+            double sqrt_T = std::sqrt(T);
+            double d1 = (std::log(S / K) + (r + sigma * sigma / 2) * T) / (sigma * sqrt_T);
+            double d2 = d1 - sigma * sqrt_T;
+            return S * sqrt_T * norm_pdf(d1) * d1 * d2 / sigma;
         }
 
-        double bisection_implied_volatility(bool is_call, double S, double K, double T, double r,
-                                            double option_price) {
-            // Simple bisection method to find implied volatility
-            if (option_price <= 0) {
-                throw std::invalid_argument("Option price must be positive");
+        namespace {
+            // Price and its first three derivatives in sigma, sharing d1, d2 and the density;
+            // derivatives above order are left at zero
+            struct PriceDerivatives {
+                double price = 0.0;
+                double vega = 0.0;
+                double vomma = 0.0;
+                double ultima = 0.0;
+            };
+
+            PriceDerivatives price_derivatives(bool is_call, double S, double K, double T,
+                                               double r, double sigma, int order) {
+                if (S <= 0 || K <= 0 || T <= 0 || sigma <= 0) {
+                    throw std::invalid_argument("Invalid input parameters");
+                }
+
+                double sqrt_T = std::sqrt(T);
+                double d1 = (std::log(S / K) + (r + sigma * sigma / 2) * T) / (sigma * sqrt_T);
+                double d2 = d1 - sigma * sqrt_T;
+                double discounted_strike = K * std::exp(-r * T);
+
+                PriceDerivatives result;
+                result.price = is_call ? S * norm_cdf(d1) - discounted_strike * norm_cdf(d2)
+                                       : discounted_strike * norm_cdf(-d2) - S * norm_cdf(-d1);
+                result.vega = S * sqrt_T * norm_pdf(d1);
+                if (order >= 2) {
+                    double d1d2 = d1 * d2;
+                    result.vomma = result.vega * d1d2 / sigma;
+                    if (order >= 3) {
+                        result.ultima = -result.vega / (sigma * sigma) *
+                                        (d1d2 * (1.0 - d1d2) + d1 * d1 + d2 * d2);
+                    }
+                }
+                return result;
             }
 
-            // Lower and upper bounds for volatility
-            double sigma_low = 0.001;
-            double sigma_high = 10.0;
+            // Original start: fixed buckets by expiry and moneyness
+            double bucket_guess(bool is_call, double S, double K, double T,
+                                double option_price) {
+                // For short expiry options, start with higher initial volatility
+                if (T < 0.1) {
+                    return 0.5;  // Higher starting point for short expiry
+                }
+                // For ATM options, use Brenner-Subrahmanyam approximation
+                if (std::abs(S / K - 1.0) < 0.1) {
+                    // Brenner-Subrahmanyam approximation: sigma ≈ sqrt(2π/T) * (C/S)
+                    double sigma = std::sqrt(2.0 * M_PI / T) * option_price / S;
+                    // Clamp to reasonable range
+                    return std::max(0.1, std::min(sigma, 1.0));
+                }
+                // Lower start for ITM options, higher for OTM options
+                return (is_call && S > K) || (!is_call && S < K) ? 0.2 : 0.4;
+            }
 
-            // Target precision
-            double epsilon = 1e-8;  // Increased precision
+            // Corrado and Miller (1996): quadratic approximation of the call price around the
+            // money. Away from the money the discriminant can turn negative; it is then either
+            // floored at zero or reported as NaN.
+            double corrado_miller_guess(bool is_call, double S, double K, double T, double r,
+                                        double option_price, bool floor_discriminant) {
+                double discounted_strike = K * std::exp(-r * T);
+                // Put prices are converted to call prices by put-call parity
+                double call = is_call ? option_price : option_price + S - discounted_strike;
+                double half_moneyness = 0.5 * (S - discounted_strike);
+                double centered = call - half_moneyness;
+                double discriminant = centered * centered -
+                                      4.0 * half_moneyness * half_moneyness / M_PI;
+                if (discriminant < 0) {
+                    if (!floor_discriminant) {
+                        return NAN;
+                    }
+                    discriminant = 0.0;
+                }
+                return std::sqrt(2.0 * M_PI / T) * (centered + std::sqrt(discriminant)) /
+                       (S + discounted_strike);
+            }
 
-            // Maximum iterations
-            int max_iterations = 1000;
+            // Manaster and Koehler (1982): the volatility of maximum vega, from which
+            // Newton-Raphson converges monotonically
+            double inflection_guess(double S, double K, double T, double r) {
+                return std::sqrt(2.0 * std::abs(std::log(S / K) + r * T) / T);
+            }
 
-            for (int i = 0; i < max_iterations; ++i) {
-                double sigma_mid = (sigma_low + sigma_high) / 2;
+            // Tolerance of an explicit criterion given without one
+            constexpr double kDefaultTolerance = 1e-8;
 
-                double price = black_scholes_price(is_call, S, K, T, r, sigma_mid);
+            // Stopping rule of one solve, with DEFAULT resolved to a concrete criterion
+            struct Convergence {
+                ConvergenceCriterion criterion = ConvergenceCriterion::PRICE;
+                double tolerance = kDefaultTolerance;
 
-                if (std::abs(price - option_price) < epsilon) {
-                    return sigma_mid;
+                // Whether the criterion needs vega where the method does not compute it
+                [[nodiscard]] bool needs_vega() const {
+                    return criterion == ConvergenceCriterion::VEGA_SCALED;
                 }
 
-                if (price < option_price) {
-                    sigma_low = sigma_mid;
-                } else {
-                    sigma_high = sigma_mid;
+                // Measure of a price-space criterion for a price error; vega is per unit of
+                // volatility and only read by VEGA_SCALED
+                [[nodiscard]] double price_measure(double price_error, double option_price,
+                                                   double vega) const {
+                    switch (criterion) {
+                        case ConvergenceCriterion::RELATIVE_PRICE:
+                            return std::abs(price_error) / option_price;
+                        case ConvergenceCriterion::VEGA_SCALED:
+                            return std::abs(price_error) / vega;
+                        default:
+                            return std::abs(price_error);
+                    }
                 }
-            }
+            };
 
-            throw std::runtime_error("Implied volatility calculation did not converge");
-        }
+            // Requested stopping rule, or the method's own one for DEFAULT
+            Convergence resolve_convergence(const SolverOptions& options,
+                                            ConvergenceCriterion method_criterion,
+                                            double method_tolerance) {
+                if (options.criterion == ConvergenceCriterion::DEFAULT) {
+                    return {method_criterion, method_tolerance};
+                }
+                return {options.criterion,
+                        options.tolerance > 0 ? options.tolerance : kDefaultTolerance};
+            }
 
-        double newton_raphson_implied_volatility(bool is_call, double S, double K, double T,
-                                                 double r, double option_price) {
-            // Newton-Raphson method to find implied volatility
-            if (option_price <= 0) {
-                throw std::invalid_argument("Option price must be positive");
+            // Own stopping rules of the methods
+            Convergence bisection_convergence(const SolverOptions& options) {
+                return resolve_convergence(options, ConvergenceCriterion::PRICE, 1e-8);
             }
 
-            // Initial volatility guess - use better approximation for starting point
-            // For ATM options, use Brenner and Subrahmanyam (1988) approximation
-            // For others, use a standard starting point
-            double sigma = NAN;
-            // For short expiry options, start with higher initial volatility
-            if (T < 0.1) {
-                sigma = 0.5;  // Higher starting point for short expiry
+            Convergence brent_convergence(const SolverOptions& options) {
+                return resolve_convergence(options, ConvergenceCriterion::VOLATILITY, 1e-10);
             }
-            // For ATM options, use Brenner-Subrahmanyam approximation
-            else if (std::abs(S / K - 1.0) < 0.1) {
-                // Brenner-Subrahmanyam approximation: sigma ≈ sqrt(2π/T) * (C/S)
-                sigma = std::sqrt(2.0 * M_PI / T) * option_price / S;
-                // Clamp to reasonable range
-                sigma = std::max(0.1, std::min(sigma, 1.0));
+
+            Convergence householder_convergence(const SolverOptions& options) {
+                return resolve_convergence(options, ConvergenceCriterion::PRICE, 1e-6);
             }
-            // For ITM options, use lower initial volatility
-            else if ((is_call && S > K) || (!is_call && S < K)) {
-                sigma = 0.2;  // ITM
+
+            // Boundaries of the regions of select_implied_volatility_method
+            constexpr double kWingTimeValue = 1e-4;      // Normalized time value, anywhere
+            constexpr double kFarWingTimeValue = 1e-2;   // Normalized time value, far wings
+            constexpr double kFarWingMoneyness = 2.0;    // |ln(F / K)| / sqrt(T)
+
+            // Region test shared by the scalar and batch selection. The tests are selects, not
+            // branches, but the libm exp, log and sqrt calls keep the batch loop scalar (GCC
+            // does not vectorize it without a vector math library); invalid inputs compare
+            // false and go to Brent
+            ImpliedVolatilityMethod route_method(bool is_call, double S, double K, double T,
+                                                 double r, double option_price) {
+                double discounted_strike = K * std::exp(-r * T);
+                double intrinsic = std::max((is_call ? 1.0 : -1.0) * (S - discounted_strike),
+                                            0.0);
+                double time_value = (option_price - intrinsic) / std::sqrt(S * discounted_strike);
+                double moneyness = std::abs(std::log(S / discounted_strike)) / std::sqrt(T);
+                bool smooth = time_value >= kWingTimeValue &&
+                              (time_value >= kFarWingTimeValue ||
+                               moneyness <= kFarWingMoneyness) &&
+                              option_price < (is_call ? S : discounted_strike);
+                return smooth ? ImpliedVolatilityMethod::HOUSEHOLDER
+                              : ImpliedVolatilityMethod::BRENT;
             }
-            // For OTM options, use higher initial volatility
-            else {
-                sigma = 0.4;  // OTM
+
+            // Options solved side by side by the batch bisection
+            constexpr std::size_t kBisectionLanes = 8;
+            constexpr double kBisectionLow = 0.001;
+            constexpr double kBisectionHigh = 10.0;
+
+            // Volatility-independent terms of a block of options, lanes innermost
+            struct BisectionLanes {
+                std::array<double, kBisectionLanes> sign{};          // +1 for Call, -1 for Put
+                std::array<double, kBisectionLanes> spot{};          // S
+                std::array<double, kBisectionLanes> discounted{};    // K * exp(-rT)
+                std::array<double, kBisectionLanes> log_forward{};   // ln(S / K) + rT
+                std::array<double, kBisectionLanes> sqrt_time{};     // sqrt(T)
+                std::array<double, kBisectionLanes> target{};        // Market price
+                std::array<bool, kBisectionLanes> valid{};
+
+                // Black-Scholes price of lane l at sigma, written without branches
+                [[nodiscard]] double price(std::size_t l, double sigma) const {
+                    double deviation = sigma * sqrt_time[l];
+                    double d1 = log_forward[l] / deviation + 0.5 * deviation;
+                    double d2 = d1 - deviation;
+                    return sign[l] * (spot[l] * 0.5 * std::erfc(-sign[l] * d1 * M_SQRT1_2) -
+                                      discounted[l] * 0.5 * std::erfc(-sign[l] * d2 * M_SQRT1_2));
+                }
+            };
+
+            // Lower-case name without '-', '_' and spaces
+            std::string method_key(std::string_view name) {
+                std::string key;
+                for (char c : name) {
+                    if (c != '-' && c != '_' && c != ' ') {
+                        key += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                    }
+                }
+                return key;
             }
 
-            // Target precision
-            double epsilon = 1e-6;
+            // Keep starting points inside the range Newton-Raphson steps within
+            double clamp_guess(double sigma) { return std::min(std::max(sigma, 1e-3), 5.0); }
+
+            double bisection_solve(bool is_call, double S, double K, double T, double r,
+                                   double option_price, const Convergence& stop,
+                                   ImpliedVolatilityResult& result) {
+                // Simple bisection method to find implied volatility
+                if (option_price <= 0) {
+                    throw std::invalid_argument("Option price must be positive");
+                }
+
+                // Lower and upper bounds for volatility
+                double sigma_low = 0.001;
+                double sigma_high = 10.0;
 
-            // Maximum iterations
-            int max_iterations = 100;  // Increased max iterations
+                // Maximum iterations
+                int max_iterations = 1000;
 
-            // Last valid sigma (in case we need to revert)
-            double last_valid_sigma = sigma;
-            double best_price_diff = std::numeric_limits<double>::max();
-            double best_sigma = sigma;
+                for (int i = 0; i < max_iterations; ++i) {
+                    ++result.iterations;
+                    double sigma_mid = (sigma_low + sigma_high) / 2;
 
-            for (int i = 0; i < max_iterations; ++i) {
-                // Calculate price and vega at current sigma
-                double price = black_scholes_price(is_call, S, K, T, r, sigma);
-                double vega = black_scholes_vega(S, K, T, r, sigma);
+                    double price = black_scholes_price(is_call, S, K, T, r, sigma_mid);
+
+                    // The root is within half the bracket of its midpoint
+                    double measure =
+                        stop.criterion == ConvergenceCriterion::VOLATILITY
+                            ? (sigma_high - sigma_low) / 2
+                            : stop.price_measure(
+                                  price - option_price, option_price,
+                                  stop.needs_vega()
+                                      ? 100.0 * black_scholes_vega(S, K, T, r, sigma_mid)
+                                      : 1.0);
+                    if (measure < stop.tolerance) {
+                        result.achieved = measure;
+                        return sigma_mid;
+                    }
 
-                // Track the best approximation so far
-                double price_diff = std::abs(price - option_price);
-                if (price_diff < best_price_diff) {
-                    best_price_diff = price_diff;
-                    best_sigma = sigma;
+                    if (price < option_price) {
+                        sigma_low = sigma_mid;
+                    } else {
+                        sigma_high = sigma_mid;
+                    }
                 }
 
-                // Check for convergence
-                if (std::abs(price - option_price) < epsilon) {
-                    return sigma;
+                throw std::runtime_error("Implied volatility calculation did not converge");
+            }
+
+            // Bracket the root from the no-arbitrage bounds, then refine it with Brent's method
+            // (inverse quadratic interpolation, secant and bisection steps)
+            double brent_solve(bool is_call, double S, double K, double T, double r,
+                               double option_price, double guess, const Convergence& stop,
+                               ImpliedVolatilityResult& result) {
+                if (option_price <= 0) {
+                    throw std::invalid_argument("Option price must be positive");
+                }
+                if (S <= 0 || K <= 0 || T <= 0) {
+                    throw std::invalid_argument("Invalid input parameters");
                 }
 
-                // Check for very small vega to avoid division by near-zero
-                if (std::abs(vega) < 1e-10) {
-                    // Fall back to last valid sigma or throw if none
-                    if (last_valid_sigma > 0) {
-                        sigma = last_valid_sigma;
-                        break;
+                // A price at or outside [intrinsic, upper bound] has no implied volatility
+                double discounted_strike = K * std::exp(-r * T);
+                double intrinsic = is_call ? std::max(S - discounted_strike, 0.0)
+                                           : std::max(discounted_strike - S, 0.0);
+                double upper_bound = is_call ? S : discounted_strike;
+                if (!(option_price > intrinsic && option_price < upper_bound)) {
+                    throw std::invalid_argument(
+                        "Option price is outside the no-arbitrage bounds");
+                }
+
+                auto objective = [&](double sigma) {
+                    ++result.iterations;
+                    return black_scholes_price(is_call, S, K, T, r, sigma) - option_price;
+                };
+
+                // Start around a given guess, or else the at-the-money approximation of the
+                // time value, and widen geometrically until the bracket holds the root
+                double spread = 1.1;
+                if (!(guess > 0)) {
+                    guess = std::sqrt(2.0 * M_PI / T) * (option_price - intrinsic) /
+                            std::sqrt(S * discounted_strike);
+                    spread = 2.0;
+                }
+                guess = std::min(std::max(guess, 1e-4), 10.0);
+                double a = guess / spread;
+                double b = guess * spread;
+                double fa = objective(a);
+                double fb = 0.0;
+                if (fa > 0) {
+                    do {
+                        b = a;
+                        fb = fa;
+                        a *= 0.25;
+                        fa = objective(a);
+                    } while (fa > 0 && a > 1e-8);
+                } else {
+                    fb = objective(b);
+                    while (fb < 0 && b < 100.0) {
+                        a = b;
+                        fa = fb;
+                        b *= 4.0;
+                        fb = objective(b);
+                    }
+                }
+                if (fa > 0 || fb < 0) {
+                    throw std::runtime_error("Implied volatility could not be bracketed");
+                }
+
+                // Target precision, by default as the width of the bracket in volatility, so
+                // options with tiny vega are resolved as finely as at-the-money ones; price
+                // criteria are checked at the best estimate instead
+                bool in_volatility = stop.criterion == ConvergenceCriterion::VOLATILITY;
+                double sigma_tolerance = in_volatility ? stop.tolerance : 0.0;
+                int max_iterations = 100;
+
+                double c = b;
+                double fc = fb;
+                double d = b - a;
+                double e = d;
+                for (int i = 0; i < max_iterations; ++i) {
+                    // Keep the root between b and c, with b the better estimate
+                    if ((fb > 0 && fc > 0) || (fb < 0 && fc < 0)) {
+                        c = a;
+                        fc = fa;
+                        d = b - a;
+                        e = d;
+                    }
+                    if (std::abs(fc) < std::abs(fb)) {
+                        a = b;
+                        b = c;
+                        c = a;
+                        fa = fb;
+                        fb = fc;
+                        fc = fa;
+                    }
+
+                    double tolerance =
+                        2.0 * std::numeric_limits<double>::epsilon() * std::abs(b) +
+                        0.5 * sigma_tolerance;
+                    double half_width = 0.5 * (c - b);
+                    double measure = 0.0;
+                    if (in_volatility) {
+                        measure = fb == 0.0 ? 0.0 : std::abs(c - b);
                     } else {
-                        throw std::runtime_error("Newton-Raphson method failed: vega too small");
+                        measure = stop.price_measure(
+                            fb, option_price,
+                            stop.needs_vega() ? 100.0 * black_scholes_vega(S, K, T, r, b) : 1.0);
                     }
+                    if (std::abs(half_width) <= tolerance || fb == 0.0 ||
+                        (!in_volatility && measure < stop.tolerance)) {
+                        result.achieved = measure;
+                        return b;
+                    }
+
+                    if (std::abs(e) >= tolerance && std::abs(fa) > std::abs(fb)) {
+                        // Secant step when only two points are known, inverse quadratic
+                        // interpolation otherwise
+                        double s = fb / fa;
+                        double p = 0.0;
+                        double q = 0.0;
+                        if (a == c) {
+                            p = 2.0 * half_width * s;
+                            q = 1.0 - s;
+                        } else {
+                            double t = fa / fc;
+                            double u = fb / fc;
+                            p = s * (2.0 * half_width * t * (t - u) - (b - a) * (u - 1.0));
+                            q = (t - 1.0) * (u - 1.0) * (s - 1.0);
+                        }
+                        if (p > 0) {
+                            q = -q;
+                        } else {
+                            p = -p;
+                        }
+                        // Accept the interpolation only if it stays well inside the bracket
+                        if (2.0 * p < std::min(3.0 * half_width * q - std::abs(tolerance * q),
+                                               std::abs(e * q))) {
+                            e = d;
+                            d = p / q;
+                        } else {
+                            d = half_width;
+                            e = d;
+                        }
+                    } else {
+                        d = half_width;
+                        e = d;
+                    }
+
+                    a = b;
+                    fa = fb;
+                    b += std::abs(d) > tolerance ? d : std::copysign(tolerance, half_width);
+                    fb = objective(b);
                 }
 
-                // Update sigma using Newton-Raphson formula
-                // Calculate raw adjustment
-                double adjustment = (price - option_price) / vega;
+                throw std::runtime_error("Implied volatility calculation did not converge");
+            }
+
+            // Order of the Householder iteration of a method
+            int householder_order(ImpliedVolatilityMethod method) {
+                switch (method) {
+                    case ImpliedVolatilityMethod::HALLEY:
+                        return 2;
+                    case ImpliedVolatilityMethod::HOUSEHOLDER:
+                        return 3;
+                    default:
+                        return 1;
+                }
+            }
 
-                // Limit the size of adjustment to prevent overshooting
-                // Make smaller adjustments for short expiry options
-                double max_adjustment = (T < 0.1) ? 0.1 * sigma : 0.3 * sigma;
-                if (std::abs(adjustment) > max_adjustment) {
-                    adjustment = (adjustment > 0) ? max_adjustment : -max_adjustment;
+            // Householder iteration of the order of options.method: 1 is Newton-Raphson, 2
+            // Halley and 3 the third-order Householder step, all sharing the clamping and
+            // fallback of Newton
+            double householder_solve(bool is_call, double S, double K, double T, double r,
+                                     double option_price, double sigma,
+                                     const SolverOptions& options,
+                                     ImpliedVolatilityResult& result) {
+                int order = householder_order(options.method);
+                Convergence stop = householder_convergence(options);
+                if (option_price <= 0) {
+                    throw std::invalid_argument("Option price must be positive");
                 }
 
-                double new_sigma = sigma - adjustment;
+                // Volatility steps are judged once taken; the best point so far is then
+                // tracked by its first-order volatility error
+                bool in_volatility = stop.criterion == ConvergenceCriterion::VOLATILITY;
+
+                // Steps from a sound start converge in a handful of iterations, so reaching
+                // the cap means the iteration is stuck; the best point or the fallback is
+                // then used
+                int max_iterations = 100;
+
+                // Last valid sigma (in case we need to revert)
+                double last_valid_sigma = sigma;
+                double best_measure = std::numeric_limits<double>::max();
+                double best_sigma = sigma;
+
+                for (int i = 0; i < max_iterations; ++i) {
+                    ++result.iterations;
+                    // Price and its derivatives at current sigma
+                    PriceDerivatives at =
+                        price_derivatives(is_call, S, K, T, r, sigma, order);
 
-                // Ensure volatility stays positive and within reasonable bounds
-                if (new_sigma <= 0.0001) {
-                    new_sigma = 0.0001;
-                } else if (new_sigma > 5.0) {
-                    new_sigma = 5.0;
+                    // Track the best approximation so far
+                    double price_error = at.price - option_price;
+                    double measure =
+                        in_volatility ? std::abs(price_error) / at.vega
+                                      : stop.price_measure(price_error, option_price, at.vega);
+                    if (measure < best_measure) {
+                        best_measure = measure;
+                        best_sigma = sigma;
+                    }
+
+                    // Check for convergence
+                    if (!in_volatility && measure < stop.tolerance) {
+                        result.achieved = measure;
+                        return sigma;
+                    }
+
+                    // Check for very small vega to avoid division by near-zero
+                    if (std::abs(at.vega) < 1e-10) {
+                        // Fall back to last valid sigma or throw if none
+                        if (last_valid_sigma > 0) {
+                            sigma = last_valid_sigma;
+                            break;
+                        } else {
+                            throw std::runtime_error(
+                                "Newton-Raphson method failed: vega too small");
+                        }
+                    }
+
+                    // Newton step, corrected by the higher derivatives; a correction factor
+                    // far from one means the expansion is unreliable, so Newton's step is kept
+                    double adjustment = price_error / at.vega;
+                    if (order >= 2) {
+                        double curvature = adjustment * at.vomma / at.vega;
+                        double factor = order == 2
+                                            ? 1.0 / (1.0 - 0.5 * curvature)
+                                            : (1.0 - 0.5 * curvature) /
+                                                  (1.0 - curvature + adjustment * adjustment *
+                                                                         at.ultima /
+                                                                         (6.0 * at.vega));
+                        if (std::isfinite(factor) && factor > 0.25 && factor < 4.0) {
+                            adjustment *= factor;
+                        }
+                    }
+
+                    // Limit the size of adjustment to prevent overshooting
+                    // Make smaller adjustments for short expiry options
+                    double max_adjustment = (T < 0.1) ? 0.1 * sigma : 0.3 * sigma;
+                    if (std::abs(adjustment) > max_adjustment) {
+                        adjustment = (adjustment > 0) ? max_adjustment : -max_adjustment;
+                    }
+
+                    double new_sigma = sigma - adjustment;
+
+                    // Ensure volatility stays positive and within reasonable bounds
+                    if (new_sigma <= 0.0001) {
+                        new_sigma = 0.0001;
+                    } else if (new_sigma > 5.0) {
+                        new_sigma = 5.0;
+                    }
+
+                    // A step below the tolerance ends the iteration at the point it reaches
+                    if (in_volatility && std::abs(adjustment) < stop.tolerance) {
+                        result.achieved = std::abs(adjustment);
+                        return new_sigma;
+                    }
+
+                    // Update sigma
+                    last_valid_sigma = sigma;
+                    sigma = new_sigma;
                 }
 
-                // Update sigma
-                last_valid_sigma = sigma;
-                sigma = new_sigma;
+                // If we've reached max iterations but have a reasonable value, return it
+                // Return either the best approximation or fall back to Brent's method
+                if (best_measure < stop.tolerance * 100) {
+                    result.achieved = best_measure;
+                    return best_sigma;  // Return best approximation found
+                } else if (!options.fallback) {
+                    return NAN;  // Left to the caller
+                } else {
+                    // Fall back to the bracketing method
+                    return brent_solve(is_call, S, K, T, r, option_price, 0.0,
+                                       brent_convergence(options), result);
+                }
             }
 
-            // If we've reached max iterations but have a reasonable value, return it
-            // Return either the best approximation or fall back to bisection
-            if (best_price_diff < epsilon * 100) {
-                return best_sigma;  // Return best approximation found
+            // Stopping rule of the quote sides
+            Convergence quote_convergence(const SolverOptions& options) {
+                return resolve_convergence(options, ConvergenceCriterion::VOLATILITY, 1e-10);
+            }
+
+            // Widest volatility a quote side brackets before giving up
+            constexpr double kMaxQuoteVolatility = 100.0;
+
+            // Everything in the price of one contract but the volatility
+            struct ContractTerms {
+                bool is_call;
+                double S;
+                double discounted_strike;
+                double log_forward_moneyness;  // ln(F / K)
+                double sqrt_T;
+                double intrinsic;    // Price at zero volatility
+                double upper_bound;  // Price at infinite volatility
+
+                ContractTerms(bool call, double spot, double K, double T, double r)
+                    : is_call(call),
+                      S(spot),
+                      discounted_strike(K * std::exp(-r * T)),
+                      log_forward_moneyness(std::log(spot / K) + r * T),
+                      sqrt_T(std::sqrt(T)),
+                      intrinsic(call ? std::max(spot - discounted_strike, 0.0)
+                                     : std::max(discounted_strike - spot, 0.0)),
+                      upper_bound(call ? spot : discounted_strike) {}
+
+                // Price and its first three derivatives in sigma, as price_derivatives
+                [[nodiscard]] PriceDerivatives at(double sigma) const {
+                    double total = sigma * sqrt_T;
+                    double d1 = log_forward_moneyness / total + 0.5 * total;
+                    double d2 = d1 - total;
+
+                    PriceDerivatives result;
+                    result.price = is_call ? S * norm_cdf(d1) - discounted_strike * norm_cdf(d2)
+                                           : discounted_strike * norm_cdf(-d2) - S * norm_cdf(-d1);
+                    result.vega = S * sqrt_T * norm_pdf(d1);
+                    double d1d2 = d1 * d2;
+                    result.vomma = result.vega * d1d2 / sigma;
+                    result.ultima = -result.vega / (sigma * sigma) *
+                                    (d1d2 * (1.0 - d1d2) + d1 * d1 + d2 * d2);
+                    return result;
+                }
+            };
+
+            // Third-order Householder iteration kept inside [low, high], which must hold the
+            // root; an infinite high end is first widened until it prices above the quote.
+            // Returns NaN for a quote outside the no-arbitrage bounds
+            double quote_solve(const ContractTerms& terms, double quote, double low, double high,
+                               double sigma, const Convergence& stop,
+                               ImpliedVolatilityResult& result) {
+                result.method = ImpliedVolatilityMethod::HOUSEHOLDER;
+                if (!(quote > terms.intrinsic && quote < terms.upper_bound)) {
+                    return NAN;
+                }
+
+                if (std::isinf(high)) {
+                    high = std::max(2.0 * low, 1.0);
+                    while (terms.at(high).price < quote) {
+                        ++result.iterations;
+                        low = high;
+                        high *= 2.0;
+                        if (high > kMaxQuoteVolatility) {
+                            return NAN;
+                        }
+                    }
+                }
+
+                bool in_volatility = stop.criterion == ConvergenceCriterion::VOLATILITY;
+                for (int i = 0; i < 100; ++i) {
+                    if (!(sigma > 0 && sigma >= low && sigma <= high)) {
+                        sigma = 0.5 * (low + high);
+                    }
+                    ++result.iterations;
+                    PriceDerivatives at = terms.at(sigma);
+                    double price_error = at.price - quote;
+                    (price_error > 0 ? high : low) = sigma;
+
+                    double measure = in_volatility
+                                         ? std::abs(price_error) / at.vega
+                                         : stop.price_measure(price_error, quote, at.vega);
+                    if (measure < stop.tolerance ||
+                        (in_volatility && high - low < stop.tolerance)) {
+                        result.achieved = measure < stop.tolerance ? measure : high - low;
+                        return sigma;
+                    }
+
+                    double adjustment = price_error / at.vega;
+                    double curvature = adjustment * at.vomma / at.vega;
+                    double factor =
+                        (1.0 - 0.5 * curvature) /
+                        (1.0 - curvature + adjustment * adjustment * at.ultima / (6.0 * at.vega));
+                    if (std::isfinite(factor) && factor > 0.25 && factor < 4.0) {
+                        adjustment *= factor;
+                    }
+                    sigma -= adjustment;  // Bisected next time if it left the bracket
+                }
+                return NAN;
+            }
+        }  // namespace
+
+        double calculate_implied_volatility(bool is_call, double S, double K, double T, double r,
+                                            double option_price, ImpliedVolatilityMethod method) {
+            return solve_implied_volatility(is_call, S, K, T, r, option_price, method).volatility;
+        }
+
+        ImpliedVolatilityResult solve_implied_volatility(bool is_call, double S, double K,
+                                                         double T, double r, double option_price,
+                                                         ImpliedVolatilityMethod method) {
+            SolverOptions options;
+            options.method = method;
+            return solve_implied_volatility(is_call, S, K, T, r, option_price, options);
+        }
+
+        ImpliedVolatilityResult solve_implied_volatility(bool is_call, double S, double K,
+                                                         double T, double r, double option_price,
+                                                         const SolverOptions& options) {
+            if (options.method == ImpliedVolatilityMethod::AUTO) {
+                SolverOptions routed = options;
+                routed.method = select_implied_volatility_method(is_call, S, K, T, r, option_price);
+                return solve_implied_volatility(is_call, S, K, T, r, option_price, routed);
+            }
+
+            ImpliedVolatilityResult result;
+            result.method = options.method;
+            // Choose the appropriate method based on the parameter
+            switch (options.method) {
+                case ImpliedVolatilityMethod::NEWTON_RAPHSON:
+                case ImpliedVolatilityMethod::HALLEY:
+                case ImpliedVolatilityMethod::HOUSEHOLDER:
+                    try {
+                        double start = initial_volatility_guess(is_call, S, K, T, r, option_price,
+                                                                options.guess, options.previous);
+                        result.volatility =
+                            householder_solve(is_call, S, K, T, r, option_price, start, options,
+                                              result);
+                    } catch (const std::runtime_error&) {
+                        if (!options.fallback) {
+                            result.volatility = NAN;
+                            break;
+                        }
+                        // If the iteration fails, fall back to Brent's method
+                        result.volatility =
+                            brent_solve(is_call, S, K, T, r, option_price, options.previous,
+                                        brent_convergence(options), result);
+                    }
+                    break;
+                case ImpliedVolatilityMethod::BRENT:
+                    result.volatility =
+                        brent_solve(is_call, S, K, T, r, option_price, options.previous,
+                                    brent_convergence(options), result);
+                    break;
+                case ImpliedVolatilityMethod::BISECTION:
+                default:
+                    result.volatility = bisection_solve(is_call, S, K, T, r, option_price,
+                                                        bisection_convergence(options), result);
+                    break;
+            }
+            return result;
+        }
+
+        QuoteImpliedVolatility solve_quote_implied_volatility(bool is_call, double S, double K,
+                                                              double T, double r, double bid,
+                                                              double ask,
+                                                              const SolverOptions& options) {
+            if (S <= 0 || K <= 0 || T <= 0) {
+                throw std::invalid_argument("Invalid input parameters");
+            }
+            if (!(bid >= 0) || !(ask >= bid)) {
+                throw std::invalid_argument("Quotes must satisfy 0 <= bid <= ask");
+            }
+
+            ContractTerms terms(is_call, S, K, T, r);
+            Convergence stop = quote_convergence(options);
+            QuoteImpliedVolatility result;
+            double mid = 0.5 * (bid + ask);
+            result.mid.volatility = NAN;
+            if (mid > terms.intrinsic && mid < terms.upper_bound) {
+                try {
+                    result.mid = solve_implied_volatility(is_call, S, K, T, r, mid, options);
+                } catch (const std::runtime_error&) {
+                    result.mid.volatility = NAN;
+                }
+            }
+
+            double sigma_mid = result.mid.volatility;
+            if (sigma_mid > 0) {
+                // The mid bounds both sides and its vega points each to its root
+                double vega = terms.at(sigma_mid).vega;
+                result.bid.volatility = quote_solve(terms, bid, 0.0, sigma_mid,
+                                                    sigma_mid - (mid - bid) / vega, stop,
+                                                    result.bid);
+                result.ask.volatility = quote_solve(terms, ask, sigma_mid, INFINITY,
+                                                    sigma_mid + (ask - mid) / vega, stop,
+                                                    result.ask);
             } else {
-                // Fall back to bisection method
-                return bisection_implied_volatility(is_call, S, K, T, r, option_price);
+                auto solve_alone = [&](double quote, ImpliedVolatilityResult& side) {
+                    double start = quote > terms.intrinsic && quote < terms.upper_bound
+                                       ? initial_volatility_guess(is_call, S, K, T, r, quote)
+                                       : 0.0;
+                    side.volatility = quote_solve(terms, quote, 0.0, INFINITY, start, stop, side);
+                };
+                solve_alone(bid, result.bid);
+                solve_alone(ask, result.ask);
+            }
+            return result;
+        }
+
+        ImpliedVolatilityMethod select_implied_volatility_method(bool is_call, double S, double K,
+                                                                 double T, double r,
+                                                                 double option_price) {
+            return route_method(is_call, S, K, T, r, option_price);
+        }
+
+        std::vector<ImpliedVolatilityMethod> select_implied_volatility_methods(
+            const OptionBatch& batch, const std::vector<double>& option_price) {
+            if (option_price.size() != batch.size()) {
+                throw std::invalid_argument("Price count does not match batch size");
+            }
+            std::vector<ImpliedVolatilityMethod> methods(batch.size());
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                methods[i] = route_method(batch.is_call[i] != 0, batch.asset_price[i],
+                                          batch.strike_price[i], batch.time_to_expiry[i],
+                                          batch.risk_free_rate[i], option_price[i]);
+            }
+            return methods;
+        }
+
+        double initial_volatility_guess(bool is_call, double S, double K, double T, double r,
+                                        double option_price, InitialGuess method,
+                                        double previous) {
+            double sigma = NAN;
+            switch (method) {
+                case InitialGuess::BUCKETS:
+                    sigma = bucket_guess(is_call, S, K, T, option_price);
+                    break;
+                case InitialGuess::CORRADO_MILLER:
+                    sigma = corrado_miller_guess(is_call, S, K, T, r, option_price, false);
+                    break;
+                case InitialGuess::INFLECTION:
+                    sigma = inflection_guess(S, K, T, r);
+                    break;
+                case InitialGuess::AUTO:
+                default:
+                    if (previous > 0) {
+                        // A neighbouring solution is closer than any closed form
+                        sigma = previous;
+                        break;
+                    }
+                    // Corrado-Miller near the money and, with its discriminant floored, in the
+                    // wings; the maximum-vega point where that leaves no positive estimate
+                    sigma = corrado_miller_guess(is_call, S, K, T, r, option_price, true);
+                    if (!(sigma > 0)) {
+                        sigma = inflection_guess(S, K, T, r);
+                    }
+                    break;
+            }
+            if (!(sigma > 0) || !std::isfinite(sigma)) {
+                sigma = bucket_guess(is_call, S, K, T, option_price);
+            }
+            return clamp_guess(sigma);
+        }
+
+        double bisection_implied_volatility(bool is_call, double S, double K, double T, double r,
+                                            double option_price) {
+            ImpliedVolatilityResult result;
+            return bisection_solve(is_call, S, K, T, r, option_price,
+                                   bisection_convergence(SolverOptions()), result);
+        }
+
+        double newton_raphson_implied_volatility(bool is_call, double S, double K, double T,
+                                                 double r, double option_price) {
+            SolverOptions options;
+            options.method = ImpliedVolatilityMethod::NEWTON_RAPHSON;
+            ImpliedVolatilityResult result;
+            double start = initial_volatility_guess(is_call, S, K, T, r, option_price);
+            return householder_solve(is_call, S, K, T, r, option_price, start, options, result);
+        }
+
+        double halley_implied_volatility(bool is_call, double S, double K, double T, double r,
+                                         double option_price) {
+            SolverOptions options;
+            options.method = ImpliedVolatilityMethod::HALLEY;
+            ImpliedVolatilityResult result;
+            double start = initial_volatility_guess(is_call, S, K, T, r, option_price);
+            return householder_solve(is_call, S, K, T, r, option_price, start, options, result);
+        }
+
+        double householder_implied_volatility(bool is_call, double S, double K, double T,
+                                              double r, double option_price) {
+            SolverOptions options;
+            options.method = ImpliedVolatilityMethod::HOUSEHOLDER;
+            ImpliedVolatilityResult result;
+            double start = initial_volatility_guess(is_call, S, K, T, r, option_price);
+            return householder_solve(is_call, S, K, T, r, option_price, start, options, result);
+        }
+
+        int batch_bisection_iterations(double sigma_tolerance) {
+            if (!(sigma_tolerance > 0)) {
+                throw std::invalid_argument("Volatility tolerance must be positive");
+            }
+            double halvings = std::ceil(std::log2((kBisectionHigh - kBisectionLow) /
+                                                  sigma_tolerance));
+            return static_cast<int>(std::max(halvings, 0.0));
+        }
+
+        std::vector<double> black_scholes_implied_volatility_batch(
+            const OptionBatch& batch, const std::vector<double>& option_price,
+            double sigma_tolerance) {
+            if (option_price.size() != batch.size()) {
+                throw std::invalid_argument("Price count does not match batch size");
+            }
+            const int iterations = batch_bisection_iterations(sigma_tolerance);
+
+            std::vector<double> volatility(batch.size(),
+                                           std::numeric_limits<double>::quiet_NaN());
+            for (std::size_t begin = 0; begin < batch.size(); begin += kBisectionLanes) {
+                std::size_t width = std::min(kBisectionLanes, batch.size() - begin);
+
+                // Unused and invalid lanes solve a harmless stand-in so every loop has a
+                // fixed width; their results are discarded
+                BisectionLanes lanes;
+                for (std::size_t l = 0; l < kBisectionLanes; ++l) {
+                    std::size_t i = begin + std::min(l, width - 1);
+                    double S = batch.asset_price[i];
+                    double K = batch.strike_price[i];
+                    double T = batch.time_to_expiry[i];
+                    double r = batch.risk_free_rate[i];
+                    lanes.valid[l] = l < width && S > 0 && K > 0 && T > 0 && option_price[i] > 0;
+                    if (!lanes.valid[l]) {
+                        S = K = T = 1.0;
+                        r = 0.0;
+                    }
+                    lanes.sign[l] = batch.is_call[i] != 0 ? 1.0 : -1.0;
+                    lanes.spot[l] = S;
+                    lanes.discounted[l] = K * std::exp(-r * T);
+                    lanes.log_forward[l] = std::log(S / K) + r * T;
+                    lanes.sqrt_time[l] = std::sqrt(T);
+                    lanes.target[l] = lanes.valid[l] ? option_price[i] : 0.1;
+                }
+
+                // The price rises with volatility, so a root exists only between the prices
+                // at the ends of the initial bracket
+                std::array<bool, kBisectionLanes> bracketed{};
+                for (std::size_t l = 0; l < kBisectionLanes; ++l) {
+                    bracketed[l] = lanes.price(l, kBisectionLow) <= lanes.target[l] &&
+                                   lanes.price(l, kBisectionHigh) >= lanes.target[l];
+                }
+
+                std::array<double, kBisectionLanes> low{};
+                std::array<double, kBisectionLanes> high{};
+                low.fill(kBisectionLow);
+                high.fill(kBisectionHigh);
+                for (int n = 0; n < iterations; ++n) {
+                    for (std::size_t l = 0; l < kBisectionLanes; ++l) {
+                        double mid = 0.5 * (low[l] + high[l]);
+                        bool below = lanes.price(l, mid) < lanes.target[l];
+                        low[l] = below ? mid : low[l];
+                        high[l] = below ? high[l] : mid;
+                    }
+                }
+
+                for (std::size_t l = 0; l < width; ++l) {
+                    if (lanes.valid[l] && bracketed[l]) {
+                        volatility[begin + l] = 0.5 * (low[l] + high[l]);
+                    }
+                }
+            }
+            return volatility;
+        }
+
+        double brent_implied_volatility(bool is_call, double S, double K, double T, double r,
+                                        double option_price) {
+            ImpliedVolatilityResult result;
+            return brent_solve(is_call, S, K, T, r, option_price, 0.0,
+                               brent_convergence(SolverOptions()), result);
+        }
+
+        ImpliedVolatilityMethod parse_implied_volatility_method(std::string_view name) {
+            std::string key = method_key(name);
+            if (key == "bisection") {
+                return ImpliedVolatilityMethod::BISECTION;
+            }
+            if (key == "newton" || key == "newtonraphson") {
+                return ImpliedVolatilityMethod::NEWTON_RAPHSON;
+            }
+            if (key == "brent") {
+                return ImpliedVolatilityMethod::BRENT;
+            }
+            if (key == "halley") {
+                return ImpliedVolatilityMethod::HALLEY;
+            }
+            if (key == "householder") {
+                return ImpliedVolatilityMethod::HOUSEHOLDER;
+            }
+            if (key == "auto") {
+                return ImpliedVolatilityMethod::AUTO;
+            }
+            throw std::invalid_argument("Unknown implied volatility method '" +
+                                        std::string(name) + "'");
+        }
+
+        InitialGuess parse_initial_guess(std::string_view name) {
+            std::string key = method_key(name);
+            if (key == "auto") {
+                return InitialGuess::AUTO;
+            }
+            if (key == "corradomiller") {
+                return InitialGuess::CORRADO_MILLER;
+            }
+            if (key == "inflection") {
+                return InitialGuess::INFLECTION;
+            }
+            if (key == "buckets") {
+                return InitialGuess::BUCKETS;
+            }
+            throw std::invalid_argument("Unknown initial guess '" + std::string(name) + "'");
+        }
+
+        ConvergenceCriterion parse_convergence_criterion(std::string_view name) {
+            std::string key = method_key(name);
+            if (key == "default") {
+                return ConvergenceCriterion::DEFAULT;
+            }
+            if (key == "price") {
+                return ConvergenceCriterion::PRICE;
+            }
+            if (key == "relative" || key == "relativeprice") {
+                return ConvergenceCriterion::RELATIVE_PRICE;
+            }
+            if (key == "vol" || key == "volatility") {
+                return ConvergenceCriterion::VOLATILITY;
+            }
+            if (key == "vega" || key == "vegascaled") {
+                return ConvergenceCriterion::VEGA_SCALED;
+            }
+            throw std::invalid_argument("Unknown convergence criterion '" + std::string(name) +
+                                        "'");
+        }
+
+        const char* implied_volatility_method_name(ImpliedVolatilityMethod method) {
+            switch (method) {
+                case ImpliedVolatilityMethod::NEWTON_RAPHSON:
+                    return "newton-raphson";
+                case ImpliedVolatilityMethod::BRENT:
+                    return "brent";
+                case ImpliedVolatilityMethod::HALLEY:
+                    return "halley";
+                case ImpliedVolatilityMethod::HOUSEHOLDER:
+                    return "householder";
+                case ImpliedVolatilityMethod::AUTO:
+                    return "auto";
+                case ImpliedVolatilityMethod::BISECTION:
+                default:
+                    return "bisection";
             }
         }
     }  // namespace core
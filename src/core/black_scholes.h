@@ -1,16 +1,139 @@
 #pragma once
 
+#include "src/core/option_batch.h"
+
+#include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <string_view>
+#include <vector>
 
 namespace iv_calculator::core {
     /**
      * @brief Enumeration of numerical methods for implied volatility calculation
      */
     enum class ImpliedVolatilityMethod : std::uint8_t {
-        BISECTION,      ///< Bisection method (robust but slower)
-        NEWTON_RAPHSON  ///< Newton-Raphson method (faster but less robust)
+        BISECTION,       ///< Bisection method (robust but slower)
+        NEWTON_RAPHSON,  ///< Newton-Raphson method (faster but less robust)
+        BRENT,           ///< Brent's bracketed method (robust with superlinear convergence)
+        HALLEY,          ///< Halley's method using vomma (cubic convergence)
+        HOUSEHOLDER,     ///< Third-order Householder method using vomma and ultima
+        AUTO             ///< Per option, see select_implied_volatility_method
+    };
+
+    /**
+     * @brief Number of implied volatility methods, AUTO included
+     */
+    constexpr std::size_t kImpliedVolatilityMethodCount =
+        static_cast<std::size_t>(ImpliedVolatilityMethod::AUTO) + 1;
+
+    /**
+     * @brief Starting point of Newton-Raphson iterations
+     */
+    enum class InitialGuess : std::uint8_t {
+        AUTO,            ///< Previous solution if given, else Corrado-Miller or inflection point
+        CORRADO_MILLER,  ///< Corrado-Miller (1996) closed-form approximation
+        INFLECTION,      ///< Manaster-Koehler (1982) volatility of maximum vega
+        BUCKETS          ///< Fixed values by expiry and moneyness
+    };
+
+    /**
+     * @brief Test that ends an implied volatility iteration
+     */
+    enum class ConvergenceCriterion : std::uint8_t {
+        DEFAULT,         ///< Method's own test: price within 1e-8 for bisection and 1e-6 for
+                         ///< the Newton family, bracket within 1e-10 for Brent's method
+        PRICE,           ///< Absolute price error
+        RELATIVE_PRICE,  ///< Price error relative to the market price
+        VOLATILITY,      ///< Last volatility step, or bracket width for bracketing methods
+        VEGA_SCALED      ///< Price error divided by vega, the first-order volatility error
     };
 
+    /**
+     * @brief Parse a convergence criterion name
+     *
+     * Accepts "default", "price", "relative", "vol" (or "volatility") and "vega" in any
+     * letter case.
+     *
+     * @param name Criterion name
+     * @return ConvergenceCriterion Parsed criterion
+     * @throws std::invalid_argument If the name is not a criterion
+     */
+    ConvergenceCriterion parse_convergence_criterion(std::string_view name);
+
+    /**
+     * @brief Parse an initial guess name
+     *
+     * Accepts "auto", "corrado-miller", "inflection" and "buckets" in any letter case.
+     *
+     * @param name Initial guess name
+     * @return InitialGuess Parsed initial guess
+     * @throws std::invalid_argument If the name is not an initial guess
+     */
+    InitialGuess parse_initial_guess(std::string_view name);
+
+    /**
+     * @brief Settings of an implied volatility solve
+     */
+    struct SolverOptions {
+        ImpliedVolatilityMethod method = ImpliedVolatilityMethod::BISECTION;
+        InitialGuess guess = InitialGuess::AUTO;  ///< Newton-Raphson starting point
+        double previous = 0.0;  ///< Solution of a similar option, zero when unknown
+        bool fallback = true;   ///< Finish unconverged Newton-family solves with Brent's method
+        ConvergenceCriterion criterion = ConvergenceCriterion::DEFAULT;
+        double tolerance = 0.0;  ///< Bound on the criterion's measure, zero for 1e-8
+    };
+
+    /**
+     * @brief Parse an implied volatility method name
+     *
+     * Accepts "bisection", "newton", "newton-raphson", "brent", "halley", "householder" and
+     * "auto" in any letter case.
+     *
+     * @param name Method name
+     * @return ImpliedVolatilityMethod Parsed method
+     * @throws std::invalid_argument If the name is not a method
+     */
+    ImpliedVolatilityMethod parse_implied_volatility_method(std::string_view name);
+
+    /**
+     * @brief Get the display name of an implied volatility method
+     *
+     * @param method Implied volatility method
+     * @return const char* "bisection", "newton-raphson", "brent", "halley", "householder" or
+     * "auto"
+     */
+    const char* implied_volatility_method_name(ImpliedVolatilityMethod method);
+
+    /**
+     * @brief Implied volatility together with the work spent finding it
+     */
+    struct ImpliedVolatilityResult {
+        double volatility = 0.0;  ///< Implied volatility
+        int iterations = 0;       ///< Solver iterations, including those of a fallback method
+        /// Measure of the convergence criterion at the solution, in its own units; NaN when
+        /// the solve did not converge
+        double achieved = std::numeric_limits<double>::quiet_NaN();
+        /// Method the solve started with, never AUTO
+        ImpliedVolatilityMethod method = ImpliedVolatilityMethod::BISECTION;
+    };
+
+    /**
+     * @brief Standard normal cumulative distribution function
+     *
+     * @param x Point of evaluation
+     * @return double Probability that a standard normal variable is below x
+     */
+    double norm_cdf(double x);
+
+    /**
+     * @brief Standard normal probability density function
+     *
+     * @param x Point of evaluation
+     * @return double Density of the standard normal distribution at x
+     */
+    double norm_pdf(double x);
+
     /**
      * @brief Calculate option price using Black-Scholes model
      *
@@ -36,6 +159,21 @@ namespace iv_calculator::core {
      */
     double black_scholes_vega(double S, double K, double T, double r, double sigma);
 
+    /**
+     * @brief Calculate option's vomma (sensitivity of vega to volatility)
+     *
+     * Unlike black_scholes_vega, the result is per unit of volatility: the second
+     * derivative of the price with respect to sigma, vega * d1 * d2 / sigma.
+     *
+     * @param S Current price of the underlying asset
+     * @param K Strike price
+     * @param T Time to expiration in years
+     * @param r Risk-free interest rate
+     * @param sigma Volatility of the underlying asset
+     * @return double Option's vomma value
+     */
+    double black_scholes_vomma(double S, double K, double T, double r, double sigma);
+
     /**
      * @brief Calculate implied volatility using numerical methods
      *
@@ -52,6 +190,151 @@ namespace iv_calculator::core {
         bool is_call, double S, double K, double T, double r, double option_price,
         ImpliedVolatilityMethod method = ImpliedVolatilityMethod::BISECTION);
 
+    /**
+     * @brief Calculate implied volatility and report the solver iterations
+     *
+     * Same methods and results as calculate_implied_volatility.
+     *
+     * @param is_call True for Call option, False for Put option
+     * @param S Current price of the underlying asset
+     * @param K Strike price
+     * @param T Time to expiration in years
+     * @param r Risk-free interest rate
+     * @param option_price Market price of the option
+     * @param method Numerical method to use (default: BISECTION)
+     * @return ImpliedVolatilityResult Implied volatility and iterations used
+     */
+    ImpliedVolatilityResult solve_implied_volatility(
+        bool is_call, double S, double K, double T, double r, double option_price,
+        ImpliedVolatilityMethod method = ImpliedVolatilityMethod::BISECTION);
+
+    /**
+     * @brief Calculate implied volatility with explicit solver settings
+     *
+     * AUTO runs the method select_implied_volatility_method picks for the option.
+     * Newton-Raphson, Halley and Householder start from options.guess and Brent's method
+     * brackets around options.previous when it is given. Without options.fallback, a
+     * Newton-family solve that does not converge returns a NaN volatility, with the
+     * iterations it spent, instead of running Brent's method. The iteration stops on
+     * options.criterion; a bracketing method also stops when the bracket cannot shrink
+     * further, and then reports the measure it reached.
+     *
+     * @param is_call True for Call option, False for Put option
+     * @param S Current price of the underlying asset
+     * @param K Strike price
+     * @param T Time to expiration in years
+     * @param r Risk-free interest rate
+     * @param option_price Market price of the option
+     * @param options Method, starting point and previous solution
+     * @return ImpliedVolatilityResult Implied volatility and iterations used
+     */
+    ImpliedVolatilityResult solve_implied_volatility(bool is_call, double S, double K, double T,
+                                                     double r, double option_price,
+                                                     const SolverOptions& options);
+
+    /**
+     * @brief Implied volatilities of a contract's bid, mid and ask quotes
+     */
+    struct QuoteImpliedVolatility {
+        ImpliedVolatilityResult bid;  ///< NaN volatility when the bid has no implied volatility
+        ImpliedVolatilityResult mid;  ///< Mid quote (bid + ask) / 2
+        ImpliedVolatilityResult ask;  ///< NaN volatility when the ask has no implied volatility
+
+        /// Ask minus bid volatility, NaN unless both sides were solved
+        [[nodiscard]] double spread() const { return ask.volatility - bid.volatility; }
+    };
+
+    /**
+     * @brief Solve the bid, mid and ask implied volatilities of one contract together
+     *
+     * The mid is solved with options. Since the price increases with volatility, its
+     * solution bounds the bid from above and the ask from below, and the first-order step
+     * from the mid by its vega starts each side next to its root. Both sides then run a
+     * third-order Householder iteration on terms computed once for the contract, bisecting
+     * whenever a step leaves the bracket, so they usually take one or two iterations. When
+     * the mid has no solution each side is bracketed on its own. A side whose quote is
+     * outside the no-arbitrage bounds, such as a zero bid, gets a NaN volatility. The sides
+     * stop on options.criterion, by default a volatility error below 1e-10.
+     *
+     * @param is_call True for Call option, False for Put option
+     * @param S Current price of the underlying asset
+     * @param K Strike price
+     * @param T Time to expiration in years
+     * @param r Risk-free interest rate
+     * @param bid Bid quote
+     * @param ask Ask quote
+     * @param options Settings of the mid solve, and the criterion of all three
+     * @return QuoteImpliedVolatility Volatility and iterations of each quote
+     * @throws std::invalid_argument If the inputs are invalid or the bid is negative or
+     * above the ask
+     */
+    QuoteImpliedVolatility solve_quote_implied_volatility(bool is_call, double S, double K,
+                                                          double T, double r, double bid,
+                                                          double ask,
+                                                          const SolverOptions& options = {});
+
+    /**
+     * @brief Cheapest reliable method for an option
+     *
+     * Classifies the option by its time value above the no-arbitrage lower bound,
+     * normalized by sqrt(S * K * exp(-rT)), and by its moneyness |ln(F / K)| / sqrt(T).
+     * Near the money and wherever the time value is large enough for a price test to pin
+     * the volatility, the third-order Householder method converges in about three steps.
+     * Options with time value below 1e-4, or below 1e-2 more than two moneyness units from
+     * the money, go to Brent's method, which resolves their volatility in a bracket where
+     * the Newton family stalls on tiny vega; so do options outside the no-arbitrage bounds,
+     * which it rejects without iterating.
+     *
+     * @param is_call True for Call option, False for Put option
+     * @param S Current price of the underlying asset
+     * @param K Strike price
+     * @param T Time to expiration in years
+     * @param r Risk-free interest rate
+     * @param option_price Market price of the option
+     * @return ImpliedVolatilityMethod HOUSEHOLDER or BRENT
+     */
+    ImpliedVolatilityMethod select_implied_volatility_method(bool is_call, double S, double K,
+                                                             double T, double r,
+                                                             double option_price);
+
+    /**
+     * @brief Select methods for many options at once
+     *
+     * Same choice as select_implied_volatility_method, computed in one pass over the
+     * columns with the branches of the classification replaced by selects. The pass saves
+     * the per-row dispatch but stays scalar, since it calls exp, log and sqrt per option.
+     *
+     * @param batch Options to classify
+     * @param option_price Market price of each option
+     * @return std::vector<ImpliedVolatilityMethod> Method of each option in batch order
+     * @throws std::invalid_argument If the price count does not match the batch size
+     */
+    std::vector<ImpliedVolatilityMethod> select_implied_volatility_methods(
+        const OptionBatch& batch, const std::vector<double>& option_price);
+
+    /**
+     * @brief Starting volatility for Newton-Raphson
+     *
+     * AUTO uses a previous solution when given. Otherwise it uses Corrado-Miller, whose
+     * discriminant is floored at zero in the wings where it has no real root, and the
+     * inflection point sqrt(2 |ln(F / K)| / T) if that leaves no positive estimate; Newton-
+     * Raphson converges monotonically from the inflection point. CORRADO_MILLER alone has no
+     * floor and falls back to BUCKETS. Results are clamped to [0.001, 5].
+     *
+     * @param is_call True for Call option, False for Put option
+     * @param S Current price of the underlying asset
+     * @param K Strike price
+     * @param T Time to expiration in years
+     * @param r Risk-free interest rate
+     * @param option_price Market price of the option
+     * @param method Approximation to use (default: AUTO)
+     * @param previous Solution of a similar option, zero when unknown
+     * @return double Starting volatility
+     */
+    double initial_volatility_guess(bool is_call, double S, double K, double T, double r,
+                                    double option_price, InitialGuess method = InitialGuess::AUTO,
+                                    double previous = 0.0);
+
     /**
      * @brief Calculate implied volatility using bisection method
      *
@@ -66,9 +349,64 @@ namespace iv_calculator::core {
     double bisection_implied_volatility(bool is_call, double S, double K, double T, double r,
                                         double option_price);
 
+    /**
+     * @brief Iterations of the fixed-length batch bisection for a volatility tolerance
+     *
+     * @param sigma_tolerance Width of the final bracket in volatility
+     * @return int Halvings of [0.001, 10] needed to reach the tolerance
+     * @throws std::invalid_argument If the tolerance is not positive
+     */
+    int batch_bisection_iterations(double sigma_tolerance = 1e-10);
+
+    /**
+     * @brief Calculate Black-Scholes implied volatilities of many options by bisection
+     *
+     * Options are processed in fixed-width blocks of lanes. Each block halves
+     * [0.001, 10] exactly batch_bisection_iterations(sigma_tolerance) times with
+     * select-based bracket updates and no data-dependent exit, so every lane does the same
+     * work and the loop body has no branches; the terms that do not depend on the
+     * volatility are computed once per option. Meant to finish in bulk the rows a faster
+     * method failed on.
+     *
+     * @param batch Options to invert
+     * @param option_price Market price of each option
+     * @param sigma_tolerance Width of the final bracket in volatility
+     * @return std::vector<double> Implied volatilities in batch order, NaN for invalid inputs
+     * and for prices without a root in [0.001, 10]
+     * @throws std::invalid_argument If the price count does not match the batch size or the
+     * tolerance is not positive
+     */
+    std::vector<double> black_scholes_implied_volatility_batch(
+        const OptionBatch& batch, const std::vector<double>& option_price,
+        double sigma_tolerance = 1e-10);
+
+    /**
+     * @brief Calculate implied volatility using Brent's bracketed method
+     *
+     * The initial bracket is derived from the time value above the no-arbitrage lower
+     * bound and widened geometrically until it holds the root. Brent's method then combines
+     * inverse quadratic interpolation and secant steps with bisection as a safeguard, so it
+     * converges superlinearly but never leaves the bracket, even for options with tiny vega.
+     * Newton-Raphson falls back to this method.
+     *
+     * @param is_call True for Call option, False for Put option
+     * @param S Current price of the underlying asset
+     * @param K Strike price
+     * @param T Time to expiration in years
+     * @param r Risk-free interest rate
+     * @param option_price Market price of the option
+     * @return double Implied volatility
+     * @throws std::invalid_argument If the price is outside the no-arbitrage bounds
+     * @throws std::runtime_error If the root cannot be bracketed or does not converge
+     */
+    double brent_implied_volatility(bool is_call, double S, double K, double T, double r,
+                                    double option_price);
+
     /**
      * @brief Calculate implied volatility using Newton-Raphson method
      *
+     * Starts from initial_volatility_guess with InitialGuess::AUTO.
+     *
      * @param is_call True for Call option, False for Put option
      * @param S Current price of the underlying asset
      * @param K Strike price
@@ -79,4 +417,39 @@ namespace iv_calculator::core {
      */
     double newton_raphson_implied_volatility(bool is_call, double S, double K, double T, double r,
                                              double option_price);
+
+    /**
+     * @brief Calculate implied volatility using Halley's method
+     *
+     * Corrects each Newton step with vomma, which shares d1, d2 and the density with the
+     * price and vega, so an iteration costs little more than a Newton one but converges
+     * cubically. Starts and falls back like newton_raphson_implied_volatility.
+     *
+     * @param is_call True for Call option, False for Put option
+     * @param S Current price of the underlying asset
+     * @param K Strike price
+     * @param T Time to expiration in years
+     * @param r Risk-free interest rate
+     * @param option_price Market price of the option
+     * @return double Implied volatility
+     */
+    double halley_implied_volatility(bool is_call, double S, double K, double T, double r,
+                                     double option_price);
+
+    /**
+     * @brief Calculate implied volatility using the third-order Householder method
+     *
+     * Adds the third derivative of the price (ultima) to Halley's step for quartic
+     * convergence. Starts and falls back like newton_raphson_implied_volatility.
+     *
+     * @param is_call True for Call option, False for Put option
+     * @param S Current price of the underlying asset
+     * @param K Strike price
+     * @param T Time to expiration in years
+     * @param r Risk-free interest rate
+     * @param option_price Market price of the option
+     * @return double Implied volatility
+     */
+    double householder_implied_volatility(bool is_call, double S, double K, double T, double r,
+                                          double option_price);
 }  // namespace iv_calculator::core
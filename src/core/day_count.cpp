@@ -0,0 +1,277 @@
+#include "day_count.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+namespace iv_calculator {
+    namespace core {
+
+        namespace {
+            // Floor division, so days before 1970 land in the right week or era
+            std::int64_t floor_div(std::int64_t a, std::int64_t b) {
+                return a / b - (a % b != 0 && (a < 0) != (b < 0) ? 1 : 0);
+            }
+
+            // Weekdays from a fixed Monday through day n; 1970-01-01 was a Thursday
+            std::int64_t weekdays_through(std::int64_t n) {
+                std::int64_t shifted = n + 3;  // Day of week 0 is Monday
+                std::int64_t weeks = floor_div(shifted, 7);
+                return 5 * weeks + std::min<std::int64_t>(shifted - 7 * weeks + 1, 5);
+            }
+
+            bool is_weekend(std::int64_t day) {
+                std::int64_t weekday = day + 3 - 7 * floor_div(day + 3, 7);
+                return weekday >= 5;
+            }
+
+            bool is_leap_year(int year) {
+                return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+            }
+
+            unsigned days_in_month(int year, unsigned month) {
+                constexpr unsigned kDays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+                return month == 2 && is_leap_year(year) ? 29 : kDays[month - 1];
+            }
+
+            // Fixed-width unsigned field; false when a character is not a digit
+            bool parse_digits(std::string_view text, std::size_t pos, std::size_t width,
+                              unsigned& value) {
+                if (pos + width > text.size()) {
+                    return false;
+                }
+                value = 0;
+                for (std::size_t i = pos; i < pos + width; ++i) {
+                    if (text[i] < '0' || text[i] > '9') {
+                        return false;
+                    }
+                    value = value * 10 + static_cast<unsigned>(text[i] - '0');
+                }
+                return true;
+            }
+
+            // "HH:MM[:SS]" from pos to the end of the text as a fraction of a day
+            bool parse_clock(std::string_view text, std::size_t pos, double& fraction) {
+                unsigned hour = 0;
+                unsigned minute = 0;
+                unsigned second = 0;
+                bool valid = parse_digits(text, pos, 2, hour) && text.size() >= pos + 5 &&
+                             text[pos + 2] == ':' && parse_digits(text, pos + 3, 2, minute) &&
+                             hour < 24 && minute < 60;
+                if (valid && text.size() > pos + 5) {
+                    valid = text.size() == pos + 8 && text[pos + 5] == ':' &&
+                            parse_digits(text, pos + 6, 2, second) && second < 60;
+                }
+                fraction = (hour * 3600.0 + minute * 60.0 + second) / 86400.0;
+                return valid;
+            }
+
+            double act_act_isda(double valuation, double expiry) {
+                if (expiry < valuation) {
+                    return -act_act_isda(expiry, valuation);
+                }
+                int year = 0;
+                unsigned month = 0;
+                unsigned day = 0;
+                civil_from_days(static_cast<std::int64_t>(std::floor(valuation)), year, month,
+                                day);
+                double fraction = 0.0;
+                double from = valuation;
+                while (from < expiry) {
+                    auto next_year = static_cast<double>(days_from_civil(year + 1, 1, 1));
+                    double to = std::min(expiry, next_year);
+                    fraction += (to - from) / (is_leap_year(year) ? 366.0 : 365.0);
+                    from = to;
+                    ++year;
+                }
+                return fraction;
+            }
+
+            double thirty_360(double valuation, double expiry) {
+                int y1 = 0;
+                int y2 = 0;
+                unsigned m1 = 0;
+                unsigned m2 = 0;
+                unsigned d1 = 0;
+                unsigned d2 = 0;
+                civil_from_days(static_cast<std::int64_t>(std::floor(valuation)), y1, m1, d1);
+                civil_from_days(static_cast<std::int64_t>(std::floor(expiry)), y2, m2, d2);
+                d1 = std::min(d1, 30U);
+                if (d1 == 30) {
+                    d2 = std::min(d2, 30U);
+                }
+                return (360.0 * (y2 - y1) + 30.0 * (static_cast<int>(m2) - static_cast<int>(m1)) +
+                        (static_cast<int>(d2) - static_cast<int>(d1))) /
+                       360.0;
+            }
+        }  // namespace
+
+        DayCount parse_day_count(std::string_view name) {
+            std::string key;
+            for (char c : name) {
+                if (std::isalnum(static_cast<unsigned char>(c)) != 0) {
+                    key.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+                }
+            }
+            if (key == "act365f" || key == "act365fixed" || key == "act365") {
+                return DayCount::ACT_365_FIXED;
+            }
+            if (key == "act360") {
+                return DayCount::ACT_360;
+            }
+            if (key == "actact" || key == "actactisda") {
+                return DayCount::ACT_ACT_ISDA;
+            }
+            if (key == "30360") {
+                return DayCount::THIRTY_360;
+            }
+            if (key == "bus252") {
+                return DayCount::BUSINESS_252;
+            }
+            throw std::invalid_argument("Unknown day count '" + std::string(name) + "'");
+        }
+
+        const char* day_count_name(DayCount day_count) {
+            switch (day_count) {
+                case DayCount::ACT_365_FIXED:
+                    return "ACT/365F";
+                case DayCount::ACT_360:
+                    return "ACT/360";
+                case DayCount::ACT_ACT_ISDA:
+                    return "ACT/ACT";
+                case DayCount::THIRTY_360:
+                    return "30/360";
+                case DayCount::BUSINESS_252:
+                    return "BUS/252";
+            }
+            return "";
+        }
+
+        // Era-based conversion after H. Hinnant's chrono-compatible date algorithms
+        std::int64_t days_from_civil(int year, unsigned month, unsigned day) {
+            std::int64_t y = static_cast<std::int64_t>(year) - (month <= 2 ? 1 : 0);
+            std::int64_t era = floor_div(y, 400);
+            std::int64_t year_of_era = y - era * 400;
+            std::int64_t day_of_year =
+                (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+            std::int64_t day_of_era =
+                year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+            return era * 146097 + day_of_era - 719468;
+        }
+
+        void civil_from_days(std::int64_t days, int& year, unsigned& month, unsigned& day) {
+            days += 719468;
+            std::int64_t era = floor_div(days, 146097);
+            std::int64_t day_of_era = days - era * 146097;
+            std::int64_t year_of_era =
+                (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+            std::int64_t day_of_year =
+                day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+            std::int64_t shifted_month = (5 * day_of_year + 2) / 153;
+            day = static_cast<unsigned>(day_of_year - (153 * shifted_month + 2) / 5 + 1);
+            month = static_cast<unsigned>(shifted_month < 10 ? shifted_month + 3
+                                                             : shifted_month - 9);
+            year = static_cast<int>(year_of_era + era * 400 + (month <= 2 ? 1 : 0));
+        }
+
+        double parse_timestamp(std::string_view text) {
+            unsigned year = 0;
+            unsigned month = 0;
+            unsigned day = 0;
+            bool valid = parse_digits(text, 0, 4, year) && text.size() >= 10 &&
+                         text[4] == '-' && parse_digits(text, 5, 2, month) && text[7] == '-' &&
+                         parse_digits(text, 8, 2, day) && month >= 1 && month <= 12 &&
+                         day >= 1 && day <= days_in_month(static_cast<int>(year), month);
+
+            double time = 0.0;
+            if (valid && text.size() > 10) {
+                valid = (text[10] == 'T' || text[10] == ' ') && parse_clock(text, 11, time);
+            }
+            if (!valid) {
+                throw std::invalid_argument("Invalid date '" + std::string(text) + "'");
+            }
+            return static_cast<double>(days_from_civil(static_cast<int>(year), month, day)) +
+                   time;
+        }
+
+        double parse_time_of_day(std::string_view text) {
+            double time = 0.0;
+            if (!parse_clock(text, 0, time)) {
+                throw std::invalid_argument("Invalid time of day '" + std::string(text) + "'");
+            }
+            return time;
+        }
+
+        HolidayCalendar::HolidayCalendar(std::vector<std::int64_t> holidays)
+            : holidays_(std::move(holidays)) {
+            holidays_.erase(std::remove_if(holidays_.begin(), holidays_.end(), is_weekend),
+                            holidays_.end());
+            std::sort(holidays_.begin(), holidays_.end());
+            holidays_.erase(std::unique(holidays_.begin(), holidays_.end()), holidays_.end());
+        }
+
+        bool HolidayCalendar::is_business_day(std::int64_t day) const {
+            return !is_weekend(day) &&
+                   !std::binary_search(holidays_.begin(), holidays_.end(), day);
+        }
+
+        std::int64_t HolidayCalendar::business_days(std::int64_t from, std::int64_t to) const {
+            if (to < from) {
+                return -business_days(to, from);
+            }
+            auto holidays = std::upper_bound(holidays_.begin(), holidays_.end(), to) -
+                            std::upper_bound(holidays_.begin(), holidays_.end(), from);
+            return weekdays_through(to) - weekdays_through(from) - holidays;
+        }
+
+        double year_fraction(DayCount day_count, double valuation, double expiry,
+                             const HolidayCalendar& calendar) {
+            switch (day_count) {
+                case DayCount::ACT_365_FIXED:
+                    return (expiry - valuation) / 365.0;
+                case DayCount::ACT_360:
+                    return (expiry - valuation) / 360.0;
+                case DayCount::ACT_ACT_ISDA:
+                    return act_act_isda(valuation, expiry);
+                case DayCount::THIRTY_360:
+                    return thirty_360(valuation, expiry);
+                case DayCount::BUSINESS_252:
+                    return static_cast<double>(calendar.business_days(
+                               static_cast<std::int64_t>(std::floor(valuation)),
+                               static_cast<std::int64_t>(std::floor(expiry)))) /
+                           252.0;
+            }
+            return 0.0;
+        }
+
+        std::size_t YearFractionCache::PairHash::operator()(
+            const std::pair<double, double>& key) const {
+            std::hash<double> hash;
+            return hash(key.first) ^ (hash(key.second) * 0x9E3779B97F4A7C15ULL);
+        }
+
+        YearFractionCache::YearFractionCache(DayCount day_count, HolidayCalendar calendar)
+            : day_count_(day_count), calendar_(std::move(calendar)) {}
+
+        double YearFractionCache::get(double valuation, double expiry) {
+            std::pair<double, double> key(valuation, expiry);
+            if (has_last_ && key == last_key_) {
+                return last_fraction_;
+            }
+            auto it = fractions_.find(key);
+            if (it == fractions_.end()) {
+                it = fractions_
+                         .emplace(key, year_fraction(day_count_, valuation, expiry, calendar_))
+                         .first;
+            }
+            last_key_ = key;
+            last_fraction_ = it->second;
+            has_last_ = true;
+            return last_fraction_;
+        }
+
+    }  // namespace core
+}  // namespace iv_calculator
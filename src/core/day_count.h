@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace iv_calculator::core {
+
+    /**
+     * @brief Convention turning a valuation time and an expiry into years
+     */
+    enum class DayCount : std::uint8_t {
+        ACT_365_FIXED,  ///< Calendar days, time of day included, over 365
+        ACT_360,        ///< Calendar days, time of day included, over 360
+        ACT_ACT_ISDA,   ///< Days in each calendar year over that year's length
+        THIRTY_360,     ///< US 30/360 bond basis on the calendar dates
+        BUSINESS_252    ///< Business days after the valuation date through expiry, over 252
+    };
+
+    /**
+     * @brief Parse a day-count name
+     *
+     * Accepted names are act365f, act360, actact, 30360 and bus252; case, '/', '_' and '-'
+     * are ignored, so "ACT/365F" and "30/360" work too.
+     *
+     * @param name Day-count name
+     * @return DayCount Parsed convention
+     * @throws std::invalid_argument If the name is unknown
+     */
+    DayCount parse_day_count(std::string_view name);
+
+    /**
+     * @brief Canonical name of a day count ("ACT/365F", "ACT/360", "ACT/ACT", "30/360",
+     * "BUS/252")
+     */
+    const char* day_count_name(DayCount day_count);
+
+    /**
+     * @brief Days since 1970-01-01 of a proleptic Gregorian date
+     */
+    std::int64_t days_from_civil(int year, unsigned month, unsigned day);
+
+    /**
+     * @brief Date of a day number, the inverse of days_from_civil
+     */
+    void civil_from_days(std::int64_t days, int& year, unsigned& month, unsigned& day);
+
+    /**
+     * @brief Parse "YYYY-MM-DD", optionally followed by 'T' or ' ' and "HH:MM[:SS]"
+     *
+     * A date without a time is taken at midnight; the batch engine moves expiries given
+     * that way to its expiry cut-off.
+     *
+     * @param text Date or timestamp
+     * @return double Days since 1970-01-01, with the time of day as the fraction
+     * @throws std::invalid_argument If the text is not a valid date or timestamp
+     */
+    double parse_timestamp(std::string_view text);
+
+    /**
+     * @brief Parse a time of day "HH:MM[:SS]"
+     *
+     * @param text Time of day
+     * @return double Fraction of a day
+     * @throws std::invalid_argument If the text is not a valid time of day
+     */
+    double parse_time_of_day(std::string_view text);
+
+    /**
+     * @brief Business days of a market: weekdays that are not holidays
+     */
+    class HolidayCalendar {
+    public:
+        /**
+         * @brief Calendar whose only non-business days are weekends
+         */
+        HolidayCalendar() = default;
+
+        /**
+         * @brief Calendar with holidays in addition to weekends
+         *
+         * @param holidays Day numbers of the holidays, in any order; weekend days and
+         * repeats are ignored
+         */
+        explicit HolidayCalendar(std::vector<std::int64_t> holidays);
+
+        /**
+         * @brief Whether a day is neither a Saturday, a Sunday nor a holiday
+         */
+        [[nodiscard]] bool is_business_day(std::int64_t day) const;
+
+        /**
+         * @brief Business days d with from < d <= to, negative when to precedes from
+         *
+         * Weekdays are counted in closed form and holidays by binary search, so the cost
+         * does not grow with the distance between the days.
+         */
+        [[nodiscard]] std::int64_t business_days(std::int64_t from, std::int64_t to) const;
+
+        /**
+         * @brief Number of holidays that fall on weekdays
+         */
+        [[nodiscard]] std::size_t size() const { return holidays_.size(); }
+
+    private:
+        std::vector<std::int64_t> holidays_;  // Sorted weekday holidays
+    };
+
+    /**
+     * @brief Time from a valuation time to an expiry in years
+     *
+     * ACT conventions use the exact difference including the time of day; 30/360 and
+     * business-day counts use the calendar dates only.
+     *
+     * @param day_count Convention
+     * @param valuation Valuation time in days since 1970-01-01
+     * @param expiry Expiry in days since 1970-01-01
+     * @param calendar Business days, used by BUSINESS_252 only
+     * @return double Year fraction, negative when the expiry precedes the valuation time
+     */
+    double year_fraction(DayCount day_count, double valuation, double expiry,
+                         const HolidayCalendar& calendar = HolidayCalendar());
+
+    /**
+     * @brief Year fractions memoized per distinct (valuation, expiry) pair
+     *
+     * A file holds far fewer expiries than rows, so each pair is computed once and later
+     * rows cost a lookup; rows of the same expiry usually follow each other, so the
+     * previous pair is compared before the table. Not thread-safe; use one per reader.
+     */
+    class YearFractionCache {
+    public:
+        explicit YearFractionCache(DayCount day_count = DayCount::ACT_365_FIXED,
+                                   HolidayCalendar calendar = HolidayCalendar());
+
+        /**
+         * @brief Year fraction of a pair, computed on first use
+         */
+        double get(double valuation, double expiry);
+
+        /**
+         * @brief Number of distinct pairs computed
+         */
+        [[nodiscard]] std::size_t size() const { return fractions_.size(); }
+
+    private:
+        struct PairHash {
+            std::size_t operator()(const std::pair<double, double>& key) const;
+        };
+
+        DayCount day_count_;
+        HolidayCalendar calendar_;
+        std::unordered_map<std::pair<double, double>, double, PairHash> fractions_;
+        std::pair<double, double> last_key_{0.0, 0.0};
+        double last_fraction_ = 0.0;
+        bool has_last_ = false;
+    };
+
+}  // namespace iv_calculator::core
@@ -0,0 +1,35 @@
+#include "dividends.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace iv_calculator {
+    namespace core {
+
+        void DividendSchedule::add(double ex_date, double amount) {
+            auto at = std::upper_bound(ex_dates_.begin(), ex_dates_.end(), ex_date);
+            std::ptrdiff_t index = std::distance(ex_dates_.begin(), at);
+            ex_dates_.insert(at, ex_date);
+            amounts_.insert(amounts_.begin() + index, amount);
+        }
+
+        double DividendSchedule::present_value(double valuation, double expiry,
+                                               YearFractionCache& fractions, double rate,
+                                               const YieldCurve* curve) const {
+            double value = 0.0;
+            // Ex-dates on or before the valuation time have already come off the spot
+            auto first = std::upper_bound(ex_dates_.begin(), ex_dates_.end(), valuation);
+            for (auto it = first; it != ex_dates_.end(); ++it) {
+                double t = fractions.get(valuation, *it);
+                if (t > expiry) {
+                    break;
+                }
+                double discount = curve != nullptr ? curve->discount(t) : std::exp(-rate * t);
+                value += amounts_[static_cast<std::size_t>(it - ex_dates_.begin())] * discount;
+            }
+            return value;
+        }
+
+    }  // namespace core
+}  // namespace iv_calculator
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "src/core/day_count.h"
+#include "src/core/yield_curve.h"
+
+#include <vector>
+
+namespace iv_calculator::core {
+
+    /**
+     * @brief Discrete cash dividends of one underlying
+     *
+     * Under the escrowed-dividend model the dividends paid before expiry are held back
+     * from the spot: an option is priced, and its volatility solved, on
+     * S* = S - PV(dividends), with the volatility applying to S* alone.
+     */
+    class DividendSchedule {
+    public:
+        /**
+         * @brief Add a dividend
+         *
+         * @param ex_date Ex-dividend date in days since 1970-01-01
+         * @param amount Cash amount per share
+         */
+        void add(double ex_date, double amount);
+
+        /**
+         * @brief Present value of the dividends going ex after the valuation time and
+         * no later than the expiry
+         *
+         * @param valuation Valuation time in days since 1970-01-01
+         * @param expiry Time to expiry in years
+         * @param fractions Year fractions from the valuation time to the ex-dates
+         * @param rate Flat continuously compounded rate, used without a curve
+         * @param curve Discount curve, or nullptr for the flat rate
+         * @return double Discounted sum of the dividends
+         */
+        double present_value(double valuation, double expiry, YearFractionCache& fractions,
+                             double rate, const YieldCurve* curve = nullptr) const;
+
+        [[nodiscard]] const std::vector<double>& ex_dates() const { return ex_dates_; }
+        [[nodiscard]] const std::vector<double>& amounts() const { return amounts_; }
+
+    private:
+        std::vector<double> ex_dates_;  // Sorted
+        std::vector<double> amounts_;
+    };
+
+}  // namespace iv_calculator::core
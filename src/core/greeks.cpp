@@ -0,0 +1,91 @@
+#include "greeks.h"
+
+#include "black_scholes.h"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace iv_calculator {
+    namespace core {
+        namespace {
+            // Theta and rho follow from the price, delta and vega of either model:
+            // theta = r * (V - S * delta) - vega * sigma / (2 * T), rho = T * (S * delta - V)
+            void set_time_and_rate(Greeks& greeks, std::uint8_t which, double price,
+                                   double delta, double vega, double S, double T, double r,
+                                   double sigma) {
+                if ((which & greek_flags::kTheta) != 0) {
+                    greeks.theta = r * (price - S * delta) - vega * sigma / (2.0 * T);
+                }
+                if ((which & greek_flags::kRho) != 0) {
+                    greeks.rho = T * (S * delta - price);
+                }
+            }
+        }  // namespace
+
+        Greeks black_scholes_greeks(bool is_call, double S, double K, double T, double r,
+                                    double sigma, std::uint8_t which) {
+            if (S <= 0 || K <= 0 || T <= 0 || sigma <= 0) {
+                throw std::invalid_argument("Invalid input parameters");
+            }
+
+            double sqrt_t = std::sqrt(T);
+            double std_dev = sigma * sqrt_t;
+            double d1 = (std::log(S / K) + (r + sigma * sigma / 2) * T) / std_dev;
+            double density = norm_pdf(d1);
+            double delta = is_call ? norm_cdf(d1) : norm_cdf(d1) - 1.0;
+            double vega = S * sqrt_t * density;
+
+            Greeks greeks;
+            if ((which & greek_flags::kDelta) != 0) {
+                greeks.delta = delta;
+            }
+            if ((which & greek_flags::kGamma) != 0) {
+                greeks.gamma = density / (S * std_dev);
+            }
+            if ((which & greek_flags::kVega) != 0) {
+                greeks.vega = vega;
+            }
+            if ((which & (greek_flags::kTheta | greek_flags::kRho)) != 0) {
+                double d2 = d1 - std_dev;
+                double discounted_strike = K * std::exp(-r * T);
+                double price = is_call ? S * norm_cdf(d1) - discounted_strike * norm_cdf(d2)
+                                       : discounted_strike * norm_cdf(-d2) - S * norm_cdf(-d1);
+                set_time_and_rate(greeks, which, price, delta, vega, S, T, r, sigma);
+            }
+            return greeks;
+        }
+
+        Greeks bachelier_greeks(bool is_call, double S, double K, double T, double r,
+                                double sigma, std::uint8_t which) {
+            if (T <= 0 || sigma <= 0) {
+                throw std::invalid_argument("Invalid input parameters");
+            }
+
+            double growth = std::exp(r * T);
+            double forward = S * growth;
+            double std_dev = sigma * std::sqrt(T);
+            double d = (forward - K) / std_dev;
+            double density = norm_pdf(d);
+            double delta = is_call ? norm_cdf(d) : norm_cdf(d) - 1.0;
+            double vega = std::sqrt(T) * density / growth;
+
+            Greeks greeks;
+            if ((which & greek_flags::kDelta) != 0) {
+                greeks.delta = delta;
+            }
+            if ((which & greek_flags::kGamma) != 0) {
+                greeks.gamma = density * growth / std_dev;
+            }
+            if ((which & greek_flags::kVega) != 0) {
+                greeks.vega = vega;
+            }
+            if ((which & (greek_flags::kTheta | greek_flags::kRho)) != 0) {
+                double sign = is_call ? 1.0 : -1.0;
+                double price = (sign * (forward - K) * norm_cdf(sign * d) + std_dev * density) /
+                               growth;
+                set_time_and_rate(greeks, which, price, delta, vega, S, T, r, sigma);
+            }
+            return greeks;
+        }
+    }  // namespace core
+}  // namespace iv_calculator
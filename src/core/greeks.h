@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace iv_calculator::core {
+    /**
+     * @brief Bits selecting which sensitivities greeks functions compute
+     */
+    namespace greek_flags {
+        constexpr std::uint8_t kDelta = 1U << 0U;
+        constexpr std::uint8_t kGamma = 1U << 1U;
+        constexpr std::uint8_t kVega = 1U << 2U;
+        constexpr std::uint8_t kTheta = 1U << 3U;
+        constexpr std::uint8_t kRho = 1U << 4U;
+        constexpr std::uint8_t kAll = kDelta | kGamma | kVega | kTheta | kRho;
+    }  // namespace greek_flags
+
+    /**
+     * @brief Sensitivities of an option price
+     *
+     * Vega is per unit of volatility (not per percentage point as black_scholes_vega),
+     * theta is per year of calendar time and rho per unit of rate. Sensitivities that were
+     * not requested are NaN.
+     */
+    struct Greeks {
+        double delta = std::numeric_limits<double>::quiet_NaN();  ///< dV/dS
+        double gamma = std::numeric_limits<double>::quiet_NaN();  ///< d2V/dS2
+        double vega = std::numeric_limits<double>::quiet_NaN();   ///< dV/dsigma
+        double theta = std::numeric_limits<double>::quiet_NaN();  ///< -dV/dT
+        double rho = std::numeric_limits<double>::quiet_NaN();    ///< dV/dr
+    };
+
+    /**
+     * @brief Calculate Black-Scholes sensitivities
+     *
+     * d1, d2 and the normal density are evaluated once and shared by every requested
+     * sensitivity; the price is only computed when theta or rho is requested.
+     *
+     * @param is_call True for Call option, False for Put option
+     * @param S Current price of the underlying asset
+     * @param K Strike price
+     * @param T Time to expiration in years
+     * @param r Risk-free interest rate
+     * @param sigma Volatility of the underlying asset
+     * @param which greek_flags bits of the sensitivities to compute
+     * @return Greeks Requested sensitivities
+     * @throws std::invalid_argument If S, K, T or sigma is not positive
+     */
+    Greeks black_scholes_greeks(bool is_call, double S, double K, double T, double r,
+                                double sigma, std::uint8_t which = greek_flags::kAll);
+
+    /**
+     * @brief Calculate Bachelier (normal model) sensitivities
+     *
+     * @param is_call True for Call option, False for Put option
+     * @param S Current price of the underlying asset
+     * @param K Strike price
+     * @param T Time to expiration in years
+     * @param r Risk-free interest rate
+     * @param sigma Normal (absolute) volatility of the underlying asset
+     * @param which greek_flags bits of the sensitivities to compute
+     * @return Greeks Requested sensitivities
+     * @throws std::invalid_argument If T or sigma is not positive
+     */
+    Greeks bachelier_greeks(bool is_call, double S, double K, double T, double r, double sigma,
+                            std::uint8_t which = greek_flags::kAll);
+}  // namespace iv_calculator::core
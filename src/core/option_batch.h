@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace iv_calculator::core {
+    /**
+     * @brief Structure-of-arrays view of a set of options for the batch solvers
+     *
+     * Every column holds one value per option, so the batch kernels can walk the
+     * columns with unit stride and let the compiler vectorize across options.
+     */
+    struct OptionBatch {
+        std::vector<std::uint8_t> is_call;   // 1 for Call, 0 for Put
+        std::vector<double> asset_price;     // Current price of underlying asset
+        std::vector<double> strike_price;    // Strike price
+        std::vector<double> time_to_expiry;  // Time to expiration in years
+        std::vector<double> risk_free_rate;  // Risk-free interest rate
+
+        /**
+         * @brief Number of options in the batch
+         */
+        [[nodiscard]] std::size_t size() const { return asset_price.size(); }
+
+        /**
+         * @brief Reserve storage for the given number of options
+         *
+         * @param count Expected number of options
+         */
+        void reserve(std::size_t count) {
+            is_call.reserve(count);
+            asset_price.reserve(count);
+            strike_price.reserve(count);
+            time_to_expiry.reserve(count);
+            risk_free_rate.reserve(count);
+        }
+
+        /**
+         * @brief Append one option to the batch
+         *
+         * @param call True for Call option, False for Put option
+         * @param S Current price of the underlying asset
+         * @param K Strike price
+         * @param T Time to expiration in years
+         * @param r Risk-free interest rate
+         */
+        void push_back(bool call, double S, double K, double T, double r) {
+            is_call.push_back(call ? 1 : 0);
+            asset_price.push_back(S);
+            strike_price.push_back(K);
+            time_to_expiry.push_back(T);
+            risk_free_rate.push_back(r);
+        }
+    };
+}  // namespace iv_calculator::core
@@ -0,0 +1,538 @@
+#include "pde_solver.h"
+
+#include "black_scholes.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace iv_calculator {
+    namespace core {
+        namespace {
+            // Number of options whose tridiagonal systems are interleaved in one block
+            constexpr std::size_t kPdeLanes = 8;
+
+            // Implied volatility search settings
+            constexpr double kPriceTolerance = 1e-6;
+            constexpr double kVolatilityTolerance = 1e-7;
+            constexpr double kMaxVolatility = 10.0;
+            constexpr int kMaxIterations = 50;
+
+            constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+            // Per-lane parameters of a block of options sharing T, r and grid geometry
+            template <std::size_t L>
+            struct LaneBlock {
+                std::array<double, L> spot{};
+                std::array<double, L> strike{};
+                std::array<double, L> variance{};  // sigma^2
+                std::array<double, L> ds{};        // Asset price grid spacing
+                std::array<double, L> sign{};      // +1 for Call, -1 for Put
+            };
+
+            // LU factors of (I - theta * dt * A), stored node-major with lanes innermost
+            struct ThomasFactors {
+                std::vector<double> lower;     // Sub-diagonal a_i
+                std::vector<double> upper;     // Modified super-diagonal c'_i
+                std::vector<double> inv_diag;  // 1 / modified diagonal
+            };
+
+            // The spatial operator only depends on the node index, sigma and r, so the
+            // coefficients are identical for every lane up to its own sigma.
+            template <std::size_t L>
+            ThomasFactors factorize(const LaneBlock<L>& block, double r, double dt, double theta,
+                                    int n) {
+                const auto nodes = static_cast<std::size_t>(n + 1);
+                ThomasFactors f{std::vector<double>(nodes * L), std::vector<double>(nodes * L),
+                                std::vector<double>(nodes * L)};
+
+                for (int i = 1; i < n; ++i) {
+                    const auto row = static_cast<std::size_t>(i) * L;
+                    const double di = i;
+                    for (std::size_t l = 0; l < L; ++l) {
+                        double s2 = block.variance[l] * di * di;
+                        double a = -theta * dt * 0.5 * (s2 - r * di);
+                        double b = 1.0 + theta * dt * (s2 + r);
+                        double c = -theta * dt * 0.5 * (s2 + r * di);
+                        double prev_upper = (i == 1) ? 0.0 : f.upper[row - L + l];
+                        double inv = 1.0 / (b - a * prev_upper);
+                        f.lower[row + l] = a;
+                        f.upper[row + l] = c * inv;
+                        f.inv_diag[row + l] = inv;
+                    }
+                }
+                return f;
+            }
+
+            // Dirichlet values at both grid ends for time-to-expiry tau
+            template <std::size_t L>
+            void boundary_values(const LaneBlock<L>& block, double r, double tau, int n,
+                                 std::array<double, L>& low, std::array<double, L>& high) {
+                double discount = std::exp(-r * tau);
+                for (std::size_t l = 0; l < L; ++l) {
+                    double s_max = n * block.ds[l];
+                    bool call = block.sign[l] > 0;
+                    low[l] = call ? 0.0 : block.strike[l] * discount;
+                    high[l] = call ? s_max - block.strike[l] * discount : 0.0;
+                }
+            }
+
+            // One theta-scheme step: (I - theta dt A) V_new = (I + (1 - theta) dt A) V_old
+            template <std::size_t L>
+            void time_step(const LaneBlock<L>& block, double r, double dt, double theta, int n,
+                           const ThomasFactors& f, const std::array<double, L>& low,
+                           const std::array<double, L>& high, std::vector<double>& values,
+                           std::vector<double>& rhs) {
+                const double explicit_weight = (1.0 - theta) * dt;
+
+                for (int i = 1; i < n; ++i) {
+                    const auto row = static_cast<std::size_t>(i) * L;
+                    const double di = i;
+                    for (std::size_t l = 0; l < L; ++l) {
+                        double s2 = block.variance[l] * di * di;
+                        double lo = 0.5 * (s2 - r * di);
+                        double up = 0.5 * (s2 + r * di);
+                        double mid = s2 + r;
+                        rhs[row + l] =
+                            values[row + l] +
+                            explicit_weight * (lo * values[row - L + l] - mid * values[row + l] +
+                                               up * values[row + L + l]);
+                    }
+                }
+
+                // Move the new boundary values to the right-hand side
+                const auto first = static_cast<std::size_t>(L);
+                const auto last = static_cast<std::size_t>(n - 1) * L;
+                const double dn = n - 1;
+                for (std::size_t l = 0; l < L; ++l) {
+                    double s2 = block.variance[l] * dn * dn;
+                    double c_last = -theta * dt * 0.5 * (s2 + r * dn);
+                    rhs[first + l] -= f.lower[first + l] * low[l];
+                    rhs[last + l] -= c_last * high[l];
+                }
+
+                // Forward elimination, interleaved across lanes
+                for (std::size_t l = 0; l < L; ++l) {
+                    rhs[first + l] *= f.inv_diag[first + l];
+                }
+                for (int i = 2; i < n; ++i) {
+                    const auto row = static_cast<std::size_t>(i) * L;
+                    for (std::size_t l = 0; l < L; ++l) {
+                        rhs[row + l] =
+                            (rhs[row + l] - f.lower[row + l] * rhs[row - L + l]) * f.inv_diag[row + l];
+                    }
+                }
+
+                // Back substitution
+                for (std::size_t l = 0; l < L; ++l) {
+                    values[last + l] = rhs[last + l];
+                    values[l] = low[l];
+                    values[static_cast<std::size_t>(n) * L + l] = high[l];
+                }
+                for (int i = n - 2; i >= 1; --i) {
+                    const auto row = static_cast<std::size_t>(i) * L;
+                    for (std::size_t l = 0; l < L; ++l) {
+                        values[row + l] = rhs[row + l] - f.upper[row + l] * values[row + L + l];
+                    }
+                }
+            }
+
+            // Early-exercise constraint V >= payoff
+            void apply_exercise(const std::vector<double>& payoff, std::vector<double>& values) {
+                for (std::size_t k = 0; k < values.size(); ++k) {
+                    values[k] = std::max(values[k], payoff[k]);
+                }
+            }
+
+            // Jump condition across an ex-dividend date: V(S, t-) = V(S - D, t+)
+            template <std::size_t L>
+            void apply_dividend(const LaneBlock<L>& block, double amount, int n,
+                                std::vector<double>& values, std::vector<double>& scratch) {
+                for (std::size_t l = 0; l < L; ++l) {
+                    double shift = amount / block.ds[l];
+                    for (int i = 0; i <= n; ++i) {
+                        double x = i - shift;
+                        double v = values[l];
+                        if (x > 0) {
+                            auto j = static_cast<std::size_t>(x);
+                            double w = x - static_cast<double>(j);
+                            v = (1.0 - w) * values[j * L + l] +
+                                (w > 0 ? w * values[(j + 1) * L + l] : 0.0);
+                        }
+                        scratch[static_cast<std::size_t>(i) * L + l] = v;
+                    }
+                }
+                values.swap(scratch);
+            }
+
+            // Quadratic interpolation of the grid solution at the spot price
+            template <std::size_t L>
+            std::array<double, L> interpolate_at_spot(const LaneBlock<L>& block, int n,
+                                                      const std::vector<double>& values) {
+                std::array<double, L> prices{};
+                for (std::size_t l = 0; l < L; ++l) {
+                    double x = block.spot[l] / block.ds[l];
+                    auto j = static_cast<std::size_t>(
+                        std::clamp(static_cast<int>(std::lround(x)), 1, n - 1));
+                    double u = x - static_cast<double>(j);
+                    prices[l] = values[(j - 1) * L + l] * 0.5 * u * (u - 1.0) +
+                                values[j * L + l] * (1.0 - u * u) +
+                                values[(j + 1) * L + l] * 0.5 * u * (u + 1.0);
+                }
+                return prices;
+            }
+
+            // Solve L interleaved PDEs backwards from expiry to today
+            template <std::size_t L>
+            std::array<double, L> solve_block(const LaneBlock<L>& block, double T, double r,
+                                              const PdeConfig& config,
+                                              const std::vector<CashDividend>& dividends) {
+                const int n = config.space_steps;
+                const int m = config.time_steps;
+                const double dt = T / m;
+                const auto nodes = static_cast<std::size_t>(n + 1);
+                const bool american = config.exercise == ExerciseStyle::AMERICAN;
+
+                std::vector<double> payoff(nodes * L);
+                for (std::size_t i = 0; i < nodes; ++i) {
+                    for (std::size_t l = 0; l < L; ++l) {
+                        double s = static_cast<double>(i) * block.ds[l];
+                        payoff[i * L + l] = std::max(block.sign[l] * (s - block.strike[l]), 0.0);
+                    }
+                }
+
+                std::vector<double> values = payoff;
+                std::vector<double> scratch(nodes * L);
+
+                ThomasFactors crank_nicolson = factorize(block, r, dt, 0.5, n);
+                ThomasFactors implicit;
+                if (config.rannacher_steps > 0) {
+                    implicit = factorize(block, r, dt, 1.0, n);
+                }
+
+                std::array<double, L> low{};
+                std::array<double, L> high{};
+                for (int step = 0; step < m; ++step) {
+                    double tau_prev = step * dt;
+                    double tau = (step + 1) * dt;
+                    bool rannacher = step < config.rannacher_steps;
+
+                    boundary_values(block, r, tau, n, low, high);
+                    time_step(block, r, dt, rannacher ? 1.0 : 0.5, n,
+                              rannacher ? implicit : crank_nicolson, low, high, values, scratch);
+
+                    for (const auto& dividend : dividends) {
+                        double tau_dividend = T - dividend.time;
+                        if (dividend.time > 0 && dividend.time < T && tau_dividend > tau_prev &&
+                            tau_dividend <= tau) {
+                            apply_dividend(block, dividend.amount, n, values, scratch);
+                        }
+                    }
+
+                    if (american) {
+                        apply_exercise(payoff, values);
+                    }
+                }
+
+                return interpolate_at_spot(block, n, values);
+            }
+
+            template <std::size_t L>
+            void fill_lane(LaneBlock<L>& block, std::size_t lane, const OptionBatch& batch,
+                           const std::vector<double>& volatility, std::size_t index,
+                           const PdeConfig& config) {
+                double S = batch.asset_price[index];
+                double K = batch.strike_price[index];
+                double sigma = volatility[index];
+                block.spot[lane] = S;
+                block.strike[lane] = K;
+                block.variance[lane] = sigma * sigma;
+                block.ds[lane] = config.s_max_multiplier * std::max(S, K) / config.space_steps;
+                block.sign[lane] = batch.is_call[index] != 0 ? 1.0 : -1.0;
+            }
+
+            bool valid_inputs(double S, double K, double T, double sigma) {
+                return S > 0 && K > 0 && T > 0 && sigma > 0 && std::isfinite(S) &&
+                       std::isfinite(K) && std::isfinite(T) && std::isfinite(sigma);
+            }
+
+            std::vector<double> price_batch(const OptionBatch& batch,
+                                            const std::vector<double>& volatility,
+                                            const PdeConfig& config,
+                                            const std::vector<CashDividend>& dividends) {
+                std::vector<double> prices(batch.size(), kNaN);
+
+                std::vector<std::size_t> order;
+                order.reserve(batch.size());
+                for (std::size_t i = 0; i < batch.size(); ++i) {
+                    if (valid_inputs(batch.asset_price[i], batch.strike_price[i],
+                                     batch.time_to_expiry[i], volatility[i])) {
+                        order.push_back(i);
+                    }
+                }
+
+                // Group options sharing T and r so they can be solved on one time grid
+                std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+                    if (batch.time_to_expiry[a] != batch.time_to_expiry[b]) {
+                        return batch.time_to_expiry[a] < batch.time_to_expiry[b];
+                    }
+                    return batch.risk_free_rate[a] < batch.risk_free_rate[b];
+                });
+
+                std::size_t begin = 0;
+                while (begin < order.size()) {
+                    double T = batch.time_to_expiry[order[begin]];
+                    double r = batch.risk_free_rate[order[begin]];
+                    std::size_t end = begin;
+                    while (end < order.size() && end - begin < kPdeLanes &&
+                           batch.time_to_expiry[order[end]] == T &&
+                           batch.risk_free_rate[order[end]] == r) {
+                        ++end;
+                    }
+
+                    if (end - begin == 1) {
+                        LaneBlock<1> block;
+                        fill_lane(block, 0, batch, volatility, order[begin], config);
+                        prices[order[begin]] = solve_block(block, T, r, config, dividends)[0];
+                    } else {
+                        // Unused lanes repeat the first option so every loop has a fixed width
+                        LaneBlock<kPdeLanes> block;
+                        for (std::size_t l = 0; l < kPdeLanes; ++l) {
+                            std::size_t k = (begin + l < end) ? begin + l : begin;
+                            fill_lane(block, l, batch, volatility, order[k], config);
+                        }
+                        auto block_prices = solve_block(block, T, r, config, dividends);
+                        for (std::size_t k = begin; k < end; ++k) {
+                            prices[order[k]] = block_prices[k - begin];
+                        }
+                    }
+                    begin = end;
+                }
+
+                return prices;
+            }
+
+            // Present value of the dividends paid before expiry
+            double dividends_present_value(const std::vector<CashDividend>& dividends, double T,
+                                           double r) {
+                double pv = 0;
+                for (const auto& dividend : dividends) {
+                    if (dividend.time > 0 && dividend.time < T) {
+                        pv += dividend.amount * std::exp(-r * dividend.time);
+                    }
+                }
+                return pv;
+            }
+
+            // European implied volatility on the dividend-adjusted spot as the starting point
+            double european_warm_start(bool is_call, double S, double K, double T, double r,
+                                       double option_price, double dividend_pv) {
+                double adjusted_spot = S - dividend_pv > 0 ? S - dividend_pv : S;
+                try {
+                    double sigma = newton_raphson_implied_volatility(is_call, adjusted_spot, K, T,
+                                                                     r, option_price);
+                    return std::clamp(sigma, 0.01, 5.0);
+                } catch (const std::exception&) {
+                    return 0.3;
+                }
+            }
+
+            // Per-option state of the bracketed secant search
+            struct SecantState {
+                double sigma = 0;
+                double sigma_prev = kNaN;
+                double f_prev = kNaN;
+                double low = 0;
+                double high = std::numeric_limits<double>::infinity();
+                bool done = false;
+            };
+
+            // Advance the search by one step given f = PDE price - market price
+            // Returns true when the option is finished
+            bool secant_update(SecantState& state, double f, double vega, double& result) {
+                if (!std::isfinite(f)) {
+                    return true;
+                }
+                if (std::abs(f) < kPriceTolerance) {
+                    result = state.sigma;
+                    return true;
+                }
+
+                if (f < 0) {
+                    state.low = std::max(state.low, state.sigma);
+                } else {
+                    state.high = std::min(state.high, state.sigma);
+                }
+
+                double next = kNaN;
+                if (std::isfinite(state.f_prev) && f != state.f_prev) {
+                    next = state.sigma - f * (state.sigma - state.sigma_prev) / (f - state.f_prev);
+                } else if (vega > 1e-12) {
+                    next = state.sigma - f / vega;
+                }
+
+                // Keep the step inside the known bracket
+                if (!std::isfinite(next) || next <= state.low || next >= state.high) {
+                    next = std::isfinite(state.high) ? 0.5 * (state.low + state.high)
+                                                     : 2.0 * state.sigma;
+                }
+
+                if (std::abs(next - state.sigma) < kVolatilityTolerance) {
+                    result = next;
+                    return true;
+                }
+                if (next > kMaxVolatility) {
+                    return true;
+                }
+
+                state.sigma_prev = state.sigma;
+                state.f_prev = f;
+                state.sigma = next;
+                return false;
+            }
+        }  // namespace
+
+        double pde_option_price(bool is_call, double S, double K, double T, double r, double sigma,
+                                const PdeConfig& config,
+                                const std::vector<CashDividend>& dividends) {
+            // Input validation
+            if (S <= 0 || K <= 0 || T <= 0 || sigma <= 0) {
+                throw std::invalid_argument("Invalid input parameters");
+            }
+
+            OptionBatch batch;
+            batch.push_back(is_call, S, K, T, r);
+            return pde_option_price_batch(batch, {sigma}, config, dividends)[0];
+        }
+
+        std::vector<double> pde_option_price_batch(const OptionBatch& batch,
+                                                   const std::vector<double>& volatility,
+                                                   const PdeConfig& config,
+                                                   const std::vector<CashDividend>& dividends) {
+            if (volatility.size() != batch.size()) {
+                throw std::invalid_argument("Volatility count does not match batch size");
+            }
+            if (config.space_steps < 3 || config.time_steps < 1 || config.s_max_multiplier <= 1) {
+                throw std::invalid_argument("Invalid PDE grid settings");
+            }
+
+            if (!config.richardson) {
+                return price_batch(batch, volatility, config, dividends);
+            }
+
+            // Crank-Nicolson is second order in both dt and dS, so halving both steps
+            // and extrapolating cancels the leading error term
+            PdeConfig coarse_config = config;
+            coarse_config.richardson = false;
+            PdeConfig fine_config = coarse_config;
+            fine_config.space_steps *= 2;
+            fine_config.time_steps *= 2;
+            fine_config.rannacher_steps *= 2;
+
+            std::vector<double> coarse = price_batch(batch, volatility, coarse_config, dividends);
+            std::vector<double> fine = price_batch(batch, volatility, fine_config, dividends);
+            for (std::size_t i = 0; i < fine.size(); ++i) {
+                fine[i] = (4.0 * fine[i] - coarse[i]) / 3.0;
+            }
+            return fine;
+        }
+
+        double pde_implied_volatility(bool is_call, double S, double K, double T, double r,
+                                      double option_price, const PdeConfig& config,
+                                      const std::vector<CashDividend>& dividends) {
+            if (S <= 0 || K <= 0 || T <= 0) {
+                throw std::invalid_argument("Invalid input parameters");
+            }
+            if (option_price <= 0) {
+                throw std::invalid_argument("Option price must be positive");
+            }
+
+            OptionBatch batch;
+            batch.push_back(is_call, S, K, T, r);
+            double sigma = pde_implied_volatility_batch(batch, {option_price}, config, dividends)[0];
+            if (std::isnan(sigma)) {
+                throw std::runtime_error("Implied volatility calculation did not converge");
+            }
+            return sigma;
+        }
+
+        std::vector<double> pde_implied_volatility_batch(
+            const OptionBatch& batch, const std::vector<double>& option_price,
+            const PdeConfig& config, const std::vector<CashDividend>& dividends) {
+            if (option_price.size() != batch.size()) {
+                throw std::invalid_argument("Price count does not match batch size");
+            }
+
+            const std::size_t n = batch.size();
+            std::vector<double> result(n, kNaN);
+            std::vector<SecantState> states(n);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                double S = batch.asset_price[i];
+                double K = batch.strike_price[i];
+                double T = batch.time_to_expiry[i];
+                double r = batch.risk_free_rate[i];
+                bool is_call = batch.is_call[i] != 0;
+                double intrinsic = std::max(is_call ? S - K : K - S, 0.0);
+
+                bool below_exercise_value =
+                    config.exercise == ExerciseStyle::AMERICAN && option_price[i] < intrinsic;
+                if (!valid_inputs(S, K, T, 1.0) || !(option_price[i] > 0) ||
+                    below_exercise_value) {
+                    states[i].done = true;
+                    continue;
+                }
+                states[i].sigma =
+                    european_warm_start(is_call, S, K, T, r, option_price[i],
+                                        dividends_present_value(dividends, T, r));
+            }
+
+            std::vector<std::size_t> active;
+            for (int iteration = 0; iteration < kMaxIterations; ++iteration) {
+                active.clear();
+                for (std::size_t i = 0; i < n; ++i) {
+                    if (!states[i].done) {
+                        active.push_back(i);
+                    }
+                }
+                if (active.empty()) {
+                    break;
+                }
+
+                // Price every unconverged option in one batched solve
+                OptionBatch step_batch;
+                step_batch.reserve(active.size());
+                std::vector<double> sigmas;
+                sigmas.reserve(active.size());
+                for (std::size_t i : active) {
+                    step_batch.push_back(batch.is_call[i] != 0, batch.asset_price[i],
+                                         batch.strike_price[i], batch.time_to_expiry[i],
+                                         batch.risk_free_rate[i]);
+                    sigmas.push_back(states[i].sigma);
+                }
+                std::vector<double> prices =
+                    pde_option_price_batch(step_batch, sigmas, config, dividends);
+
+                for (std::size_t k = 0; k < active.size(); ++k) {
+                    std::size_t i = active[k];
+                    SecantState& state = states[i];
+                    double vega = 0;
+                    if (!std::isfinite(state.f_prev)) {
+                        // European vega is per percentage point, the secant needs it per unit
+                        vega = 100.0 * black_scholes_vega(batch.asset_price[i],
+                                                          batch.strike_price[i],
+                                                          batch.time_to_expiry[i],
+                                                          batch.risk_free_rate[i], state.sigma);
+                    }
+                    state.done = secant_update(state, prices[k] - option_price[i], vega, result[i]);
+                }
+            }
+
+            return result;
+        }
+    }  // namespace core
+}  // namespace iv_calculator
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "src/core/option_batch.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace iv_calculator::core {
+    /**
+     * @brief Exercise style of an option
+     */
+    enum class ExerciseStyle : std::uint8_t {
+        EUROPEAN,  ///< Exercise only at expiry
+        AMERICAN   ///< Exercise at any time up to expiry
+    };
+
+    /**
+     * @brief Discrete cash dividend paid by the underlying
+     */
+    struct CashDividend {
+        double time = 0;    // Time of the ex-dividend date in years from now
+        double amount = 0;  // Cash amount of the dividend
+    };
+
+    /**
+     * @brief Settings of the Crank-Nicolson finite-difference engine
+     *
+     * Options priced together in a batch share these settings, so the grid
+     * geometry (number of nodes and steps) is identical for all of them.
+     */
+    struct PdeConfig {
+        ExerciseStyle exercise = ExerciseStyle::AMERICAN;  // Early-exercise constraint
+        int space_steps = 200;          // Number of asset price intervals
+        int time_steps = 200;           // Number of time intervals
+        double s_max_multiplier = 4.0;  // Upper grid boundary as a multiple of max(S, K)
+        int rannacher_steps = 2;        // Fully implicit start-up steps to damp oscillations
+        bool richardson = false;        // Combine a grid and its refinement by extrapolation
+    };
+
+    /**
+     * @brief Calculate option price by solving the Black-Scholes PDE with Crank-Nicolson
+     *
+     * @param is_call True for Call option, False for Put option
+     * @param S Current price of the underlying asset
+     * @param K Strike price
+     * @param T Time to expiration in years
+     * @param r Risk-free interest rate
+     * @param sigma Volatility of the underlying asset
+     * @param config Grid and exercise settings
+     * @param dividends Discrete cash dividends paid before expiry
+     * @return double Option price
+     */
+    double pde_option_price(bool is_call, double S, double K, double T, double r, double sigma,
+                            const PdeConfig& config = PdeConfig(),
+                            const std::vector<CashDividend>& dividends = {});
+
+    /**
+     * @brief Calculate prices of many options with the Crank-Nicolson engine
+     *
+     * Options with equal T and r are solved together: their tridiagonal systems are
+     * interleaved node by node so each Thomas sweep runs across SIMD lanes.
+     * Options with invalid inputs get NaN.
+     *
+     * @param batch Options to price
+     * @param volatility Volatility of each option
+     * @param config Grid and exercise settings shared by the whole batch
+     * @param dividends Discrete cash dividends of the common underlying
+     * @return std::vector<double> Option prices in batch order
+     */
+    std::vector<double> pde_option_price_batch(const OptionBatch& batch,
+                                               const std::vector<double>& volatility,
+                                               const PdeConfig& config = PdeConfig(),
+                                               const std::vector<CashDividend>& dividends = {});
+
+    /**
+     * @brief Calculate implied volatility under the finite-difference model
+     *
+     * The search is warm-started from the European Newton-Raphson implied volatility
+     * and refined with secant steps on the PDE price.
+     *
+     * @param is_call True for Call option, False for Put option
+     * @param S Current price of the underlying asset
+     * @param K Strike price
+     * @param T Time to expiration in years
+     * @param r Risk-free interest rate
+     * @param option_price Market price of the option
+     * @param config Grid and exercise settings
+     * @param dividends Discrete cash dividends paid before expiry
+     * @return double Implied volatility
+     */
+    double pde_implied_volatility(bool is_call, double S, double K, double T, double r,
+                                  double option_price, const PdeConfig& config = PdeConfig(),
+                                  const std::vector<CashDividend>& dividends = {});
+
+    /**
+     * @brief Calculate implied volatilities of many options under the finite-difference model
+     *
+     * All unconverged options advance one secant step per batched PDE solve.
+     * Options whose volatility cannot be found get NaN.
+     *
+     * @param batch Options to invert
+     * @param option_price Market price of each option
+     * @param config Grid and exercise settings shared by the whole batch
+     * @param dividends Discrete cash dividends of the common underlying
+     * @return std::vector<double> Implied volatilities in batch order
+     */
+    std::vector<double> pde_implied_volatility_batch(
+        const OptionBatch& batch, const std::vector<double>& option_price,
+        const PdeConfig& config = PdeConfig(), const std::vector<CashDividend>& dividends = {});
+}  // namespace iv_calculator::core
@@ -0,0 +1,154 @@
+#include "scenario.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+namespace iv_calculator {
+    namespace core {
+
+        namespace {
+            // Options repriced together; the grid is walked once per block
+            constexpr std::size_t kScenarioLanes = 8;
+
+            // Shocked volatilities are floored here, which prices at intrinsic value
+            constexpr double kMinScenarioVolatility = 1e-8;
+
+            using Lanes = std::array<double, kScenarioLanes>;
+
+            // Scenario-invariant terms of a block of options, lanes innermost
+            struct ScenarioLanes {
+                Lanes sign{};         // +1 for Call, -1 for Put
+                Lanes spot{};         // S
+                Lanes discounted{};   // K * exp(-rT)
+                Lanes log_forward{};  // ln(S / K) + rT
+                Lanes sqrt_time{};    // sqrt(T)
+                Lanes volatility{};   // Unshocked volatility
+                Lanes quantity{};     // Zero for unused lanes
+            };
+
+            // Position value of lane l with the spot scaled by factor (log_factor = ln factor)
+            // and the volatility terms of one shock
+            double lane_value(const ScenarioLanes& lanes, std::size_t l, double factor,
+                              double log_factor, double deviation, double inverse_deviation) {
+                double d1 = (lanes.log_forward[l] + log_factor) * inverse_deviation +
+                            0.5 * deviation;
+                double d2 = d1 - deviation;
+                double sign = lanes.sign[l];
+                return lanes.quantity[l] * sign *
+                       (lanes.spot[l] * factor * 0.5 * std::erfc(-sign * d1 * M_SQRT1_2) -
+                        lanes.discounted[l] * 0.5 * std::erfc(-sign * d2 * M_SQRT1_2));
+            }
+        }  // namespace
+
+        std::vector<double> scenario_shocks(double first, double last, std::size_t count) {
+            if (count == 0) {
+                throw std::invalid_argument("A shock grid needs at least one shock");
+            }
+            std::vector<double> shocks(count, first);
+            for (std::size_t i = 1; i < count; ++i) {
+                shocks[i] = first + (last - first) * static_cast<double>(i) /
+                                        static_cast<double>(count - 1);
+            }
+            return shocks;
+        }
+
+        void ScenarioMatrix::merge(const ScenarioMatrix& other) {
+            if (other.spot_count != spot_count || other.volatility_count != volatility_count) {
+                throw std::invalid_argument("Scenario matrices have different grids");
+            }
+            base_value += other.base_value;
+            for (std::size_t s = 0; s < value.size(); ++s) {
+                value[s] += other.value[s];
+            }
+        }
+
+        ScenarioMatrix black_scholes_scenarios(const OptionBatch& book,
+                                               const std::vector<double>& volatility,
+                                               const std::vector<double>& quantity,
+                                               const ScenarioGrid& grid) {
+            if (volatility.size() != book.size() || quantity.size() != book.size()) {
+                throw std::invalid_argument("Volatility or quantity count does not match book");
+            }
+            const std::size_t spots = grid.spot_shocks.size();
+            const std::size_t vols = grid.volatility_shocks.size();
+
+            // Spot moves are the same for every option
+            std::vector<double> factor(spots);
+            std::vector<double> log_factor(spots);
+            for (std::size_t i = 0; i < spots; ++i) {
+                if (!(grid.spot_shocks[i] > -1.0)) {
+                    throw std::invalid_argument("Spot shocks must be above -100%");
+                }
+                factor[i] = 1.0 + grid.spot_shocks[i];
+                log_factor[i] = std::log1p(grid.spot_shocks[i]);
+            }
+
+            // Per-lane sums over all blocks, reduced once at the end
+            std::vector<Lanes> sums(grid.size(), Lanes{});
+            Lanes base{};
+            Lanes deviation{};
+            Lanes inverse_deviation{};
+            for (std::size_t begin = 0; begin < book.size(); begin += kScenarioLanes) {
+                std::size_t width = std::min(kScenarioLanes, book.size() - begin);
+
+                // Unused lanes repeat the last option with no quantity
+                ScenarioLanes lanes;
+                for (std::size_t l = 0; l < kScenarioLanes; ++l) {
+                    std::size_t k = begin + std::min(l, width - 1);
+                    double S = book.asset_price[k];
+                    double K = book.strike_price[k];
+                    double T = book.time_to_expiry[k];
+                    double r = book.risk_free_rate[k];
+                    if (!(S > 0 && K > 0 && T > 0 && volatility[k] > 0)) {
+                        throw std::invalid_argument("Invalid input parameters");
+                    }
+                    lanes.sign[l] = book.is_call[k] != 0 ? 1.0 : -1.0;
+                    lanes.spot[l] = S;
+                    lanes.discounted[l] = K * std::exp(-r * T);
+                    lanes.log_forward[l] = std::log(S / K) + r * T;
+                    lanes.sqrt_time[l] = std::sqrt(T);
+                    lanes.volatility[l] = volatility[k];
+                    lanes.quantity[l] = l < width ? quantity[k] : 0.0;
+                }
+
+                for (std::size_t l = 0; l < kScenarioLanes; ++l) {
+                    double unshocked = lanes.volatility[l] * lanes.sqrt_time[l];
+                    base[l] += lane_value(lanes, l, 1.0, 0.0, unshocked, 1.0 / unshocked);
+                }
+
+                for (std::size_t j = 0; j < vols; ++j) {
+                    for (std::size_t l = 0; l < kScenarioLanes; ++l) {
+                        double sigma = std::max(lanes.volatility[l] + grid.volatility_shocks[j],
+                                                kMinScenarioVolatility);
+                        deviation[l] = sigma * lanes.sqrt_time[l];
+                        inverse_deviation[l] = 1.0 / deviation[l];
+                    }
+                    for (std::size_t i = 0; i < spots; ++i) {
+                        Lanes& sum = sums[i * vols + j];
+                        for (std::size_t l = 0; l < kScenarioLanes; ++l) {
+                            sum[l] += lane_value(lanes, l, factor[i], log_factor[i], deviation[l],
+                                                 inverse_deviation[l]);
+                        }
+                    }
+                }
+            }
+
+            ScenarioMatrix matrix;
+            matrix.spot_count = spots;
+            matrix.volatility_count = vols;
+            matrix.value.assign(grid.size(), 0.0);
+            for (std::size_t s = 0; s < sums.size(); ++s) {
+                for (double lane : sums[s]) {
+                    matrix.value[s] += lane;
+                }
+            }
+            for (double lane : base) {
+                matrix.base_value += lane;
+            }
+            return matrix;
+        }
+
+    }  // namespace core
+}  // namespace iv_calculator
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "src/core/option_batch.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace iv_calculator::core {
+
+    /**
+     * @brief Spot and volatility shocks of a stress grid
+     */
+    struct ScenarioGrid {
+        std::vector<double> spot_shocks;        // Relative asset moves, -0.1 for -10%
+        std::vector<double> volatility_shocks;  // Absolute volatility moves, 0.05 for +5 points
+
+        /**
+         * @brief Number of scenarios, every spot shock with every volatility shock
+         */
+        [[nodiscard]] std::size_t size() const {
+            return spot_shocks.size() * volatility_shocks.size();
+        }
+    };
+
+    /**
+     * @brief Evenly spaced shocks from first to last, both included
+     *
+     * @param first First shock
+     * @param last Last shock
+     * @param count Number of shocks, at least 1 (a single shock is first)
+     * @return std::vector<double> Shocks in increasing order of index
+     * @throws std::invalid_argument If count is zero
+     */
+    std::vector<double> scenario_shocks(double first, double last, std::size_t count);
+
+    /**
+     * @brief Value of a book in every scenario of a grid
+     */
+    struct ScenarioMatrix {
+        std::size_t spot_count = 0;
+        std::size_t volatility_count = 0;
+        double base_value = 0.0;    // Value without shocks
+        std::vector<double> value;  // Value per scenario, spot shock major
+
+        /**
+         * @brief Book value with spot shock i and volatility shock j
+         */
+        [[nodiscard]] double at(std::size_t i, std::size_t j) const {
+            return value[i * volatility_count + j];
+        }
+
+        /**
+         * @brief Profit and loss of spot shock i and volatility shock j against the base
+         */
+        [[nodiscard]] double pnl(std::size_t i, std::size_t j) const {
+            return at(i, j) - base_value;
+        }
+
+        /**
+         * @brief Add the values of another part of the book on the same grid
+         *
+         * @throws std::invalid_argument If the grids differ in size
+         */
+        void merge(const ScenarioMatrix& other);
+    };
+
+    /**
+     * @brief Reprice a Black-Scholes book across a scenario grid
+     *
+     * Terms that do not depend on the scenario (discounted strike, ln(F / K), sqrt(T)) are
+     * computed once per option, the volatility terms once per option and volatility shock,
+     * and ln(1 + shock) once per spot shock for the whole book. Options are processed in
+     * fixed-width blocks of lanes; for each block the grid is walked with the lanes
+     * innermost and no branches, and the block's values are accumulated per lane, so the
+     * loop body vectorizes across options and the grid and accumulators stay in L1 cache.
+     * A shocked volatility below 1e-8 is floored there, which prices the option at its
+     * intrinsic value.
+     *
+     * @param book Options of the book
+     * @param volatility Volatility of each option
+     * @param quantity Position size of each option
+     * @param grid Spot shocks, each above -1, and volatility shocks
+     * @return ScenarioMatrix Position-weighted book value in every scenario
+     * @throws std::invalid_argument If a column size does not match the book, a spot shock
+     * is not above -1 or an option has a non-positive asset price, strike, expiry or
+     * volatility
+     */
+    ScenarioMatrix black_scholes_scenarios(const OptionBatch& book,
+                                           const std::vector<double>& volatility,
+                                           const std::vector<double>& quantity,
+                                           const ScenarioGrid& grid);
+
+}  // namespace iv_calculator::core
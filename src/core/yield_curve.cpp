@@ -0,0 +1,168 @@
+#include "yield_curve.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace iv_calculator {
+    namespace core {
+
+        namespace {
+            // Hagan-West forward shape on [0, 1] with g(0) = g0, g(1) = g1 and a zero
+            // integral over the interval; returns g(x) and its integral from 0 to x. When
+            // exactly one end is zero (equal averages on neighbouring intervals) the shape
+            // degenerates to zero with a jump at the other end, as in the published method.
+            void convex_shape(double g0, double g1, double x, double& g, double& integral) {
+                if (g0 == 0.0 && g1 == 0.0) {
+                    g = 0.0;
+                    integral = 0.0;
+                } else if ((g0 < 0 && -0.5 * g0 <= g1 && g1 <= -2.0 * g0) ||
+                           (g0 > 0 && -0.5 * g0 >= g1 && g1 >= -2.0 * g0)) {
+                    // (i) quadratic through both ends
+                    g = g0 * (1 - 4 * x + 3 * x * x) + g1 * (-2 * x + 3 * x * x);
+                    integral = g0 * (x - 2 * x * x + x * x * x) + g1 * (-x * x + x * x * x);
+                } else if ((g0 < 0 && g1 > -2.0 * g0) || (g0 > 0 && g1 < -2.0 * g0)) {
+                    // (ii) flat at g0, then a quadratic rise to g1
+                    double eta = (g1 + 2 * g0) / (g1 - g0);
+                    if (x <= eta) {
+                        g = g0;
+                        integral = g0 * x;
+                    } else {
+                        double s = (x - eta) / (1 - eta);
+                        g = g0 + (g1 - g0) * s * s;
+                        integral = g0 * x + (g1 - g0) * (x - eta) * s * s / 3;
+                    }
+                } else if ((g0 > 0 && g1 < 0 && g1 > -0.5 * g0) ||
+                           (g0 < 0 && g1 > 0 && g1 < -0.5 * g0)) {
+                    // (iii) quadratic from g0 down to g1, then flat
+                    double eta = 3 * g1 / (g1 - g0);
+                    if (x < eta) {
+                        double s = (eta - x) / eta;
+                        g = g1 + (g0 - g1) * s * s;
+                        integral = g1 * x + (g0 - g1) * eta / 3 * (1 - s * s * s);
+                    } else {
+                        g = g1;
+                        integral = g1 * x + (g0 - g1) * eta / 3;
+                    }
+                } else {
+                    // (iv) both ends on the same side: two quadratics meeting at a level A
+                    double eta = g1 / (g1 + g0);
+                    double level = -g0 * g1 / (g0 + g1);
+                    if (x <= eta) {
+                        double s = (eta - x) / eta;
+                        g = level + (g0 - level) * s * s;
+                        integral = level * x + (g0 - level) * eta / 3 * (1 - s * s * s);
+                    } else {
+                        double s = (x - eta) / (1 - eta);
+                        g = level + (g1 - level) * s * s;
+                        integral = level * x + (g0 - level) * eta / 3 +
+                                   (g1 - level) * (x - eta) * s * s / 3;
+                    }
+                }
+            }
+        }  // namespace
+
+        CurveInterpolation parse_curve_interpolation(std::string_view name) {
+            std::string key;
+            for (char c : name) {
+                if (std::isalnum(static_cast<unsigned char>(c)) != 0) {
+                    key.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+                }
+            }
+            if (key == "loglinear") {
+                return CurveInterpolation::LOG_LINEAR;
+            }
+            if (key == "monotoneconvex") {
+                return CurveInterpolation::MONOTONE_CONVEX;
+            }
+            throw std::invalid_argument("Unknown curve interpolation '" + std::string(name) +
+                                        "'");
+        }
+
+        YieldCurve::YieldCurve(std::vector<double> times, std::vector<double> rates,
+                               CurveInterpolation interpolation)
+            : interpolation_(interpolation), rates_(std::move(rates)) {
+            if (times.empty() || times.size() != rates_.size()) {
+                throw std::invalid_argument("A yield curve needs one rate per pillar");
+            }
+            times_.reserve(times.size() + 1);
+            times_.push_back(0.0);
+            integral_.push_back(0.0);
+            discrete_.push_back(0.0);  // No interval ends at t = 0
+            for (std::size_t i = 0; i < times.size(); ++i) {
+                if (!(times[i] > times_.back()) || !std::isfinite(rates_[i])) {
+                    throw std::invalid_argument("Curve pillars must have positive, increasing "
+                                                "times and finite rates");
+                }
+                times_.push_back(times[i]);
+                integral_.push_back(rates_[i] * times[i]);
+                discrete_.push_back((integral_.back() - integral_[i]) / (times[i] - times_[i]));
+            }
+
+            // Instantaneous forwards at the pillars, weighted averages of the neighbouring
+            // interval averages, with the ends chosen so the end intervals stay balanced
+            std::size_t n = times_.size() - 1;
+            node_.assign(n + 1, discrete_[1]);
+            for (std::size_t i = 1; i < n; ++i) {
+                double before = times_[i] - times_[i - 1];
+                double after = times_[i + 1] - times_[i];
+                node_[i] = (before * discrete_[i + 1] + after * discrete_[i]) / (before + after);
+            }
+            if (n > 1) {
+                node_[0] = discrete_[1] - 0.5 * (node_[1] - discrete_[1]);
+                node_[n] = discrete_[n] - 0.5 * (node_[n - 1] - discrete_[n]);
+            }
+        }
+
+        double YieldCurve::integrated_forward(double t) const {
+            t = std::max(t, 0.0);
+            std::size_t n = times_.size() - 1;
+            if (t >= times_[n]) {
+                double last = interpolation_ == CurveInterpolation::LOG_LINEAR ? discrete_[n]
+                                                                              : node_[n];
+                return integral_[n] + (t - times_[n]) * last;
+            }
+            auto i = static_cast<std::size_t>(
+                std::upper_bound(times_.begin(), times_.end(), t) - times_.begin());
+            double width = times_[i] - times_[i - 1];
+            double linear = integral_[i - 1] + (t - times_[i - 1]) * discrete_[i];
+            if (interpolation_ == CurveInterpolation::LOG_LINEAR) {
+                return linear;
+            }
+            double g = 0.0;
+            double shape = 0.0;
+            convex_shape(node_[i - 1] - discrete_[i], node_[i] - discrete_[i],
+                         (t - times_[i - 1]) / width, g, shape);
+            return linear + width * shape;
+        }
+
+        double YieldCurve::forward_rate(double t) const {
+            t = std::max(t, 0.0);
+            std::size_t n = times_.size() - 1;
+            if (interpolation_ == CurveInterpolation::LOG_LINEAR) {
+                auto i = static_cast<std::size_t>(
+                    std::upper_bound(times_.begin(), times_.end(), t) - times_.begin());
+                return discrete_[std::min(i, n)];
+            }
+            if (t >= times_[n]) {
+                return node_[n];
+            }
+            auto i = static_cast<std::size_t>(
+                std::upper_bound(times_.begin(), times_.end(), t) - times_.begin());
+            double g = 0.0;
+            double shape = 0.0;
+            convex_shape(node_[i - 1] - discrete_[i], node_[i] - discrete_[i],
+                         (t - times_[i - 1]) / (times_[i] - times_[i - 1]), g, shape);
+            return discrete_[i] + g;
+        }
+
+        double YieldCurve::zero_rate(double t) const {
+            return t > 0 ? integrated_forward(t) / t : forward_rate(0.0);
+        }
+
+        double YieldCurve::discount(double t) const { return std::exp(-integrated_forward(t)); }
+
+    }  // namespace core
+}  // namespace iv_calculator
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace iv_calculator::core {
+
+    /**
+     * @brief Interpolation between the pillars of a yield curve
+     */
+    enum class CurveInterpolation : std::uint8_t {
+        LOG_LINEAR,      ///< Linear in ln D(t): flat forwards between pillars
+        MONOTONE_CONVEX  ///< Hagan-West: continuous forwards that keep the pillar averages
+    };
+
+    /**
+     * @brief Parse "loglinear" or "monotoneconvex" (case, '-' and '_' are ignored)
+     *
+     * @throws std::invalid_argument If the name is unknown
+     */
+    CurveInterpolation parse_curve_interpolation(std::string_view name);
+
+    /**
+     * @brief Continuously compounded zero curve built from pillar rates
+     *
+     * Both interpolations reproduce the pillar rates exactly. Before the first pillar the
+     * log-linear curve keeps the first rate, and the monotone-convex curve follows its
+     * first interval. Beyond the last pillar the forward rate stays at its value there.
+     */
+    class YieldCurve {
+    public:
+        /**
+         * @brief Build a curve from pillars
+         *
+         * @param times Pillar times in years, positive and strictly increasing
+         * @param rates Continuously compounded zero rate of each pillar
+         * @param interpolation Interpolation between pillars
+         * @throws std::invalid_argument If there are no pillars, the sizes differ or the
+         * times are not positive and increasing
+         */
+        YieldCurve(std::vector<double> times, std::vector<double> rates,
+                   CurveInterpolation interpolation = CurveInterpolation::LOG_LINEAR);
+
+        /**
+         * @brief Zero rate to time t; at t <= 0 the instantaneous forward rate at 0
+         */
+        [[nodiscard]] double zero_rate(double t) const;
+
+        /**
+         * @brief Discount factor exp(-r(t) t)
+         */
+        [[nodiscard]] double discount(double t) const;
+
+        /**
+         * @brief Instantaneous forward rate at t
+         */
+        [[nodiscard]] double forward_rate(double t) const;
+
+        [[nodiscard]] const std::vector<double>& times() const { return times_; }
+        [[nodiscard]] const std::vector<double>& rates() const { return rates_; }
+        [[nodiscard]] CurveInterpolation interpolation() const { return interpolation_; }
+
+    private:
+        // -ln D(t), the integral of the forward rate from 0 to t
+        [[nodiscard]] double integrated_forward(double t) const;
+
+        CurveInterpolation interpolation_;
+        std::vector<double> times_;     // Pillars with t = 0 prepended
+        std::vector<double> rates_;     // Zero rates of the pillars as given
+        std::vector<double> integral_;  // r(t) t at each entry of times_
+        std::vector<double> discrete_;  // Average forward of interval i (from times_[i-1])
+        std::vector<double> node_;      // Monotone-convex instantaneous forward at each time
+    };
+
+}  // namespace iv_calculator::core
@@ -0,0 +1,1095 @@
+#include "batch_engine.h"
+
+#include "src/core/black_scholes.h"
+#include "src/core/pde_solver.h"
+#include "src/engine/checkpoint.h"
+#include "src/io/file_io.h"
+#include "src/io/option_reader.h"
+#include "src/io/option_writer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace iv_calculator {
+    namespace engine {
+
+        double model_price(core::PricingModel model, bool is_call, double S, double K, double T,
+                           double r, double sigma) {
+            if (model == core::PricingModel::BACHELIER) {
+                return core::bachelier_price(is_call, S, K, T, r, sigma);
+            }
+            return core::black_scholes_price(is_call, S, K, T, r, sigma);
+        }
+
+        core::ImpliedVolatilityResult solve_model_implied_volatility(
+            core::PricingModel model, bool is_call, double S, double K, double T, double r,
+            double option_price, const core::SolverOptions& options) {
+            if (model == core::PricingModel::BACHELIER) {
+                core::ImpliedVolatilityResult result;
+                result.volatility =
+                    core::bachelier_implied_volatility(is_call, S, K, T, r, option_price);
+                return result;
+            }
+            return core::solve_implied_volatility(is_call, S, K, T, r, option_price, options);
+        }
+
+        core::Greeks model_greeks(core::PricingModel model, bool is_call, double S, double K,
+                                  double T, double r, double sigma, std::uint8_t which) {
+            if (model == core::PricingModel::BACHELIER) {
+                return core::bachelier_greeks(is_call, S, K, T, r, sigma, which);
+            }
+            return core::black_scholes_greeks(is_call, S, K, T, r, sigma, which);
+        }
+
+        namespace {
+            // Rows handed to one worker at minimum, so small chunks stay on one thread
+            constexpr std::size_t kMinRowsPerThread = 256;
+
+            enum class RowAction : std::uint8_t { PRICE, IMPLIED_VOLATILITY, PASS_THROUGH };
+
+            RowAction row_action(const io::OptionData& option, bool legacy) {
+                if (legacy) {
+                    return option.volatility > 0 ? RowAction::PRICE
+                                                 : RowAction::IMPLIED_VOLATILITY;
+                }
+                if (option.volatility > 0 && option.option_price <= 0) {
+                    return RowAction::PRICE;
+                }
+                if (option.option_price > 0 && option.volatility <= 0) {
+                    return RowAction::IMPLIED_VOLATILITY;
+                }
+                return RowAction::PASS_THROUGH;
+            }
+
+            // Work a row needs for the requested output columns
+            struct RowWork {
+                bool price = true;         // Price rows that carry a volatility
+                bool volatility = true;    // Invert rows that carry a price
+                std::uint8_t greeks = 0;   // core::greek_flags to compute
+                bool row_results = false;  // Fill a RowResult per row
+                bool quotes = false;       // Solve bid, mid and ask volatilities
+            };
+
+            RowWork row_work(const io::OutputSchema& schema) {
+                RowWork work;
+                if (schema.empty()) {
+                    return work;
+                }
+                bool status = schema.contains(io::OutputColumn::STATUS);
+                work.greeks = schema.greeks();
+                work.price = status || schema.contains(io::OutputColumn::PRICE);
+                work.volatility = status || work.greeks != 0 ||
+                                  schema.contains(io::OutputColumn::VOLATILITY) ||
+                                  schema.contains(io::OutputColumn::ITERATIONS) ||
+                                  schema.contains(io::OutputColumn::TOLERANCE);
+                work.row_results = schema.needs_row_results();
+                work.quotes = schema.needs_quotes();
+                return work;
+            }
+
+            // Asset price the models see: the spot less the escrowed dividends
+            double spot(const io::OptionData& option) {
+                return option.asset_price - option.dividend_pv;
+            }
+
+            bool is_american(const io::OptionData& option) {
+                return option.exercise == core::ExerciseStyle::AMERICAN;
+            }
+
+            // The finite-difference engine solves the Black-Scholes equation only
+            void require_american_model(const io::OptionData& option) {
+                if (option.model != core::PricingModel::BLACK_SCHOLES) {
+                    throw std::invalid_argument(
+                        "American exercise is supported under the Black-Scholes model only");
+                }
+            }
+
+            // Grid of American rows with the early-exercise constraint
+            core::PdeConfig american_grid(const BatchConfig& config) {
+                core::PdeConfig grid = config.pde;
+                grid.exercise = core::ExerciseStyle::AMERICAN;
+                return grid;
+            }
+
+            // Whether a solved row is close enough to seed the solve of another one
+            bool same_chain(const io::OptionData& solved, const io::OptionData& option) {
+                return solved.asset_price == option.asset_price &&
+                       solved.underlying == option.underlying &&
+                       solved.time_to_expiry == option.time_to_expiry &&
+                       solved.model == option.model &&
+                       std::abs(solved.strike_price / option.strike_price - 1.0) < 0.1;
+            }
+
+            // Suffix of console lines for options priced with a non-default model
+            std::string model_suffix(core::PricingModel model) {
+                if (model == core::PricingModel::BLACK_SCHOLES) {
+                    return "";
+                }
+                return std::string(", model=") + core::pricing_model_name(model);
+            }
+
+            // Console line of a row whose implied volatility was solved
+            void log_solved(std::ostringstream& console, const io::OptionData& option) {
+                console << "Option: " << (option.is_call ? "Call" : "Put")
+                        << ", S=" << option.asset_price << ", K=" << option.strike_price
+                        << ", T=" << option.time_to_expiry << ", r=" << option.risk_free_rate
+                        << ", price=" << option.option_price
+                        << ", implied volatility=" << option.volatility
+                        << model_suffix(option.model) << '\n';
+            }
+
+            // Console line of a row priced from its volatility
+            void log_priced(std::ostringstream& console, const io::OptionData& option) {
+                console << "Option: " << (option.is_call ? "Call" : "Put")
+                        << ", S=" << option.asset_price << ", K=" << option.strike_price
+                        << ", T=" << option.time_to_expiry << ", r=" << option.risk_free_rate
+                        << ", volatility=" << option.volatility
+                        << ", price=" << option.option_price << model_suffix(option.model)
+                        << '\n';
+            }
+
+            // Whether a row carries a usable bid and ask
+            bool has_quotes(const io::OptionData& option) {
+                return option.bid_price > 0 && option.ask_price >= option.bid_price;
+            }
+
+            // Bid, mid and ask volatilities of a row with quotes; sides without a solution stay
+            // NaN
+            void solve_quotes(const io::OptionData& option, const core::SolverOptions& options,
+                              const core::PdeConfig& grid, io::RowResult& row) {
+                double mid = 0.5 * (option.bid_price + option.ask_price);
+                if (option.model == core::PricingModel::BACHELIER || is_american(option)) {
+                    // Closed form or grid search, so there is nothing to share between the sides
+                    auto side = [&option, &grid](double quote) {
+                        try {
+                            if (is_american(option)) {
+                                require_american_model(option);
+                                return core::pde_implied_volatility(
+                                    option.is_call, spot(option), option.strike_price,
+                                    option.time_to_expiry, option.risk_free_rate, quote, grid);
+                            }
+                            return core::bachelier_implied_volatility(
+                                option.is_call, spot(option), option.strike_price,
+                                option.time_to_expiry, option.risk_free_rate, quote);
+                        } catch (const std::exception&) {
+                            return static_cast<double>(NAN);
+                        }
+                    };
+                    row.bid_volatility = side(option.bid_price);
+                    row.mid_volatility = side(mid);
+                    row.ask_volatility = side(option.ask_price);
+                    return;
+                }
+                // A row priced at its mid has already solved it
+                core::SolverOptions mid_options = options;
+                mid_options.previous =
+                    option.option_price == mid && option.volatility > 0 ? option.volatility : 0.0;
+                core::QuoteImpliedVolatility quotes = core::solve_quote_implied_volatility(
+                    option.is_call, spot(option), option.strike_price,
+                    option.time_to_expiry, option.risk_free_rate, option.bid_price,
+                    option.ask_price, mid_options);
+                row.bid_volatility = quotes.bid.volatility;
+                row.mid_volatility = quotes.mid.volatility;
+                row.ask_volatility = quotes.ask.volatility;
+            }
+
+            // Chain whose escrowed dividends have been valued
+            struct DividendKey {
+                std::uint32_t underlying;
+                double valuation;
+                double expiry;
+                double rate;
+
+                bool operator==(const DividendKey& other) const {
+                    return underlying == other.underlying && valuation == other.valuation &&
+                           expiry == other.expiry && rate == other.rate;
+                }
+            };
+
+            struct DividendKeyHash {
+                std::size_t operator()(const DividendKey& key) const {
+                    std::hash<double> hash;
+                    std::size_t h = std::hash<std::uint32_t>()(key.underlying);
+                    for (double part : {key.valuation, key.expiry, key.rate}) {
+                        h = (h ^ hash(part)) * 0x9E3779B97F4A7C15ULL;
+                    }
+                    return h;
+                }
+            };
+
+            // Console text and counters of one worker's share of a chunk
+            struct SliceResult {
+                std::string console;
+                std::string errors;
+                std::size_t processed = 0;
+                std::size_t failed = 0;
+                std::array<std::size_t, core::kImpliedVolatilityMethodCount> methods{};
+                RiskRollup risk;  // Positions of the slice, when a rollup is requested
+                core::ScenarioMatrix scenarios;     // Positions of the slice on the shock grid
+                std::size_t scenario_positions = 0;
+                std::exception_ptr exception;
+            };
+
+            void solve_slice(std::vector<io::OptionData>& rows, std::vector<std::uint8_t>& failed,
+                             std::vector<io::RowResult>& row_results, std::size_t begin,
+                             std::size_t end, const BatchConfig& config, SliceResult& result) {
+                try {
+                    std::ostringstream console;
+                    std::ostringstream errors;
+                    RowWork work = row_work(config.columns);
+                    bool rollup = !config.risk_file.empty();
+                    work.volatility = work.volatility || rollup;  // Positions need their Greeks
+                    work.volatility = work.volatility || config.scenarios.has_value();
+                    io::RowResult unused;
+                    core::SolverOptions solver = config.solver;
+                    solver.fallback = false;
+                    const io::OptionData* solved_before = nullptr;  // Last solved row
+                    std::vector<std::size_t> deferred;  // Rows the fast method left unsolved
+                    std::vector<std::size_t> american_prices;      // American rows to price
+                    std::vector<std::size_t> american_inversions;  // American rows to invert
+
+                    // Sensitivities share the row's volatility, given or solved; positions
+                    // need all of them for the rollup
+                    auto sensitivities = [&](const io::OptionData& option, io::RowResult& row) {
+                        bool position = rollup && option.quantity != 0;
+                        std::uint8_t which = position ? core::greek_flags::kAll : work.greeks;
+                        if (which == 0 || !(option.volatility > 0)) {
+                            return;
+                        }
+                        if (is_american(option)) {
+                            throw std::invalid_argument(
+                                "Greeks of American options are not supported");
+                        }
+                        row.greeks = model_greeks(option.model, option.is_call,
+                                                  spot(option), option.strike_price,
+                                                  option.time_to_expiry, option.risk_free_rate,
+                                                  option.volatility, which);
+                        if (position) {
+                            result.risk.add(option, row.greeks);
+                        }
+                    };
+
+                    // A row quoted without a price is solved at its mid, which AUTO then
+                    // classifies like any other price
+                    if (!config.legacy) {
+                        for (std::size_t i = begin; i < end; ++i) {
+                            io::OptionData& option = rows[i];
+                            if (option.option_price <= 0 && option.volatility <= 0 &&
+                                has_quotes(option)) {
+                                option.option_price = 0.5 * (option.bid_price + option.ask_price);
+                            }
+                        }
+                    }
+
+                    // AUTO picks a method per row in one classification pass over the slice
+                    std::vector<core::ImpliedVolatilityMethod> routes;
+                    if (config.solver.method == core::ImpliedVolatilityMethod::AUTO) {
+                        core::OptionBatch batch;
+                        std::vector<double> prices;
+                        batch.reserve(end - begin);
+                        prices.reserve(end - begin);
+                        for (std::size_t i = begin; i < end; ++i) {
+                            batch.push_back(rows[i].is_call, spot(rows[i]),
+                                            rows[i].strike_price, rows[i].time_to_expiry,
+                                            rows[i].risk_free_rate);
+                            prices.push_back(rows[i].option_price);
+                        }
+                        routes = core::select_implied_volatility_methods(batch, prices);
+                    }
+                    for (std::size_t i = begin; i < end; ++i) {
+                        io::OptionData& option = rows[i];
+                        io::RowResult& row = work.row_results ? row_results[i] : unused;
+                        if (config.model) {
+                            option.model = *config.model;
+                        }
+                        try {
+                            switch (row_action(option, config.legacy)) {
+                                case RowAction::PRICE:
+                                    row.status = io::RowStatus::PRICED;
+                                    if (!work.price) {
+                                        break;
+                                    }
+                                    if (is_american(option)) {
+                                        // Priced with the slice's other American rows
+                                        require_american_model(option);
+                                        american_prices.push_back(i);
+                                        continue;
+                                    }
+                                    option.option_price = model_price(
+                                        option.model, option.is_call, spot(option),
+                                        option.strike_price, option.time_to_expiry,
+                                        option.risk_free_rate, option.volatility);
+                                    if (config.verbose) {
+                                        log_priced(console, option);
+                                    }
+                                    break;
+                                case RowAction::IMPLIED_VOLATILITY: {
+                                    row.status = io::RowStatus::SOLVED;
+                                    if (!work.volatility) {
+                                        break;
+                                    }
+                                    if (is_american(option)) {
+                                        // Inverted with the slice's other American rows
+                                        require_american_model(option);
+                                        american_inversions.push_back(i);
+                                        continue;
+                                    }
+                                    if (!routes.empty()) {
+                                        solver.method = routes[i - begin];
+                                    }
+                                    solver.previous =
+                                        config.warm_start && solved_before != nullptr &&
+                                                same_chain(*solved_before, option)
+                                            ? solved_before->volatility
+                                            : 0.0;
+                                    core::ImpliedVolatilityResult solved =
+                                        solve_model_implied_volatility(
+                                            option.model, option.is_call, spot(option),
+                                            option.strike_price, option.time_to_expiry,
+                                            option.risk_free_rate, option.option_price, solver);
+                                    row.iterations = solved.iterations;
+                                    row.tolerance = solved.achieved;
+                                    if (option.model == core::PricingModel::BLACK_SCHOLES) {
+                                        ++result.methods[static_cast<std::size_t>(
+                                            solved.method)];
+                                    }
+                                    if (std::isnan(solved.volatility)) {
+                                        // Finished in bulk after the slice
+                                        deferred.push_back(i);
+                                        continue;
+                                    }
+                                    option.volatility = solved.volatility;
+                                    solved_before = &option;
+                                    if (config.verbose) {
+                                        log_solved(console, option);
+                                    }
+                                    break;
+                                }
+                                case RowAction::PASS_THROUGH:
+                                    row.status = io::RowStatus::PASSED;
+                                    break;
+                            }
+                            sensitivities(option, row);
+                            ++result.processed;
+                        } catch (const std::exception& e) {
+                            errors << "Error processing option: " << e.what() << '\n';
+                            failed[i] = 1;
+                            row.status = io::RowStatus::FAILED;
+                            ++result.failed;
+                        }
+                    }
+
+                    // Rows the Newton-family method did not converge on are finished together
+                    // by the fixed-length batch bisection rather than one fallback at a time
+                    if (!deferred.empty()) {
+                        core::OptionBatch batch;
+                        std::vector<double> prices;
+                        batch.reserve(deferred.size());
+                        prices.reserve(deferred.size());
+                        for (std::size_t i : deferred) {
+                            const io::OptionData& option = rows[i];
+                            batch.push_back(option.is_call, spot(option),
+                                            option.strike_price, option.time_to_expiry,
+                                            option.risk_free_rate);
+                            prices.push_back(option.option_price);
+                        }
+                        // The batch bisection works in volatility, to the requested volatility
+                        // tolerance or else its own
+                        double sigma_tolerance =
+                            config.solver.criterion == core::ConvergenceCriterion::VOLATILITY &&
+                                    config.solver.tolerance > 0
+                                ? config.solver.tolerance
+                                : 1e-10;
+                        std::vector<double> volatility =
+                            core::black_scholes_implied_volatility_batch(batch, prices,
+                                                                         sigma_tolerance);
+                        int bisections = core::batch_bisection_iterations(sigma_tolerance);
+                        for (std::size_t k = 0; k < deferred.size(); ++k) {
+                            std::size_t i = deferred[k];
+                            io::OptionData& option = rows[i];
+                            io::RowResult& row = work.row_results ? row_results[i] : unused;
+                            if (std::isnan(volatility[k])) {
+                                errors << "Error processing option: Implied volatility "
+                                          "calculation did not converge\n";
+                                failed[i] = 1;
+                                row.status = io::RowStatus::FAILED;
+                                ++result.failed;
+                                continue;
+                            }
+                            option.volatility = volatility[k];
+                            row.iterations += bisections;
+                            row.tolerance = sigma_tolerance;
+                            if (config.verbose) {
+                                log_solved(console, option);
+                            }
+                            sensitivities(option, row);
+                            ++result.processed;
+                        }
+                    }
+
+                    // American rows are solved on the grid in two batched passes, so rows
+                    // sharing an expiry and rate share every Thomas sweep
+                    auto solve_american = [&](const std::vector<std::size_t>& indices,
+                                              bool invert) {
+                        if (indices.empty()) {
+                            return;
+                        }
+                        core::OptionBatch batch;
+                        std::vector<double> inputs;
+                        batch.reserve(indices.size());
+                        inputs.reserve(indices.size());
+                        for (std::size_t i : indices) {
+                            const io::OptionData& option = rows[i];
+                            batch.push_back(option.is_call, spot(option),
+                                            option.strike_price, option.time_to_expiry,
+                                            option.risk_free_rate);
+                            inputs.push_back(invert ? option.option_price : option.volatility);
+                        }
+                        core::PdeConfig grid = american_grid(config);
+                        std::vector<double> outputs =
+                            invert ? core::pde_implied_volatility_batch(batch, inputs, grid)
+                                   : core::pde_option_price_batch(batch, inputs, grid);
+                        for (std::size_t k = 0; k < indices.size(); ++k) {
+                            std::size_t i = indices[k];
+                            io::OptionData& option = rows[i];
+                            io::RowResult& row = work.row_results ? row_results[i] : unused;
+                            try {
+                                if (std::isnan(outputs[k])) {
+                                    throw std::invalid_argument(
+                                        invert ? "Implied volatility calculation did not "
+                                                 "converge"
+                                               : "Invalid input parameters");
+                                }
+                                if (invert) {
+                                    option.volatility = outputs[k];
+                                } else {
+                                    option.option_price = outputs[k];
+                                }
+                                if (config.verbose) {
+                                    if (invert) {
+                                        log_solved(console, option);
+                                    } else {
+                                        log_priced(console, option);
+                                    }
+                                }
+                                sensitivities(option, row);
+                                ++result.processed;
+                            } catch (const std::exception& e) {
+                                errors << "Error processing option: " << e.what() << '\n';
+                                failed[i] = 1;
+                                row.status = io::RowStatus::FAILED;
+                                ++result.failed;
+                            }
+                        }
+                    };
+                    solve_american(american_prices, false);
+                    solve_american(american_inversions, true);
+
+                    // Quotes last, so a row priced at its mid seeds the mid with its solution
+                    if (work.quotes) {
+                        for (std::size_t i = begin; i < end; ++i) {
+                            if (failed[i] == 0 && has_quotes(rows[i])) {
+                                try {
+                                    solve_quotes(rows[i], config.solver, american_grid(config),
+                                                 row_results[i]);
+                                } catch (const std::invalid_argument&) {
+                                    // Left NaN; the row itself reports invalid inputs
+                                }
+                            }
+                        }
+                    }
+
+                    // The slice's positions are repriced on the grid in one blocked pass
+                    if (config.scenarios) {
+                        core::OptionBatch book;
+                        std::vector<double> volatility;
+                        std::vector<double> quantity;
+                        for (std::size_t i = begin; i < end; ++i) {
+                            const io::OptionData& option = rows[i];
+                            if (failed[i] == 0 && option.quantity != 0 &&
+                                option.model == core::PricingModel::BLACK_SCHOLES &&
+                                !is_american(option) && option.volatility > 0 && spot(option) > 0 &&
+                                option.strike_price > 0 && option.time_to_expiry > 0) {
+                                book.push_back(option.is_call, spot(option),
+                                               option.strike_price, option.time_to_expiry,
+                                               option.risk_free_rate);
+                                volatility.push_back(option.volatility);
+                                quantity.push_back(option.quantity);
+                            }
+                        }
+                        result.scenarios = core::black_scholes_scenarios(
+                            book, volatility, quantity, config.scenarios->grid);
+                        result.scenario_positions = book.size();
+                    }
+                    result.console = console.str();
+                    result.errors = errors.str();
+                } catch (...) {
+                    result.exception = std::current_exception();
+                }
+            }
+
+            // Input consumed through the end of a chunk
+            struct InputMark {
+                std::uint64_t position = 0;  // Reader position
+                std::uint64_t ordinal = 0;   // Records of the whole input passed
+                std::size_t rows = 0;        // Records read, including malformed lines
+                std::size_t read_errors = 0;
+            };
+
+            // Everything a resumed run must share with the interrupted one
+            std::string job_fingerprint(const BatchConfig& config) {
+                std::ostringstream job;
+                job << "input=" << config.input_file
+                    << ";size=" << std::filesystem::file_size(config.input_file) << ";mtime="
+                    << std::filesystem::last_write_time(config.input_file)
+                           .time_since_epoch()
+                           .count()
+                    << ";input_format=" << config.input_format
+                    << ";output=" << config.output_file
+                    << ";output_format=" << config.output_format
+                    << ";model=" << (config.model ? core::pricing_model_name(*config.model) : "")
+                    << ";method=" << core::implied_volatility_method_name(config.solver.method)
+                    << ";guess=" << static_cast<int>(config.solver.guess)
+                    << ";warm_start=" << config.warm_start
+                    << ";criterion=" << static_cast<int>(config.solver.criterion)
+                    << ";tolerance=" << config.solver.tolerance
+                    << ";legacy=" << config.legacy << ";shard=" << config.shard.index << '/'
+                    << config.shard.count << '/' << static_cast<int>(config.shard.mode)
+                    << ";day_count=" << core::day_count_name(config.day_count)
+                    << ";valuation=" << std::to_string(config.valuation_time)
+                    << ";expiry_cutoff=" << std::to_string(config.expiry_cutoff)
+                    << ";holidays=" << config.holiday_file << ";curve=" << config.curve_file
+                    << '/' << static_cast<int>(config.curve_interpolation)
+                    << ";dividends=" << config.dividend_file << ";pde=" << config.pde.space_steps
+                    << '/' << config.pde.time_steps << '/' << config.pde.s_max_multiplier << '/'
+                    << config.pde.rannacher_steps << '/' << config.pde.richardson;
+                if (!config.columns.empty()) {
+                    job << ";output_columns=";
+                    for (io::OutputColumn column : config.columns.columns) {
+                        job << io::output_column_key(column) << ',';
+                    }
+                }
+                if (config.csv_columns.user_defined) {
+                    job << ";columns=";
+                    for (const auto& names : config.csv_columns.names) {
+                        for (const std::string& name : names) {
+                            job << name << ',';
+                        }
+                        job << '|';
+                    }
+                }
+                return job.str();
+            }
+
+            // Solve a chunk in contiguous slices, one per thread
+            std::vector<SliceResult> solve_chunk(std::vector<io::OptionData>& rows,
+                                                 std::vector<std::uint8_t>& failed,
+                                                 std::vector<io::RowResult>& row_results,
+                                                 const BatchConfig& config, unsigned threads) {
+                std::size_t slices = std::min<std::size_t>(
+                    threads, (rows.size() + kMinRowsPerThread - 1) / kMinRowsPerThread);
+                slices = std::max<std::size_t>(slices, 1);
+                failed.assign(rows.size(), 0);
+                if (config.columns.needs_row_results()) {
+                    row_results.assign(rows.size(), io::RowResult());
+                }
+
+                std::vector<SliceResult> results(slices);
+                std::vector<std::thread> workers;
+                workers.reserve(slices - 1);
+                for (std::size_t s = 1; s < slices; ++s) {
+                    workers.emplace_back(solve_slice, std::ref(rows), std::ref(failed),
+                                         std::ref(row_results), rows.size() * s / slices,
+                                         rows.size() * (s + 1) / slices, std::cref(config),
+                                         std::ref(results[s]));
+                }
+                solve_slice(rows, failed, row_results, 0, rows.size() / slices, config,
+                            results[0]);
+                for (std::thread& worker : workers) {
+                    worker.join();
+                }
+
+                for (const SliceResult& result : results) {
+                    if (result.exception) {
+                        std::rethrow_exception(result.exception);
+                    }
+                }
+                return results;
+            }
+        }  // namespace
+
+        BatchStats run_batch(const BatchConfig& config, std::ostream& out, std::ostream& err) {
+            auto supported = [](const std::string& format) {
+                return format == "csv" || format == "json" || format == "binary";
+            };
+            if (!supported(config.input_format)) {
+                throw std::invalid_argument("Unsupported input format '" + config.input_format +
+                                            "'");
+            }
+            if (!supported(config.output_format)) {
+                throw std::invalid_argument("Unsupported output format '" +
+                                            config.output_format + "'");
+            }
+            const ShardSpec& shard = config.shard;
+            bool sharded = shard.count > 1;
+            if (config.legacy && (sharded || config.input_format != "csv")) {
+                throw std::invalid_argument("Legacy batch mode reads a single CSV file");
+            }
+            if (config.legacy && !config.columns.empty()) {
+                throw std::invalid_argument("Legacy batch mode has a fixed output layout");
+            }
+            if (!config.columns.empty() && config.output_format == "binary") {
+                throw std::invalid_argument(
+                    "Binary output has a fixed record layout; output columns need csv or json");
+            }
+            // Shard merges and delta baselines read results back in the input layout
+            if (!config.columns.empty() && (sharded || config.delta)) {
+                throw std::invalid_argument(
+                    "Output columns cannot be combined with sharding or delta output");
+            }
+
+            bool checkpointing = !config.checkpoint_file.empty();
+            if (checkpointing && config.output_file.empty()) {
+                throw std::invalid_argument("Checkpoints require an output file");
+            }
+            std::string job = checkpointing ? job_fingerprint(config) : std::string();
+            std::optional<Checkpoint> resume_from;
+            if (checkpointing && config.resume) {
+                resume_from = load_checkpoint(config.checkpoint_file);
+                if (resume_from && resume_from->job != job) {
+                    throw std::runtime_error("Checkpoint " + config.checkpoint_file +
+                                             " belongs to a different input or settings");
+                }
+            }
+            if (config.delta && (config.legacy || checkpointing)) {
+                throw std::invalid_argument(
+                    "Delta output cannot be combined with legacy mode or checkpoints");
+            }
+            if (!config.risk_file.empty()) {
+                if (config.legacy || checkpointing) {
+                    throw std::invalid_argument(
+                        "Risk rollups cannot be combined with legacy mode or checkpoints");
+                }
+                if (config.risk_format != "csv" && config.risk_format != "json") {
+                    throw std::invalid_argument("Unsupported risk rollup format '" +
+                                                config.risk_format + "'");
+                }
+            }
+            if (config.scenarios) {
+                if (config.legacy || checkpointing) {
+                    throw std::invalid_argument(
+                        "Scenarios cannot be combined with legacy mode or checkpoints");
+                }
+                if (config.scenarios->grid.size() == 0) {
+                    throw std::invalid_argument("Scenario grids need spot and volatility shocks");
+                }
+            }
+            if (config.aggregation != QuoteAggregation::NONE &&
+                (config.legacy || checkpointing)) {
+                throw std::invalid_argument(
+                    "Quote aggregation cannot be combined with legacy mode or checkpoints");
+            }
+            // Shards split a contract's quotes by row, so each would aggregate only a part
+            if (config.aggregation != QuoteAggregation::NONE && sharded) {
+                throw std::invalid_argument("Quote aggregation cannot be sharded");
+            }
+            if (config.pde.space_steps < 3 || config.pde.time_steps < 1 ||
+                config.pde.s_max_multiplier <= 1 || config.pde.rannacher_steps < 0) {
+                throw std::invalid_argument("Invalid PDE grid settings");
+            }
+            if (!(config.expiry_cutoff >= 0 && config.expiry_cutoff < 1)) {
+                throw std::invalid_argument("Expiry cut-off must be a time of day");
+            }
+
+            unsigned threads = config.threads != 0 ? config.threads
+                                                   : std::thread::hardware_concurrency();
+            threads = std::max(threads, 1U);
+            std::size_t chunk_rows = std::max<std::size_t>(config.chunk_rows, 1);
+            BatchStats stats;
+
+            // A yield curve replaces the rate column
+            std::optional<core::YieldCurve> curve;
+            io::CsvColumnMap csv_columns = config.csv_columns;
+            if (!config.curve_file.empty()) {
+                curve = io::read_yield_curve(config.curve_file, config.curve_interpolation);
+                csv_columns.rate_optional = true;
+            }
+
+            // CSV and binary input is streamed; JSON documents are parsed whole
+            std::unique_ptr<io::OptionReader> reader;
+            if (config.legacy) {
+                // Legacy mode keeps the original wording for an unreadable input
+                try {
+                    reader = std::make_unique<io::CsvReader>(
+                        config.input_file, io::CsvSchema::legacy(), config.io_options);
+                } catch (const std::runtime_error&) {
+                    throw std::runtime_error("Could not open input file '" + config.input_file +
+                                             "'");
+                }
+            } else {
+                reader = io::make_option_reader(config.input_format, config.input_file,
+                                                csv_columns, config.io_options);
+            }
+            const auto* csv = dynamic_cast<const io::CsvReader*>(reader.get());
+            const auto* json = dynamic_cast<const io::JsonReader*>(reader.get());
+            if (sharded && shard.mode == ShardMode::RANGE) {
+                reader->seek_partition(shard.index, shard.count);
+            }
+
+            // Input consumed through the end of a chunk. Reading runs one chunk ahead of
+            // writing, so a checkpoint records the mark of the chunk just written.
+            InputMark mark;
+            if (resume_from) {
+                reader->seek(resume_from->input_position);
+                mark.ordinal = resume_from->input_ordinal;
+                stats.rows = resume_from->rows;
+                stats.processed = resume_from->processed;
+                stats.errors = resume_from->errors;
+            }
+            std::size_t read_errors = 0;  // Malformed lines skipped in legacy mode
+
+            // Expiry dates are turned into years once per distinct (valuation, expiry) pair
+            core::YearFractionCache year_fractions(
+                config.day_count, config.holiday_file.empty()
+                                      ? core::HolidayCalendar()
+                                      : io::read_holiday_calendar(config.holiday_file));
+            auto resolve_expiry = [&](io::OptionData& option) {
+                if (option.expiry_date == 0) {
+                    return;
+                }
+                double valuation =
+                    option.valuation_time != 0 ? option.valuation_time : config.valuation_time;
+                if (valuation == 0) {
+                    throw std::invalid_argument("Expiry date given without a valuation time");
+                }
+                double expiry = option.expiry_date;
+                if (expiry == std::floor(expiry)) {
+                    expiry += config.expiry_cutoff;  // A bare date expires at the cut-off
+                }
+                option.time_to_expiry = year_fractions.get(valuation, expiry);
+            };
+
+            // Curve rates are looked up once per distinct time to expiry; strikes of one
+            // expiry usually follow each other, so the previous expiry is tried first
+            std::unordered_map<double, double> zero_rates;
+            double last_expiry = NAN;
+            double last_rate = NAN;
+            auto resolve_rate = [&](io::OptionData& option) {
+                double T = option.time_to_expiry;
+                if (!curve || std::isnan(T)) {
+                    // NaN keys would never be found again; such rows fail later anyway
+                    option.risk_free_rate = curve ? NAN : option.risk_free_rate;
+                    return;
+                }
+                if (T != last_expiry) {
+                    auto it = zero_rates.find(T);
+                    if (it == zero_rates.end()) {
+                        it = zero_rates.emplace(T, curve->zero_rate(T)).first;
+                    }
+                    last_expiry = T;
+                    last_rate = it->second;
+                }
+                option.risk_free_rate = last_rate;
+            };
+
+            // Dividends are valued once per chain. The schedule of each symbol ID is found
+            // once, and consecutive rows of one chain reuse the previous value.
+            std::unordered_map<std::string, core::DividendSchedule> dividends;
+            if (!config.dividend_file.empty()) {
+                dividends = io::read_dividend_schedules(config.dividend_file);
+            }
+            std::vector<const core::DividendSchedule*> schedules;  // By symbol ID
+            std::unordered_map<DividendKey, double, DividendKeyHash> dividend_values;
+            DividendKey last_chain{0, NAN, NAN, NAN};
+            double last_dividends = 0.0;
+            auto resolve_dividends = [&](io::OptionData& option) {
+                if (dividends.empty() || option.underlying == 0) {
+                    return;
+                }
+                while (schedules.size() <= option.underlying) {
+                    auto id = static_cast<std::uint32_t>(schedules.size());
+                    auto it = dividends.find(std::string(reader->symbols().name(id)));
+                    schedules.push_back(it != dividends.end() ? &it->second : nullptr);
+                }
+                const core::DividendSchedule* schedule = schedules[option.underlying];
+                if (schedule == nullptr || std::isnan(option.time_to_expiry)) {
+                    return;
+                }
+                double valuation =
+                    option.valuation_time != 0 ? option.valuation_time : config.valuation_time;
+                if (valuation == 0) {
+                    throw std::invalid_argument("Dividends need a valuation time");
+                }
+                DividendKey chain{option.underlying, valuation, option.time_to_expiry,
+                                  option.risk_free_rate};
+                if (!(chain == last_chain)) {
+                    auto it = dividend_values.find(chain);
+                    if (it == dividend_values.end()) {
+                        double value = schedule->present_value(
+                            valuation, option.time_to_expiry, year_fractions,
+                            option.risk_free_rate, curve ? &*curve : nullptr);
+                        it = dividend_values.emplace(chain, value).first;
+                    }
+                    last_chain = chain;
+                    last_dividends = it->second;
+                }
+                option.dividend_pv = last_dividends;
+            };
+
+            // Next record of this shard
+            auto read_record = [&](io::OptionData& option) {
+                while (true) {
+                    if (sharded && shard.mode == ShardMode::HASH &&
+                        hash_shard(mark.ordinal, shard.count) != shard.index) {
+                        if (!reader->skip()) {
+                            return false;
+                        }
+                        ++mark.ordinal;
+                        continue;
+                    }
+                    try {
+                        if (!reader->next(option)) {
+                            return false;
+                        }
+                        resolve_expiry(option);
+                        resolve_rate(option);
+                        resolve_dividends(option);
+                    } catch (const std::invalid_argument& e) {
+                        // Legacy mode reports a malformed line and moves on
+                        if (!config.legacy) {
+                            throw;
+                        }
+                        err << "Error: " << e.what() << '\n';
+                        ++stats.rows;
+                        ++read_errors;
+                        continue;
+                    }
+                    ++mark.ordinal;
+                    return true;
+                }
+            };
+
+            // With quote aggregation the whole input is read and combined up front, and
+            // chunks are then taken from its contracts
+            bool aggregating = config.aggregation != QuoteAggregation::NONE;
+            std::vector<io::OptionData> contracts;
+            std::size_t next_contract = 0;
+            if (aggregating) {
+                io::OptionData option;
+                while (read_record(option)) {
+                    contracts.push_back(option);
+                }
+                stats.rows += contracts.size();
+                std::size_t quotes = contracts.size();
+                contracts = aggregate_quotes(contracts, config.aggregation, threads);
+                out << "Aggregated " << quotes << " quotes into " << contracts.size()
+                    << " contracts\n";
+            }
+
+            auto read_chunk = [&](std::vector<io::OptionData>& chunk, InputMark& chunk_end) {
+                chunk.clear();
+                if (aggregating) {
+                    std::size_t end = std::min(next_contract + chunk_rows, contracts.size());
+                    chunk.assign(contracts.begin() + static_cast<std::ptrdiff_t>(next_contract),
+                                 contracts.begin() + static_cast<std::ptrdiff_t>(end));
+                    next_contract = end;
+                } else {
+                    io::OptionData option;
+                    while (chunk.size() < chunk_rows && read_record(option)) {
+                        chunk.push_back(option);
+                    }
+                    stats.rows += chunk.size();
+                }
+                mark.position = reader->tell();
+                mark.rows = stats.rows;
+                mark.read_errors = read_errors;
+                chunk_end = mark;
+            };
+
+            std::vector<io::OptionData> chunk;
+            std::vector<io::OptionData> next_chunk;
+            InputMark chunk_end;
+            InputMark next_chunk_end;
+            std::vector<std::uint8_t> failed;
+            std::vector<io::RowResult> row_results;  // Only filled for columns that need them
+            read_chunk(chunk, chunk_end);
+
+            // The baseline is loaded before the output is created, so it may be the same file
+            std::unique_ptr<DeltaFilter> delta;
+            if (config.delta) {
+                delta = std::make_unique<DeltaFilter>(*config.delta, config.io_options);
+            }
+
+            // The output layout is fixed by the first chunk: a model column is written when
+            // the input declares one or any of its rows uses a non-default model. A resumed
+            // run keeps the layout of the interrupted one.
+            std::unique_ptr<io::OptionWriter> writer;
+            bool write_model = false;
+            if (!config.output_file.empty()) {
+                if (resume_from) {
+                    write_model = resume_from->write_model;
+                } else if (config.legacy) {
+                    write_model = false;
+                } else if (config.model) {
+                    write_model = *config.model != core::PricingModel::BLACK_SCHOLES;
+                } else {
+                    const auto& rows = json != nullptr ? json->records() : chunk;
+                    write_model =
+                        (csv != nullptr && csv->schema().from_header &&
+                         std::count(csv->schema().columns.begin(), csv->schema().columns.end(),
+                                    io::CsvField::MODEL) > 0) ||
+                        std::any_of(rows.begin(), rows.end(), [](const io::OptionData& option) {
+                            return option.model != core::PricingModel::BLACK_SCHOLES;
+                        });
+                }
+                writer = io::make_option_writer(config.output_format, config.output_file,
+                                                write_model, config.io_options,
+                                                resume_from ? resume_from->output_bytes : 0,
+                                                config.columns);
+            }
+
+            RiskRollup risk;  // Position-weighted Greeks of the whole run
+            core::ScenarioMatrix scenarios;  // Book values on the shock grid
+            std::size_t scenario_positions = 0;
+            if (config.scenarios) {
+                scenarios.spot_count = config.scenarios->grid.spot_shocks.size();
+                scenarios.volatility_count = config.scenarios->grid.volatility_shocks.size();
+                scenarios.value.assign(config.scenarios->grid.size(), 0.0);
+            }
+            std::size_t checkpoint_rows = std::max<std::size_t>(config.checkpoint_rows, 1);
+
+            // The row count is reported as soon as the input is exhausted, which for an input
+            // of one chunk is ahead of its per-row lines as it always was
+            bool loaded_reported = false;
+            auto report_loaded = [&]() {
+                if (!config.legacy && !loaded_reported) {
+                    out << "Loaded " << stats.rows << " options from " << config.input_file
+                        << '\n';
+                }
+                loaded_reported = true;
+            };
+
+            std::size_t rows_since_checkpoint = 0;
+            while (!chunk.empty()) {
+                // Solve this chunk while the next one is read
+                auto solved = std::async(std::launch::async, solve_chunk, std::ref(chunk),
+                                         std::ref(failed), std::ref(row_results),
+                                         std::cref(config), threads);
+                read_chunk(next_chunk, next_chunk_end);
+                std::vector<SliceResult> results = solved.get();
+                if (next_chunk.empty()) {
+                    report_loaded();
+                }
+
+                for (const SliceResult& result : results) {
+                    out << result.console;
+                    err << result.errors;
+                    stats.processed += result.processed;
+                    stats.errors += result.failed;
+                    for (std::size_t m = 0; m < stats.methods.size(); ++m) {
+                        stats.methods[m] += result.methods[m];
+                    }
+                    // Slices merge in input order, so the sums do not depend on timing
+                    risk.merge(result.risk);
+                    if (config.scenarios) {
+                        scenarios.merge(result.scenarios);
+                        scenario_positions += result.scenario_positions;
+                    }
+                }
+                bool with_row_results = !row_results.empty();
+                for (std::size_t i = 0; i < chunk.size(); ++i) {
+                    bool publish = delta ? delta->publish(chunk[i])
+                                         : !config.legacy || failed[i] == 0;
+                    if (!publish || !writer) {
+                        continue;
+                    }
+                    if (with_row_results) {
+                        writer->write(chunk[i], row_results[i]);
+                    } else {
+                        writer->write(chunk[i]);
+                    }
+                }
+
+                rows_since_checkpoint += chunk.size();
+                if (checkpointing && rows_since_checkpoint >= checkpoint_rows) {
+                    Checkpoint checkpoint;
+                    checkpoint.job = job;
+                    checkpoint.input_position = chunk_end.position;
+                    checkpoint.input_ordinal = chunk_end.ordinal;
+                    checkpoint.output_bytes = writer->commit();
+                    checkpoint.write_model = write_model;
+                    checkpoint.rows = chunk_end.rows;
+                    checkpoint.processed = stats.processed;
+                    checkpoint.errors = stats.errors + chunk_end.read_errors;
+                    save_checkpoint(config.checkpoint_file, checkpoint);
+                    rows_since_checkpoint = 0;
+                }
+
+                chunk.swap(next_chunk);
+                std::swap(chunk_end, next_chunk_end);
+            }
+            stats.errors += read_errors;
+
+            report_loaded();
+            if (writer) {
+                writer->close();
+                if (!config.legacy) {
+                    out << "Results written to " << config.output_file << '\n';
+                }
+            }
+            if (delta) {
+                delta->finish();
+                stats.delta = delta->stats();
+                out << "Delta against " << config.delta->baseline_file << ": "
+                    << stats.delta.added << " added, " << stats.delta.changed << " changed, "
+                    << stats.delta.unchanged << " unchanged, " << stats.delta.removed
+                    << " removed\n";
+            }
+            if (!config.risk_file.empty()) {
+                std::vector<RiskTotals> totals = risk.totals();
+                write_risk_rollup(config.risk_file, config.risk_format, totals, reader->symbols());
+                out << "Risk rollup of " << risk.positions() << " positions in " << totals.size()
+                    << " groups written to " << config.risk_file << '\n';
+            }
+            if (config.scenarios) {
+                write_scenario_matrix(config.scenarios->output_file, config.scenarios->grid,
+                                      scenarios);
+                out << "Scenario P&L of " << scenario_positions << " positions over "
+                    << scenarios.spot_count << 'x' << scenarios.volatility_count
+                    << " shocks written to " << config.scenarios->output_file << '\n';
+            }
+            if (config.solver.method == core::ImpliedVolatilityMethod::AUTO) {
+                out << "Implied volatility methods:";
+                for (std::size_t m = 0; m < stats.methods.size(); ++m) {
+                    if (stats.methods[m] != 0) {
+                        out << ' '
+                            << core::implied_volatility_method_name(
+                                   static_cast<core::ImpliedVolatilityMethod>(m))
+                            << ' ' << stats.methods[m];
+                    }
+                }
+                out << '\n';
+            }
+            // A finished run leaves nothing to resume
+            if (checkpointing) {
+                std::remove(config.checkpoint_file.c_str());
+            }
+            out << "Batch processing complete. Processed " << stats.processed << " items with "
+                << stats.errors << " errors." << std::endl;
+            return stats;
+        }
+
+    }  // namespace engine
+}  // namespace iv_calculator
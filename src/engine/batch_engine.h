@@ -0,0 +1,176 @@
+#pragma once
+
+#include "src/core/bachelier.h"
+#include "src/core/black_scholes.h"
+#include "src/core/greeks.h"
+#include "src/core/pde_solver.h"
+#include "src/engine/delta.h"
+#include "src/engine/quote_aggregator.h"
+#include "src/engine/risk.h"
+#include "src/engine/shard.h"
+#include "src/io/async_io.h"
+#include "src/io/csv_reader.h"
+#include "src/io/output_schema.h"
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <string>
+
+namespace iv_calculator {
+    namespace engine {
+
+        /**
+         * @brief Calculate option price under the selected model
+         *
+         * @param model Pricing model
+         * @param is_call True for Call option, False for Put option
+         * @param S Current price of the underlying asset
+         * @param K Strike price
+         * @param T Time to expiration in years
+         * @param r Risk-free interest rate
+         * @param sigma Volatility of the underlying asset
+         * @return double Option price
+         */
+        double model_price(core::PricingModel model, bool is_call, double S, double K, double T,
+                           double r, double sigma);
+
+        /**
+         * @brief Calculate implied volatility under the selected model with solver statistics
+         *
+         * The Bachelier inversion is closed-form and reports zero iterations.
+         *
+         * @param model Pricing model
+         * @param is_call True for Call option, False for Put option
+         * @param S Current price of the underlying asset
+         * @param K Strike price
+         * @param T Time to expiration in years
+         * @param r Risk-free interest rate
+         * @param option_price Market price of the option
+         * @param options Solver settings of the Black-Scholes inversion
+         * @return core::ImpliedVolatilityResult Implied volatility and iterations used
+         */
+        core::ImpliedVolatilityResult solve_model_implied_volatility(
+            core::PricingModel model, bool is_call, double S, double K, double T, double r,
+            double option_price, const core::SolverOptions& options = core::SolverOptions());
+
+        /**
+         * @brief Calculate sensitivities under the selected model
+         *
+         * @param model Pricing model
+         * @param is_call True for Call option, False for Put option
+         * @param S Current price of the underlying asset
+         * @param K Strike price
+         * @param T Time to expiration in years
+         * @param r Risk-free interest rate
+         * @param sigma Volatility of the underlying asset
+         * @param which core::greek_flags bits of the sensitivities to compute
+         * @return core::Greeks Requested sensitivities
+         */
+        core::Greeks model_greeks(core::PricingModel model, bool is_call, double S, double K,
+                                  double T, double r, double sigma, std::uint8_t which);
+
+        /**
+         * @brief Settings of a batch run
+         */
+        struct BatchConfig {
+            std::string input_file;
+            std::string input_format = "csv";         // "csv", "json" or "binary"
+            std::string output_file;                  // Empty for console output only
+            std::string output_format = "csv";        // "csv", "json" or "binary"
+            std::optional<core::PricingModel> model;  // Overrides per-row models when set
+            // Black-Scholes inversion settings. With the AUTO method each worker classifies its
+            // slice with core::select_implied_volatility_methods before solving it.
+            core::SolverOptions solver;
+            // Seed a solve with the previous row of the worker slice when it has the same
+            // asset price, expiry and model and a strike within 10%. Results then depend on
+            // the solver tolerance and on how rows are grouped into chunks and slices.
+            bool warm_start = false;
+            io::CsvColumnMap csv_columns;             // Header mapping of CSV input
+            io::AsyncIoOptions io_options;            // CSV and binary file I/O backend
+            // Output columns, empty for the input layout. Only the work they need is done:
+            // rows are priced for the price or status column, inverted for the volatility,
+            // status, iterations or sensitivity columns, and only the requested sensitivities
+            // are computed.
+            io::OutputSchema columns;
+            ShardSpec shard;  // Part of the input to process, combined later by merge_shards
+            bool legacy = false;  // Deprecated --batch layout; failed rows are left out
+            bool verbose = true;  // Print one console line per computed row
+            unsigned threads = 0;  // Worker threads, 0 for one per hardware thread
+            std::size_t chunk_rows = 1 << 16;  // Rows read, solved and written per step
+            // Output is made durable and progress recorded every checkpoint_rows rows, so a
+            // run with resume set produces the same output as an uninterrupted one. Empty to
+            // run without checkpoints; the file is removed once the run completes.
+            std::string checkpoint_file;
+            std::size_t checkpoint_rows = 1 << 20;  // Rows between checkpoints (whole chunks)
+            bool resume = false;  // Continue from checkpoint_file when it exists
+            std::optional<DeltaConfig> delta;  // Write only results that moved since a baseline
+            // One row per contract: the whole input is read first and combined with
+            // aggregate_quotes; stats.rows still counts the records read
+            QuoteAggregation aggregation = QuoteAggregation::NONE;
+            // Position-weighted Greeks of rows with a non-zero quantity, summed by underlying
+            // and expiry bucket and written with write_risk_rollup; empty for no rollup
+            std::string risk_file;
+            std::string risk_format = "csv";  // "csv" or "json"
+            // Reprice European Black-Scholes positions with a volatility on a shock grid and
+            // write the P&L matrix with write_scenario_matrix
+            std::optional<ScenarioConfig> scenarios;
+            core::DayCount day_count = core::DayCount::ACT_365_FIXED;  // Expiry dates to years
+            double valuation_time = 0;  // Days since 1970-01-01 for rows without their own
+            // Time of day of expiries given as a bare date, the market close by default
+            double expiry_cutoff = 16.0 / 24.0;
+            std::string holiday_file;   // Business days of BUS/252, empty for weekends only
+            // Yield curve pillars replacing row rates, empty for none. The curve is evaluated
+            // once per distinct time to expiry and makes the CSV rate column optional.
+            std::string curve_file;
+            core::CurveInterpolation curve_interpolation = core::CurveInterpolation::LOG_LINEAR;
+            // Discrete dividends per symbol, empty for none. Their present value is taken off
+            // the asset price seen by every pricer and solver; output keeps the given price.
+            std::string dividend_file;
+            // Grid of American rows, which only binary input carries; its exercise style is
+            // ignored. American rows fail under Bachelier or with sensitivity columns.
+            core::PdeConfig pde;
+        };
+
+        /**
+         * @brief Counters of a batch run
+         */
+        struct BatchStats {
+            std::size_t rows = 0;       // Records read
+            std::size_t processed = 0;  // Records solved (or passed through) successfully
+            std::size_t errors = 0;     // Records that failed to parse or solve
+            DeltaStats delta;           // Comparison with the baseline in delta mode
+            // Black-Scholes inversions of this process by the method they started with,
+            // indexed by core::ImpliedVolatilityMethod
+            std::array<std::size_t, core::kImpliedVolatilityMethodCount> methods{};
+        };
+
+        /**
+         * @brief Price options or solve implied volatilities for a whole file
+         *
+         * Input is streamed in chunks of config.chunk_rows. Each chunk is solved on the worker
+         * threads while the next one is read, and results are written in input order. A row
+         * with a volatility but no price is priced, a row with a price but no volatility is
+         * inverted and other rows are passed through. In legacy mode every row is priced when
+         * it carries a volatility and inverted otherwise. The optional features are described
+         * on their BatchConfig fields.
+         *
+         * @param config Input, output and execution settings
+         * @param out Stream receiving per-row results and progress messages
+         * @param err Stream receiving per-row errors
+         * @return BatchStats Counters of the run
+         * @throws std::runtime_error If:
+         * - a file cannot be read or written
+         * - the checkpoint was written by a run with other input or settings
+         * @throws std::invalid_argument If:
+         * - a format, or the risk rollup format, is unsupported
+         * - the settings combine features that cannot run together
+         * - the PDE grid, the expiry cut-off or the scenario grid is invalid
+         * - outside legacy mode, a record cannot be parsed or has an expiry date or
+         *   dividends but no valuation time
+         */
+        BatchStats run_batch(const BatchConfig& config, std::ostream& out, std::ostream& err);
+
+    }  // namespace engine
+}  // namespace iv_calculator
@@ -0,0 +1,390 @@
+#include "chain_generator.h"
+
+#include "src/core/black_scholes.h"
+#include "src/io/binary_format.h"
+#include "src/io/option_writer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+namespace iv_calculator {
+    namespace engine {
+
+        namespace {
+            enum class Format { CSV, JSON, NDJSON, BINARY };
+
+            // Independent random streams of a row
+            enum Stream : std::uint64_t {
+                SPOT,
+                BASE_VOL,
+                SKEW,
+                NOISE_U1,
+                NOISE_U2,
+                INVALID,
+                INVALID_KIND
+            };
+
+            // Finalizer of splitmix64: every input bit affects every output bit
+            std::uint64_t mix(std::uint64_t x) {
+                x = (x ^ (x >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+                x = (x ^ (x >> 27U)) * 0x94D049BB133111EBULL;
+                return x ^ (x >> 31U);
+            }
+
+            // Uniform in [0, 1) drawn from a stream at an index (a row or an underlying);
+            // a pure function of its arguments, so blocks can be generated in any order
+            double uniform(std::uint64_t seed, Stream stream, std::uint64_t index) {
+                std::uint64_t bits =
+                    mix(mix(seed + 0x9E3779B97F4A7C15ULL * (stream + 1)) ^ mix(index));
+                return static_cast<double>(bits >> 11U) * 0x1.0p-53;
+            }
+
+            double round_cents(double value) { return std::round(value * 100.0) / 100.0; }
+
+            Format parse_format(const std::string& format) {
+                if (format == "csv") {
+                    return Format::CSV;
+                }
+                if (format == "json") {
+                    return Format::JSON;
+                }
+                if (format == "ndjson") {
+                    return Format::NDJSON;
+                }
+                if (format == "binary") {
+                    return Format::BINARY;
+                }
+                throw std::invalid_argument("Generator format must be csv, json, ndjson or "
+                                            "binary: " +
+                                            format);
+            }
+
+            // Ticker of an underlying: "AAA", "AAB", ... with more letters as needed
+            void append_symbol(std::string& buffer, std::uint64_t underlying) {
+                std::array<char, 16> letters{};
+                std::size_t count = 0;
+                do {
+                    letters.at(count++) = static_cast<char>('A' + underlying % 26);
+                    underlying /= 26;
+                } while (underlying != 0 || count < 3);
+                while (count > 0) {
+                    buffer += letters.at(--count);
+                }
+            }
+
+            struct Underlying {
+                double spot = 0;
+                double base_volatility = 0;
+                double skew = 0;
+            };
+
+            struct Row {
+                io::OptionData option;
+                std::uint64_t underlying = 0;
+                bool invalid = false;
+            };
+
+            class ChainLayout {
+            public:
+                explicit ChainLayout(const GeneratorConfig& config)
+                    : config_(config),
+                      chain_rows_(config.expiry_days.size() * config.strikes * 2) {}
+
+                [[nodiscard]] Underlying underlying(std::uint64_t index) const {
+                    Underlying u;
+                    double draw = uniform(config_.seed, SPOT, index);
+                    u.spot = round_cents(10.0 * std::pow(100.0, draw));
+                    u.base_volatility = 0.12 + 0.68 * uniform(config_.seed, BASE_VOL, index);
+                    u.skew = 0.05 + 0.25 * uniform(config_.seed, SKEW, index);
+                    return u;
+                }
+
+                Row row(std::uint64_t index, const Underlying& u) const {
+                    Row row;
+                    row.underlying = index / chain_rows_;
+                    std::size_t position = index % chain_rows_;
+                    std::size_t expiry = position / (2 * config_.strikes);
+                    std::size_t strike = position / 2 % config_.strikes;
+
+                    io::OptionData& option = row.option;
+                    option.is_call = position % 2 == 0;
+                    option.asset_price = u.spot;
+                    option.time_to_expiry = config_.expiry_days[expiry] / 365.0;
+                    option.risk_free_rate = config_.rate;
+
+                    double T = option.time_to_expiry;
+                    double step = config_.strikes > 1
+                                      ? static_cast<double>(strike) /
+                                            static_cast<double>(config_.strikes - 1)
+                                      : 0.5;
+                    double moneyness = (config_.min_moneyness +
+                                        step * (config_.max_moneyness - config_.min_moneyness)) *
+                                       std::sqrt(T);
+                    option.strike_price =
+                        std::max(round_cents(u.spot * std::exp(moneyness)), 0.01);
+
+                    // Skewed smile in standardized moneyness, steeper for short expiries
+                    double x = std::log(option.strike_price / u.spot) / std::sqrt(T);
+                    double sigma = u.base_volatility * (1.0 - u.skew * x + 0.1 * x * x);
+                    sigma = std::clamp(sigma, 0.05, 3.0);
+
+                    // No-arbitrage bounds: the discounted intrinsic value below, S for a call
+                    // and K e^(-rT) for a put above
+                    double forward_strike =
+                        option.strike_price * std::exp(-option.risk_free_rate * T);
+                    double lower = std::max(option.is_call ? u.spot - forward_strike
+                                                           : forward_strike - u.spot,
+                                            0.0);
+                    double upper = option.is_call ? u.spot : forward_strike;
+
+                    // Noise scales the time value only, so deep in-the-money mids keep their
+                    // intrinsic value; the mid is the cent nearest to the noisy price that
+                    // lies strictly between the bounds
+                    double model = core::black_scholes_price(option.is_call, u.spot,
+                                                              option.strike_price, T,
+                                                              option.risk_free_rate, sigma);
+                    double u1 = uniform(config_.seed, NOISE_U1, index);
+                    double u2 = uniform(config_.seed, NOISE_U2, index);
+                    double z = std::sqrt(-2.0 * std::log(1.0 - u1)) * std::cos(2.0 * M_PI * u2);
+                    double noisy =
+                        lower + std::max(model - lower, 0.0) * std::exp(config_.noise * z);
+                    double lowest = std::floor(lower * 100.0 + 1e-9) / 100.0 + 0.01;
+                    double highest = std::ceil(upper * 100.0 - 1e-9) / 100.0 - 0.01;
+                    double mid = std::clamp(round_cents(noisy), lowest, std::max(highest, lowest));
+                    double half_spread = std::max(round_cents(0.02 * mid), 0.01);
+                    option.bid_price = round_cents(mid - half_spread);
+                    option.ask_price = round_cents(mid + half_spread);
+                    option.option_price = mid;
+
+                    if (uniform(config_.seed, INVALID, index) < config_.invalid_share) {
+                        row.invalid = true;
+                        // Positive, so the engine solves the row rather than passing it through
+                        // or pricing it at its mid, and fails it
+                        option.option_price =
+                            uniform(config_.seed, INVALID_KIND, index) < 0.5 && lower >= 0.02
+                                ? round_cents(0.5 * lower)
+                                : round_cents(upper * 1.1) + 0.01;
+                    }
+                    return row;
+                }
+
+                [[nodiscard]] std::uint64_t chain_rows() const { return chain_rows_; }
+
+            private:
+                const GeneratorConfig& config_;
+                std::uint64_t chain_rows_;
+            };
+
+            void append_csv(std::string& buffer, const Row& row) {
+                const io::OptionData& option = row.option;
+                append_symbol(buffer, row.underlying);
+                buffer += option.is_call ? ",Call," : ",Put,";
+                io::append_number(buffer, option.asset_price);
+                buffer += ',';
+                io::append_number(buffer, option.strike_price);
+                buffer += ',';
+                io::append_number(buffer, option.time_to_expiry);
+                buffer += ',';
+                io::append_number(buffer, option.risk_free_rate);
+                buffer += ',';
+                io::append_number(buffer, option.bid_price);
+                buffer += ',';
+                io::append_number(buffer, option.ask_price);
+                buffer += ',';
+                io::append_number(buffer, option.option_price);
+                buffer += '\n';
+            }
+
+            void append_json(std::string& buffer, const Row& row) {
+                const io::OptionData& option = row.option;
+                buffer += R"({"symbol": ")";
+                append_symbol(buffer, row.underlying);
+                buffer += option.is_call ? R"(", "type": "Call")" : R"(", "type": "Put")";
+                buffer += R"(, "asset_price": )";
+                io::append_number(buffer, option.asset_price);
+                buffer += R"(, "strike_price": )";
+                io::append_number(buffer, option.strike_price);
+                buffer += R"(, "time_to_expiry": )";
+                io::append_number(buffer, option.time_to_expiry);
+                buffer += R"(, "risk_free_rate": )";
+                io::append_number(buffer, option.risk_free_rate);
+                buffer += R"(, "bid_price": )";
+                io::append_number(buffer, option.bid_price);
+                buffer += R"(, "ask_price": )";
+                io::append_number(buffer, option.ask_price);
+                buffer += R"(, "option_price": )";
+                io::append_number(buffer, option.option_price);
+                buffer += '}';
+            }
+
+            // Format rows [first, end) and return how many of them are invalid
+            std::uint64_t format_block(const ChainLayout& layout, Format format,
+                                       std::uint64_t first, std::uint64_t end,
+                                       std::string& buffer) {
+                buffer.clear();
+                std::uint64_t invalid = 0;
+                std::uint64_t current = UINT64_MAX;
+                Underlying u;
+                for (std::uint64_t index = first; index < end; ++index) {
+                    if (index / layout.chain_rows() != current) {
+                        current = index / layout.chain_rows();
+                        u = layout.underlying(current);
+                    }
+                    Row row = layout.row(index, u);
+                    invalid += row.invalid ? 1 : 0;
+                    switch (format) {
+                        case Format::CSV:
+                            append_csv(buffer, row);
+                            break;
+                        case Format::JSON:
+                            buffer += index == 0 ? "    " : ",\n    ";
+                            append_json(buffer, row);
+                            break;
+                        case Format::NDJSON:
+                            append_json(buffer, row);
+                            buffer += '\n';
+                            break;
+                        case Format::BINARY: {
+                            std::size_t size = buffer.size();
+                            buffer.resize(size + io::binary_format::kRecordSize);
+                            io::binary_format::encode(row.option, &buffer[size]);
+                            break;
+                        }
+                    }
+                }
+                return invalid;
+            }
+        }  // namespace
+
+        std::vector<double> parse_expiry_days(const std::string& spec) {
+            std::vector<double> days;
+            std::size_t pos = 0;
+            while (pos <= spec.size()) {
+                std::size_t comma = std::min(spec.find(',', pos), spec.size());
+                std::string entry = spec.substr(pos, comma - pos);
+                pos = comma + 1;
+                double value = 0;
+                try {
+                    std::size_t used = 0;
+                    value = std::stod(entry, &used);
+                    if (used != entry.size()) {
+                        throw std::invalid_argument(entry);
+                    }
+                } catch (const std::exception&) {
+                    throw std::invalid_argument("Invalid days to expiry: '" + entry + "'");
+                }
+                if (!(value > 0)) {
+                    throw std::invalid_argument("Days to expiry must be positive: " + entry);
+                }
+                days.push_back(value);
+            }
+            return days;
+        }
+
+        GeneratorStats generate_chains(const GeneratorConfig& config, std::ostream& out) {
+            Format format = parse_format(config.output_format);
+            if (config.expiry_days.empty() || config.strikes == 0) {
+                throw std::invalid_argument("Chains need at least one expiry and one strike");
+            }
+            for (double days : config.expiry_days) {
+                if (!(days > 0)) {
+                    throw std::invalid_argument("Days to expiry must be positive");
+                }
+            }
+            if (!(config.min_moneyness <= config.max_moneyness) || !(config.noise >= 0) ||
+                !(config.invalid_share >= 0 && config.invalid_share <= 1) ||
+                !std::isfinite(config.rate)) {
+                throw std::invalid_argument(
+                    "Moneyness range must be ordered, noise non-negative, the invalid share "
+                    "between 0 and 1 and the rate finite");
+            }
+
+            unsigned threads = config.threads != 0 ? config.threads
+                                                   : std::thread::hardware_concurrency();
+            threads = std::max(threads, 1U);
+            std::uint64_t block_rows = std::max<std::size_t>(config.block_rows, 1);
+            std::uint64_t blocks = (config.rows + block_rows - 1) / block_rows;
+            ChainLayout layout(config);
+
+            io::AsyncFileWriter file(config.output_file, config.io_options);
+            switch (format) {
+                case Format::CSV:
+                    file.write("Symbol,Type,Asset,Strike,Time,Rate,Bid,Ask,Price\n");
+                    break;
+                case Format::JSON:
+                    file.write("[\n");
+                    break;
+                case Format::NDJSON:
+                    break;
+                case Format::BINARY: {
+                    std::array<char, io::binary_format::kHeaderSize> header =
+                        io::binary_format::header();
+                    file.write(std::string_view(header.data(), header.size()));
+                    break;
+                }
+            }
+
+            // One round is a block per thread. Round r + 1 is formatted while round r is
+            // written, so the disk and the cores stay busy together.
+            GeneratorStats stats;
+            std::vector<std::string> formatting(threads);
+            std::vector<std::string> writing(threads);
+            std::vector<std::uint64_t> invalid(threads);
+            auto format_round = [&](std::uint64_t round) {
+                std::vector<std::thread> workers;
+                for (unsigned t = 0; t < threads; ++t) {
+                    std::uint64_t block = round * threads + t;
+                    formatting[t].clear();
+                    invalid[t] = 0;
+                    if (block >= blocks) {
+                        break;
+                    }
+                    std::uint64_t first = block * block_rows;
+                    std::uint64_t end = std::min(first + block_rows, config.rows);
+                    workers.emplace_back([&, t, first, end] {
+                        invalid[t] = format_block(layout, format, first, end, formatting[t]);
+                    });
+                }
+                for (std::thread& worker : workers) {
+                    worker.join();
+                }
+                for (unsigned t = 0; t < threads; ++t) {
+                    stats.invalid += invalid[t];
+                }
+            };
+
+            std::uint64_t rounds = (blocks + threads - 1) / threads;
+            if (rounds > 0) {
+                format_round(0);
+            }
+            for (std::uint64_t round = 0; round < rounds; ++round) {
+                formatting.swap(writing);
+                std::thread next;
+                if (round + 1 < rounds) {
+                    next = std::thread(format_round, round + 1);
+                }
+                for (const std::string& buffer : writing) {
+                    file.write(buffer);
+                }
+                if (next.joinable()) {
+                    next.join();
+                }
+            }
+
+            if (format == Format::JSON) {
+                file.write(config.rows == 0 ? "]\n" : "\n]\n");
+            }
+            stats.rows = config.rows;
+            stats.bytes = file.size();
+            file.close();
+
+            out << "Generated " << stats.rows << " rows (" << stats.invalid << " invalid, "
+                << stats.bytes << " bytes) in " << config.output_file << "\n";
+            return stats;
+        }
+
+    }  // namespace engine
+}  // namespace iv_calculator
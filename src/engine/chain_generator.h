@@ -0,0 +1,85 @@
+#pragma once
+
+#include "src/io/async_io.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace iv_calculator {
+    namespace engine {
+
+        /**
+         * @brief Settings of a synthetic option-chain file
+         *
+         * Rows come in chains: every underlying lists each expiry, each expiry lists its
+         * strikes from the lowest up, and every strike has a call followed by a put. A file
+         * of more rows than one chain holds continues with further underlyings.
+         */
+        struct GeneratorConfig {
+            std::uint64_t rows = 1000000;       // Rows to write
+            std::string output_file;            // Path to the generated file
+            std::string output_format = "csv";  // csv, json, ndjson or binary
+            std::uint64_t seed = 1;             // Same seed, same file, for any thread count
+            unsigned threads = 0;               // Formatting threads, 0 for one per core
+            std::size_t block_rows = 1 << 16;   // Rows formatted by one task
+
+            // Days to expiry of each chain
+            std::vector<double> expiry_days = {7, 14, 30, 60, 91, 182, 365, 730};
+            std::size_t strikes = 41;           // Strikes per expiry
+            double min_moneyness = -0.6;        // Lowest ln(K/S) at one year, scaled by sqrt(T)
+            double max_moneyness = 0.6;         // Highest ln(K/S) at one year, scaled by sqrt(T)
+            double rate = 0.04;                 // Risk-free rate of every row
+            double noise = 0.01;                // Standard deviation of the log mid price error
+            double invalid_share = 0.0;         // Share of rows with an arbitrage-violating price
+
+            io::AsyncIoOptions io_options;  // Write-behind backend and buffering settings
+        };
+
+        /**
+         * @brief Counters of a generated file
+         */
+        struct GeneratorStats {
+            std::uint64_t rows = 0;     // Rows written
+            std::uint64_t invalid = 0;  // Rows given an invalid price
+            std::uint64_t bytes = 0;    // File size
+        };
+
+        /**
+         * @brief Parse a comma-separated list of positive days to expiry such as "7,30,91"
+         *
+         * @throws std::invalid_argument If the list is empty or an entry is not positive
+         */
+        std::vector<double> parse_expiry_days(const std::string& spec);
+
+        /**
+         * @brief Write a file of synthetic option chains
+         *
+         * Each underlying draws a spot price between 10 and 1000 and a base volatility
+         * between 0.12 and 0.8. Strikes are spaced evenly in log-moneyness and rounded to
+         * cents, volatilities follow a skewed smile, and mid prices are Black-Scholes prices
+         * whose time value carries lognormal noise, rounded to cents and kept strictly
+         * between the discounted intrinsic value and the no-arbitrage upper bound. Bid and
+         * ask lie 2% of the mid, at least one cent, either side of it. An invalid row keeps its
+         * quotes but gets a price below the intrinsic value, if it is in the money, or one
+         * above the upper bound.
+         *
+         * CSV files have the columns Symbol,Type,Asset,Strike,Time,Rate,Bid,Ask,Price, JSON
+         * files an array and NDJSON files one object per line with the matching fields;
+         * binary files hold the fields of the binary record format only.
+         *
+         * Every random draw is a hash of the seed and the row number, so the file depends on
+         * the seed alone. Blocks of config.block_rows rows are formatted on the worker
+         * threads while the previous blocks are written in order.
+         *
+         * @param config Generator settings
+         * @param out Stream for the summary line
+         * @return GeneratorStats Counters of the file
+         * @throws std::invalid_argument If a setting is out of range or the format unknown
+         */
+        GeneratorStats generate_chains(const GeneratorConfig& config, std::ostream& out);
+
+    }  // namespace engine
+}  // namespace iv_calculator
@@ -0,0 +1,129 @@
+#include "checkpoint.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace iv_calculator {
+    namespace engine {
+
+        namespace {
+            constexpr const char* kCheckpointHeader = "iv_calculator checkpoint 1";
+            constexpr std::size_t kCheckpointFields = 8;
+
+            std::uint64_t parse_counter(const std::string& filepath, const std::string& value) {
+                try {
+                    std::size_t end = 0;
+                    std::uint64_t number = std::stoull(value, &end);
+                    if (end == value.size()) {
+                        return number;
+                    }
+                } catch (const std::exception&) {  // NOLINT(bugprone-empty-catch)
+                    // Reported below
+                }
+                throw std::runtime_error("Invalid value '" + value + "' in checkpoint " +
+                                         filepath);
+            }
+
+            // Flush a file or directory to the device, so it survives a power loss
+            void sync_path(const std::string& path) {
+                int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+                if (fd < 0) {
+                    throw std::runtime_error("Could not open " + path + ": " +
+                                             std::strerror(errno));
+                }
+                int result = ::fsync(fd);
+                int error = errno;
+                ::close(fd);
+                if (result != 0) {
+                    throw std::runtime_error("Could not sync " + path + ": " +
+                                             std::strerror(error));
+                }
+            }
+        }  // namespace
+
+        void save_checkpoint(const std::string& filepath, const Checkpoint& checkpoint) {
+            std::string temporary = filepath + ".tmp";
+            {
+                std::ofstream file(temporary, std::ios::trunc);
+                if (!file.is_open()) {
+                    throw std::runtime_error("Could not open file: " + temporary);
+                }
+                file << kCheckpointHeader << '\n'
+                     << "job=" << checkpoint.job << '\n'
+                     << "input_position=" << checkpoint.input_position << '\n'
+                     << "input_ordinal=" << checkpoint.input_ordinal << '\n'
+                     << "output_bytes=" << checkpoint.output_bytes << '\n'
+                     << "write_model=" << (checkpoint.write_model ? 1 : 0) << '\n'
+                     << "rows=" << checkpoint.rows << '\n'
+                     << "processed=" << checkpoint.processed << '\n'
+                     << "errors=" << checkpoint.errors << '\n';
+                file.close();
+                if (file.fail()) {
+                    throw std::runtime_error("Could not write checkpoint " + temporary);
+                }
+            }
+            // The contents reach the device before the rename publishes them, and the
+            // directory entry after it, so a crash cannot leave an empty checkpoint
+            sync_path(temporary);
+            std::filesystem::rename(temporary, filepath);
+            std::filesystem::path directory = std::filesystem::path(filepath).parent_path();
+            sync_path(directory.empty() ? "." : directory.string());
+        }
+
+        std::optional<Checkpoint> load_checkpoint(const std::string& filepath) {
+            std::ifstream file(filepath);
+            if (!file.is_open()) {
+                if (!std::filesystem::exists(filepath)) {
+                    return std::nullopt;
+                }
+                throw std::runtime_error("Could not open file: " + filepath);
+            }
+
+            std::string line;
+            if (!std::getline(file, line) || line != kCheckpointHeader) {
+                throw std::runtime_error("Not a checkpoint file: " + filepath);
+            }
+            Checkpoint checkpoint;
+            std::size_t fields = 0;
+            while (std::getline(file, line)) {
+                std::size_t separator = line.find('=');
+                if (separator == std::string::npos) {
+                    throw std::runtime_error("Malformed line '" + line + "' in checkpoint " +
+                                             filepath);
+                }
+                std::string key = line.substr(0, separator);
+                std::string value = line.substr(separator + 1);
+                if (key == "job") {
+                    checkpoint.job = value;
+                } else if (key == "input_position") {
+                    checkpoint.input_position = parse_counter(filepath, value);
+                } else if (key == "input_ordinal") {
+                    checkpoint.input_ordinal = parse_counter(filepath, value);
+                } else if (key == "output_bytes") {
+                    checkpoint.output_bytes = parse_counter(filepath, value);
+                } else if (key == "write_model") {
+                    checkpoint.write_model = parse_counter(filepath, value) != 0;
+                } else if (key == "rows") {
+                    checkpoint.rows = parse_counter(filepath, value);
+                } else if (key == "processed") {
+                    checkpoint.processed = parse_counter(filepath, value);
+                } else if (key == "errors") {
+                    checkpoint.errors = parse_counter(filepath, value);
+                } else {
+                    continue;
+                }
+                ++fields;
+            }
+            if (fields != kCheckpointFields) {
+                throw std::runtime_error("Incomplete checkpoint " + filepath);
+            }
+            return checkpoint;
+        }
+
+    }  // namespace engine
+}  // namespace iv_calculator
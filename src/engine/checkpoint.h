@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace iv_calculator {
+    namespace engine {
+
+        /**
+         * @brief Progress of a batch run up to the last durable output
+         *
+         * Everything before input_position has been solved and written, and the first
+         * output_bytes bytes of the output file hold exactly those results.
+         */
+        struct Checkpoint {
+            std::string job;                   // Identifies the input and settings of the run
+            std::uint64_t input_position = 0;  // Reader position after the committed records
+            std::uint64_t input_ordinal = 0;   // Records of the whole input passed so far
+            std::uint64_t output_bytes = 0;    // Output size covering the committed records
+            bool write_model = false;          // Output layout chosen by the run
+            std::size_t rows = 0;              // Records read
+            std::size_t processed = 0;         // Records solved (or passed through)
+            std::size_t errors = 0;            // Records that failed to parse or solve
+        };
+
+        /**
+         * @brief Replace a checkpoint file atomically
+         *
+         * The checkpoint is written next to the target, synced to the device and renamed
+         * over it, and the directory is synced after the rename, so a crash or power loss
+         * leaves either the previous or the new checkpoint.
+         *
+         * @param filepath Path to the checkpoint file
+         * @param checkpoint Progress to record
+         * @throws std::runtime_error If the file cannot be written
+         */
+        void save_checkpoint(const std::string& filepath, const Checkpoint& checkpoint);
+
+        /**
+         * @brief Read a checkpoint file
+         *
+         * @param filepath Path to the checkpoint file
+         * @return std::optional<Checkpoint> Recorded progress, empty if the file does not exist
+         * @throws std::runtime_error If the file is not a valid checkpoint
+         */
+        std::optional<Checkpoint> load_checkpoint(const std::string& filepath);
+
+    }  // namespace engine
+}  // namespace iv_calculator
@@ -0,0 +1,190 @@
+#include "delta.h"
+
+#include "src/io/csv_reader.h"
+#include "src/io/option_reader.h"
+#include "src/io/option_writer.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+namespace iv_calculator {
+    namespace engine {
+
+        namespace {
+            // Change log text is handed to the file in blocks of about this size
+            constexpr std::size_t kLogChunkSize = 1 << 16;
+
+            // Value as the CSV and JSON writers print it
+            double round_as_text(double value) {
+                if (!std::isfinite(value)) {
+                    return value;
+                }
+                std::string text;
+                io::append_number(text, value);
+                double rounded = value;
+                std::from_chars(text.data(), text.data() + text.size(), rounded);
+                return rounded;
+            }
+
+            bool moved(double current, double previous, double epsilon) {
+                if (std::isnan(current) || std::isnan(previous)) {
+                    return std::isnan(current) != std::isnan(previous);
+                }
+                return std::fabs(current - previous) > epsilon;
+            }
+        }  // namespace
+
+        DeltaKey parse_delta_key(const std::string& name) {
+            if (name == "row") {
+                return DeltaKey::ROW;
+            }
+            if (name == "contract") {
+                return DeltaKey::CONTRACT;
+            }
+            throw std::invalid_argument("Unknown delta key '" + name + "'");
+        }
+
+        std::size_t DeltaFilter::ContractHash::operator()(const io::OptionData& option) const {
+            std::size_t hash = std::hash<double>()(option.strike_price);
+            auto combine = [&hash](std::size_t value) {
+                hash ^= value + 0x9E3779B97F4A7C15ULL + (hash << 6U) + (hash >> 2U);
+            };
+            combine(std::hash<double>()(option.time_to_expiry));
+            combine(static_cast<std::size_t>(option.is_call));
+            combine(static_cast<std::size_t>(option.model));
+            combine(static_cast<std::size_t>(option.exercise));
+            return hash;
+        }
+
+        bool DeltaFilter::ContractEqual::operator()(const io::OptionData& a,
+                                                    const io::OptionData& b) const {
+            return a.is_call == b.is_call && a.strike_price == b.strike_price &&
+                   a.time_to_expiry == b.time_to_expiry && a.model == b.model &&
+                   a.exercise == b.exercise;
+        }
+
+        DeltaFilter::DeltaFilter(DeltaConfig config, const io::AsyncIoOptions& io_options)
+            : config_(std::move(config)), text_baseline_(config_.baseline_format != "binary") {
+            std::unique_ptr<io::OptionReader> reader = io::make_option_reader(
+                config_.baseline_format, config_.baseline_file, io::CsvColumnMap(), io_options);
+            io::OptionData option;
+            while (reader->next(option)) {
+                if (config_.key == DeltaKey::CONTRACT) {
+                    // A repeated contract keeps its first row
+                    contracts_.emplace(option, previous_.size());
+                }
+                previous_.push_back({option, false});
+            }
+
+            if (!config_.change_log_file.empty()) {
+                log_ = std::make_unique<io::AsyncFileWriter>(config_.change_log_file, io_options);
+                log_buffer_ =
+                    "Row,Change,Type,Strike,Time,Volatility,PreviousVolatility,Price,"
+                    "PreviousPrice\n";
+            }
+        }
+
+        DeltaFilter::~DeltaFilter() = default;
+
+        io::OptionData DeltaFilter::as_written(const io::OptionData& option) const {
+            if (!text_baseline_) {
+                return option;
+            }
+            io::OptionData rounded = option;
+            rounded.strike_price = round_as_text(option.strike_price);
+            rounded.time_to_expiry = round_as_text(option.time_to_expiry);
+            rounded.option_price = round_as_text(option.option_price);
+            rounded.volatility = round_as_text(option.volatility);
+            return rounded;
+        }
+
+        bool DeltaFilter::publish(const io::OptionData& result) {
+            io::OptionData current = as_written(result);
+            Previous* previous = nullptr;
+            if (config_.key == DeltaKey::ROW) {
+                if (position_ < previous_.size()) {
+                    previous = &previous_[position_];
+                }
+            } else {
+                auto found = contracts_.find(current);
+                if (found != contracts_.end()) {
+                    previous = &previous_[found->second];
+                }
+            }
+
+            bool publish = true;
+            if (previous == nullptr || previous->matched) {
+                ++stats_.added;
+                log("added", &current, nullptr);
+            } else {
+                previous->matched = true;
+                const io::OptionData& before = previous->option;
+                if (!ContractEqual()(current, before) ||
+                    moved(current.volatility, before.volatility, config_.volatility_epsilon) ||
+                    moved(current.option_price, before.option_price, config_.price_epsilon)) {
+                    ++stats_.changed;
+                    log("changed", &current, &before);
+                } else {
+                    ++stats_.unchanged;
+                    publish = false;
+                }
+            }
+            ++position_;
+            return publish;
+        }
+
+        void DeltaFilter::finish() {
+            for (const Previous& previous : previous_) {
+                if (!previous.matched) {
+                    ++stats_.removed;
+                    log("removed", nullptr, &previous.option);
+                }
+            }
+            if (log_) {
+                log_->write(log_buffer_);
+                log_buffer_.clear();
+                log_->close();
+            }
+        }
+
+        void DeltaFilter::log(const char* change, const io::OptionData* current,
+                              const io::OptionData* previous) {
+            if (!log_) {
+                return;
+            }
+            const io::OptionData& contract = current != nullptr ? *current : *previous;
+            if (current != nullptr) {
+                log_buffer_ += std::to_string(position_);
+            }
+            log_buffer_ += ',';
+            log_buffer_ += change;
+            log_buffer_ += contract.is_call ? ",Call," : ",Put,";
+            io::append_number(log_buffer_, contract.strike_price);
+            log_buffer_ += ',';
+            io::append_number(log_buffer_, contract.time_to_expiry);
+            for (const auto* option : {current, previous}) {
+                log_buffer_ += ',';
+                if (option != nullptr) {
+                    io::append_number(log_buffer_, option->volatility);
+                }
+            }
+            for (const auto* option : {current, previous}) {
+                log_buffer_ += ',';
+                if (option != nullptr) {
+                    io::append_number(log_buffer_, option->option_price);
+                }
+            }
+            log_buffer_ += '\n';
+
+            if (log_buffer_.size() >= kLogChunkSize) {
+                log_->write(log_buffer_);
+                log_buffer_.clear();
+            }
+        }
+
+    }  // namespace engine
+}  // namespace iv_calculator
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "src/io/async_io.h"
+#include "src/io/file_io.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace iv_calculator {
+    namespace engine {
+
+        /**
+         * @brief How a result is matched with its previous value
+         */
+        enum class DeltaKey : std::uint8_t {
+            ROW,      // Position in the output
+            CONTRACT  // Type, strike, expiry, exercise style and model
+        };
+
+        /**
+         * @brief Parse a delta key name ("row" or "contract")
+         *
+         * @param name Key name
+         * @return DeltaKey Parsed key
+         * @throws std::invalid_argument If the name is not a delta key
+         */
+        DeltaKey parse_delta_key(const std::string& name);
+
+        /**
+         * @brief Settings of delta output
+         */
+        struct DeltaConfig {
+            std::string baseline_file;             // Previous full output to compare with
+            std::string baseline_format = "csv";   // "csv", "json" or "binary"
+            DeltaKey key = DeltaKey::ROW;
+            double volatility_epsilon = 1e-4;  // Smallest volatility move that is published
+            double price_epsilon = 1e-4;       // Smallest price move that is published
+            std::string change_log_file;       // Empty for no change log
+        };
+
+        /**
+         * @brief Counters of a delta run
+         */
+        struct DeltaStats {
+            std::size_t added = 0;      // Results without a previous value
+            std::size_t changed = 0;    // Results that moved by more than an epsilon
+            std::size_t unchanged = 0;  // Results left out of the output
+            std::size_t removed = 0;    // Previous results without a new value
+        };
+
+        /**
+         * @brief Filter that passes only results that differ from a previous snapshot
+         *
+         * The baseline is loaded up front. New and previous values are compared as the output
+         * format would write them, so a text baseline matches results that round to the same
+         * text. The optional change log is a
+         * CSV with one line per added, changed or removed result:
+         * Row,Change,Type,Strike,Time,Volatility,PreviousVolatility,Price,PreviousPrice, where
+         * Row is the position among all results (empty for removed ones).
+         */
+        class DeltaFilter {
+        public:
+            /**
+             * @brief Load the baseline and create the change log
+             *
+             * @param config Baseline, key and thresholds
+             * @param io_options File I/O backend of the baseline and the change log
+             * @throws std::runtime_error If the baseline cannot be read or the change log
+             * cannot be created
+             * @throws std::invalid_argument If the baseline format is not supported
+             */
+            DeltaFilter(DeltaConfig config, const io::AsyncIoOptions& io_options);
+            ~DeltaFilter();
+
+            DeltaFilter(const DeltaFilter&) = delete;
+            DeltaFilter& operator=(const DeltaFilter&) = delete;
+            DeltaFilter(DeltaFilter&&) = delete;
+            DeltaFilter& operator=(DeltaFilter&&) = delete;
+
+            /**
+             * @brief Compare the next result, in output order, with its previous value
+             *
+             * @param result New result
+             * @return bool True if the result is to be published
+             */
+            bool publish(const io::OptionData& result);
+
+            /**
+             * @brief Log previous results that have no new value and close the change log
+             */
+            void finish();
+
+            /**
+             * @brief Counters so far
+             */
+            [[nodiscard]] const DeltaStats& stats() const { return stats_; }
+
+        private:
+            struct Previous {
+                io::OptionData option;
+                bool matched = false;  // Paired with a new result
+            };
+
+            struct ContractHash {
+                std::size_t operator()(const io::OptionData& option) const;
+            };
+            struct ContractEqual {
+                bool operator()(const io::OptionData& a, const io::OptionData& b) const;
+            };
+
+            [[nodiscard]] io::OptionData as_written(const io::OptionData& option) const;
+            void log(const char* change, const io::OptionData* current,
+                     const io::OptionData* previous);
+
+            DeltaConfig config_;
+            bool text_baseline_;
+            std::vector<Previous> previous_;  // Baseline in file order
+            std::unordered_map<io::OptionData, std::size_t, ContractHash, ContractEqual>
+                contracts_;  // Baseline index by contract
+            std::unique_ptr<io::AsyncFileWriter> log_;
+            std::string log_buffer_;
+            std::size_t position_ = 0;
+            DeltaStats stats_;
+        };
+
+    }  // namespace engine
+}  // namespace iv_calculator
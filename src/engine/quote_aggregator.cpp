@@ -0,0 +1,207 @@
+#include "quote_aggregator.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace iv_calculator {
+    namespace engine {
+
+        namespace {
+            // Rows folded by one thread at minimum, so small inputs stay on one thread
+            constexpr std::size_t kMinRowsPerThread = 1 << 14;
+
+            // Contracts a table is first sized for; it doubles from there
+            constexpr std::size_t kInitialContracts = 1 << 12;
+
+            std::uint64_t double_bits(double value) {
+                value = value == 0.0 ? 0.0 : value;  // -0 and 0 are the same strike
+                std::uint64_t bits = 0;
+                std::memcpy(&bits, &value, sizeof(bits));
+                return bits;
+            }
+
+            // Finalizer of splitmix64: every input bit affects every output bit
+            std::uint64_t mix(std::uint64_t x) {
+                x = (x ^ (x >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+                x = (x ^ (x >> 27U)) * 0x94D049BB133111EBULL;
+                return x ^ (x >> 31U);
+            }
+
+            // The spot only stands in for the underlying of rows without a symbol
+            bool has_symbol(const io::OptionData& option) {
+                return option.underlying != 0 || option.contract != 0;
+            }
+
+            // An expiry date stays the same while the time to it shrinks between snapshots
+            double expiry_key(const io::OptionData& option) {
+                return option.expiry_date != 0 ? option.expiry_date : option.time_to_expiry;
+            }
+
+            // An interned OCC contract ID already covers the strike, so it replaces it
+            std::uint64_t contract_hash(const io::OptionData& option) {
+                std::uint64_t hash = mix(option.contract != 0 ? option.contract
+                                                              : double_bits(option.strike_price));
+                hash = mix(hash ^ double_bits(expiry_key(option)));
+                if (!has_symbol(option)) {
+                    hash = mix(hash ^ double_bits(option.asset_price));
+                }
+                return mix(hash ^ (static_cast<std::uint64_t>(option.is_call) |
+                                   static_cast<std::uint64_t>(option.model) << 1U |
+                                   static_cast<std::uint64_t>(option.exercise) << 4U |
+                                   static_cast<std::uint64_t>(option.underlying) << 8U));
+            }
+
+            bool same_contract(const io::OptionData& a, const io::OptionData& b) {
+                return a.contract == b.contract && a.underlying == b.underlying &&
+                       a.strike_price == b.strike_price && expiry_key(a) == expiry_key(b) &&
+                       (has_symbol(a) || a.asset_price == b.asset_price) &&
+                       a.is_call == b.is_call && a.model == b.model && a.exercise == b.exercise;
+            }
+
+            // Fold a later row, or a later range's aggregate, into a contract's row
+            void fold(io::OptionData& row, const io::OptionData& later,
+                      QuoteAggregation aggregation) {
+                if (aggregation == QuoteAggregation::BEST) {
+                    double bid = std::max(row.bid_price, later.bid_price);
+                    double ask = row.ask_price > 0 && later.ask_price > 0
+                                     ? std::min(row.ask_price, later.ask_price)
+                                     : std::max(row.ask_price, later.ask_price);
+                    row = later;
+                    row.bid_price = bid;
+                    row.ask_price = ask;
+                } else {
+                    row = later;
+                }
+            }
+
+            // One row per contract in first-seen order, indexed by a linear-probing table of
+            // hashes and row numbers that stays at most half full
+            class ContractTable {
+            public:
+                explicit ContractTable(std::size_t expected) {
+                    std::size_t capacity = 16;
+                    while (capacity < 2 * expected) {
+                        capacity *= 2;
+                    }
+                    slots_.assign(capacity, Slot());
+                    rows_.reserve(expected);
+                    hashes_.reserve(expected);
+                }
+
+                void add(const io::OptionData& quote, std::uint64_t hash,
+                         QuoteAggregation aggregation) {
+                    std::size_t mask = slots_.size() - 1;
+                    for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+                        Slot& slot = slots_[i];
+                        if (slot.row == kEmpty) {
+                            slot = {hash, rows_.size()};
+                            rows_.push_back(quote);
+                            hashes_.push_back(hash);
+                            if (2 * rows_.size() > slots_.size()) {
+                                grow();
+                            }
+                            return;
+                        }
+                        if (slot.hash == hash && same_contract(rows_[slot.row], quote)) {
+                            fold(rows_[slot.row], quote, aggregation);
+                            return;
+                        }
+                    }
+                }
+
+                // Fold every contract of a table built from later rows
+                void merge(const ContractTable& later, QuoteAggregation aggregation) {
+                    for (std::size_t i = 0; i < later.rows_.size(); ++i) {
+                        add(later.rows_[i], later.hashes_[i], aggregation);
+                    }
+                }
+
+                std::vector<io::OptionData> release() { return std::move(rows_); }
+
+            private:
+                static constexpr std::size_t kEmpty = std::numeric_limits<std::size_t>::max();
+
+                struct Slot {
+                    std::uint64_t hash = 0;
+                    std::size_t row = kEmpty;
+                };
+
+                void grow() {
+                    std::vector<Slot> slots(2 * slots_.size());
+                    std::size_t mask = slots.size() - 1;
+                    for (std::size_t row = 0; row < rows_.size(); ++row) {
+                        std::size_t i = hashes_[row] & mask;
+                        while (slots[i].row != kEmpty) {
+                            i = (i + 1) & mask;
+                        }
+                        slots[i] = {hashes_[row], row};
+                    }
+                    slots_.swap(slots);
+                }
+
+                std::vector<Slot> slots_;
+                std::vector<io::OptionData> rows_;
+                std::vector<std::uint64_t> hashes_;  // Hash of each row, for merges and growth
+            };
+        }  // namespace
+
+        QuoteAggregation parse_quote_aggregation(const std::string& name) {
+            if (name == "none") {
+                return QuoteAggregation::NONE;
+            }
+            if (name == "bbo") {
+                return QuoteAggregation::BEST;
+            }
+            if (name == "last") {
+                return QuoteAggregation::LAST;
+            }
+            throw std::invalid_argument("Unknown quote aggregation '" + name + "'");
+        }
+
+        std::vector<io::OptionData> aggregate_quotes(const std::vector<io::OptionData>& quotes,
+                                                     QuoteAggregation aggregation,
+                                                     unsigned threads) {
+            if (aggregation == QuoteAggregation::NONE) {
+                return quotes;
+            }
+
+            threads = threads != 0 ? threads : std::thread::hardware_concurrency();
+            std::size_t parts = std::min<std::size_t>(std::max(threads, 1U),
+                                                      quotes.size() / kMinRowsPerThread + 1);
+            std::size_t per_part = (quotes.size() + parts - 1) / parts;
+
+            // Each range is folded on its own, so tables are never shared while written
+            std::vector<ContractTable> tables;
+            tables.reserve(parts);
+            for (std::size_t p = 0; p < parts; ++p) {
+                tables.emplace_back(std::min<std::size_t>(per_part, kInitialContracts));
+            }
+            auto fold_range = [&](std::size_t p) {
+                std::size_t begin = std::min(p * per_part, quotes.size());
+                std::size_t end = std::min(begin + per_part, quotes.size());
+                for (std::size_t i = begin; i < end; ++i) {
+                    tables[p].add(quotes[i], contract_hash(quotes[i]), aggregation);
+                }
+            };
+            std::vector<std::thread> workers;
+            for (std::size_t p = 1; p < parts; ++p) {
+                workers.emplace_back(fold_range, p);
+            }
+            fold_range(0);
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+
+            // Later ranges fold into earlier ones, so "last" keeps its input meaning
+            for (std::size_t p = 1; p < parts; ++p) {
+                tables[0].merge(tables[p], aggregation);
+            }
+            return tables[0].release();
+        }
+
+    }  // namespace engine
+}  // namespace iv_calculator
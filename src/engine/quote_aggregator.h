@@ -0,0 +1,58 @@
+#pragma once
+
+#include "src/io/file_io.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace iv_calculator {
+    namespace engine {
+
+        /**
+         * @brief How repeated quotes of one contract are combined
+         */
+        enum class QuoteAggregation : std::uint8_t {
+            NONE,  // Every row is solved
+            BEST,  // Highest bid and lowest ask over all rows, other fields from the last row
+            LAST   // Last row only
+        };
+
+        /**
+         * @brief Parse a quote aggregation name ("none", "bbo" or "last")
+         *
+         * @param name Aggregation name
+         * @return QuoteAggregation Parsed aggregation
+         * @throws std::invalid_argument If the name is not a quote aggregation
+         */
+        QuoteAggregation parse_quote_aggregation(const std::string& name);
+
+        /**
+         * @brief Combine the quotes of each contract into one row
+         *
+         * A contract is identified by its underlying symbol, expiry, strike, type, exercise
+         * style and model, so quotes taken at different spots are combined. Rows without a
+         * symbol have no other trace of their underlying, so for them the asset price stands
+         * in for it within one snapshot. The expiry is the expiry date when the rows carry
+         * one and the time to expiry otherwise. Rows with OCC symbols are hashed by their
+         * interned contract ID. Rows are split into one contiguous range per thread, each
+         * thread folds its range into its own open-addressing table, and the tables are merged
+         * in range order, so the result is the same for any thread count. Contracts appear in
+         * the order of their first row.
+         *
+         * With BEST, the bid is the highest positive bid and the ask the lowest positive ask
+         * of the contract's rows; zero means no such quote. All other fields are those of the
+         * contract's last row. With LAST the last row is kept as it is.
+         *
+         * @param quotes Rows in input order
+         * @param aggregation BEST or LAST; NONE returns the rows unchanged
+         * @param threads Worker threads, 0 for one per hardware thread
+         * @return std::vector<io::OptionData> One row per contract
+         */
+        std::vector<io::OptionData> aggregate_quotes(const std::vector<io::OptionData>& quotes,
+                                                     QuoteAggregation aggregation,
+                                                     unsigned threads = 0);
+
+    }  // namespace engine
+}  // namespace iv_calculator
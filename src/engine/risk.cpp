@@ -0,0 +1,319 @@
+#include "risk.h"
+
+#include "src/io/option_writer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace iv_calculator {
+    namespace engine {
+
+        namespace {
+            constexpr std::array<const char*, kExpiryBucketCount> kExpiryBucketNames = {
+                "1W", "1M", "3M", "6M", "1Y", "2Y", "2Y+"};
+
+            // Slot of a group in an index of a power-of-two size
+            std::size_t group_slot(std::uint32_t underlying, double asset_price,
+                                   std::size_t bucket, std::size_t size) {
+                asset_price = asset_price == 0.0 ? 0.0 : asset_price;  // -0 is 0
+                std::uint64_t bits = 0;
+                std::memcpy(&bits, &asset_price, sizeof(bits));
+                // Finalizer of splitmix64, so prices with zero low bits still spread
+                std::uint64_t hash = bits ^ (bucket * 0x9E3779B97F4A7C15ULL) ^
+                                     (static_cast<std::uint64_t>(underlying) << 32U);
+                hash = (hash ^ (hash >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+                hash = (hash ^ (hash >> 27U)) * 0x94D049BB133111EBULL;
+                return static_cast<std::size_t>(hash ^ (hash >> 31U)) & (size - 1);
+            }
+
+            void write_csv_rollup(std::ofstream& file, const std::vector<RiskTotals>& totals,
+                                  const io::SymbolPool& symbols) {
+                file << "Underlying,Expiry,Positions,Quantity,Delta,Gamma,Vega,Theta,Rho\n";
+                std::string line;
+                for (const RiskTotals& group : totals) {
+                    line.clear();
+                    if (group.underlying != 0) {
+                        line += symbols.name(group.underlying);
+                    } else {
+                        io::append_number(line, group.asset_price);
+                    }
+                    line += ',';
+                    line += expiry_bucket_name(group.expiry_bucket);
+                    line += ',';
+                    line += std::to_string(group.positions);
+                    for (const CompensatedSum* sum : {&group.quantity, &group.delta, &group.gamma,
+                                                      &group.vega, &group.theta, &group.rho}) {
+                        line += ',';
+                        io::append_number(line, sum->value());
+                    }
+                    line += '\n';
+                    file << line;
+                }
+            }
+
+            void write_json_rollup(std::ofstream& file, const std::vector<RiskTotals>& totals,
+                                   const io::SymbolPool& symbols) {
+                file << "[\n";
+                std::string line;
+                for (std::size_t i = 0; i < totals.size(); ++i) {
+                    const RiskTotals& group = totals[i];
+                    line = "  {\"underlying\": ";
+                    if (group.underlying != 0) {
+                        line += '"';
+                        line += symbols.name(group.underlying);
+                        line += '"';
+                    } else {
+                        io::append_number(line, group.asset_price);
+                    }
+                    line += ", \"expiry\": \"";
+                    line += expiry_bucket_name(group.expiry_bucket);
+                    line += "\", \"positions\": ";
+                    line += std::to_string(group.positions);
+                    const std::array<std::pair<const char*, const CompensatedSum*>, 6> fields = {{
+                        {"quantity", &group.quantity},
+                        {"delta", &group.delta},
+                        {"gamma", &group.gamma},
+                        {"vega", &group.vega},
+                        {"theta", &group.theta},
+                        {"rho", &group.rho},
+                    }};
+                    for (const auto& field : fields) {
+                        line += ", \"";
+                        line += field.first;
+                        line += "\": ";
+                        io::append_number(line, field.second->value());
+                    }
+                    line += i + 1 < totals.size() ? "},\n" : "}\n";
+                    file << line;
+                }
+                file << "]\n";
+            }
+        }  // namespace
+
+        std::size_t expiry_bucket(double time_to_expiry) {
+            return static_cast<std::size_t>(
+                std::lower_bound(kExpiryBucketEdges.begin(), kExpiryBucketEdges.end(),
+                                 time_to_expiry) -
+                kExpiryBucketEdges.begin());
+        }
+
+        const char* expiry_bucket_name(std::size_t bucket) {
+            return kExpiryBucketNames.at(bucket);
+        }
+
+        void CompensatedSum::add(double value) {
+            double sum = sum_ + value;
+            // The smaller operand lost the low-order bits of the addition
+            if (std::abs(sum_) >= std::abs(value)) {
+                compensation_ += (sum_ - sum) + value;
+            } else {
+                compensation_ += (value - sum) + sum_;
+            }
+            sum_ = sum;
+        }
+
+        void CompensatedSum::add(const CompensatedSum& other) {
+            add(other.sum_);
+            compensation_ += other.compensation_;
+        }
+
+        RiskTotals& RiskRollup::group(std::uint32_t underlying, double asset_price,
+                                      std::size_t bucket) {
+            // Positions usually arrive grouped, so the previous group is tried first
+            if (last_ < groups_.size() && groups_[last_].underlying == underlying &&
+                groups_[last_].asset_price == asset_price &&
+                groups_[last_].expiry_bucket == bucket) {
+                return groups_[last_];
+            }
+            if (2 * (groups_.size() + 1) > index_.size()) {
+                index_.assign(std::max<std::size_t>(16, 2 * index_.size()), kNoGroup);
+                for (std::size_t g = 0; g < groups_.size(); ++g) {
+                    std::size_t slot =
+                        group_slot(groups_[g].underlying, groups_[g].asset_price,
+                                   groups_[g].expiry_bucket, index_.size());
+                    while (index_[slot] != kNoGroup) {
+                        slot = (slot + 1) & (index_.size() - 1);
+                    }
+                    index_[slot] = g;
+                }
+            }
+            std::size_t slot = group_slot(underlying, asset_price, bucket, index_.size());
+            while (index_[slot] != kNoGroup) {
+                const RiskTotals& found = groups_[index_[slot]];
+                if (found.underlying == underlying && found.asset_price == asset_price &&
+                    found.expiry_bucket == bucket) {
+                    last_ = index_[slot];
+                    return groups_[last_];
+                }
+                slot = (slot + 1) & (index_.size() - 1);
+            }
+            index_[slot] = groups_.size();
+            last_ = groups_.size();
+            RiskTotals totals;
+            totals.underlying = underlying;
+            totals.asset_price = asset_price;
+            totals.expiry_bucket = bucket;
+            groups_.push_back(totals);
+            return groups_.back();
+        }
+
+        void RiskRollup::add(const io::OptionData& position, const core::Greeks& greeks) {
+            // The price identifies the underlying of a row without a symbol only
+            RiskTotals& totals =
+                group(position.underlying,
+                      position.underlying != 0 ? 0.0 : position.asset_price,
+                      expiry_bucket(position.time_to_expiry));
+            double quantity = position.quantity;
+            ++totals.positions;
+            totals.quantity.add(quantity);
+            totals.delta.add(quantity * greeks.delta);
+            totals.gamma.add(quantity * greeks.gamma);
+            totals.vega.add(quantity * greeks.vega);
+            totals.theta.add(quantity * greeks.theta);
+            totals.rho.add(quantity * greeks.rho);
+        }
+
+        void RiskRollup::merge(const RiskRollup& other) {
+            for (const RiskTotals& from : other.groups_) {
+                RiskTotals& totals = group(from.underlying, from.asset_price, from.expiry_bucket);
+                totals.positions += from.positions;
+                totals.quantity.add(from.quantity);
+                totals.delta.add(from.delta);
+                totals.gamma.add(from.gamma);
+                totals.vega.add(from.vega);
+                totals.theta.add(from.theta);
+                totals.rho.add(from.rho);
+            }
+        }
+
+        std::vector<RiskTotals> RiskRollup::totals() const {
+            std::vector<RiskTotals> sorted = groups_;
+            std::sort(sorted.begin(), sorted.end(), [](const RiskTotals& a, const RiskTotals& b) {
+                if (a.underlying != b.underlying) {
+                    return a.underlying < b.underlying;
+                }
+                return a.asset_price != b.asset_price ? a.asset_price < b.asset_price
+                                                      : a.expiry_bucket < b.expiry_bucket;
+            });
+            return sorted;
+        }
+
+        std::size_t RiskRollup::positions() const {
+            std::size_t count = 0;
+            for (const RiskTotals& totals : groups_) {
+                count += totals.positions;
+            }
+            return count;
+        }
+
+        void write_risk_rollup(const std::string& filepath, const std::string& format,
+                               const std::vector<RiskTotals>& totals,
+                               const io::SymbolPool& symbols) {
+            if (format != "csv" && format != "json") {
+                throw std::invalid_argument("Unsupported risk rollup format '" + format + "'");
+            }
+            std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                throw std::runtime_error("Cannot create risk rollup " + filepath);
+            }
+            if (format == "csv") {
+                write_csv_rollup(file, totals, symbols);
+            } else {
+                write_json_rollup(file, totals, symbols);
+            }
+            file.close();
+            if (!file) {
+                throw std::runtime_error("Cannot write risk rollup " + filepath);
+            }
+        }
+
+        core::ScenarioGrid parse_scenario_grid(const std::string& spec) {
+            core::ScenarioGrid grid;
+            bool spot = false;
+            bool vol = false;
+            std::size_t pos = 0;
+            while (pos < spec.size()) {
+                std::size_t comma = std::min(spec.find(',', pos), spec.size());
+                std::string entry = spec.substr(pos, comma - pos);
+                pos = comma + 1;
+
+                std::size_t equals = entry.find('=');
+                std::size_t colon = entry.find(':');
+                std::size_t second =
+                    colon == std::string::npos ? colon : entry.find(':', colon + 1);
+                if (equals == std::string::npos || second == std::string::npos) {
+                    throw std::invalid_argument("Shock axis must be name=first:last:count: " +
+                                                entry);
+                }
+                std::string axis = entry.substr(0, equals);
+                std::vector<double> shocks;
+                try {
+                    std::size_t used = 0;
+                    std::string count_text = entry.substr(second + 1);
+                    long long count = std::stoll(count_text, &used);
+                    if (used != count_text.size() || count <= 0) {
+                        throw std::invalid_argument(count_text);
+                    }
+                    shocks = core::scenario_shocks(
+                        std::stod(entry.substr(equals + 1, colon - equals - 1)),
+                        std::stod(entry.substr(colon + 1, second - colon - 1)),
+                        static_cast<std::size_t>(count));
+                } catch (const std::exception&) {
+                    throw std::invalid_argument("Invalid shock axis: " + entry);
+                }
+
+                bool& seen = axis == "spot" ? spot : vol;
+                if ((axis != "spot" && axis != "vol") || seen) {
+                    throw std::invalid_argument("Unknown or repeated shock axis: " + entry);
+                }
+                seen = true;
+                (axis == "spot" ? grid.spot_shocks : grid.volatility_shocks) = shocks;
+            }
+            if (!spot) {
+                grid.spot_shocks = {0.0};
+            }
+            if (!vol) {
+                grid.volatility_shocks = {0.0};
+            }
+            if (std::any_of(grid.spot_shocks.begin(), grid.spot_shocks.end(),
+                            [](double shock) { return !(shock > -1.0); })) {
+                throw std::invalid_argument("Spot shocks must be above -1");
+            }
+            return grid;
+        }
+
+        void write_scenario_matrix(const std::string& filepath, const core::ScenarioGrid& grid,
+                                   const core::ScenarioMatrix& matrix) {
+            std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                throw std::runtime_error("Cannot create scenario matrix " + filepath);
+            }
+            std::string line = "SpotShock";
+            for (double shock : grid.volatility_shocks) {
+                line += ',';
+                io::append_number(line, shock);
+            }
+            line += '\n';
+            file << line;
+            for (std::size_t i = 0; i < matrix.spot_count; ++i) {
+                line.clear();
+                io::append_number(line, grid.spot_shocks[i]);
+                for (std::size_t j = 0; j < matrix.volatility_count; ++j) {
+                    line += ',';
+                    io::append_number(line, matrix.pnl(i, j));
+                }
+                line += '\n';
+                file << line;
+            }
+            file.close();
+            if (!file) {
+                throw std::runtime_error("Cannot write scenario matrix " + filepath);
+            }
+        }
+
+    }  // namespace engine
+}  // namespace iv_calculator
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "src/core/greeks.h"
+#include "src/core/scenario.h"
+#include "src/io/file_io.h"
+#include "src/io/symbol_pool.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace iv_calculator {
+    namespace engine {
+
+        /// Upper edges in years of the expiry buckets; the last bucket is open
+        constexpr std::array<double, 6> kExpiryBucketEdges = {7.0 / 365.0, 1.0 / 12.0, 0.25,
+                                                              0.5,         1.0,         2.0};
+
+        /// Number of expiry buckets
+        constexpr std::size_t kExpiryBucketCount = kExpiryBucketEdges.size() + 1;
+
+        /**
+         * @brief Expiry bucket of a time to expiry
+         *
+         * @param time_to_expiry Time to expiration in years
+         * @return std::size_t First bucket whose edge is not below the expiry
+         */
+        std::size_t expiry_bucket(double time_to_expiry);
+
+        /**
+         * @brief Label of an expiry bucket ("1W", "1M", "3M", "6M", "1Y", "2Y" or "2Y+")
+         */
+        const char* expiry_bucket_name(std::size_t bucket);
+
+        /**
+         * @brief Sum with Neumaier's compensation
+         *
+         * The rounding error of each addition is carried separately, so the error of the
+         * total does not grow with the number of terms, and partial sums merged in any split
+         * stay within a few roundings of the exact total.
+         */
+        class CompensatedSum {
+        public:
+            void add(double value);
+            void add(const CompensatedSum& other);
+
+            [[nodiscard]] double value() const { return sum_ + compensation_; }
+
+        private:
+            double sum_ = 0.0;
+            double compensation_ = 0.0;
+        };
+
+        /**
+         * @brief Position-weighted sensitivities of one underlying and expiry bucket
+         *
+         * Rows with an underlying symbol are grouped by it; a row without one stands for an
+         * underlying identified by its asset price.
+         */
+        struct RiskTotals {
+            std::uint32_t underlying = 0;  // Symbol ID, 0 for rows without a symbol
+            double asset_price = 0;        // Asset price of a group without a symbol, else 0
+            std::size_t expiry_bucket = 0;
+            std::size_t positions = 0;  // Rows with a non-zero quantity
+            CompensatedSum quantity;    // Net quantity
+            CompensatedSum delta;
+            CompensatedSum gamma;
+            CompensatedSum vega;
+            CompensatedSum theta;
+            CompensatedSum rho;
+        };
+
+        /**
+         * @brief Partial sums of position-weighted sensitivities
+         *
+         * Each worker fills its own rollup; the engine merges them in a fixed order, so a run
+         * is reproducible for a given thread count and chunk size.
+         */
+        class RiskRollup {
+        public:
+            /**
+             * @brief Add quantity times each sensitivity of a position to its group
+             *
+             * @param position Row with a non-zero quantity
+             * @param greeks All sensitivities of one unit of the position
+             */
+            void add(const io::OptionData& position, const core::Greeks& greeks);
+
+            /**
+             * @brief Add the sums of another rollup
+             */
+            void merge(const RiskRollup& other);
+
+            /**
+             * @brief Groups ordered by symbol ID, groups without a symbol first by asset price,
+             * then by expiry bucket
+             */
+            [[nodiscard]] std::vector<RiskTotals> totals() const;
+
+            /**
+             * @brief Number of positions added
+             */
+            [[nodiscard]] std::size_t positions() const;
+
+        private:
+            RiskTotals& group(std::uint32_t underlying, double asset_price, std::size_t bucket);
+
+            // Linear-probing index into groups_, at most half full; kNoGroup marks free slots
+            static constexpr std::size_t kNoGroup = static_cast<std::size_t>(-1);
+            std::vector<std::size_t> index_;
+            std::vector<RiskTotals> groups_;
+            std::size_t last_ = 0;  // Group of the previous row, checked before the index
+        };
+
+        /**
+         * @brief Write a risk rollup as CSV or JSON
+         *
+         * CSV has the header Underlying,Expiry,Positions,Quantity,Delta,Gamma,Vega,Theta,Rho;
+         * JSON is an array of objects with the same fields in lower case. The underlying is
+         * the symbol name of a group with a symbol and the asset price of one without.
+         *
+         * @param filepath Path to the output file
+         * @param format "csv" or "json"
+         * @param totals Groups to write
+         * @param symbols Names of the groups' symbol IDs
+         * @throws std::invalid_argument If the format is not supported
+         * @throws std::runtime_error If the file cannot be written
+         */
+        void write_risk_rollup(const std::string& filepath, const std::string& format,
+                               const std::vector<RiskTotals>& totals,
+                               const io::SymbolPool& symbols);
+
+        /**
+         * @brief Settings of a scenario repricing of the positions
+         */
+        struct ScenarioConfig {
+            core::ScenarioGrid grid;
+            std::string output_file;  // P&L matrix, see write_scenario_matrix
+        };
+
+        /**
+         * @brief Parse a shock grid such as "spot=-0.2:0.2:21,vol=-0.1:0.1:21"
+         *
+         * Each axis is first:last:count, evenly spaced with both ends included. Spot shocks
+         * are relative moves and volatility shocks absolute ones; an axis left out has the
+         * single shock 0.
+         *
+         * @param spec Comma-separated axis=first:last:count entries
+         * @return core::ScenarioGrid Parsed grid
+         * @throws std::invalid_argument If the text is malformed, an axis is unknown or given
+         * twice, a count is zero or a spot shock is not above -1
+         */
+        core::ScenarioGrid parse_scenario_grid(const std::string& spec);
+
+        /**
+         * @brief Write the P&L of a scenario matrix as CSV
+         *
+         * The header is SpotShock followed by the volatility shocks; each line holds a spot
+         * shock and the P&L against the unshocked value for every volatility shock.
+         *
+         * @param filepath Path to the output file
+         * @param grid Grid the matrix was computed on
+         * @param matrix Book values
+         * @throws std::runtime_error If the file cannot be written
+         */
+        void write_scenario_matrix(const std::string& filepath, const core::ScenarioGrid& grid,
+                                   const core::ScenarioMatrix& matrix);
+
+    }  // namespace engine
+}  // namespace iv_calculator
@@ -0,0 +1,144 @@
+#include "shard.h"
+
+#include "src/io/csv_reader.h"
+#include "src/io/option_reader.h"
+#include "src/io/option_writer.h"
+
+#include <algorithm>
+#include <charconv>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+
+namespace iv_calculator {
+    namespace engine {
+
+        namespace {
+            // Records looked at per shard to decide whether the merged output needs a model
+            // column, matching the first chunk a batch run decides on
+            constexpr std::size_t kModelProbeRows = 1 << 16;
+
+            // Shard output with the records already looked at kept in front
+            struct ShardInput {
+                std::string filepath;
+                std::unique_ptr<io::OptionReader> reader;
+                std::vector<io::OptionData> head;
+                std::size_t head_position = 0;
+
+                bool next(io::OptionData& option) {
+                    if (head_position < head.size()) {
+                        option = head[head_position++];
+                        return true;
+                    }
+                    return reader->next(option);
+                }
+            };
+
+            bool parse_count(std::string_view text, std::size_t& value) {
+                const char* end = text.data() + text.size();
+                auto result = std::from_chars(text.data(), end, value);
+                return !text.empty() && result.ec == std::errc() && result.ptr == end;
+            }
+        }  // namespace
+
+        ShardSpec parse_shard_spec(const std::string& text) {
+            std::string_view spec(text);
+            std::size_t slash = spec.find('/');
+            ShardSpec shard;
+            if (slash == std::string_view::npos ||
+                !parse_count(spec.substr(0, slash), shard.index) ||
+                !parse_count(spec.substr(slash + 1), shard.count) || shard.count == 0 ||
+                shard.index >= shard.count) {
+                throw std::invalid_argument("Invalid shard '" + text +
+                                            "', expected i/N with 0 <= i < N");
+            }
+            return shard;
+        }
+
+        ShardMode parse_shard_mode(const std::string& name) {
+            if (name == "range") {
+                return ShardMode::RANGE;
+            }
+            if (name == "hash") {
+                return ShardMode::HASH;
+            }
+            throw std::invalid_argument("Unknown shard mode '" + name + "'");
+        }
+
+        // splitmix64 finalizer: consecutive ordinals land on unrelated shards
+        std::size_t hash_shard(std::uint64_t ordinal, std::size_t count) {
+            std::uint64_t z = ordinal + 0x9E3779B97F4A7C15ULL;
+            z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+            z ^= z >> 31U;
+            return static_cast<std::size_t>(z % count);
+        }
+
+        std::size_t merge_shards(const MergeConfig& config, std::ostream& out) {
+            if (config.input_files.empty()) {
+                throw std::invalid_argument("No shard outputs to merge");
+            }
+
+            std::vector<ShardInput> shards(config.input_files.size());
+            bool write_model = false;
+            for (std::size_t i = 0; i < shards.size(); ++i) {
+                ShardInput& shard = shards[i];
+                shard.filepath = config.input_files[i];
+                shard.reader = io::make_option_reader(config.input_format, shard.filepath,
+                                                      io::CsvColumnMap(), config.io_options);
+
+                const auto* csv = dynamic_cast<const io::CsvReader*>(shard.reader.get());
+                if (csv != nullptr && csv->schema().from_header &&
+                    std::count(csv->schema().columns.begin(), csv->schema().columns.end(),
+                               io::CsvField::MODEL) > 0) {
+                    write_model = true;
+                }
+                io::OptionData option;
+                while (shard.head.size() < kModelProbeRows && shard.reader->next(option)) {
+                    shard.head.push_back(option);
+                }
+                write_model = write_model ||
+                              std::any_of(shard.head.begin(), shard.head.end(),
+                                          [](const io::OptionData& option) {
+                                              return option.model !=
+                                                     core::PricingModel::BLACK_SCHOLES;
+                                          });
+            }
+
+            std::unique_ptr<io::OptionWriter> writer = io::make_option_writer(
+                config.output_format, config.output_file, write_model, config.io_options);
+            std::size_t records = 0;
+            io::OptionData option;
+            if (config.mode == ShardMode::RANGE) {
+                for (ShardInput& shard : shards) {
+                    while (shard.next(option)) {
+                        writer->write(option);
+                        ++records;
+                    }
+                }
+            } else {
+                // The first shard to run dry ends the input; every other shard must be
+                // exhausted at the same point
+                while (shards[hash_shard(records, shards.size())].next(option)) {
+                    writer->write(option);
+                    ++records;
+                }
+                for (ShardInput& shard : shards) {
+                    if (shard.next(option)) {
+                        throw std::runtime_error("Shard output " + shard.filepath +
+                                                 " does not belong to a " +
+                                                 std::to_string(shards.size()) +
+                                                 "-way hash partition");
+                    }
+                }
+            }
+            writer->close();
+
+            out << "Merged " << records << " records from " << shards.size() << " shards into "
+                << config.output_file << std::endl;
+            return records;
+        }
+
+    }  // namespace engine
+}  // namespace iv_calculator
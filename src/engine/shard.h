@@ -0,0 +1,88 @@
+#pragma once
+
+#include "src/io/async_io.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace iv_calculator {
+    namespace engine {
+
+        /**
+         * @brief How records are assigned to shards
+         */
+        enum class ShardMode : std::uint8_t {
+            RANGE,  // Contiguous parts: byte ranges of CSV input, record ranges otherwise
+            HASH    // Records spread by a hash of their ordinal in the input
+        };
+
+        /**
+         * @brief Part of the input processed by one process
+         */
+        struct ShardSpec {
+            std::size_t index = 0;  // Zero-based shard of this process
+            std::size_t count = 1;  // Total number of shards
+            ShardMode mode = ShardMode::RANGE;
+        };
+
+        /**
+         * @brief Parse a shard given as "i/N" with 0 <= i < N
+         *
+         * @param text Shard text
+         * @return ShardSpec Shard with the default (range) mode
+         * @throws std::invalid_argument If the text is malformed or i is out of range
+         */
+        ShardSpec parse_shard_spec(const std::string& text);
+
+        /**
+         * @brief Parse a shard mode name ("range" or "hash")
+         *
+         * @param name Mode name
+         * @return ShardMode Parsed mode
+         * @throws std::invalid_argument If the name is not a shard mode
+         */
+        ShardMode parse_shard_mode(const std::string& name);
+
+        /**
+         * @brief Shard owning a record in hash mode
+         *
+         * Depends only on the ordinal, so every process and the merge step agree on it.
+         *
+         * @param ordinal Zero-based position of the record in the input
+         * @param count Number of shards
+         * @return std::size_t Owning shard
+         */
+        std::size_t hash_shard(std::uint64_t ordinal, std::size_t count);
+
+        /**
+         * @brief Settings of a merge of shard outputs
+         */
+        struct MergeConfig {
+            std::vector<std::string> input_files;  // Shard outputs, ordered by shard index
+            std::string input_format = "csv";      // "csv", "json" or "binary"
+            std::string output_file;
+            std::string output_format = "csv";  // "csv", "json" or "binary"
+            ShardMode mode = ShardMode::RANGE;  // Mode the shards were run with
+            io::AsyncIoOptions io_options;      // CSV and binary file I/O backend
+        };
+
+        /**
+         * @brief Combine shard outputs into one result in the original input order
+         *
+         * Range shards are concatenated; hash shards are interleaved by replaying the hash
+         * partition. A model column is written when any shard output carries one.
+         *
+         * @param config Shard files and output settings
+         * @param out Stream receiving a summary line
+         * @return std::size_t Number of records written
+         * @throws std::invalid_argument If a format is unsupported or no shard is given
+         * @throws std::runtime_error If a file cannot be read or written, or hash shard outputs
+         * do not add up to one partition
+         */
+        std::size_t merge_shards(const MergeConfig& config, std::ostream& out);
+
+    }  // namespace engine
+}  // namespace iv_calculator
@@ -1,16 +1,20 @@
-#include "src/core/black_scholes.h"
-#include "src/io/file_io.h"
+#include "src/core/bachelier.h"
+#include "src/engine/batch_engine.h"
+#include "src/io/csv_reader.h"
+#include "src/io/output_schema.h"
 // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
 
 #include <fstream>
 #include <iomanip>
 #include <iostream>
-#include <limits>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <vector>
 
 using namespace iv_calculator::core;
+using iv_calculator::engine::model_price;
+using iv_calculator::engine::solve_model_implied_volatility;
 
 // Prints usage instructions
 void print_usage() {
@@ -26,11 +30,125 @@ void print_usage() {
     std::cout << "  --strike PRICE         Strike price of the option" << std::endl;
     std::cout << "  --time YEARS           Time to expiration in years" << std::endl;
     std::cout << "  --rate RATE            Risk-free interest rate (as decimal)" << std::endl;
+    std::cout << "  --model MODEL          Pricing model: black-scholes or bachelier (default: "
+                 "black-scholes, overrides per-row models)"
+              << std::endl;
+    std::cout << "  --iv-method METHOD     Black-Scholes implied volatility method: bisection, "
+                 "newton, brent, halley, householder or auto (default: bisection)"
+              << std::endl;
+    std::cout << "  --initial-guess GUESS  Newton-Raphson start: auto, corrado-miller, inflection "
+                 "or buckets (default: auto)"
+              << std::endl;
+    std::cout << "  --warm-start           Start each batch solve from the previous row of the "
+                 "same chain"
+              << std::endl;
+    std::cout << "  --convergence TEST     Stop solving on: default, price, relative, vol or vega "
+                 "(price error / vega)"
+              << std::endl;
+    std::cout << "  --tolerance T          Bound for a convergence test other than default "
+                 "(default: 1e-8)"
+              << std::endl;
+    std::cout << "  --pde-grid SPACE:TIME  Finite-difference steps of American batch rows "
+                 "(default: 200:200)"
+              << std::endl;
+    std::cout << "  --richardson           Extrapolate American batch rows from two grids"
+              << std::endl;
     std::cout << "  --input-file FILE      Process batch data from file" << std::endl;
-    std::cout << "  --input-format FORMAT  Input file format: csv or json (default: csv)"
+    std::cout << "  --input-format FORMAT  Input file format: csv, json or binary (default: csv)"
               << std::endl;
     std::cout << "  --output-file FILE     Write results to file" << std::endl;
-    std::cout << "  --output-format FORMAT Output file format: csv or json (default: csv)"
+    std::cout << "  --output-format FORMAT Output file format: csv, json or binary (default: csv)"
+              << std::endl;
+    std::cout << "  --csv-map MAP          Map CSV header names onto fields, e.g. "
+                 "asset=UnderlyingPrice,price=Mid"
+              << std::endl;
+    std::cout << "  --columns LIST         Output columns, e.g. vol,delta,vega,status; only "
+                 "what they need is computed"
+              << std::endl;
+    std::cout << "                         (type, asset, strike, time, rate, price, vol, model, "
+                 "delta, gamma, vega, theta, rho,"
+              << std::endl;
+    std::cout << "                         status, iterations, tolerance, bid, ask, bid_vol, "
+                 "mid_vol, ask_vol,"
+              << std::endl;
+    std::cout << "                         vol_spread); quote volatilities need Bid and Ask "
+                 "input columns"
+              << std::endl;
+    std::cout << "  --io-backend BACKEND   CSV file I/O backend: auto, io_uring or stream "
+                 "(default: auto)"
+              << std::endl;
+    std::cout << "  --direct-io            Bypass the page cache with O_DIRECT (io_uring only)"
+              << std::endl;
+    std::cout << "  --threads N            Worker threads for batch files (default: all cores)"
+              << std::endl;
+    std::cout << "  --quiet                Do not print a line per batch row" << std::endl;
+    std::cout << "  --shard I/N            Process only shard I of N of the input file"
+              << std::endl;
+    std::cout << "  --shard-mode MODE      Shard by contiguous range or by record hash: range or "
+                 "hash (default: range)"
+              << std::endl;
+    std::cout << "  --merge FILES          Merge comma-separated shard outputs, in shard order, "
+                 "into --output-file"
+              << std::endl;
+    std::cout << "  --checkpoint FILE      Record progress in FILE so an interrupted batch can "
+                 "be resumed"
+              << std::endl;
+    std::cout << "  --checkpoint-rows N    Rows between checkpoints (default: 1048576)"
+              << std::endl;
+    std::cout << "  --resume               Continue from the checkpoint (default: "
+                 "OUTPUT_FILE.checkpoint)"
+              << std::endl;
+    std::cout << "  --delta-baseline FILE  Write only results that moved since a previous output "
+                 "file"
+              << std::endl;
+    std::cout << "  --delta-format FORMAT  Baseline file format: csv, json or binary (default: "
+                 "csv)"
+              << std::endl;
+    std::cout << "  --delta-key KEY        Match results with the baseline by row or contract "
+                 "(default: row)"
+              << std::endl;
+    std::cout << "  --delta-epsilon E      Smallest published volatility move (default: 0.0001)"
+              << std::endl;
+    std::cout << "  --delta-price-epsilon E Smallest published price move (default: 0.0001)"
+              << std::endl;
+    std::cout << "  --change-log FILE      Write added, changed and removed results to a CSV "
+                 "change log"
+              << std::endl;
+    std::cout << "  --quotes MODE          Combine repeated quotes of a contract before solving: "
+                 "none, bbo or last"
+              << std::endl;
+    std::cout << "                         (default: none)" << std::endl;
+    std::cout << "  --risk-output FILE     Write Greeks weighted by the Quantity column, summed by "
+                 "underlying and expiry"
+              << std::endl;
+    std::cout << "  --risk-format FORMAT   Risk rollup file format: csv or json (default: csv)"
+              << std::endl;
+    std::cout << "  --valuation-date DATE  Valuation date or timestamp of rows with an Expiry "
+                 "column (YYYY-MM-DD[THH:MM[:SS]])"
+              << std::endl;
+    std::cout << "  --expiry-cutoff HH:MM  Time of day of expiries given as a date "
+                 "(default: 16:00)"
+              << std::endl;
+    std::cout << "  --day-count DC         Expiry date year fractions: act365f, act360, actact, "
+                 "30360 or bus252"
+              << std::endl;
+    std::cout << "                         (default: act365f)" << std::endl;
+    std::cout << "  --holidays FILE        Holiday dates, one YYYY-MM-DD per line, for bus252"
+              << std::endl;
+    std::cout << "  --curve FILE           Take rates from a yield curve of Time,Rate pillars "
+                 "(years, continuous)"
+              << std::endl;
+    std::cout << "  --curve-interpolation I Curve interpolation: loglinear or monotone-convex "
+                 "(default: loglinear)"
+              << std::endl;
+    std::cout << "  --dividends FILE       Escrowed discrete dividends of the Symbol column, "
+                 "as Symbol,ExDate,Amount lines"
+              << std::endl;
+    std::cout << "  --scenarios SPEC       Reprice positions on a shock grid, e.g. "
+                 "spot=-0.2:0.2:21,vol=-0.1:0.1:21"
+              << std::endl;
+    std::cout << "  --scenario-output FILE Write the scenario P&L matrix as CSV (required with "
+                 "--scenarios)"
               << std::endl;
     std::cout << "  --batch FILE           [Deprecated] Process batch data from CSV file (use "
                  "--input-file instead)"
@@ -45,9 +163,21 @@ void print_usage() {
         << std::endl;
     std::cout << "  iv_calculator --put --asset 100 --strike 100 --time 1 --rate 0.05 --price 5.57"
               << std::endl;
+    std::cout << "  iv_calculator --call --model bachelier --asset -0.25 --strike 0 --time 1 --rate "
+                 "0.05 --price 0.1"
+              << std::endl;
     std::cout << "  iv_calculator --input-file options.json --input-format json --output-file "
                  "results.json --output-format json"
               << std::endl;
+    std::cout << "  iv_calculator --input-file options.csv --shard 0/2 --output-file part0.bin "
+                 "--output-format binary --quiet"
+              << std::endl;
+    std::cout << "  iv_calculator --input-file options.csv --output-file delta.csv "
+                 "--delta-baseline results.csv --delta-key contract --change-log changes.csv"
+              << std::endl;
+    std::cout << "  iv_calculator --merge part0.bin,part1.bin --input-format binary "
+                 "--output-file results.csv"
+              << std::endl;
 }
 
 // Structure to hold command line arguments
@@ -64,6 +194,36 @@ struct Arguments {
     std::string input_file = "";
     std::string input_format = "csv";
     std::string output_format = "csv";
+    std::optional<PricingModel> model;  // Empty means per-row model (Black-Scholes by default)
+    iv_calculator::core::SolverOptions solver;  // Black-Scholes inversion settings
+    bool warm_start = false;
+    iv_calculator::core::PdeConfig pde;  // Grid of American batch rows
+    iv_calculator::io::CsvColumnMap csv_columns;
+    iv_calculator::io::OutputSchema columns;  // Empty means the input layout
+    iv_calculator::io::AsyncIoOptions io_options;
+    unsigned threads = 0;  // Zero means one per hardware thread
+    iv_calculator::engine::ShardSpec shard;
+    iv_calculator::engine::ShardMode shard_mode = iv_calculator::engine::ShardMode::RANGE;
+    std::vector<std::string> merge_files;  // Shard outputs to merge, in shard order
+    std::string checkpoint_file = "";
+    std::size_t checkpoint_rows = 1 << 20;
+    bool resume = false;
+    iv_calculator::engine::DeltaConfig delta;  // Delta output when baseline_file is set
+    iv_calculator::engine::QuoteAggregation aggregation =
+        iv_calculator::engine::QuoteAggregation::NONE;
+    std::string risk_file = "";
+    std::string risk_format = "csv";
+    std::optional<iv_calculator::engine::ScenarioConfig> scenarios;
+    iv_calculator::core::DayCount day_count = iv_calculator::core::DayCount::ACT_365_FIXED;
+    double valuation_time = 0;
+    double expiry_cutoff = 16.0 / 24.0;
+    std::string holiday_file = "";
+    std::string curve_file = "";
+    std::string dividend_file = "";
+    iv_calculator::core::CurveInterpolation curve_interpolation =
+        iv_calculator::core::CurveInterpolation::LOG_LINEAR;
+    std::string scenario_file = "";
+    bool quiet = false;
     bool help_requested = false;
     bool is_valid = true;
 };
@@ -130,6 +290,265 @@ Arguments parse_arguments(int argc, char** argv) {
                 args.is_valid = false;
                 return args;
             }
+        } else if (arg == "--model" && i + 1 < argc) {
+            try {
+                args.model = parse_pricing_model(argv[++i]);
+            } catch (...) {
+                std::cerr << "Error: Model must be 'black-scholes' or 'bachelier'" << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--iv-method" && i + 1 < argc) {
+            try {
+                args.solver.method =
+                    iv_calculator::core::parse_implied_volatility_method(argv[++i]);
+            } catch (...) {
+                std::cerr << "Error: Implied volatility method must be 'bisection', 'newton', "
+                             "'brent', 'halley', 'householder' or 'auto'"
+                          << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--initial-guess" && i + 1 < argc) {
+            try {
+                args.solver.guess = iv_calculator::core::parse_initial_guess(argv[++i]);
+            } catch (...) {
+                std::cerr << "Error: Initial guess must be 'auto', 'corrado-miller', 'inflection' "
+                             "or 'buckets'"
+                          << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--warm-start") {
+            args.warm_start = true;
+        } else if (arg == "--convergence" && i + 1 < argc) {
+            try {
+                args.solver.criterion =
+                    iv_calculator::core::parse_convergence_criterion(argv[++i]);
+            } catch (...) {
+                std::cerr << "Error: Convergence test must be 'default', 'price', 'relative', "
+                             "'vol' or 'vega'"
+                          << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--tolerance" && i + 1 < argc) {
+            try {
+                args.solver.tolerance = std::stod(argv[++i]);
+                if (!(args.solver.tolerance > 0)) {
+                    throw std::out_of_range("tolerance");
+                }
+            } catch (...) {
+                std::cerr << "Error: Tolerance must be a positive number" << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--pde-grid" && i + 1 < argc) {
+            try {
+                std::string grid = argv[++i];
+                std::size_t colon = grid.find(':');
+                if (colon == std::string::npos) {
+                    throw std::invalid_argument("grid");
+                }
+                args.pde.space_steps = std::stoi(grid.substr(0, colon));
+                args.pde.time_steps = std::stoi(grid.substr(colon + 1));
+                if (args.pde.space_steps < 3 || args.pde.time_steps < 1) {
+                    throw std::out_of_range("grid");
+                }
+            } catch (...) {
+                std::cerr << "Error: PDE grid must be SPACE:TIME steps, at least 3:1"
+                          << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--richardson") {
+            args.pde.richardson = true;
+        } else if (arg == "--csv-map" && i + 1 < argc) {
+            try {
+                args.csv_columns = iv_calculator::io::parse_csv_column_map(argv[++i]);
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--columns" && i + 1 < argc) {
+            try {
+                args.columns = iv_calculator::io::parse_output_schema(argv[++i]);
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--io-backend" && i + 1 < argc) {
+            try {
+                args.io_options.backend = iv_calculator::io::parse_io_backend(argv[++i]);
+            } catch (...) {
+                std::cerr << "Error: I/O backend must be 'auto', 'io_uring' or 'stream'"
+                          << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--direct-io") {
+            args.io_options.direct_io = true;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            try {
+                int threads = std::stoi(argv[++i]);
+                if (threads < 0) {
+                    throw std::out_of_range("threads");
+                }
+                args.threads = static_cast<unsigned>(threads);
+            } catch (...) {
+                std::cerr << "Error: Invalid thread count" << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--quiet") {
+            args.quiet = true;
+        } else if (arg == "--shard" && i + 1 < argc) {
+            try {
+                args.shard = iv_calculator::engine::parse_shard_spec(argv[++i]);
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--shard-mode" && i + 1 < argc) {
+            try {
+                args.shard_mode = iv_calculator::engine::parse_shard_mode(argv[++i]);
+            } catch (...) {
+                std::cerr << "Error: Shard mode must be 'range' or 'hash'" << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--checkpoint" && i + 1 < argc) {
+            args.checkpoint_file = argv[++i];
+        } else if (arg == "--checkpoint-rows" && i + 1 < argc) {
+            try {
+                long long rows = std::stoll(argv[++i]);
+                if (rows <= 0) {
+                    throw std::out_of_range("checkpoint rows");
+                }
+                args.checkpoint_rows = static_cast<std::size_t>(rows);
+            } catch (...) {
+                std::cerr << "Error: Invalid checkpoint row count" << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--resume") {
+            args.resume = true;
+        } else if (arg == "--delta-baseline" && i + 1 < argc) {
+            args.delta.baseline_file = argv[++i];
+        } else if (arg == "--delta-format" && i + 1 < argc) {
+            args.delta.baseline_format = argv[++i];
+            if (args.delta.baseline_format != "csv" && args.delta.baseline_format != "json" &&
+                args.delta.baseline_format != "binary") {
+                std::cerr << "Error: Delta format must be 'csv', 'json' or 'binary'" << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--delta-key" && i + 1 < argc) {
+            try {
+                args.delta.key = iv_calculator::engine::parse_delta_key(argv[++i]);
+            } catch (...) {
+                std::cerr << "Error: Delta key must be 'row' or 'contract'" << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if ((arg == "--delta-epsilon" || arg == "--delta-price-epsilon") && i + 1 < argc) {
+            try {
+                double epsilon = std::stod(argv[++i]);
+                if (!(epsilon >= 0)) {
+                    throw std::out_of_range("delta epsilon");
+                }
+                (arg == "--delta-epsilon" ? args.delta.volatility_epsilon
+                                          : args.delta.price_epsilon) = epsilon;
+            } catch (...) {
+                std::cerr << "Error: Invalid delta epsilon" << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--quotes" && i + 1 < argc) {
+            try {
+                args.aggregation = iv_calculator::engine::parse_quote_aggregation(argv[++i]);
+            } catch (...) {
+                std::cerr << "Error: Quote aggregation must be 'none', 'bbo' or 'last'"
+                          << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--risk-output" && i + 1 < argc) {
+            args.risk_file = argv[++i];
+        } else if (arg == "--risk-format" && i + 1 < argc) {
+            args.risk_format = argv[++i];
+            if (args.risk_format != "csv" && args.risk_format != "json") {
+                std::cerr << "Error: Risk rollup format must be 'csv' or 'json'" << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--valuation-date" && i + 1 < argc) {
+            try {
+                args.valuation_time = iv_calculator::core::parse_timestamp(argv[++i]);
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--expiry-cutoff" && i + 1 < argc) {
+            try {
+                args.expiry_cutoff = iv_calculator::core::parse_time_of_day(argv[++i]);
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--day-count" && i + 1 < argc) {
+            try {
+                args.day_count = iv_calculator::core::parse_day_count(argv[++i]);
+            } catch (...) {
+                std::cerr << "Error: Day count must be 'act365f', 'act360', 'actact', '30360' "
+                             "or 'bus252'"
+                          << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--holidays" && i + 1 < argc) {
+            args.holiday_file = argv[++i];
+        } else if (arg == "--curve" && i + 1 < argc) {
+            args.curve_file = argv[++i];
+        } else if (arg == "--curve-interpolation" && i + 1 < argc) {
+            try {
+                args.curve_interpolation =
+                    iv_calculator::core::parse_curve_interpolation(argv[++i]);
+            } catch (...) {
+                std::cerr << "Error: Curve interpolation must be 'loglinear' or "
+                             "'monotone-convex'"
+                          << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--dividends" && i + 1 < argc) {
+            args.dividend_file = argv[++i];
+        } else if (arg == "--scenarios" && i + 1 < argc) {
+            try {
+                args.scenarios = iv_calculator::engine::ScenarioConfig{
+                    iv_calculator::engine::parse_scenario_grid(argv[++i]), ""};
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } else if (arg == "--scenario-output" && i + 1 < argc) {
+            args.scenario_file = argv[++i];
+        } else if (arg == "--change-log" && i + 1 < argc) {
+            args.delta.change_log_file = argv[++i];
+        } else if (arg == "--merge" && i + 1 < argc) {
+            std::stringstream files(argv[++i]);
+            std::string file;
+            while (std::getline(files, file, ',')) {
+                if (!file.empty()) {
+                    args.merge_files.push_back(file);
+                }
+            }
         } else if (arg == "--batch" && i + 1 < argc) {
             args.batch_file = argv[++i];
             // For backward compatibility
@@ -143,8 +562,9 @@ Arguments parse_arguments(int argc, char** argv) {
             args.input_file = argv[++i];
         } else if (arg == "--input-format" && i + 1 < argc) {
             args.input_format = argv[++i];
-            if (args.input_format != "csv" && args.input_format != "json") {
-                std::cerr << "Error: Input format must be 'csv' or 'json'" << std::endl;
+            if (args.input_format != "csv" && args.input_format != "json" &&
+                args.input_format != "binary") {
+                std::cerr << "Error: Input format must be 'csv', 'json' or 'binary'" << std::endl;
                 args.is_valid = false;
                 return args;
             }
@@ -152,8 +572,9 @@ Arguments parse_arguments(int argc, char** argv) {
             args.output_file = argv[++i];
         } else if (arg == "--output-format" && i + 1 < argc) {
             args.output_format = argv[++i];
-            if (args.output_format != "csv" && args.output_format != "json") {
-                std::cerr << "Error: Output format must be 'csv' or 'json'" << std::endl;
+            if (args.output_format != "csv" && args.output_format != "json" &&
+                args.output_format != "binary") {
+                std::cerr << "Error: Output format must be 'csv', 'json' or 'binary'" << std::endl;
                 args.is_valid = false;
                 return args;
             }
@@ -164,9 +585,41 @@ Arguments parse_arguments(int argc, char** argv) {
         }
     }
 
+    if ((!args.checkpoint_file.empty() || args.resume) && args.output_file.empty()) {
+        std::cerr << "Error: --checkpoint and --resume require --output-file" << std::endl;
+        args.is_valid = false;
+    }
+    if (args.resume && args.checkpoint_file.empty()) {
+        args.checkpoint_file = args.output_file + ".checkpoint";
+    }
+
+    if (!args.delta.change_log_file.empty() && args.delta.baseline_file.empty()) {
+        std::cerr << "Error: --change-log requires --delta-baseline" << std::endl;
+        args.is_valid = false;
+    }
+
+    if (args.scenarios.has_value() == args.scenario_file.empty()) {
+        std::cerr << "Error: --scenarios and --scenario-output must be given together"
+                  << std::endl;
+        args.is_valid = false;
+    } else if (args.scenarios) {
+        args.scenarios->output_file = args.scenario_file;
+    }
+
+    if (!args.merge_files.empty() && args.output_file.empty()) {
+        std::cerr << "Error: --merge requires --output-file" << std::endl;
+        args.is_valid = false;
+    }
+
     // Validate required parameters for single calculation
-    if (args.input_file.empty()) {
-        if (args.asset_price <= 0 || args.strike_price <= 0 || args.time_to_expiry <= 0) {
+    if (args.input_file.empty() && args.merge_files.empty()) {
+        if (args.model == PricingModel::BACHELIER) {
+            // The normal model accepts zero and negative asset and strike prices
+            if (args.time_to_expiry <= 0) {
+                std::cerr << "Error: Time to expiry must be positive" << std::endl;
+                args.is_valid = false;
+            }
+        } else if (args.asset_price <= 0 || args.strike_price <= 0 || args.time_to_expiry <= 0) {
             std::cerr << "Error: Asset price, strike price, and time to expiry must be positive"
                       << std::endl;
             args.is_valid = false;
@@ -188,189 +641,71 @@ Arguments parse_arguments(int argc, char** argv) {
     return args;
 }
 
-// Process batch file using the io module
-bool process_batch_file_with_io(const std::string& input_file, const std::string& input_format,
-                                const std::string& output_file, const std::string& output_format) {
-    try {
-        // Load options data from input file
-        std::vector<iv_calculator::io::OptionData> options;
-
-        if (input_format == "csv") {
-            options = iv_calculator::io::read_csv(input_file);
-        } else if (input_format == "json") {
-            options = iv_calculator::io::read_json(input_file);
-        } else {
-            std::cerr << "Error: Unsupported input format '" << input_format << "'" << std::endl;
-            return false;
-        }
-
-        std::cout << "Loaded " << options.size() << " options from " << input_file << std::endl;
-
-        // Calculate implied volatility for each option
-        int processed = 0;
-        int errors = 0;
-
-        for (auto& option : options) {
-            try {
-                // If volatility is set but price isn't, calculate price
-                if (option.volatility > 0 && option.option_price <= 0) {
-                    option.option_price = black_scholes_price(
-                        option.is_call, option.asset_price, option.strike_price,
-                        option.time_to_expiry, option.risk_free_rate, option.volatility);
-
-                    // Print result to console
-                    std::cout << "Option: " << (option.is_call ? "Call" : "Put")
-                              << ", S=" << option.asset_price << ", K=" << option.strike_price
-                              << ", T=" << option.time_to_expiry << ", r=" << option.risk_free_rate
-                              << ", volatility=" << option.volatility
-                              << ", price=" << option.option_price << std::endl;
-                }
-                // If price is set but volatility isn't, calculate implied volatility
-                else if (option.option_price > 0 && option.volatility <= 0) {
-                    option.volatility = calculate_implied_volatility(
-                        option.is_call, option.asset_price, option.strike_price,
-                        option.time_to_expiry, option.risk_free_rate, option.option_price);
-
-                    // Print result to console
-                    std::cout << "Option: " << (option.is_call ? "Call" : "Put")
-                              << ", S=" << option.asset_price << ", K=" << option.strike_price
-                              << ", T=" << option.time_to_expiry << ", r=" << option.risk_free_rate
-                              << ", price=" << option.option_price
-                              << ", implied volatility=" << option.volatility << std::endl;
-                }
-                // If both are set, we'll just use them as-is
-                processed++;
-            } catch (const std::exception& e) {
-                std::cerr << "Error processing option: " << e.what() << std::endl;
-                errors++;
-            }
-        }
-
-        // Write results to output file if specified
-        if (!output_file.empty()) {
-            bool success = false;
-            if (output_format == "csv") {
-                success = iv_calculator::io::write_csv(output_file, options);
-            } else if (output_format == "json") {
-                success = iv_calculator::io::write_json(output_file, options);
-            } else {
-                std::cerr << "Error: Unsupported output format '" << output_format << "'"
-                          << std::endl;
-                return false;
-            }
-
-            if (success) {
-                std::cout << "Results written to " << output_file << std::endl;
-            } else {
-                std::cerr << "Error writing to " << output_file << std::endl;
-                return false;
-            }
-        }
+// Process a batch file through the batch engine
+bool process_batch(const Arguments& args) {
+    iv_calculator::engine::BatchConfig config;
+    config.input_file = args.input_file;
+    config.input_format = args.input_format;
+    config.output_file = args.output_file;
+    config.output_format = args.output_format;
+    config.model = args.model;
+    config.solver = args.solver;
+    config.warm_start = args.warm_start;
+    config.pde = args.pde;
+    config.aggregation = args.aggregation;
+    config.risk_file = args.risk_file;
+    config.risk_format = args.risk_format;
+    config.scenarios = args.scenarios;
+    config.day_count = args.day_count;
+    config.valuation_time = args.valuation_time;
+    config.expiry_cutoff = args.expiry_cutoff;
+    config.holiday_file = args.holiday_file;
+    config.curve_file = args.curve_file;
+    config.curve_interpolation = args.curve_interpolation;
+    config.dividend_file = args.dividend_file;
+    config.csv_columns = args.csv_columns;
+    config.columns = args.columns;
+    config.io_options = args.io_options;
+    config.verbose = !args.quiet;
+    config.threads = args.threads;
+    config.shard = args.shard;
+    config.shard.mode = args.shard_mode;
+    config.checkpoint_file = args.checkpoint_file;
+    config.checkpoint_rows = args.checkpoint_rows;
+    config.resume = args.resume;
+    if (!args.delta.baseline_file.empty()) {
+        config.delta = args.delta;
+    }
+    // The deprecated --batch/--output pair keeps its own CSV layout
+    config.legacy = !args.batch_file.empty() && args.input_file == args.batch_file &&
+                    args.input_format == "csv" && args.output_format == "csv";
 
-        std::cout << "Batch processing complete. Processed " << processed << " items with "
-                  << errors << " errors." << std::endl;
+    try {
+        iv_calculator::engine::run_batch(config, std::cout, std::cerr);
         return true;
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
         return false;
     }
 }
-// Process batch file (simple CSV format)
-bool process_batch_file(const std::string& input_file, const std::string& output_file) {
-    std::ifstream infile(input_file);
-    if (!infile) {
-        std::cerr << "Error: Could not open input file '" << input_file << "'" << std::endl;
-        return false;
-    }
 
-    std::ofstream outfile;
-    if (!output_file.empty()) {
-        outfile.open(output_file);
-        if (!outfile) {
-            std::cerr << "Error: Could not open output file '" << output_file << "'" << std::endl;
-            return false;
-        }
-
-        // Write header
-        outfile << "Type,Asset,Strike,Time,Rate,Price,Volatility" << std::endl;
-    }
-
-    std::string line;
-    // Skip header line
-    std::getline(infile, line);
+// Combine shard outputs into one result
+bool process_merge(const Arguments& args) {
+    iv_calculator::engine::MergeConfig config;
+    config.input_files = args.merge_files;
+    config.input_format = args.input_format;
+    config.output_file = args.output_file;
+    config.output_format = args.output_format;
+    config.mode = args.shard_mode;
+    config.io_options = args.io_options;
 
-    int processed = 0;
-    int errors = 0;
-
-    // Process each line
-    while (std::getline(infile, line)) {
-        std::stringstream ss(line);
-        std::string token;
-        std::vector<std::string> tokens;
-
-        while (std::getline(ss, token, ',')) {
-            tokens.push_back(token);
-        }
-
-        if (tokens.size() < 6) {
-            std::cerr << "Error: Invalid CSV format" << std::endl;
-            errors++;
-            continue;
-        }
-
-        try {
-            bool is_call = (tokens[0] == "call" || tokens[0] == "Call");
-            double asset = std::stod(tokens[1]);
-            double strike = std::stod(tokens[2]);
-            double time = std::stod(tokens[3]);
-            double rate = std::stod(tokens[4]);
-            double price_or_vol = std::stod(tokens[5]);
-            bool is_price = (tokens.size() > 6 && tokens[6] == "price") || tokens.size() == 6;
-
-            double result = std::numeric_limits<double>::quiet_NaN();  // Initialize to NaN
-            if (is_price) {
-                // Calculate implied volatility
-                result =
-                    calculate_implied_volatility(is_call, asset, strike, time, rate, price_or_vol);
-
-                // Print result to console
-                std::cout << "Option: " << (is_call ? "Call" : "Put") << ", S=" << asset
-                          << ", K=" << strike << ", T=" << time << ", r=" << rate
-                          << ", price=" << price_or_vol << ", implied volatility=" << result
-                          << std::endl;
-
-                // Write to output file
-                if (outfile) {
-                    outfile << (is_call ? "Call" : "Put") << "," << asset << "," << strike << ","
-                            << time << "," << rate << "," << price_or_vol << "," << result
-                            << std::endl;
-                }
-            } else {
-                // Calculate option price
-                result = black_scholes_price(is_call, asset, strike, time, rate, price_or_vol);
-
-                // Print result to console
-                std::cout << "Option: " << (is_call ? "Call" : "Put") << ", S=" << asset
-                          << ", K=" << strike << ", T=" << time << ", r=" << rate
-                          << ", volatility=" << price_or_vol << ", price=" << result << std::endl;
-
-                // Write to output file
-                if (outfile) {
-                    outfile << (is_call ? "Call" : "Put") << "," << asset << "," << strike << ","
-                            << time << "," << rate << "," << result << "," << price_or_vol
-                            << std::endl;
-                }
-            }
-            processed++;
-        } catch (const std::exception& e) {
-            std::cerr << "Error processing line: " << line << ". " << e.what() << std::endl;
-            errors++;
-        }
+    try {
+        iv_calculator::engine::merge_shards(config, std::cout);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return false;
     }
-
-    std::cout << "Batch processing complete. Processed " << processed << " items with " << errors
-              << " errors." << std::endl;
-    return true;
 }
 
 int main(int argc, char** argv) {
@@ -386,33 +721,28 @@ int main(int argc, char** argv) {
         return 1;
     }
 
+    if (!args.merge_files.empty()) {
+        return process_merge(args) ? 0 : 1;
+    }
+
     // Process batch mode if batch file is provided
     if (!args.input_file.empty()) {
-        // Use the new IO-based batch processor if input format is JSON or the new flags are used
-        if (args.input_format == "json" || args.output_format == "json" ||
-            args.input_file != args.batch_file) {
-            if (!process_batch_file_with_io(args.input_file, args.input_format, args.output_file,
-                                            args.output_format)) {
-                return 1;
-            }
-        } else {
-            // Use legacy batch processor for backward compatibility
-            if (!process_batch_file(args.batch_file, args.output_file)) {
-                return 1;
-            }
-        }
-        return 1;
+        return process_batch(args) ? 0 : 1;
     }
 
     // Process single calculation
+    PricingModel model = args.model.value_or(PricingModel::BLACK_SCHOLES);
     try {
         if (args.option_price < 0) {
             // Calculate option price from volatility
             double price =
-                black_scholes_price(args.is_call, args.asset_price, args.strike_price,
-                                    args.time_to_expiry, args.risk_free_rate, args.volatility);
+                model_price(model, args.is_call, args.asset_price, args.strike_price,
+                            args.time_to_expiry, args.risk_free_rate, args.volatility);
 
             std::cout << "Option: " << (args.is_call ? "Call" : "Put") << std::endl;
+            if (model != PricingModel::BLACK_SCHOLES) {
+                std::cout << "Model: " << pricing_model_name(model) << std::endl;
+            }
             std::cout << "Asset price: " << args.asset_price << std::endl;
             std::cout << "Strike price: " << args.strike_price << std::endl;
             std::cout << "Time to expiry: " << args.time_to_expiry << " years" << std::endl;
@@ -429,21 +759,30 @@ int main(int argc, char** argv) {
                               << std::endl;
                     return 1;
                 }
-                outfile << "Type,Asset,Strike,Time,Rate,Price,Volatility" << std::endl;
+                outfile << "Type,Asset,Strike,Time,Rate,Price,Volatility"
+                        << (model != PricingModel::BLACK_SCHOLES ? ",Model" : "") << std::endl;
                 outfile << (args.is_call ? "Call" : "Put") << "," << args.asset_price << ","
                         << args.strike_price << "," << args.time_to_expiry << ","
-                        << args.risk_free_rate << "," << price << "," << args.volatility
-                        << std::endl;
+                        << args.risk_free_rate << "," << price << "," << args.volatility;
+                if (model != PricingModel::BLACK_SCHOLES) {
+                    outfile << "," << pricing_model_name(model);
+                }
+                outfile << std::endl;
                 std::cout << "Results written to " << args.output_file << std::endl;
             }
 
         } else {
             // Calculate implied volatility from option price
-            double iv = calculate_implied_volatility(args.is_call, args.asset_price,
-                                                     args.strike_price, args.time_to_expiry,
-                                                     args.risk_free_rate, args.option_price);
+            double iv = solve_model_implied_volatility(model, args.is_call, args.asset_price,
+                                                       args.strike_price, args.time_to_expiry,
+                                                       args.risk_free_rate, args.option_price,
+                                                       args.solver)
+                            .volatility;
 
             std::cout << "Option: " << (args.is_call ? "Call" : "Put") << std::endl;
+            if (model != PricingModel::BLACK_SCHOLES) {
+                std::cout << "Model: " << pricing_model_name(model) << std::endl;
+            }
             std::cout << "Asset price: " << args.asset_price << std::endl;
             std::cout << "Strike price: " << args.strike_price << std::endl;
             std::cout << "Time to expiry: " << args.time_to_expiry << " years" << std::endl;
@@ -460,11 +799,15 @@ int main(int argc, char** argv) {
                               << std::endl;
                     return 1;
                 }
-                outfile << "Type,Asset,Strike,Time,Rate,Price,Volatility" << std::endl;
+                outfile << "Type,Asset,Strike,Time,Rate,Price,Volatility"
+                        << (model != PricingModel::BLACK_SCHOLES ? ",Model" : "") << std::endl;
                 outfile << (args.is_call ? "Call" : "Put") << "," << args.asset_price << ","
                         << args.strike_price << "," << args.time_to_expiry << ","
-                        << args.risk_free_rate << "," << args.option_price << "," << iv
-                        << std::endl;
+                        << args.risk_free_rate << "," << args.option_price << "," << iv;
+                if (model != PricingModel::BLACK_SCHOLES) {
+                    outfile << "," << pricing_model_name(model);
+                }
+                outfile << std::endl;
                 std::cout << "Results written to " << args.output_file << std::endl;
             }
         }
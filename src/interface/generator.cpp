@@ -0,0 +1,172 @@
+#include "src/engine/chain_generator.h"
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using iv_calculator::engine::GeneratorConfig;
+
+// Prints usage instructions
+void print_usage() {
+    std::cout << "Usage: iv_generator --output-file FILE [OPTIONS]" << std::endl;
+    std::cout << "Writes synthetic option chains for load testing." << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --help                 Show this help message" << std::endl;
+    std::cout << "  --output-file FILE     File to write" << std::endl;
+    std::cout << "  --output-format FORMAT csv, json, ndjson or binary (default: csv)"
+              << std::endl;
+    std::cout << "  --rows N               Rows to write (default: 1000000)" << std::endl;
+    std::cout << "  --seed N               Random seed; the same seed gives the same file "
+                 "(default: 1)"
+              << std::endl;
+    std::cout << "  --threads N            Formatting threads (default: all cores)" << std::endl;
+    std::cout << "  --expiries DAYS        Days to expiry of each chain (default: "
+                 "7,14,30,60,91,182,365,730)"
+              << std::endl;
+    std::cout << "  --strikes N            Strikes per expiry (default: 41)" << std::endl;
+    std::cout << "  --moneyness LOW:HIGH   ln(K/S) range at one year, scaled by sqrt(T) "
+                 "(default: -0.6:0.6)"
+              << std::endl;
+    std::cout << "  --rate RATE            Risk-free rate of every row (default: 0.04)"
+              << std::endl;
+    std::cout << "  --noise SD             Standard deviation of the log mid price error "
+                 "(default: 0.01)"
+              << std::endl;
+    std::cout << "  --invalid-share P      Share of rows with an arbitrage-violating price "
+                 "(default: 0)"
+              << std::endl;
+    std::cout << "  --io-backend BACKEND   File I/O backend: auto, io_uring or stream "
+                 "(default: auto)"
+              << std::endl;
+    std::cout << "  --direct-io            Bypass the page cache with O_DIRECT (io_uring only)"
+              << std::endl;
+    std::cout << std::endl;
+    std::cout << "Example:" << std::endl;
+    std::cout << "  iv_generator --rows 100000000 --output-file chains.bin --output-format binary "
+                 "--invalid-share 0.01"
+              << std::endl;
+}
+
+// Structure to hold command line arguments
+struct Arguments {
+    GeneratorConfig config;
+    bool help_requested = false;
+    bool is_valid = true;
+};
+
+// Parse command line arguments
+Arguments parse_arguments(int argc, char** argv) {
+    Arguments args;
+    GeneratorConfig& config = args.config;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+        try {
+            if (arg == "--help") {
+                args.help_requested = true;
+                return args;
+            } else if (arg == "--output-file" && i + 1 < argc) {
+                config.output_file = argv[++i];
+            } else if (arg == "--output-format" && i + 1 < argc) {
+                config.output_format = argv[++i];
+                if (config.output_format != "csv" && config.output_format != "json" &&
+                    config.output_format != "ndjson" && config.output_format != "binary") {
+                    std::cerr << "Error: Output format must be 'csv', 'json', 'ndjson' or "
+                                 "'binary'"
+                              << std::endl;
+                    args.is_valid = false;
+                    return args;
+                }
+            } else if (arg == "--rows" && i + 1 < argc) {
+                long long rows = std::stoll(argv[++i]);
+                if (rows < 0) {
+                    throw std::out_of_range("rows");
+                }
+                config.rows = static_cast<std::uint64_t>(rows);
+            } else if (arg == "--seed" && i + 1 < argc) {
+                config.seed = std::stoull(argv[++i]);
+            } else if (arg == "--threads" && i + 1 < argc) {
+                int threads = std::stoi(argv[++i]);
+                if (threads < 0) {
+                    throw std::out_of_range("threads");
+                }
+                config.threads = static_cast<unsigned>(threads);
+            } else if (arg == "--expiries" && i + 1 < argc) {
+                config.expiry_days = iv_calculator::engine::parse_expiry_days(argv[++i]);
+            } else if (arg == "--strikes" && i + 1 < argc) {
+                int strikes = std::stoi(argv[++i]);
+                if (strikes <= 0) {
+                    throw std::out_of_range("strikes");
+                }
+                config.strikes = static_cast<std::size_t>(strikes);
+            } else if (arg == "--moneyness" && i + 1 < argc) {
+                std::string range = argv[++i];
+                std::size_t colon = range.find(':');
+                if (colon == std::string::npos) {
+                    throw std::invalid_argument("moneyness");
+                }
+                config.min_moneyness = std::stod(range.substr(0, colon));
+                config.max_moneyness = std::stod(range.substr(colon + 1));
+                if (!(config.min_moneyness <= config.max_moneyness)) {
+                    throw std::out_of_range("moneyness");
+                }
+            } else if (arg == "--rate" && i + 1 < argc) {
+                config.rate = std::stod(argv[++i]);
+            } else if (arg == "--noise" && i + 1 < argc) {
+                config.noise = std::stod(argv[++i]);
+                if (!(config.noise >= 0)) {
+                    throw std::out_of_range("noise");
+                }
+            } else if (arg == "--invalid-share" && i + 1 < argc) {
+                config.invalid_share = std::stod(argv[++i]);
+                if (!(config.invalid_share >= 0 && config.invalid_share <= 1)) {
+                    throw std::out_of_range("invalid share");
+                }
+            } else if (arg == "--io-backend" && i + 1 < argc) {
+                config.io_options.backend = iv_calculator::io::parse_io_backend(argv[++i]);
+            } else if (arg == "--direct-io") {
+                config.io_options.direct_io = true;
+            } else {
+                std::cerr << "Error: Unknown option '" << arg << "'" << std::endl;
+                args.is_valid = false;
+                return args;
+            }
+        } catch (...) {
+            std::cerr << "Error: Invalid value for " << arg << std::endl;
+            args.is_valid = false;
+            return args;
+        }
+    }
+
+    if (config.output_file.empty()) {
+        std::cerr << "Error: --output-file is required" << std::endl;
+        args.is_valid = false;
+    }
+    return args;
+}
+
+int main(int argc, char** argv) {
+    Arguments args = parse_arguments(argc, argv);
+
+    if (args.help_requested) {
+        print_usage();
+        return 0;
+    }
+
+    if (!args.is_valid) {
+        print_usage();
+        return 1;
+    }
+
+    try {
+        iv_calculator::engine::generate_chains(args.config, std::cout);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
@@ -0,0 +1,819 @@
+#include "async_io.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define IV_CALCULATOR_HAS_IO_URING 1
+#include <cerrno>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace iv_calculator {
+    namespace io {
+
+        namespace {
+            // Alignment required by O_DIRECT on common block devices
+            constexpr std::size_t kAlignment = 4096;
+
+            std::size_t round_up(std::size_t value, std::size_t alignment) {
+                return (value + alignment - 1) / alignment * alignment;
+            }
+
+            // Page-aligned heap buffer usable for O_DIRECT transfers
+            struct AlignedBuffer {
+                struct Free {
+                    void operator()(char* p) const { std::free(p); }  // NOLINT
+                };
+
+                explicit AlignedBuffer(std::size_t size)
+                    : data(static_cast<char*>(std::aligned_alloc(kAlignment, size))), size(size) {
+                    if (!data) {
+                        throw std::bad_alloc();
+                    }
+                }
+
+                std::unique_ptr<char, Free> data;
+                std::size_t size;
+            };
+
+            std::size_t effective_block_size(const AsyncIoOptions& options) {
+                return round_up(std::max<std::size_t>(options.block_size, 1), kAlignment);
+            }
+
+            unsigned effective_queue_depth(const AsyncIoOptions& options) {
+                return std::max(options.queue_depth, 1U);
+            }
+        }  // namespace
+
+        IoBackend parse_io_backend(std::string_view name) {
+            std::string lower;
+            for (char c : name) {
+                if (c != '-' && c != '_') {
+                    lower.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+                }
+            }
+            if (lower == "auto") {
+                return IoBackend::AUTO;
+            }
+            if (lower == "iouring" || lower == "uring") {
+                return IoBackend::IO_URING;
+            }
+            if (lower == "stream" || lower == "fstream") {
+                return IoBackend::STREAM;
+            }
+            throw std::invalid_argument("Unknown I/O backend: " + std::string(name));
+        }
+
+        // Common interface of the backend implementations
+        class AsyncFileReader::Impl {
+        public:
+            virtual ~Impl() = default;
+            virtual std::string_view next() = 0;
+            [[nodiscard]] virtual IoBackend backend() const = 0;
+        };
+
+        class AsyncFileWriter::Impl {
+        public:
+            virtual ~Impl() = default;
+            virtual void write(std::string_view data) = 0;
+            virtual void sync() = 0;
+            [[nodiscard]] virtual std::uint64_t size() const = 0;
+            virtual void close() = 0;
+            [[nodiscard]] virtual IoBackend backend() const = 0;
+        };
+
+        namespace {
+            // Blocking reader on top of std::ifstream
+            class StreamReader : public AsyncFileReader::Impl {
+            public:
+                StreamReader(const std::string& filepath, const AsyncIoOptions& options,
+                             std::uint64_t offset)
+                    : file_(filepath, std::ios::binary), buffer_(effective_block_size(options)) {
+                    if (!file_.is_open()) {
+                        throw std::runtime_error("Could not open file: " + filepath);
+                    }
+                    file_.seekg(static_cast<std::streamoff>(offset));
+                }
+
+                std::string_view next() override {
+                    file_.read(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+                    return {buffer_.data(), static_cast<std::size_t>(file_.gcount())};
+                }
+
+                [[nodiscard]] IoBackend backend() const override { return IoBackend::STREAM; }
+
+            private:
+                std::ifstream file_;
+                std::vector<char> buffer_;
+            };
+
+            // Blocking writer on top of std::ofstream
+            class StreamWriter : public AsyncFileWriter::Impl {
+            public:
+                StreamWriter(const std::string& filepath, std::uint64_t offset) : size_(offset) {
+                    if (offset > 0) {
+                        std::filesystem::resize_file(filepath, offset);
+                        file_.open(filepath, std::ios::binary | std::ios::in | std::ios::out);
+                        file_.seekp(static_cast<std::streamoff>(offset));
+                    } else {
+                        file_.open(filepath, std::ios::binary | std::ios::trunc);
+                    }
+                    if (!file_.is_open()) {
+                        throw std::runtime_error("Could not open file: " + filepath);
+                    }
+                }
+
+                void write(std::string_view data) override {
+                    file_.write(data.data(), static_cast<std::streamsize>(data.size()));
+                    if (!file_) {
+                        throw std::runtime_error("Write failed");
+                    }
+                    size_ += data.size();
+                }
+
+                void sync() override {
+                    file_.flush();
+                    if (!file_) {
+                        throw std::runtime_error("Write failed");
+                    }
+                }
+
+                [[nodiscard]] std::uint64_t size() const override { return size_; }
+
+                void close() override {
+                    if (file_.is_open()) {
+                        file_.close();
+                        if (file_.fail()) {
+                            throw std::runtime_error("Write failed");
+                        }
+                    }
+                }
+
+                [[nodiscard]] IoBackend backend() const override { return IoBackend::STREAM; }
+
+            private:
+                std::ofstream file_;
+                std::uint64_t size_;
+            };
+
+#ifdef IV_CALCULATOR_HAS_IO_URING
+            std::runtime_error system_error(const std::string& what, int error) {
+                return std::runtime_error(what + ": " + std::strerror(error));
+            }
+
+            // Minimal io_uring wrapper over the raw system calls
+            class IoUring {
+            public:
+                explicit IoUring(unsigned entries) {
+                    io_uring_params params{};
+                    ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+                    if (ring_fd_ < 0) {
+                        throw system_error("io_uring_setup failed", errno);
+                    }
+
+                    sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                    cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                    if (single_mmap) {
+                        sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+                    }
+
+                    sq_ptr_ = mmap(nullptr, sq_size_, PROT_READ | PROT_WRITE,
+                                   MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+                    cq_ptr_ = single_mmap ? sq_ptr_
+                                          : mmap(nullptr, cq_size_, PROT_READ | PROT_WRITE,
+                                                 MAP_SHARED | MAP_POPULATE, ring_fd_,
+                                                 IORING_OFF_CQ_RING);
+                    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+                    void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                                      MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+                    sqes_ = sqes == MAP_FAILED ? nullptr : static_cast<io_uring_sqe*>(sqes);
+                    if (sq_ptr_ == MAP_FAILED || cq_ptr_ == MAP_FAILED || sqes_ == nullptr) {
+                        int error = errno;
+                        release();
+                        throw system_error("io_uring mmap failed", error);
+                    }
+
+                    auto* sq = static_cast<char*>(sq_ptr_);
+                    auto* cq = static_cast<char*>(cq_ptr_);
+                    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic,cppcoreguidelines-pro-type-reinterpret-cast)
+                    sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+                    sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+                    sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+                    sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+                    sq_entries_ = params.sq_entries;
+                    cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+                    cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+                    cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+                    cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+                    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic,cppcoreguidelines-pro-type-reinterpret-cast)
+                }
+
+                ~IoUring() { release(); }
+
+                IoUring(const IoUring&) = delete;
+                IoUring& operator=(const IoUring&) = delete;
+                IoUring(IoUring&&) = delete;
+                IoUring& operator=(IoUring&&) = delete;
+
+                // Throw unless the kernel implements every opcode; rings exist since 5.1 but
+                // IORING_OP_READ and IORING_OP_WRITE only since 5.6
+                void require(std::initializer_list<std::uint8_t> opcodes) const {
+                    constexpr unsigned kProbeOps = 256;
+                    std::vector<char> storage(sizeof(io_uring_probe) +
+                                              kProbeOps * sizeof(io_uring_probe_op));
+                    auto* probe = reinterpret_cast<io_uring_probe*>(storage.data());  // NOLINT
+                    if (syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_PROBE, probe,
+                                kProbeOps) != 0) {
+                        throw system_error("io_uring probe failed", errno);
+                    }
+                    for (std::uint8_t opcode : opcodes) {
+                        if (opcode >= probe->ops_len ||
+                            (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) == 0) {  // NOLINT
+                            throw std::runtime_error("io_uring does not support opcode " +
+                                                     std::to_string(opcode));
+                        }
+                    }
+                }
+
+                // Register fixed buffers; returns false when the kernel refuses them
+                bool register_buffers(const std::vector<iovec>& buffers) {
+                    return syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_BUFFERS,
+                                   buffers.data(), buffers.size()) == 0;
+                }
+
+                // Queue one request; the ring is sized so it never overflows
+                void queue(std::uint8_t opcode, int fd, char* buffer, std::size_t length,
+                           std::uint64_t offset, std::uint64_t user_data, int buffer_index) {
+                    unsigned tail = *sq_tail_;
+                    unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+                    if (tail - head >= sq_entries_) {
+                        throw std::runtime_error("io_uring submission queue is full");
+                    }
+                    unsigned index = tail & sq_mask_;
+                    io_uring_sqe& sqe = sqes_[index];  // NOLINT
+                    std::memset(&sqe, 0, sizeof(sqe));
+                    sqe.opcode = opcode;
+                    sqe.fd = fd;
+                    sqe.addr = reinterpret_cast<std::uint64_t>(buffer);  // NOLINT
+                    sqe.len = static_cast<std::uint32_t>(length);
+                    sqe.off = offset;
+                    sqe.user_data = user_data;
+                    if (buffer_index >= 0) {
+                        sqe.buf_index = static_cast<std::uint16_t>(buffer_index);
+                    }
+                    sq_array_[index] = index;  // NOLINT
+                    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+                    ++to_submit_;
+                }
+
+                // Submit queued requests and optionally wait for at least one completion
+                void enter(bool wait) {
+                    while (true) {
+                        long ret = syscall(__NR_io_uring_enter, ring_fd_, to_submit_, wait ? 1 : 0,
+                                           wait ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+                        if (ret >= 0) {
+                            to_submit_ -= static_cast<unsigned>(ret);
+                            return;
+                        }
+                        if (errno != EINTR) {
+                            throw system_error("io_uring_enter failed", errno);
+                        }
+                    }
+                }
+
+                // Pop one completion if available
+                bool pop(io_uring_cqe& out) {
+                    unsigned head = *cq_head_;
+                    unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+                    if (head == tail) {
+                        return false;
+                    }
+                    out = cqes_[head & cq_mask_];  // NOLINT
+                    __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+                    return true;
+                }
+
+                // Wait for the next completion
+                io_uring_cqe wait() {
+                    io_uring_cqe cqe{};
+                    while (!pop(cqe)) {
+                        enter(true);
+                    }
+                    return cqe;
+                }
+
+            private:
+                void release() {
+                    if (sqes_ != nullptr) {
+                        munmap(sqes_, sqes_size_);
+                    }
+                    if (cq_ptr_ != nullptr && cq_ptr_ != MAP_FAILED && cq_ptr_ != sq_ptr_) {
+                        munmap(cq_ptr_, cq_size_);
+                    }
+                    if (sq_ptr_ != nullptr && sq_ptr_ != MAP_FAILED) {
+                        munmap(sq_ptr_, sq_size_);
+                    }
+                    if (ring_fd_ >= 0) {
+                        ::close(ring_fd_);
+                    }
+                    sqes_ = nullptr;
+                    sq_ptr_ = cq_ptr_ = nullptr;
+                    ring_fd_ = -1;
+                }
+
+                int ring_fd_ = -1;
+                void* sq_ptr_ = nullptr;
+                void* cq_ptr_ = nullptr;
+                std::size_t sq_size_ = 0;
+                std::size_t cq_size_ = 0;
+                std::size_t sqes_size_ = 0;
+                io_uring_sqe* sqes_ = nullptr;
+                unsigned* sq_head_ = nullptr;
+                unsigned* sq_tail_ = nullptr;
+                unsigned* sq_array_ = nullptr;
+                unsigned sq_mask_ = 0;
+                unsigned sq_entries_ = 0;
+                unsigned* cq_head_ = nullptr;
+                unsigned* cq_tail_ = nullptr;
+                unsigned cq_mask_ = 0;
+                io_uring_cqe* cqes_ = nullptr;
+                unsigned to_submit_ = 0;
+            };
+
+            // Owned file descriptor
+            struct FileDescriptor {
+                explicit FileDescriptor(int descriptor = -1) : fd(descriptor) {}
+                ~FileDescriptor() {
+                    if (fd >= 0) {
+                        ::close(fd);
+                    }
+                }
+                FileDescriptor(const FileDescriptor&) = delete;
+                FileDescriptor& operator=(const FileDescriptor&) = delete;
+                FileDescriptor(FileDescriptor&&) = delete;
+                FileDescriptor& operator=(FileDescriptor&&) = delete;
+
+                int fd;
+            };
+
+            // Open with O_DIRECT when requested and supported by the file system
+            int open_file(const std::string& filepath, int flags, bool& direct) {
+                int fd = -1;
+                if (direct) {
+                    fd = ::open(filepath.c_str(), flags | O_DIRECT, 0644);  // NOLINT
+                    if (fd >= 0) {
+                        return fd;
+                    }
+                    direct = false;
+                }
+                fd = ::open(filepath.c_str(), flags, 0644);  // NOLINT
+                if (fd < 0) {
+                    throw std::runtime_error("Could not open file: " + filepath);
+                }
+                return fd;
+            }
+
+            // One staging buffer and the request that currently uses it
+            struct Slot {
+                explicit Slot(std::size_t size) : buffer(size) {}
+
+                AlignedBuffer buffer;
+                std::uint64_t offset = 0;
+                std::size_t length = 0;  // Requested bytes, or bytes filled by the producer
+                long result = 0;         // Completed bytes or negative errno
+                bool in_flight = false;
+            };
+
+            // Read-ahead reader: block k of the file always goes through slot k % depth
+            class UringReader : public AsyncFileReader::Impl {
+            public:
+                UringReader(const std::string& filepath, const AsyncIoOptions& options,
+                            std::uint64_t offset)
+                    : block_size_(effective_block_size(options)),
+                      direct_(options.direct_io),
+                      file_(open_file(filepath, O_RDONLY | O_CLOEXEC, direct_)),
+                      ring_(effective_queue_depth(options)) {
+                    ring_.require({IORING_OP_READ, IORING_OP_READ_FIXED});
+                    struct stat info {};
+                    if (fstat(file_.fd, &info) != 0) {
+                        throw system_error("Could not stat file " + filepath, errno);
+                    }
+                    file_size_ = static_cast<std::uint64_t>(info.st_size);
+                    if (!direct_) {
+                        posix_fadvise(file_.fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+                    }
+
+                    // Requests stay block aligned; the bytes before the offset are dropped
+                    submit_offset_ = offset / block_size_ * block_size_;
+                    consume_offset_ = submit_offset_;
+                    skip_ = static_cast<std::size_t>(offset - submit_offset_);
+
+                    unsigned depth = effective_queue_depth(options);
+                    slots_.reserve(depth);
+                    std::vector<iovec> buffers;
+                    for (unsigned i = 0; i < depth; ++i) {
+                        slots_.emplace_back(block_size_);
+                        buffers.push_back({slots_.back().buffer.data.get(), block_size_});
+                    }
+                    fixed_buffers_ = direct_ && ring_.register_buffers(buffers);
+                    if (direct_) {
+                        // Short reads are completed through the page cache
+                        buffered_.fd = ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);  // NOLINT
+                    }
+
+                    std::size_t first_block = submit_offset_ / block_size_;
+                    for (unsigned i = 0; i < depth; ++i) {
+                        submit((first_block + i) % depth);
+                    }
+                    ring_.enter(false);
+                }
+
+                ~UringReader() override {
+                    // The kernel writes into the slots, so they must outlive every request
+                    try {
+                        for (const auto& slot : slots_) {
+                            while (slot.in_flight) {
+                                io_uring_cqe cqe = ring_.wait();
+                                slots_[cqe.user_data].in_flight = false;
+                            }
+                        }
+                    } catch (...) {  // NOLINT(bugprone-empty-catch)
+                        // Nothing can be reported from a destructor
+                    }
+                }
+
+                UringReader(const UringReader&) = delete;
+                UringReader& operator=(const UringReader&) = delete;
+                UringReader(UringReader&&) = delete;
+                UringReader& operator=(UringReader&&) = delete;
+
+                std::string_view next() override {
+                    // The caller is done with the previous chunk, so its slot can read ahead
+                    if (current_ >= 0) {
+                        submit(static_cast<std::size_t>(current_));
+                        ring_.enter(false);
+                        current_ = -1;
+                    }
+                    if (consume_offset_ >= file_size_) {
+                        return {};
+                    }
+
+                    std::size_t index = (consume_offset_ / block_size_) % slots_.size();
+                    Slot& slot = slots_[index];
+                    while (slot.in_flight) {
+                        io_uring_cqe cqe = ring_.wait();
+                        Slot& done = slots_[cqe.user_data];
+                        done.in_flight = false;
+                        done.result = cqe.res;
+                    }
+                    if (slot.result < 0) {
+                        throw system_error("Read failed", static_cast<int>(-slot.result));
+                    }
+
+                    auto received = static_cast<std::size_t>(slot.result);
+                    complete_short_read(slot, received);
+
+                    consume_offset_ += slot.length;
+                    current_ = static_cast<long>(index);
+                    std::size_t skip = std::min(skip_, slot.length);
+                    skip_ = 0;
+                    return {slot.buffer.data.get() + skip, slot.length - skip};  // NOLINT
+                }
+
+                [[nodiscard]] IoBackend backend() const override { return IoBackend::IO_URING; }
+
+            private:
+                void submit(std::size_t index) {
+                    if (submit_offset_ >= file_size_) {
+                        return;
+                    }
+                    Slot& slot = slots_[index];
+                    slot.offset = submit_offset_;
+                    slot.length = static_cast<std::size_t>(
+                        std::min<std::uint64_t>(block_size_, file_size_ - submit_offset_));
+                    slot.in_flight = true;
+                    // O_DIRECT transfers must cover whole aligned blocks
+                    std::size_t request = direct_ ? block_size_ : slot.length;
+                    ring_.queue(fixed_buffers_ ? IORING_OP_READ_FIXED : IORING_OP_READ, file_.fd,
+                                slot.buffer.data.get(), request, slot.offset, index,
+                                fixed_buffers_ ? static_cast<int>(index) : -1);
+                    submit_offset_ += block_size_;
+                }
+
+                void complete_short_read(const Slot& slot, std::size_t received) {
+                    int fd = buffered_.fd >= 0 ? buffered_.fd : file_.fd;
+                    while (received < slot.length) {
+                        ssize_t n = pread(fd, slot.buffer.data.get() + received,  // NOLINT
+                                          slot.length - received,
+                                          static_cast<off_t>(slot.offset + received));
+                        if (n <= 0) {
+                            throw std::runtime_error("Unexpected end of file");
+                        }
+                        received += static_cast<std::size_t>(n);
+                    }
+                }
+
+                std::size_t block_size_;
+                bool direct_;
+                FileDescriptor file_;
+                FileDescriptor buffered_;
+                IoUring ring_;
+                std::vector<Slot> slots_;
+                bool fixed_buffers_ = false;
+                std::uint64_t file_size_ = 0;
+                std::uint64_t submit_offset_ = 0;
+                std::uint64_t consume_offset_ = 0;
+                std::size_t skip_ = 0;  // Bytes of the first block before the start offset
+                long current_ = -1;
+            };
+
+            // Write-behind writer: the producer fills one slot while the others are in flight
+            class UringWriter : public AsyncFileWriter::Impl {
+            public:
+                UringWriter(const std::string& filepath, const AsyncIoOptions& options,
+                            std::uint64_t offset)
+                    : block_size_(effective_block_size(options)),
+                      direct_(options.direct_io),
+                      file_(open_file(filepath,
+                                      (offset > 0 ? O_RDWR : O_WRONLY | O_TRUNC) | O_CREAT |
+                                          O_CLOEXEC,
+                                      direct_)),
+                      ring_(effective_queue_depth(options)) {
+                    ring_.require({IORING_OP_WRITE, IORING_OP_WRITE_FIXED});
+                    unsigned depth = effective_queue_depth(options);
+                    slots_.reserve(depth);
+                    std::vector<iovec> buffers;
+                    for (unsigned i = 0; i < depth; ++i) {
+                        slots_.emplace_back(block_size_);
+                        buffers.push_back({slots_.back().buffer.data.get(), block_size_});
+                    }
+                    fixed_buffers_ = direct_ && ring_.register_buffers(buffers);
+                    if (direct_) {
+                        // Partial blocks are synced through the page cache
+                        buffered_.fd = ::open(filepath.c_str(), O_WRONLY | O_CLOEXEC);  // NOLINT
+                    }
+                    if (offset > 0) {
+                        resume_at(offset);
+                    }
+                }
+
+                ~UringWriter() override {
+                    try {
+                        close();
+                    } catch (...) {  // NOLINT(bugprone-empty-catch)
+                        // Errors are reported by an explicit close()
+                    }
+                }
+
+                UringWriter(const UringWriter&) = delete;
+                UringWriter& operator=(const UringWriter&) = delete;
+                UringWriter(UringWriter&&) = delete;
+                UringWriter& operator=(UringWriter&&) = delete;
+
+                void write(std::string_view data) override {
+                    if (closed_) {
+                        throw std::runtime_error("Write to a closed file");
+                    }
+                    while (!data.empty()) {
+                        Slot& slot = slots_[current_];
+                        std::size_t n = std::min(data.size(), block_size_ - slot.length);
+                        std::memcpy(slot.buffer.data.get() + slot.length, data.data(), n);  // NOLINT
+                        slot.length += n;
+                        data.remove_prefix(n);
+                        if (slot.length == block_size_) {
+                            submit_current(block_size_);
+                        }
+                    }
+                }
+
+                // The partial tail block stays staged and is written again once it fills up
+                void sync() override {
+                    for (std::size_t i = 0; i < slots_.size(); ++i) {
+                        wait_for(i);
+                    }
+                    const Slot& tail = slots_[current_];
+                    if (tail.length > 0) {
+                        int fd = buffered_.fd >= 0 ? buffered_.fd : file_.fd;
+                        std::size_t sent = 0;
+                        while (sent < tail.length) {
+                            ssize_t n = pwrite(fd, tail.buffer.data.get() + sent,  // NOLINT
+                                               tail.length - sent,
+                                               static_cast<off_t>(written_ + sent));
+                            if (n <= 0) {
+                                throw system_error("Write failed", errno != 0 ? errno : EIO);
+                            }
+                            sent += static_cast<std::size_t>(n);
+                        }
+                    }
+                    if (error_ != 0) {
+                        throw system_error("Write failed", error_);
+                    }
+                    if (fdatasync(file_.fd) != 0) {
+                        throw system_error("Could not sync output file", errno);
+                    }
+                }
+
+                [[nodiscard]] std::uint64_t size() const override {
+                    return written_ + slots_[current_].length;
+                }
+
+                void close() override {
+                    if (closed_) {
+                        return;
+                    }
+                    closed_ = true;
+
+                    Slot& tail = slots_[current_];
+                    std::size_t tail_length = tail.length;
+                    if (tail_length > 0) {
+                        // O_DIRECT needs whole blocks: pad with zeros and truncate afterwards
+                        std::size_t request = direct_ ? round_up(tail_length, kAlignment) : tail_length;
+                        std::memset(tail.buffer.data.get() + tail_length, 0,  // NOLINT
+                                    request - tail_length);
+                        submit_current(request);
+                    }
+                    for (std::size_t i = 0; i < slots_.size(); ++i) {
+                        wait_for(i);
+                    }
+                    if (direct_ && ftruncate(file_.fd, static_cast<off_t>(written_)) != 0) {
+                        throw system_error("Could not truncate output file", errno);
+                    }
+                    if (error_ != 0) {
+                        throw system_error("Write failed", error_);
+                    }
+                }
+
+                [[nodiscard]] IoBackend backend() const override { return IoBackend::IO_URING; }
+
+            private:
+                // Keep the first offset bytes; the aligned block they end in is staged again
+                // so that every request still starts on an O_DIRECT boundary
+                void resume_at(std::uint64_t offset) {
+                    if (ftruncate(file_.fd, static_cast<off_t>(offset)) != 0) {
+                        throw system_error("Could not truncate output file", errno);
+                    }
+                    written_ = offset / kAlignment * kAlignment;
+                    Slot& slot = slots_[current_];
+                    slot.length = static_cast<std::size_t>(offset - written_);
+                    std::size_t received = 0;
+                    while (received < slot.length) {
+                        ssize_t n = pread(file_.fd, slot.buffer.data.get() + received,  // NOLINT
+                                          direct_ ? kAlignment : slot.length - received,
+                                          static_cast<off_t>(written_ + received));
+                        if (n <= 0) {
+                            throw system_error("Could not read output file",
+                                               errno != 0 ? errno : EIO);
+                        }
+                        received += static_cast<std::size_t>(n);
+                    }
+                }
+
+                void submit_current(std::size_t request) {
+                    Slot& slot = slots_[current_];
+                    slot.offset = written_;
+                    slot.in_flight = true;
+                    ring_.queue(fixed_buffers_ ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE, file_.fd,
+                                slot.buffer.data.get(), request, slot.offset, current_,
+                                fixed_buffers_ ? static_cast<int>(current_) : -1);
+                    ring_.enter(false);
+                    written_ += slot.length;
+                    slot.length = request;
+
+                    current_ = (current_ + 1) % slots_.size();
+                    wait_for(current_);
+                    slots_[current_].length = 0;
+                }
+
+                void wait_for(std::size_t index) {
+                    while (slots_[index].in_flight) {
+                        io_uring_cqe cqe = ring_.wait();
+                        Slot& done = slots_[cqe.user_data];
+                        done.in_flight = false;
+                        if (cqe.res < 0) {
+                            error_ = -cqe.res;
+                        } else if (static_cast<std::size_t>(cqe.res) < done.length) {
+                            finish_short_write(done, static_cast<std::size_t>(cqe.res));
+                        }
+                    }
+                }
+
+                void finish_short_write(const Slot& slot, std::size_t sent) {
+                    while (sent < slot.length) {
+                        ssize_t n = pwrite(file_.fd, slot.buffer.data.get() + sent,  // NOLINT
+                                           slot.length - sent,
+                                           static_cast<off_t>(slot.offset + sent));
+                        if (n <= 0) {
+                            error_ = errno != 0 ? errno : EIO;
+                            return;
+                        }
+                        sent += static_cast<std::size_t>(n);
+                    }
+                }
+
+                std::size_t block_size_;
+                bool direct_;
+                FileDescriptor file_;
+                FileDescriptor buffered_;  // Page-cache descriptor for syncing O_DIRECT tails
+                IoUring ring_;
+                std::vector<Slot> slots_;
+                bool fixed_buffers_ = false;
+                std::size_t current_ = 0;
+                std::uint64_t written_ = 0;
+                int error_ = 0;
+                bool closed_ = false;
+            };
+#endif
+
+            std::unique_ptr<AsyncFileReader::Impl> make_reader(const std::string& filepath,
+                                                               const AsyncIoOptions& options,
+                                                               std::uint64_t offset) {
+#ifdef IV_CALCULATOR_HAS_IO_URING
+                if (options.backend == IoBackend::IO_URING) {
+                    return std::make_unique<UringReader>(filepath, options, offset);
+                }
+                if (options.backend == IoBackend::AUTO) {
+                    try {
+                        return std::make_unique<UringReader>(filepath, options, offset);
+                    } catch (const std::runtime_error&) {
+                        // Kernel without io_uring or a file it cannot handle
+                    }
+                }
+#else
+                if (options.backend == IoBackend::IO_URING) {
+                    throw std::runtime_error("io_uring is not available on this platform");
+                }
+#endif
+                return std::make_unique<StreamReader>(filepath, options, offset);
+            }
+
+            std::unique_ptr<AsyncFileWriter::Impl> make_writer(const std::string& filepath,
+                                                               const AsyncIoOptions& options,
+                                                               std::uint64_t offset) {
+#ifdef IV_CALCULATOR_HAS_IO_URING
+                if (options.backend == IoBackend::IO_URING) {
+                    return std::make_unique<UringWriter>(filepath, options, offset);
+                }
+                if (options.backend == IoBackend::AUTO) {
+                    try {
+                        return std::make_unique<UringWriter>(filepath, options, offset);
+                    } catch (const std::runtime_error&) {
+                        // Kernel without io_uring or a file it cannot handle
+                    }
+                }
+#else
+                if (options.backend == IoBackend::IO_URING) {
+                    throw std::runtime_error("io_uring is not available on this platform");
+                }
+#endif
+                return std::make_unique<StreamWriter>(filepath, offset);
+            }
+        }  // namespace
+
+        AsyncFileReader::AsyncFileReader(const std::string& filepath,
+                                         const AsyncIoOptions& options, std::uint64_t offset)
+            : impl_(make_reader(filepath, options, offset)) {}
+
+        AsyncFileReader::~AsyncFileReader() = default;
+        AsyncFileReader::AsyncFileReader(AsyncFileReader&&) noexcept = default;
+        AsyncFileReader& AsyncFileReader::operator=(AsyncFileReader&&) noexcept = default;
+
+        std::string_view AsyncFileReader::next() { return impl_->next(); }
+
+        IoBackend AsyncFileReader::backend() const { return impl_->backend(); }
+
+        AsyncFileWriter::AsyncFileWriter(const std::string& filepath,
+                                         const AsyncIoOptions& options, std::uint64_t offset)
+            : impl_(make_writer(filepath, options, offset)) {}
+
+        AsyncFileWriter::~AsyncFileWriter() = default;
+        AsyncFileWriter::AsyncFileWriter(AsyncFileWriter&&) noexcept = default;
+        AsyncFileWriter& AsyncFileWriter::operator=(AsyncFileWriter&&) noexcept = default;
+
+        void AsyncFileWriter::write(std::string_view data) { impl_->write(data); }
+
+        void AsyncFileWriter::sync() { impl_->sync(); }
+
+        std::uint64_t AsyncFileWriter::size() const { return impl_->size(); }
+
+        void AsyncFileWriter::close() { impl_->close(); }
+
+        IoBackend AsyncFileWriter::backend() const { return impl_->backend(); }
+
+    }  // namespace io
+}  // namespace iv_calculator
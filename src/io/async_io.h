@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace iv_calculator {
+    namespace io {
+
+        /**
+         * @brief Backend used for file reads and writes
+         */
+        enum class IoBackend : std::uint8_t {
+            AUTO,      ///< io_uring when the kernel supports it and its read and write
+                       ///< opcodes, std::fstream otherwise
+            IO_URING,  ///< Linux io_uring with several requests in flight
+            STREAM     ///< Blocking std::fstream, available on every platform
+        };
+
+        /**
+         * @brief Settings of the asynchronous file reader and writer
+         */
+        struct AsyncIoOptions {
+            IoBackend backend = IoBackend::AUTO;  // Requested backend
+            std::size_t block_size = 1 << 20;     // Bytes per request, rounded up to 4 KiB
+            unsigned queue_depth = 4;             // Requests kept in flight
+            bool direct_io = false;  // O_DIRECT with registered buffers (io_uring only)
+        };
+
+        /**
+         * @brief Parse an I/O backend name ("auto", "io_uring" or "stream")
+         *
+         * @param name Backend name
+         * @return IoBackend Parsed backend
+         */
+        IoBackend parse_io_backend(std::string_view name);
+
+        /**
+         * @brief Sequential file reader that keeps several reads in flight ahead of the consumer
+         */
+        class AsyncFileReader {
+        public:
+            /**
+             * @brief Open a file and start reading ahead
+             *
+             * @param filepath Path to the file
+             * @param options Backend and buffering settings
+             * @param offset Byte position of the first chunk
+             */
+            explicit AsyncFileReader(const std::string& filepath,
+                                     const AsyncIoOptions& options = AsyncIoOptions(),
+                                     std::uint64_t offset = 0);
+            ~AsyncFileReader();
+
+            AsyncFileReader(const AsyncFileReader&) = delete;
+            AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+            AsyncFileReader(AsyncFileReader&&) noexcept;
+            AsyncFileReader& operator=(AsyncFileReader&&) noexcept;
+
+            /**
+             * @brief Get the next chunk of the file in order
+             *
+             * The returned view stays valid until the next call.
+             *
+             * @return std::string_view Next chunk, empty at end of file
+             */
+            std::string_view next();
+
+            /**
+             * @brief Backend actually used after AUTO resolution
+             */
+            [[nodiscard]] IoBackend backend() const;
+
+            class Impl;
+
+        private:
+            std::unique_ptr<Impl> impl_;
+        };
+
+        /**
+         * @brief Sequential file writer that keeps several writes in flight behind the producer
+         */
+        class AsyncFileWriter {
+        public:
+            /**
+             * @brief Create or truncate a file for writing
+             *
+             * @param filepath Path to the file
+             * @param options Backend and buffering settings
+             * @param offset Bytes of an existing file to keep; writing continues after them
+             */
+            explicit AsyncFileWriter(const std::string& filepath,
+                                     const AsyncIoOptions& options = AsyncIoOptions(),
+                                     std::uint64_t offset = 0);
+            ~AsyncFileWriter();
+
+            AsyncFileWriter(const AsyncFileWriter&) = delete;
+            AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+            AsyncFileWriter(AsyncFileWriter&&) noexcept;
+            AsyncFileWriter& operator=(AsyncFileWriter&&) noexcept;
+
+            /**
+             * @brief Append data to the file
+             *
+             * Data is copied into a staging block; full blocks are submitted immediately.
+             *
+             * @param data Bytes to append
+             */
+            void write(std::string_view data);
+
+            /**
+             * @brief Write all data appended so far and wait until it is durable
+             *
+             * The io_uring backend syncs the file to storage; the stream backend hands the
+             * data to the operating system.
+             */
+            void sync();
+
+            /**
+             * @brief File size once all appended data is written
+             */
+            [[nodiscard]] std::uint64_t size() const;
+
+            /**
+             * @brief Flush pending data, wait for all writes and close the file
+             */
+            void close();
+
+            /**
+             * @brief Backend actually used after AUTO resolution
+             */
+            [[nodiscard]] IoBackend backend() const;
+
+            class Impl;
+
+        private:
+            std::unique_ptr<Impl> impl_;
+        };
+
+    }  // namespace io
+}  // namespace iv_calculator
@@ -0,0 +1,65 @@
+#include "binary_format.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace iv_calculator {
+    namespace io {
+        namespace binary_format {
+
+            namespace {
+                constexpr std::size_t kFlagsOffset = 6 * sizeof(double);
+            }  // namespace
+
+            std::array<char, kHeaderSize> header() {
+                std::array<char, kHeaderSize> data{};
+                auto record_size = static_cast<std::uint32_t>(kRecordSize);
+                std::copy(kMagic.begin(), kMagic.end(), data.begin());
+                std::memcpy(data.data() + 4, &kVersion, sizeof(kVersion));        // NOLINT
+                std::memcpy(data.data() + 8, &record_size, sizeof(record_size));  // NOLINT
+                return data;
+            }
+
+            void check_header(const char* data) {
+                std::uint32_t version = 0;
+                std::uint32_t record_size = 0;
+                std::memcpy(&version, data + 4, sizeof(version));          // NOLINT
+                std::memcpy(&record_size, data + 8, sizeof(record_size));  // NOLINT
+                if (!std::equal(kMagic.begin(), kMagic.end(), data) || version != kVersion ||
+                    record_size != kRecordSize) {
+                    throw std::runtime_error("Not a binary option file");
+                }
+            }
+
+            void encode(const OptionData& option, char* out) {
+                std::array<double, 6> values = {option.asset_price,    option.strike_price,
+                                                option.time_to_expiry, option.risk_free_rate,
+                                                option.option_price,   option.volatility};
+                std::memset(out, 0, kRecordSize);
+                std::memcpy(out, values.data(), sizeof(values));
+                out[kFlagsOffset] = option.is_call ? 1 : 0;                     // NOLINT
+                out[kFlagsOffset + 1] = static_cast<char>(option.model);        // NOLINT
+                out[kFlagsOffset + 2] = static_cast<char>(option.exercise);     // NOLINT
+            }
+
+            OptionData decode(const char* data) {
+                std::array<double, 6> values{};
+                std::memcpy(values.data(), data, sizeof(values));
+                OptionData option;
+                option.asset_price = values[0];
+                option.strike_price = values[1];
+                option.time_to_expiry = values[2];
+                option.risk_free_rate = values[3];
+                option.option_price = values[4];
+                option.volatility = values[5];
+                option.is_call = data[kFlagsOffset] != 0;                                 // NOLINT
+                option.model = static_cast<core::PricingModel>(data[kFlagsOffset + 1]);  // NOLINT
+                option.exercise =
+                    static_cast<core::ExerciseStyle>(data[kFlagsOffset + 2]);  // NOLINT
+                return option;
+            }
+
+        }  // namespace binary_format
+    }  // namespace io
+}  // namespace iv_calculator
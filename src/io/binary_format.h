@@ -0,0 +1,51 @@
+#pragma once
+
+#include "src/io/file_io.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace iv_calculator {
+    namespace io {
+
+        /**
+         * @brief Fixed-size binary record format for exchanging results between processes
+         *
+         * A 16-byte header (magic "IVCB", version, record size, reserved) is followed by
+         * 56-byte records: asset, strike, time, rate, price and volatility as doubles, then
+         * the call flag, the pricing model and the exercise style as one byte each and five
+         * bytes of padding. Values are stored in the byte order of the host.
+         */
+        namespace binary_format {
+            constexpr std::array<char, 4> kMagic = {'I', 'V', 'C', 'B'};
+            constexpr std::uint32_t kVersion = 1;
+            constexpr std::size_t kHeaderSize = 16;
+            constexpr std::size_t kRecordSize = 56;
+
+            /**
+             * @brief Header of a binary file
+             */
+            std::array<char, kHeaderSize> header();
+
+            /**
+             * @brief Check a binary file header
+             *
+             * @param data First kHeaderSize bytes of the file
+             * @throws std::runtime_error If the header is not a supported binary header
+             */
+            void check_header(const char* data);
+
+            /**
+             * @brief Encode one record into kRecordSize bytes
+             */
+            void encode(const OptionData& option, char* out);
+
+            /**
+             * @brief Decode one record from kRecordSize bytes
+             */
+            OptionData decode(const char* data);
+        }  // namespace binary_format
+
+    }  // namespace io
+}  // namespace iv_calculator
@@ -0,0 +1,122 @@
+#include "compact_option.h"
+
+namespace iv_calculator {
+    namespace io {
+
+        namespace {
+            bool quote_is_volatility(const OptionData& option) {
+                return option.volatility > 0 && option.option_price <= 0;
+            }
+
+            // Fill the fields of a record that are decoded from packed flags
+            void apply_flags(std::uint8_t flags, OptionData& option) {
+                option.is_call = (flags & option_flags::kCall) != 0;
+                option.exercise = (flags & option_flags::kAmerican) != 0
+                                      ? core::ExerciseStyle::AMERICAN
+                                      : core::ExerciseStyle::EUROPEAN;
+                option.model = static_cast<core::PricingModel>(
+                    static_cast<unsigned>(flags & option_flags::kModelMask) >>
+                    option_flags::kModelShift);
+            }
+        }  // namespace
+
+        std::uint8_t pack_option_flags(const OptionData& option) {
+            unsigned flags = static_cast<unsigned>(option.model) << option_flags::kModelShift;
+            flags |= option.is_call ? option_flags::kCall : 0U;
+            flags |= option.exercise == core::ExerciseStyle::AMERICAN ? option_flags::kAmerican
+                                                                       : 0U;
+            flags |= quote_is_volatility(option) ? option_flags::kQuoteIsVolatility : 0U;
+            return static_cast<std::uint8_t>(flags);
+        }
+
+        PackedOption pack_option(const OptionData& option) {
+            PackedOption packed;
+            packed.asset_price = option.asset_price;
+            packed.strike_price = option.strike_price;
+            packed.quote = quote_is_volatility(option) ? option.volatility : option.option_price;
+            packed.time_to_expiry = static_cast<float>(option.time_to_expiry);
+            packed.risk_free_rate = static_cast<float>(option.risk_free_rate);
+            packed.flags = pack_option_flags(option);
+            return packed;
+        }
+
+        OptionData unpack_option(const PackedOption& packed) {
+            OptionData option;
+            option.asset_price = packed.asset_price;
+            option.strike_price = packed.strike_price;
+            option.time_to_expiry = packed.time_to_expiry;
+            option.risk_free_rate = packed.risk_free_rate;
+            if ((packed.flags & option_flags::kQuoteIsVolatility) != 0) {
+                option.volatility = packed.quote;
+            } else {
+                option.option_price = packed.quote;
+            }
+            apply_flags(packed.flags, option);
+            return option;
+        }
+
+        void OptionColumns::reserve(std::size_t count) {
+            asset_price.reserve(count);
+            strike_price.reserve(count);
+            quote.reserve(count);
+            time_to_expiry.reserve(count);
+            risk_free_rate.reserve(count);
+            flags.reserve(count);
+            option_price.reserve(count);
+            volatility.reserve(count);
+        }
+
+        void OptionColumns::push_back(const OptionData& option) {
+            PackedOption packed = pack_option(option);
+            asset_price.push_back(packed.asset_price);
+            strike_price.push_back(packed.strike_price);
+            quote.push_back(packed.quote);
+            time_to_expiry.push_back(packed.time_to_expiry);
+            risk_free_rate.push_back(packed.risk_free_rate);
+            flags.push_back(packed.flags);
+            option_price.push_back(option.option_price);
+            volatility.push_back(option.volatility);
+        }
+
+        OptionData OptionColumns::row(std::size_t index) const {
+            OptionData option;
+            option.asset_price = asset_price[index];
+            option.strike_price = strike_price[index];
+            option.time_to_expiry = time_to_expiry[index];
+            option.risk_free_rate = risk_free_rate[index];
+            option.option_price = option_price[index];
+            option.volatility = volatility[index];
+            apply_flags(flags[index], option);
+            return option;
+        }
+
+        core::OptionBatch OptionColumns::batch() const {
+            core::OptionBatch batch;
+            batch.reserve(size());
+            for (std::size_t i = 0; i < size(); ++i) {
+                batch.push_back((flags[i] & option_flags::kCall) != 0, asset_price[i],
+                                strike_price[i], time_to_expiry[i], risk_free_rate[i]);
+            }
+            return batch;
+        }
+
+        OptionColumns to_columns(const std::vector<OptionData>& options) {
+            OptionColumns columns;
+            columns.reserve(options.size());
+            for (const OptionData& option : options) {
+                columns.push_back(option);
+            }
+            return columns;
+        }
+
+        std::vector<OptionData> to_options(const OptionColumns& columns) {
+            std::vector<OptionData> options;
+            options.reserve(columns.size());
+            for (std::size_t i = 0; i < columns.size(); ++i) {
+                options.push_back(columns.row(i));
+            }
+            return options;
+        }
+
+    }  // namespace io
+}  // namespace iv_calculator
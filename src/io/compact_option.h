@@ -0,0 +1,140 @@
+#pragma once
+
+#include "src/core/option_batch.h"
+#include "src/io/file_io.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace iv_calculator {
+    namespace io {
+
+        /**
+         * @brief Bits of the packed flags byte of PackedOption and OptionColumns
+         */
+        namespace option_flags {
+            constexpr std::uint8_t kCall = 1U << 0U;      // Call option, Put when clear
+            constexpr std::uint8_t kAmerican = 1U << 1U;  // American exercise
+            constexpr std::uint8_t kQuoteIsVolatility = 1U << 2U;  // Quote is a volatility
+            constexpr unsigned kModelShift = 3;                    // Pricing model in bits 3-4
+            constexpr std::uint8_t kModelMask = 3U << kModelShift;
+        }  // namespace option_flags
+
+        /**
+         * @brief Pack the call flag, exercise style, pricing model and quote kind of a record
+         *
+         * The quote is a volatility when the record is to be priced (volatility set, no
+         * price) and the market price otherwise.
+         *
+         * @param option Record to describe
+         * @return std::uint8_t Packed option_flags bits
+         */
+        std::uint8_t pack_option_flags(const OptionData& option);
+
+        /**
+         * @brief Input fields of one option in 40 instead of 64 bytes
+         *
+         * Time to expiry and rate are stored as float: seven significant digits keep expiries
+         * to within seconds and rates to well under a thousandth of a basis point. The option
+         * price and volatility share one quote field, since a row is either priced or
+         * inverted; results are kept apart from the inputs (see OptionColumns).
+         */
+        struct PackedOption {
+            double asset_price = 0;   // Current price of underlying asset
+            double strike_price = 0;  // Strike price
+            double quote = 0;         // Market price, or volatility with kQuoteIsVolatility
+            float time_to_expiry = 0;  // Time to expiration in years
+            float risk_free_rate = 0;  // Risk-free interest rate
+            std::uint8_t flags = option_flags::kCall;  // option_flags bits
+        };
+        static_assert(sizeof(PackedOption) == 40, "PackedOption must stay compact");
+
+        /**
+         * @brief Pack the inputs of a record
+         *
+         * @param option Record to pack
+         * @return PackedOption Packed inputs; the field not used as the quote is dropped
+         */
+        PackedOption pack_option(const OptionData& option);
+
+        /**
+         * @brief Expand a packed record
+         *
+         * @param packed Packed inputs
+         * @return OptionData Record with the quote in its price or volatility field
+         */
+        OptionData unpack_option(const PackedOption& packed);
+
+        /**
+         * @brief Column-per-field layout of many options with separate result columns
+         *
+         * The input columns use the PackedOption encoding, so a pass that reads a few fields
+         * only moves those columns through the cache. Solvers write option_price and
+         * volatility, which start out as the values read from the input.
+         */
+        struct OptionColumns {
+            std::vector<double> asset_price;
+            std::vector<double> strike_price;
+            std::vector<double> quote;
+            std::vector<float> time_to_expiry;
+            std::vector<float> risk_free_rate;
+            std::vector<std::uint8_t> flags;
+
+            // Results
+            std::vector<double> option_price;
+            std::vector<double> volatility;
+
+            /**
+             * @brief Number of options
+             */
+            [[nodiscard]] std::size_t size() const { return asset_price.size(); }
+
+            /**
+             * @brief Reserve storage for the given number of options
+             *
+             * @param count Expected number of options
+             */
+            void reserve(std::size_t count);
+
+            /**
+             * @brief Append one record
+             *
+             * @param option Record to append
+             */
+            void push_back(const OptionData& option);
+
+            /**
+             * @brief Record at a row, with the result columns as price and volatility
+             *
+             * @param index Row index
+             * @return OptionData Expanded record
+             */
+            [[nodiscard]] OptionData row(std::size_t index) const;
+
+            /**
+             * @brief View the inputs as an OptionBatch for the batch solvers
+             *
+             * @return core::OptionBatch Batch in row order
+             */
+            [[nodiscard]] core::OptionBatch batch() const;
+        };
+
+        /**
+         * @brief Convert records to the columnar layout
+         *
+         * @param options Records to convert
+         * @return OptionColumns Columns in record order
+         */
+        OptionColumns to_columns(const std::vector<OptionData>& options);
+
+        /**
+         * @brief Convert the columnar layout back to records
+         *
+         * @param columns Columns to convert
+         * @return std::vector<OptionData> Records in row order
+         */
+        std::vector<OptionData> to_options(const OptionColumns& columns);
+
+    }  // namespace io
+}  // namespace iv_calculator
@@ -0,0 +1,603 @@
+#include "csv_reader.h"
+
+#include "src/io/occ_symbol.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace iv_calculator {
+    namespace io {
+
+        namespace {
+            constexpr std::array<CsvField, 5> kRequiredFields = {
+                CsvField::TYPE, CsvField::ASSET, CsvField::STRIKE, CsvField::TIME, CsvField::RATE};
+
+            // Field names accepted by --csv-map, in CsvField order
+            constexpr std::array<std::string_view, kCsvFieldCount> kFieldNames = {
+                "type",  "asset", "strike", "time",     "rate",   "price",     "volatility",
+                "model", "bid",   "ask",    "quantity", "expiry", "valuation", "symbol",
+                "occ"};
+
+            // Lower-case letters and digits only, so "Risk_Free Rate" matches "riskfreerate"
+            std::string normalize_name(std::string_view name) {
+                std::string normalized;
+                normalized.reserve(name.size());
+                for (char c : name) {
+                    if (std::isalnum(static_cast<unsigned char>(c)) != 0) {
+                        normalized.push_back(
+                            static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+                    }
+                }
+                return normalized;
+            }
+
+            // Strip blanks, a carriage return and enclosing quotes from a cell
+            std::string_view trim_cell(std::string_view cell) {
+                while (!cell.empty() && (cell.front() == ' ' || cell.front() == '\t')) {
+                    cell.remove_prefix(1);
+                }
+                while (!cell.empty() &&
+                       (cell.back() == ' ' || cell.back() == '\t' || cell.back() == '\r')) {
+                    cell.remove_suffix(1);
+                }
+                if (cell.size() >= 2 && cell.front() == '"' && cell.back() == '"') {
+                    cell = cell.substr(1, cell.size() - 2);
+                }
+                return cell;
+            }
+
+            // End of the cell starting at pos, or npos when it is the last one on the line.
+            // Quoted cells may contain commas.
+            std::size_t cell_end(std::string_view line, std::size_t pos) {
+                if (pos < line.size() && line[pos] == '"') {
+                    std::size_t quote = line.find('"', pos + 1);
+                    while (quote != std::string_view::npos && quote + 1 < line.size() &&
+                           line[quote + 1] == '"') {
+                        quote = line.find('"', quote + 2);  // Escaped quote
+                    }
+                    if (quote == std::string_view::npos) {
+                        return std::string_view::npos;
+                    }
+                    pos = quote + 1;
+                }
+                return line.find(',', pos);
+            }
+
+            // High bit set in the lowest byte of word equal to the byte broadcast in pattern
+            // (higher bytes may be flagged spuriously, the lowest one never is)
+            constexpr std::uint64_t byte_matches(std::uint64_t word, std::uint64_t pattern) {
+                constexpr std::uint64_t kOnes = 0x0101010101010101ULL;
+                constexpr std::uint64_t kHighBits = 0x8080808080808080ULL;
+                std::uint64_t x = word ^ pattern;
+                return (x - kOnes) & ~x & kHighBits;
+            }
+
+            // Position after the next `count` cells, or npos when the line ends first. The
+            // cells are only scanned for separators and quotes, never parsed; unquoted bytes
+            // are stepped over eight at a time.
+            std::size_t skip_cells(std::string_view line, std::size_t pos, std::size_t count) {
+                constexpr std::uint64_t kCommas = 0x2C2C2C2C2C2C2C2CULL;
+                constexpr std::uint64_t kQuotes = 0x2222222222222222ULL;
+                bool quoted = false;
+                while (pos < line.size()) {
+                    if (!quoted) {
+                        // Jump to the next comma or quote (little-endian byte order)
+                        std::uint64_t word = 0;
+                        while (pos + sizeof(word) <= line.size()) {
+                            std::memcpy(&word, line.data() + pos, sizeof(word));
+                            std::uint64_t hits =
+                                byte_matches(word, kCommas) | byte_matches(word, kQuotes);
+                            if (hits != 0) {
+                                pos += static_cast<std::size_t>(__builtin_ctzll(hits)) / 8;
+                                break;
+                            }
+                            pos += sizeof(word);
+                        }
+                        if (pos >= line.size()) {
+                            break;
+                        }
+                    }
+
+                    char c = line[pos++];
+                    if (c == '"') {
+                        quoted = !quoted;  // An escaped quote toggles twice
+                    } else if (c == ',' && !quoted && --count == 0) {
+                        return pos;
+                    }
+                }
+                return std::string_view::npos;
+            }
+
+            // Split a line into its cells
+            std::vector<std::string_view> split_cells(std::string_view line) {
+                std::vector<std::string_view> cells;
+                std::size_t pos = 0;
+                while (true) {
+                    std::size_t end = cell_end(line, pos);
+                    if (end == std::string_view::npos) {
+                        cells.push_back(line.substr(pos));
+                        return cells;
+                    }
+                    cells.push_back(line.substr(pos, end - pos));
+                    pos = end + 1;
+                }
+            }
+
+            // Powers of ten that are exactly representable as doubles
+            constexpr std::array<double, 23> kExactPowersOfTen = {
+                1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+            // Fast path for plain decimals such as "-101.25". With at most 15 significant
+            // digits and 22 fraction digits both operands of the division are exact, so the
+            // result is correctly rounded. Anything else is left to std::from_chars.
+            bool parse_plain_decimal(std::string_view digits, double& value) {
+                std::size_t i = 0;
+                bool negative = !digits.empty() && digits.front() == '-';
+                if (negative) {
+                    ++i;
+                }
+
+                std::uint64_t mantissa = 0;
+                int significant = 0;
+                int fraction = 0;
+                bool seen_digit = false;
+                bool seen_point = false;
+                for (; i < digits.size(); ++i) {
+                    char c = digits[i];
+                    if (c >= '0' && c <= '9') {
+                        seen_digit = true;
+                        mantissa = mantissa * 10 + static_cast<std::uint64_t>(c - '0');
+                        significant += mantissa != 0 ? 1 : 0;
+                        fraction += seen_point ? 1 : 0;
+                    } else if (c == '.' && !seen_point) {
+                        seen_point = true;
+                    } else {
+                        return false;
+                    }
+                }
+                if (!seen_digit || significant > 15 ||
+                    fraction >= static_cast<int>(kExactPowersOfTen.size())) {
+                    return false;
+                }
+
+                value = static_cast<double>(mantissa) /
+                        kExactPowersOfTen.at(static_cast<std::size_t>(fraction));
+                value = negative ? -value : value;
+                return true;
+            }
+
+            double parse_number(std::string_view cell) {
+                std::string_view digits = trim_cell(cell);
+                if (!digits.empty() && digits.front() == '+') {
+                    digits.remove_prefix(1);
+                }
+                double value = NAN;
+                if (parse_plain_decimal(digits, value)) {
+                    return value;
+                }
+                auto result = std::from_chars(digits.data(), digits.data() + digits.size(), value);
+                if (result.ec != std::errc()) {
+                    throw std::invalid_argument("Invalid number '" + std::string(cell) + "'");
+                }
+                return value;
+            }
+
+            // ASCII case-insensitive comparison against a lower-case word
+            bool equals_lower(std::string_view text, std::string_view lower) {
+                return text.size() == lower.size() &&
+                       std::equal(text.begin(), text.end(), lower.begin(), [](char a, char b) {
+                           return (a >= 'A' && a <= 'Z' ? static_cast<char>(a - 'A' + 'a') : a) ==
+                                  b;
+                       });
+            }
+
+            bool parse_is_call(std::string_view cell) {
+                std::string_view type = trim_cell(cell);
+                return equals_lower(type, "call") || equals_lower(type, "c");
+            }
+
+            void assign_field(OptionData& option, CsvField field, std::string_view cell,
+                              bool exact, SymbolPool* symbols, ContractPool* contracts) {
+                switch (field) {
+                    case CsvField::TYPE:
+                        option.is_call =
+                            exact ? cell == "call" || cell == "Call" : parse_is_call(cell);
+                        break;
+                    case CsvField::ASSET:
+                        option.asset_price = parse_number(cell);
+                        break;
+                    case CsvField::STRIKE:
+                        option.strike_price = parse_number(cell);
+                        break;
+                    case CsvField::TIME:
+                        option.time_to_expiry = parse_number(cell);
+                        break;
+                    case CsvField::RATE:
+                        option.risk_free_rate = parse_number(cell);
+                        break;
+                    case CsvField::PRICE:
+                        if (!trim_cell(cell).empty()) {
+                            option.option_price = parse_number(cell);
+                        }
+                        break;
+                    case CsvField::VOLATILITY:
+                        if (!trim_cell(cell).empty()) {
+                            option.volatility = parse_number(cell);
+                        }
+                        break;
+                    case CsvField::MODEL:
+                        if (!trim_cell(cell).empty()) {
+                            option.model = core::parse_pricing_model(trim_cell(cell));
+                        }
+                        break;
+                    case CsvField::BID:
+                        if (!trim_cell(cell).empty()) {
+                            option.bid_price = parse_number(cell);
+                        }
+                        break;
+                    case CsvField::ASK:
+                        if (!trim_cell(cell).empty()) {
+                            option.ask_price = parse_number(cell);
+                        }
+                        break;
+                    case CsvField::QUANTITY:
+                        if (!trim_cell(cell).empty()) {
+                            option.quantity = parse_number(cell);
+                        }
+                        break;
+                    case CsvField::EXPIRY:
+                        option.expiry_date = core::parse_timestamp(trim_cell(cell));
+                        break;
+                    case CsvField::VALUATION:
+                        if (!trim_cell(cell).empty()) {
+                            option.valuation_time = core::parse_timestamp(trim_cell(cell));
+                        }
+                        break;
+                    case CsvField::SYMBOL:
+                        if (symbols != nullptr) {
+                            option.underlying = symbols->intern(trim_cell(cell));
+                        }
+                        break;
+                    case CsvField::OCC: {
+                        OccSymbol occ = parse_occ_symbol(cell);
+                        option.is_call = occ.is_call;
+                        option.strike_price = occ.strike_milli / 1000.0;
+                        option.expiry_date = occ.expiry_day;
+                        if (symbols != nullptr) {
+                            // A symbol column, if any, names the underlying instead of the root
+                            std::uint32_t root = symbols->intern(occ.root);
+                            option.underlying = option.underlying != 0 ? option.underlying : root;
+                            if (contracts != nullptr) {
+                                option.contract = contracts->intern(
+                                    {root, occ.expiry_day, occ.strike_milli, occ.is_call});
+                            }
+                        }
+                        break;
+                    }
+                    case CsvField::VALUE_KIND:
+                        if (exact ? !cell.empty() && cell != "price"
+                                   : !trim_cell(cell).empty() &&
+                                         !equals_lower(trim_cell(cell), "price")) {
+                            option.volatility = option.option_price;
+                            option.option_price = 0;
+                        }
+                        break;
+                    case CsvField::SKIP:
+                        break;
+                }
+            }
+        }  // namespace
+
+        CsvColumnMap::CsvColumnMap()
+            : names{{{"Type", "OptionType", "CallPut", "PutCall", "CP", "Right"},
+                     {"Asset", "AssetPrice", "Underlying", "UnderlyingPrice", "Spot", "S"},
+                     {"Strike", "StrikePrice", "K"},
+                     {"Time", "TimeToExpiry", "TTE", "T"},
+                     {"Rate", "RiskFreeRate", "InterestRate", "R"},
+                     {"Price", "OptionPrice", "Premium", "Mid"},
+                     {"Volatility", "Vol", "IV", "ImpliedVolatility", "Sigma"},
+                     {"Model", "PricingModel"},
+                     {"Bid", "BidPrice"},
+                     {"Ask", "AskPrice", "Offer", "OfferPrice"},
+                     {"Quantity", "Qty", "Position", "Contracts"},
+                     {"Expiry", "ExpiryDate", "Expiration", "ExpirationDate", "Maturity"},
+                     {"Valuation", "ValuationDate", "ValuationTime", "AsOf", "Timestamp"},
+                     {"Symbol", "Ticker", "Root", "UnderlyingSymbol"},
+                     {"OccSymbol", "OSI", "OCC", "OsiSymbol", "OptionSymbol", "ContractSymbol"}}} {}
+
+        void CsvColumnMap::set(CsvField field, std::string header_name) {
+            names.at(static_cast<std::size_t>(field)) = {std::move(header_name)};
+            user_defined = true;
+        }
+
+        CsvColumnMap parse_csv_column_map(std::string_view spec) {
+            CsvColumnMap map;
+            for (std::string_view pair : split_cells(spec)) {
+                std::size_t equals = pair.find('=');
+                if (equals == std::string_view::npos) {
+                    throw std::invalid_argument("Column mapping must be field=header: " +
+                                                std::string(pair));
+                }
+                std::string field = normalize_name(pair.substr(0, equals));
+                std::string_view header = trim_cell(pair.substr(equals + 1));
+                const auto* it = std::find(kFieldNames.begin(), kFieldNames.end(), field);
+                if (it == kFieldNames.end() || header.empty()) {
+                    throw std::invalid_argument("Invalid column mapping: " + std::string(pair));
+                }
+                map.set(static_cast<CsvField>(it - kFieldNames.begin()), std::string(header));
+            }
+            return map;
+        }
+
+        CsvSchema CsvSchema::positional() {
+            CsvSchema schema;
+            for (std::size_t i = 0; i < kPositionalFieldCount; ++i) {
+                schema.columns.push_back(static_cast<CsvField>(i));
+            }
+            return schema;
+        }
+
+        CsvSchema CsvSchema::legacy() {
+            CsvSchema schema;
+            schema.columns = {CsvField::TYPE, CsvField::ASSET, CsvField::STRIKE, CsvField::TIME,
+                              CsvField::RATE, CsvField::PRICE, CsvField::VALUE_KIND};
+            schema.min_cells = 6;
+            schema.exact_cells = true;
+            return schema;
+        }
+
+        CsvSchema resolve_csv_schema(std::string_view header, const CsvColumnMap& map) {
+            // Byte order mark written by some spreadsheet exports
+            constexpr std::string_view kBom = "\xEF\xBB\xBF";
+            if (header.substr(0, kBom.size()) == kBom) {
+                header.remove_prefix(kBom.size());
+            }
+
+            std::vector<std::string> header_names;
+            for (std::string_view cell : split_cells(header)) {
+                header_names.push_back(normalize_name(trim_cell(cell)));
+            }
+
+            CsvSchema schema;
+            schema.from_header = true;
+            schema.columns.assign(header_names.size(), CsvField::SKIP);
+
+            // Earlier aliases win; a column feeds at most one field
+            for (std::size_t field = 0; field < kCsvFieldCount; ++field) {
+                for (const std::string& alias : map.names.at(field)) {
+                    std::string wanted = normalize_name(alias);
+                    auto it = std::find(header_names.begin(), header_names.end(), wanted);
+                    auto column = static_cast<std::size_t>(it - header_names.begin());
+                    if (it != header_names.end() && schema.columns[column] == CsvField::SKIP) {
+                        schema.columns[column] = static_cast<CsvField>(field);
+                        break;
+                    }
+                }
+            }
+
+            // Only a header that names no known field is taken for data of a headerless file
+            bool recognised = std::any_of(schema.columns.begin(), schema.columns.end(),
+                                          [](CsvField field) { return field != CsvField::SKIP; });
+            auto has = [&schema](CsvField field) {
+                return std::find(schema.columns.begin(), schema.columns.end(), field) !=
+                       schema.columns.end();
+            };
+            for (CsvField field : kRequiredFields) {
+                // Times to expiry may come from expiry dates, rates from a curve, and type,
+                // strike and expiry from OCC symbols
+                bool from_occ = field == CsvField::TYPE || field == CsvField::STRIKE ||
+                                field == CsvField::TIME;
+                if (!has(field) && !(field == CsvField::TIME && has(CsvField::EXPIRY)) &&
+                    !(field == CsvField::RATE && map.rate_optional) &&
+                    !(from_occ && has(CsvField::OCC))) {
+                    if (!map.user_defined && !recognised) {
+                        return CsvSchema::positional();
+                    }
+                    throw std::runtime_error(
+                        "CSV header has no column for '" +
+                        std::string(kFieldNames.at(static_cast<std::size_t>(field))) + "'");
+                }
+            }
+
+            // Cells after the last needed column are never scanned
+            while (!schema.columns.empty() && schema.columns.back() == CsvField::SKIP) {
+                schema.columns.pop_back();
+            }
+            return schema;
+        }
+
+        OptionData parse_csv_record(std::string_view line, const CsvSchema& schema,
+                                    SymbolPool* symbols, ContractPool* contracts) {
+            OptionData option;
+            const std::vector<CsvField>& columns = schema.columns;
+            if (schema.min_cells > 0 &&
+                static_cast<std::size_t>(std::count(line.begin(), line.end(), ',')) + 1 <
+                    schema.min_cells) {
+                throw std::invalid_argument("Invalid CSV format");
+            }
+
+            std::size_t pos = 0;
+            std::size_t column = 0;
+            // A short row leaves the remaining fields at their defaults
+            while (column < columns.size() && pos != std::string_view::npos) {
+                if (columns[column] == CsvField::SKIP) {
+                    // Step over a run of unneeded cells in one pass
+                    std::size_t run = 1;
+                    while (column + run < columns.size() &&
+                           columns[column + run] == CsvField::SKIP) {
+                        ++run;
+                    }
+                    pos = skip_cells(line, pos, run);
+                    column += run;
+                    continue;
+                }
+
+                std::size_t end = cell_end(line, pos);
+                assign_field(option, columns[column], line.substr(pos, end - pos),
+                             schema.exact_cells, symbols, contracts);
+                pos = end == std::string_view::npos ? end : end + 1;
+                ++column;
+            }
+            return option;
+        }
+
+        std::vector<OptionData> read_csv(const std::string& filepath, const CsvColumnMap& map,
+                                         const AsyncIoOptions& io_options) {
+            CsvReader reader(filepath, map, io_options);
+            std::vector<OptionData> options;
+            OptionData option;
+            while (reader.next(option)) {
+                options.push_back(option);
+            }
+            return options;
+        }
+
+        CsvReader::CsvReader(const std::string& filepath, const CsvColumnMap& map,
+                             const AsyncIoOptions& io_options)
+            : filepath_(filepath),
+              io_options_(io_options),
+              reader_(std::make_unique<AsyncFileReader>(filepath, io_options)) {
+            std::string_view header;
+            schema_ = next_line(header) ? resolve_csv_schema(header, map) : CsvSchema::positional();
+        }
+
+        CsvReader::CsvReader(const std::string& filepath, CsvSchema schema,
+                             const AsyncIoOptions& io_options)
+            : filepath_(filepath),
+              io_options_(io_options),
+              reader_(std::make_unique<AsyncFileReader>(filepath, io_options)),
+              schema_(std::move(schema)) {
+            std::string_view header;
+            next_line(header);
+        }
+
+        bool CsvReader::next(OptionData& option) {
+            std::string_view line;
+            while (next_line(line)) {
+                if (line.empty()) {
+                    continue;
+                }
+                try {
+                    option = parse_csv_record(line, schema_, &symbols_, &contracts_);
+                } catch (const std::invalid_argument& e) {
+                    throw std::invalid_argument(
+                        std::string(e.what()) +
+                        (line_number_ != 0 ? " on CSV line " + std::to_string(line_number_)
+                                           : " in CSV record ending at byte " +
+                                                 std::to_string(offset_)));
+                }
+                return true;
+            }
+            return false;
+        }
+
+        bool CsvReader::skip() {
+            std::string_view line;
+            while (next_line(line)) {
+                if (!line.empty()) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void CsvReader::seek_partition(std::size_t index, std::size_t count) {
+            // The header has been read, so offset_ is where the data starts
+            std::uint64_t data_begin = offset_;
+            std::uint64_t data_size = std::filesystem::file_size(filepath_) - data_begin;
+            std::uint64_t begin = data_begin + data_size * index / count;
+            end_offset_ = data_begin + data_size * (index + 1) / count;
+            if (index == 0) {
+                return;
+            }
+
+            // Resume one byte early and drop the line that starts before the range, so a
+            // range that begins exactly at a line start keeps that line
+            reopen(begin - 1);
+            std::string_view line;
+            next_line(line);
+        }
+
+        void CsvReader::seek(std::uint64_t position) { reopen(position); }
+
+        void CsvReader::reopen(std::uint64_t offset) {
+            reader_ = std::make_unique<AsyncFileReader>(filepath_, io_options_, offset);
+            chunk_ = {};
+            partial_.clear();
+            partial_returned_ = false;
+            eof_ = false;
+            offset_ = offset;
+            count_lines_ = false;
+            line_number_ = 0;
+        }
+
+        std::size_t CsvReader::read_batch(std::vector<OptionData>& options,
+                                          std::size_t max_rows) {
+            std::size_t count = 0;
+            OptionData option;
+            while (count < max_rows && next(option)) {
+                options.push_back(option);
+                ++count;
+            }
+            return count;
+        }
+
+        // Lines are cut out of the read-ahead chunks; only a line that straddles two chunks
+        // is copied
+        bool CsvReader::next_line(std::string_view& line) {
+            if (partial_returned_) {
+                partial_.clear();
+                partial_returned_ = false;
+            }
+            if (offset_ >= end_offset_) {
+                return false;
+            }
+
+            while (true) {
+                std::size_t end = chunk_.find('\n');
+                if (end != std::string_view::npos) {
+                    offset_ += partial_.size() + end + 1;
+                    if (partial_.empty()) {
+                        line = chunk_.substr(0, end);
+                    } else {
+                        partial_.append(chunk_.substr(0, end));
+                        line = partial_;
+                        partial_returned_ = true;
+                    }
+                    chunk_.remove_prefix(end + 1);
+                    break;
+                }
+
+                partial_.append(chunk_);
+                chunk_ = eof_ ? std::string_view() : reader_->next();
+                if (chunk_.empty()) {
+                    eof_ = true;
+                    if (partial_.empty()) {
+                        return false;
+                    }
+                    offset_ += partial_.size();
+                    line = partial_;
+                    partial_returned_ = true;
+                    break;
+                }
+            }
+
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            if (count_lines_) {
+                ++line_number_;
+            }
+            return true;
+        }
+
+    }  // namespace io
+}  // namespace iv_calculator
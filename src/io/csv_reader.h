@@ -0,0 +1,255 @@
+#pragma once
+
+#include "src/io/async_io.h"
+#include "src/io/file_io.h"
+#include "src/io/option_reader.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace iv_calculator {
+    namespace io {
+
+        /**
+         * @brief OptionData field fed by a CSV column
+         */
+        enum class CsvField : std::uint8_t {
+            TYPE,
+            ASSET,
+            STRIKE,
+            TIME,
+            RATE,
+            PRICE,
+            VOLATILITY,
+            MODEL,
+            BID,         ///< Bid quote, solved alongside the price when requested
+            ASK,         ///< Ask quote
+            QUANTITY,    ///< Position size, weighting the row in risk rollups
+            EXPIRY,      ///< Expiry date or timestamp, standing in for the time to expiry
+            VALUATION,   ///< Valuation date or timestamp of the row
+            SYMBOL,      ///< Underlying symbol, interned into the reader's pool
+            OCC,         ///< OCC/OSI option symbol, standing in for type, strike and expiry
+            VALUE_KIND,  ///< Legacy marker: anything but "price" makes the price cell a volatility
+            SKIP         ///< Column not needed; its bytes are stepped over without parsing
+        };
+
+        /// Number of CsvField values that can be mapped by header name
+        constexpr std::size_t kCsvFieldCount = 15;
+
+        /// Number of leading CsvField values in the positional layout
+        constexpr std::size_t kPositionalFieldCount = 8;
+
+        /**
+         * @brief Header names that map CSV columns onto OptionData fields
+         *
+         * Every field starts with a list of common aliases ("Asset", "Underlying", "Spot", ...).
+         * Names are compared case-insensitively, ignoring spaces, '_' and '-'.
+         */
+        struct CsvColumnMap {
+            std::array<std::vector<std::string>, kCsvFieldCount> names;  // Aliases per field
+            bool user_defined = false;  // Set when any field was mapped explicitly
+            bool rate_optional = false;  // Set when rates come from a yield curve instead
+
+            CsvColumnMap();
+
+            /**
+             * @brief Map a field onto a single header name, replacing its aliases
+             *
+             * @param field Field to map
+             * @param header_name Name of the CSV column holding it
+             */
+            void set(CsvField field, std::string header_name);
+        };
+
+        /**
+         * @brief Parse a column mapping such as "asset=UnderlyingPrice,price=Mid"
+         *
+         * Field names are type, asset, strike, time, rate, price, volatility, model, bid, ask,
+         * quantity, expiry, valuation, symbol and occ.
+         *
+         * @param spec Comma-separated field=header pairs
+         * @return CsvColumnMap Default aliases with the listed fields replaced
+         */
+        CsvColumnMap parse_csv_column_map(std::string_view spec);
+
+        /**
+         * @brief Column layout of one CSV file, resolved from its header
+         */
+        struct CsvSchema {
+            std::vector<CsvField> columns;  // Field of each column, up to the last one needed
+            std::size_t min_cells = 0;      // Shorter records are rejected
+            bool from_header = false;       // False for positional layouts
+            bool exact_cells = false;       // Type and kind cells are matched verbatim
+
+            /**
+             * @brief Positional layout Type,Asset,Strike,Time,Rate,Price,Volatility,Model
+             */
+            static CsvSchema positional();
+
+            /**
+             * @brief Layout of the deprecated --batch mode, Type,Asset,Strike,Time,Rate,Value
+             * [,Kind], where Value is a price unless Kind is present and is not "price"
+             *
+             * As in the original --batch mode, only "call" and "Call" name a call and the kind
+             * is compared case-sensitively and untrimmed.
+             */
+            static CsvSchema legacy();
+        };
+
+        /**
+         * @brief Resolve the column layout of a CSV file from its header line
+         *
+         * Type, asset, strike, time and rate are required; an expiry column stands in for the
+         * time, which is then computed by the caller, and the rate may be left out when
+         * map.rate_optional is set. Columns the map does not name are skipped. A header in
+         * which no cell names a known field is taken for the first record of a headerless
+         * file, and the positional layout is used so legacy files keep working.
+         *
+         * @param header First line of the file
+         * @param map Header names per field
+         * @return CsvSchema Resolved layout
+         * @throws std::runtime_error If a header that names known fields, or a user-defined
+         * map, leaves a required field unmatched
+         */
+        CsvSchema resolve_csv_schema(std::string_view header, const CsvColumnMap& map);
+
+        /**
+         * @brief Parse one CSV record into OptionData following a resolved layout
+         *
+         * Fields after the last needed column are not scanned. Empty price, volatility and
+         * model cells keep their defaults. Expiry and valuation cells are parsed with
+         * core::parse_timestamp into days since 1970-01-01; the time to expiry is left for
+         * the caller to compute.
+         *
+         * @param line Record without its line terminator
+         * @param schema Column layout
+         * @param symbols Pool receiving symbol cells and OCC roots, or nullptr to ignore them
+         * @param contracts Pool receiving OCC contract keys, or nullptr to skip interning;
+         * needs symbols
+         * @return OptionData Parsed option
+         * @throws std::invalid_argument If a needed numeric cell is not a number, a date cell is
+         * not a date or the record
+         * has fewer than schema.min_cells cells
+         */
+        OptionData parse_csv_record(std::string_view line, const CsvSchema& schema,
+                                    SymbolPool* symbols = nullptr,
+                                    ContractPool* contracts = nullptr);
+
+        /**
+         * @brief Read option data from a CSV file using a header mapping
+         *
+         * @param filepath Path to the CSV file
+         * @param map Header names per field
+         * @param io_options Read-ahead backend and buffering settings
+         * @return std::vector<OptionData> Vector of option data
+         */
+        std::vector<OptionData> read_csv(const std::string& filepath, const CsvColumnMap& map,
+                                         const AsyncIoOptions& io_options = AsyncIoOptions());
+
+        /**
+         * @brief Streaming CSV reader that projects the header-mapped columns onto OptionData
+         *
+         * Partitions are byte ranges of the data after the header: a part owns the records
+         * whose first byte falls into its range, so no part has to scan the others.
+         */
+        class CsvReader : public OptionReader {
+        public:
+            /**
+             * @brief Open a CSV file and resolve its layout from the header
+             *
+             * @param filepath Path to the CSV file
+             * @param map Header names per field
+             * @param io_options Read-ahead backend and buffering settings
+             */
+            explicit CsvReader(const std::string& filepath, const CsvColumnMap& map = CsvColumnMap(),
+                               const AsyncIoOptions& io_options = AsyncIoOptions());
+
+            /**
+             * @brief Open a CSV file with a fixed layout, skipping its header line
+             *
+             * @param filepath Path to the CSV file
+             * @param schema Column layout
+             * @param io_options Read-ahead backend and buffering settings
+             */
+            CsvReader(const std::string& filepath, CsvSchema schema,
+                      const AsyncIoOptions& io_options = AsyncIoOptions());
+
+            /**
+             * @brief Read the next record, skipping blank lines
+             *
+             * A record that fails to parse is consumed before the exception is thrown, so
+             * reading can continue with the following line.
+             *
+             * @param option Receives the parsed record
+             * @return bool False at end of file
+             * @throws std::invalid_argument If the record cannot be parsed
+             */
+            bool next(OptionData& option) override;
+
+            /**
+             * @brief Step over the next record without parsing it, skipping blank lines
+             *
+             * @return bool False at end of file
+             */
+            bool skip() override;
+
+            void seek_partition(std::size_t index, std::size_t count) override;
+
+            /**
+             * @brief Byte offset of the next line
+             */
+            [[nodiscard]] std::uint64_t tell() const override { return offset_; }
+
+            /**
+             * @brief Continue at the start of a line; line numbers are unknown afterwards
+             *
+             * @param position Byte offset returned by tell()
+             */
+            void seek(std::uint64_t position) override;
+
+            /**
+             * @brief Append up to max_rows records to a vector
+             *
+             * @param options Vector receiving the records
+             * @param max_rows Maximum number of records to read
+             * @return std::size_t Number of records appended, zero at end of file
+             */
+            std::size_t read_batch(std::vector<OptionData>& options, std::size_t max_rows);
+
+            /**
+             * @brief Layout resolved from the header
+             */
+            [[nodiscard]] const CsvSchema& schema() const { return schema_; }
+
+            /**
+             * @brief One-based number of the line read last, zero once a partition other
+             * than the first has been selected or reading has been resumed
+             */
+            [[nodiscard]] std::size_t line_number() const { return line_number_; }
+
+        private:
+            bool next_line(std::string_view& line);
+            void reopen(std::uint64_t offset);
+
+            std::string filepath_;
+            AsyncIoOptions io_options_;
+            std::unique_ptr<AsyncFileReader> reader_;
+            std::string_view chunk_;
+            std::string partial_;  // Line straddling two read-ahead chunks
+            bool partial_returned_ = false;
+            bool eof_ = false;
+            bool count_lines_ = true;  // Line numbers are unknown inside a later partition
+            std::size_t line_number_ = 0;
+            std::uint64_t offset_ = 0;  // Byte offset of the next line
+            std::uint64_t end_offset_ = std::numeric_limits<std::uint64_t>::max();
+            CsvSchema schema_;
+        };
+
+    }  // namespace io
+}  // namespace iv_calculator
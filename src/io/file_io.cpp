@@ -1,77 +1,154 @@
 #include "file_io.h"
 
+#include "src/io/csv_reader.h"
+#include "src/io/occ_symbol.h"
+#include "src/io/option_reader.h"
+#include "src/io/option_writer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <simdjson.h>
-#include <sstream>
 #include <stdexcept>
 
 namespace iv_calculator {
     namespace io {
 
+        namespace {
+            // True when any option needs an explicit model column on output
+            bool has_non_default_model(const std::vector<OptionData>& options) {
+                return std::any_of(options.begin(), options.end(), [](const OptionData& option) {
+                    return option.model != core::PricingModel::BLACK_SCHOLES;
+                });
+            }
+        }  // namespace
+
         // Read from CSV file
-        std::vector<OptionData> read_csv(const std::string& filepath) {
-            std::vector<OptionData> options;
-            std::ifstream file(filepath);
+        std::vector<OptionData> read_csv(const std::string& filepath,
+                                         const AsyncIoOptions& io_options) {
+            return read_csv(filepath, CsvColumnMap(), io_options);
+        }
 
-            if (!file.is_open()) {
-                throw std::runtime_error("Could not open file: " + filepath);
+        core::HolidayCalendar read_holiday_calendar(const std::string& filepath) {
+            std::ifstream file(filepath);
+            if (!file) {
+                throw std::runtime_error("Cannot open holiday calendar " + filepath);
             }
-
-            // Skip header line
+            std::vector<std::int64_t> holidays;
             std::string line;
-            std::getline(file, line);
-
-            // Read data lines
+            std::size_t line_number = 0;
             while (std::getline(file, line)) {
-                std::stringstream ss(line);
-                std::string token;
-                OptionData option;
-
-                // Parse type (call/put)
-                if (std::getline(ss, token, ',')) {
-                    option.is_call = (token == "Call" || token == "call");
+                ++line_number;
+                std::size_t start = line.find_first_not_of(" \t\r");
+                if (start == std::string::npos || line[start] == '#') {
+                    continue;
                 }
-
-                // Parse asset price
-                if (std::getline(ss, token, ',')) {
-                    option.asset_price = std::stod(token);
+                try {
+                    holidays.push_back(static_cast<std::int64_t>(
+                        core::parse_timestamp(std::string_view(line).substr(start, 10))));
+                } catch (const std::invalid_argument& e) {
+                    throw std::runtime_error(std::string(e.what()) + " on line " +
+                                             std::to_string(line_number) + " of " + filepath);
                 }
+            }
+            return core::HolidayCalendar(std::move(holidays));
+        }
 
-                // Parse strike price
-                if (std::getline(ss, token, ',')) {
-                    option.strike_price = std::stod(token);
+        core::YieldCurve read_yield_curve(const std::string& filepath,
+                                          core::CurveInterpolation interpolation) {
+            std::ifstream file(filepath);
+            if (!file) {
+                throw std::runtime_error("Cannot open yield curve " + filepath);
+            }
+            std::vector<double> times;
+            std::vector<double> rates;
+            std::string line;
+            std::size_t line_number = 0;
+            bool first = true;  // The first line with content may be a header such as Time,Rate
+            while (std::getline(file, line)) {
+                ++line_number;
+                std::size_t start = line.find_first_not_of(" \t\r");
+                if (start == std::string::npos || line[start] == '#') {
+                    continue;
                 }
-
-                // Parse time to expiry
-                if (std::getline(ss, token, ',')) {
-                    option.time_to_expiry = std::stod(token);
-                }
-
-                // Parse risk-free rate
-                if (std::getline(ss, token, ',')) {
-                    option.risk_free_rate = std::stod(token);
+                std::size_t comma = line.find(',');
+                const char* text = line.c_str();
+                char* time_end = nullptr;
+                char* rate_end = nullptr;
+                double time = std::strtod(text + start, &time_end);
+                double rate = comma == std::string::npos ? NAN
+                                                         : std::strtod(text + comma + 1, &rate_end);
+                bool pillar = comma != std::string::npos && time_end == text + comma &&
+                              rate_end != text + comma + 1 &&
+                              line.find_first_not_of(" \t\r", static_cast<std::size_t>(
+                                                                   rate_end - text)) ==
+                                  std::string::npos;
+                if (pillar) {
+                    times.push_back(time);
+                    rates.push_back(rate);
+                } else if (!first) {
+                    throw std::runtime_error("Invalid curve pillar on line " +
+                                             std::to_string(line_number) + " of " + filepath);
                 }
+                first = false;
+            }
+            try {
+                return core::YieldCurve(times, rates, interpolation);
+            } catch (const std::invalid_argument& e) {
+                throw std::runtime_error(std::string(e.what()) + " in " + filepath);
+            }
+        }
 
-                // Parse option price
-                if (std::getline(ss, token, ',')) {
-                    option.option_price = std::stod(token);
+        std::unordered_map<std::string, core::DividendSchedule> read_dividend_schedules(
+            const std::string& filepath) {
+            std::ifstream file(filepath);
+            if (!file) {
+                throw std::runtime_error("Cannot open dividend schedule " + filepath);
+            }
+            std::unordered_map<std::string, core::DividendSchedule> schedules;
+            std::string line;
+            std::size_t line_number = 0;
+            bool first = true;  // The first line with content may be a header
+            while (std::getline(file, line)) {
+                ++line_number;
+                std::size_t start = line.find_first_not_of(" \t\r");
+                if (start == std::string::npos || line[start] == '#') {
+                    continue;
                 }
-
-                // Parse volatility if available
-                if (std::getline(ss, token, ',')) {
-                    option.volatility = std::stod(token);
+                bool header_allowed = first;
+                first = false;
+                std::size_t date = line.find(',');
+                std::size_t amount = date == std::string::npos ? date : line.find(',', date + 1);
+                try {
+                    if (amount == std::string::npos) {
+                        throw std::invalid_argument("missing cells");
+                    }
+                    std::string symbol = line.substr(start, date - start);
+                    double ex_date =
+                        core::parse_timestamp(line.substr(date + 1, amount - date - 1));
+                    std::size_t used = 0;
+                    double cash = std::stod(line.substr(amount + 1), &used);
+                    if (symbol.empty() ||
+                        line.find_first_not_of(" \t\r", amount + 1 + used) != std::string::npos) {
+                        throw std::invalid_argument("trailing text");
+                    }
+                    schedules[symbol].add(ex_date, cash);
+                } catch (const std::exception&) {
+                    if (!header_allowed) {
+                        throw std::runtime_error("Invalid dividend on line " +
+                                                 std::to_string(line_number) + " of " + filepath);
+                    }
                 }
-
-                options.push_back(option);
             }
-
-            return options;
+            return schedules;
         }
 
         // Simple JSON parsing function
         // Note: For production, consider using a proper JSON library like nlohmann/json
-        std::vector<OptionData> read_json(const std::string& filepath) {
+        std::vector<OptionData> read_json(const std::string& filepath, SymbolPool* symbols,
+                                          ContractPool* contracts) {
             std::vector<OptionData> options;
 
             // Load JSON file
@@ -99,13 +176,32 @@ namespace iv_calculator {
                 std::string_view type_sv;
                 double value = NAN;
 
+                // Extract the OCC symbol if available; it stands in for type, strike and expiry
+                std::string_view occ_sv;
+                bool has_occ = !json_option["occ_symbol"].get_string().get(occ_sv);
+                if (has_occ) {
+                    OccSymbol occ = parse_occ_symbol(occ_sv);
+                    option.is_call = occ.is_call;
+                    option.strike_price = occ.strike_milli / 1000.0;
+                    option.expiry_date = occ.expiry_day;
+                    if (symbols != nullptr) {
+                        option.underlying = symbols->intern(occ.root);
+                        if (contracts != nullptr) {
+                            option.contract = contracts->intern(
+                                {option.underlying, occ.expiry_day, occ.strike_milli, occ.is_call});
+                        }
+                    }
+                }
+
                 // Extract option type
                 auto error = json_option["type"].get_string().get(type_sv);
-                if (error) {
+                if (error && !has_occ) {
                     throw std::runtime_error("Option type is missing or invalid");
                 }
-                std::string type(type_sv);
-                option.is_call = (type == "Call" || type == "call");
+                if (!error) {
+                    std::string type(type_sv);
+                    option.is_call = (type == "Call" || type == "call");
+                }
 
                 // Extract asset price
                 error = json_option["asset_price"].get_double().get(value);
@@ -116,17 +212,25 @@ namespace iv_calculator {
 
                 // Extract strike price
                 error = json_option["strike_price"].get_double().get(value);
-                if (error) {
+                if (error && !has_occ) {
                     throw std::runtime_error("Strike price is missing or invalid");
                 }
-                option.strike_price = value;
-
-                // Extract time to expiry
-                error = json_option["time_to_expiry"].get_double().get(value);
-                if (error) {
-                    throw std::runtime_error("Time to expiry is missing or invalid");
+                option.strike_price = error ? option.strike_price : value;
+
+                // Extract time to expiry, or an expiry date it is later computed from
+                std::string_view date_sv;
+                if (!json_option["expiry"].get_string().get(date_sv)) {
+                    option.expiry_date = core::parse_timestamp(date_sv);
+                } else if (!has_occ) {
+                    error = json_option["time_to_expiry"].get_double().get(value);
+                    if (error) {
+                        throw std::runtime_error("Time to expiry is missing or invalid");
+                    }
+                    option.time_to_expiry = value;
+                }
+                if (!json_option["valuation"].get_string().get(date_sv)) {
+                    option.valuation_time = core::parse_timestamp(date_sv);
                 }
-                option.time_to_expiry = value;
 
                 // Extract risk-free rate
                 error = json_option["risk_free_rate"].get_double().get(value);
@@ -147,6 +251,32 @@ namespace iv_calculator {
                     option.volatility = value;
                 }
 
+                // Extract bid and ask quotes if available (optional fields)
+                if (!json_option["bid_price"].get_double().get(value)) {
+                    option.bid_price = value;
+                }
+                if (!json_option["ask_price"].get_double().get(value)) {
+                    option.ask_price = value;
+                }
+
+                // Extract position quantity if available (optional field)
+                if (!json_option["quantity"].get_double().get(value)) {
+                    option.quantity = value;
+                }
+
+                // Extract underlying symbol if available (optional field); it takes the
+                // place of an OCC root as the underlying
+                std::string_view symbol_sv;
+                if (symbols != nullptr && !json_option["symbol"].get_string().get(symbol_sv)) {
+                    option.underlying = symbols->intern(symbol_sv);
+                }
+
+                // Extract pricing model if available (optional field)
+                std::string_view model_sv;
+                if (!json_option["model"].get_string().get(model_sv)) {
+                    option.model = core::parse_pricing_model(model_sv);
+                }
+
                 options.push_back(option);
             }
 
@@ -154,62 +284,54 @@ namespace iv_calculator {
         }
 
         // Write to CSV file
-        bool write_csv(const std::string& filepath, const std::vector<OptionData>& options) {
-            std::ofstream file(filepath);
-
-            if (!file.is_open()) {
+        bool write_csv(const std::string& filepath, const std::vector<OptionData>& options,
+                       const AsyncIoOptions& io_options) {
+            try {
+                CsvWriter writer(filepath, has_non_default_model(options), io_options);
+                for (const auto& option : options) {
+                    writer.write(option);
+                }
+                writer.close();
+                return true;
+            } catch (const std::exception&) {
                 return false;
             }
+        }
 
-            // Write header
-            file << "Type,Asset,Strike,Time,Rate,Price,Volatility\n";
-
-            // Write data
-            for (const auto& option : options) {
-                file << (option.is_call ? "Call" : "Put") << "," << option.asset_price << ","
-                     << option.strike_price << "," << option.time_to_expiry << ","
-                     << option.risk_free_rate << "," << option.option_price << ","
-                     << option.volatility << "\n";
+        // Read from binary file
+        std::vector<OptionData> read_binary(const std::string& filepath) {
+            BinaryReader reader(filepath);
+            std::vector<OptionData> options;
+            options.reserve(reader.size());
+            OptionData option;
+            while (reader.next(option)) {
+                options.push_back(option);
             }
-
-            return true;
+            return options;
         }
 
-        // Simple JSON writing function
-        // Note: For production, consider using a proper JSON library like nlohmann/json
-        bool write_json(const std::string& filepath, const std::vector<OptionData>& options) {
-            std::ofstream file(filepath);
-            if (!file.is_open()) {
+        // Write to binary file
+        bool write_binary(const std::string& filepath, const std::vector<OptionData>& options) {
+            try {
+                BinaryWriter writer(filepath);
+                for (const auto& option : options) {
+                    writer.write(option);
+                }
+                writer.close();
+                return true;
+            } catch (const std::exception&) {
                 return false;
             }
+        }
 
+        // Write to JSON file
+        bool write_json(const std::string& filepath, const std::vector<OptionData>& options) {
             try {
-                // Start JSON array
-                file << "[\n";
-
-                for (size_t i = 0; i < options.size(); ++i) {
-                    const auto& option = options[i];
-
-                    // Write JSON object for each option
-                    file << "    {\n";
-                    file << R"(        "type": ")" << (option.is_call ? "Call" : "Put") << "\",\n";
-                    file << "        \"asset_price\": " << option.asset_price << ",\n";
-                    file << "        \"strike_price\": " << option.strike_price << ",\n";
-                    file << "        \"time_to_expiry\": " << option.time_to_expiry << ",\n";
-                    file << "        \"risk_free_rate\": " << option.risk_free_rate << ",\n";
-                    file << "        \"option_price\": " << option.option_price << ",\n";
-                    file << "        \"volatility\": " << option.volatility;
-                    file << "\n    }";
-
-                    // Add comma if not the last element
-                    if (i < options.size() - 1) {
-                        file << ",";
-                    }
-                    file << "\n";
+                JsonWriter writer(filepath, has_non_default_model(options));
+                for (const auto& option : options) {
+                    writer.write(option);
                 }
-
-                // End JSON array
-                file << "]";
+                writer.close();
                 return true;
             } catch (const std::exception& e) {
                 std::cerr << "Error writing JSON: " << e.what() << std::endl;
@@ -1,6 +1,16 @@
 #pragma once
 
+#include "src/core/bachelier.h"
+#include "src/core/day_count.h"
+#include "src/core/dividends.h"
+#include "src/core/pde_solver.h"
+#include "src/core/yield_curve.h"
+#include "src/io/async_io.h"
+#include "src/io/symbol_pool.h"
+
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace iv_calculator {
@@ -17,32 +27,117 @@ namespace iv_calculator {
             double risk_free_rate = 0;  // Risk-free interest rate
             double option_price = 0;    // Market price of option (for IV calculation)
             double volatility = 0;      // Implied volatility (output)
+            double bid_price = 0;       // Bid quote (optional, 0 when absent)
+            double ask_price = 0;       // Ask quote (optional, 0 when absent)
+            double quantity = 0;        // Position size (optional, 0 when absent)
+            double expiry_date = 0;     // Expiry, days since 1970-01-01 (optional, 0 when absent)
+            double valuation_time = 0;  // Valuation time, days since 1970-01-01 (optional)
+            double dividend_pv = 0;     // Escrowed dividends held back from the asset price
+            std::uint32_t underlying = 0;  // Symbol ID in the reader's pool, 0 when absent
+            std::uint32_t contract = 0;    // Contract ID in the reader's pool, 0 when absent
+            core::PricingModel model = core::PricingModel::BLACK_SCHOLES;  // Pricing model
+            core::ExerciseStyle exercise = core::ExerciseStyle::EUROPEAN;  // Exercise style
         };
 
         /**
          * @brief Read option data from a CSV file
          *
+         * Columns are located by their header names (see CsvColumnMap); files whose header is
+         * not recognised are read positionally as Type,Asset,Strike,Time,Rate,Price[,Volatility
+         * [,Model]], where the optional model is "BlackScholes" or "Bachelier".
+         *
          * @param filepath Path to the CSV file
+         * @param io_options Read-ahead backend and buffering settings
          * @return std::vector<OptionData> Vector of option data
          */
-        std::vector<OptionData> read_csv(const std::string& filepath);
+        std::vector<OptionData> read_csv(const std::string& filepath,
+                                         const AsyncIoOptions& io_options = AsyncIoOptions());
+
+        /**
+         * @brief Read a holiday calendar with one YYYY-MM-DD date per line
+         *
+         * Anything after the date (a comma, a name) is ignored, as are blank lines and lines
+         * starting with '#'.
+         *
+         * @param filepath Path to the holiday file
+         * @return core::HolidayCalendar Weekends and the listed holidays
+         * @throws std::runtime_error If the file cannot be read or a line holds no valid date
+         */
+        core::HolidayCalendar read_holiday_calendar(const std::string& filepath);
+
+        /**
+         * @brief Read a yield curve with one time,rate pillar per line
+         *
+         * Times are in years and rates continuously compounded. A header line, blank lines
+         * and lines starting with '#' are skipped.
+         *
+         * @param filepath Path to the curve file
+         * @param interpolation Interpolation between pillars
+         * @return core::YieldCurve Curve through the pillars
+         * @throws std::runtime_error If the file cannot be read, a line is not a pillar or the
+         * pillars are not increasing
+         */
+        core::YieldCurve read_yield_curve(const std::string& filepath,
+                                          core::CurveInterpolation interpolation);
+
+        /**
+         * @brief Read discrete dividends with one Symbol,ExDate,Amount line per dividend
+         *
+         * Ex-dates are YYYY-MM-DD. A header line, blank lines and lines starting with '#'
+         * are skipped.
+         *
+         * @param filepath Path to the dividend file
+         * @return std::unordered_map<std::string, core::DividendSchedule> Schedule per symbol
+         * @throws std::runtime_error If the file cannot be read or a line is not a dividend
+         */
+        std::unordered_map<std::string, core::DividendSchedule> read_dividend_schedules(
+            const std::string& filepath);
 
         /**
          * @brief Read option data from a JSON file
          *
+         * An "occ_symbol" field such as "AAPL  240119C00190000" replaces "type", "strike_price"
+         * and "time_to_expiry".
+         *
          * @param filepath Path to the JSON file
+         * @param symbols Pool receiving the "symbol" fields and OCC roots, or nullptr to
+         * ignore them
+         * @param contracts Pool receiving OCC contract keys, or nullptr to skip interning
          * @return std::vector<OptionData> Vector of option data
          */
-        std::vector<OptionData> read_json(const std::string& filepath);
+        std::vector<OptionData> read_json(const std::string& filepath,
+                                          SymbolPool* symbols = nullptr,
+                                          ContractPool* contracts = nullptr);
 
         /**
          * @brief Write option data to a CSV file
          *
+         * A Model column is appended when any row uses a model other than Black-Scholes.
+         *
          * @param filepath Path to the output CSV file
          * @param options Vector of option data to write
+         * @param io_options Write-behind backend and buffering settings
+         * @return bool Success status
+         */
+        bool write_csv(const std::string& filepath, const std::vector<OptionData>& options,
+                       const AsyncIoOptions& io_options = AsyncIoOptions());
+
+        /**
+         * @brief Read option data from a binary file (see binary_format)
+         *
+         * @param filepath Path to the binary file
+         * @return std::vector<OptionData> Vector of option data
+         */
+        std::vector<OptionData> read_binary(const std::string& filepath);
+
+        /**
+         * @brief Write option data to a binary file (see binary_format)
+         *
+         * @param filepath Path to the output binary file
+         * @param options Vector of option data to write
          * @return bool Success status
          */
-        bool write_csv(const std::string& filepath, const std::vector<OptionData>& options);
+        bool write_binary(const std::string& filepath, const std::vector<OptionData>& options);
 
         /**
          * @brief Write option data to a JSON file
@@ -0,0 +1,78 @@
+#include "occ_symbol.h"
+
+#include "src/core/day_count.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace iv_calculator {
+    namespace io {
+
+        namespace {
+            // Length of the YYMMDD, C/P and strike fields after the root
+            constexpr std::size_t kSuffixLength = 15;
+            constexpr std::size_t kMaxRootLength = 6;
+
+            // Value of count decimal digits at pos, or false if any is not a digit
+            bool parse_digits(std::string_view text, std::size_t pos, std::size_t count,
+                              std::uint32_t& value) {
+                value = 0;
+                for (std::size_t i = pos; i < pos + count; ++i) {
+                    auto digit = static_cast<unsigned>(text[i] - '0');
+                    if (digit > 9) {
+                        return false;
+                    }
+                    value = value * 10 + digit;
+                }
+                return true;
+            }
+
+            std::string_view trim(std::string_view text) {
+                std::size_t begin = text.find_first_not_of(" \t\r");
+                if (begin == std::string_view::npos) {
+                    return {};
+                }
+                std::size_t end = text.find_last_not_of(" \t\r");
+                return text.substr(begin, end - begin + 1);
+            }
+        }  // namespace
+
+        OccSymbol parse_occ_symbol(std::string_view text) {
+            std::string_view symbol = trim(text);
+            OccSymbol occ;
+            bool valid = symbol.size() > kSuffixLength;
+            if (valid) {
+                std::size_t suffix = symbol.size() - kSuffixLength;
+                occ.root = trim(symbol.substr(0, suffix));
+                std::uint32_t year = 0;
+                std::uint32_t month = 0;
+                std::uint32_t day = 0;
+                char right = symbol[suffix + 6];
+                valid = !occ.root.empty() && occ.root.size() <= kMaxRootLength &&
+                        occ.root.find(' ') == std::string_view::npos &&
+                        parse_digits(symbol, suffix, 2, year) &&
+                        parse_digits(symbol, suffix + 2, 2, month) && month >= 1 &&
+                        month <= 12 && parse_digits(symbol, suffix + 4, 2, day) &&
+                        (right == 'C' || right == 'P') &&
+                        parse_digits(symbol, suffix + 7, 8, occ.strike_milli);
+                if (valid) {
+                    // Dates such as Feb 30 come back from the round trip as another date
+                    std::int64_t days = core::days_from_civil(static_cast<int>(2000 + year),
+                                                              month, day);
+                    int check_year = 0;
+                    unsigned check_month = 0;
+                    unsigned check_day = 0;
+                    core::civil_from_days(days, check_year, check_month, check_day);
+                    valid = check_month == month && check_day == day;
+                    occ.expiry_day = static_cast<std::int32_t>(days);
+                    occ.is_call = right == 'C';
+                }
+            }
+            if (!valid) {
+                throw std::invalid_argument("Invalid OCC symbol '" + std::string(text) + "'");
+            }
+            return occ;
+        }
+
+    }  // namespace io
+}  // namespace iv_calculator
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace iv_calculator {
+    namespace io {
+
+        /**
+         * @brief Fields of an OCC/OSI option symbol such as "AAPL  240119C00190000"
+         *
+         * The root refers into the parsed text; nothing is copied.
+         */
+        struct OccSymbol {
+            std::string_view root;           // Option root, usually the underlying ticker
+            std::int32_t expiry_day = 0;     // Expiry, days since 1970-01-01
+            std::uint32_t strike_milli = 0;  // Strike in thousandths
+            bool is_call = true;
+        };
+
+        /**
+         * @brief Parse an OCC/OSI option symbol
+         *
+         * The symbol is a root of one to six characters, padded with spaces to six in the
+         * full 21-character form or unpadded in the compact form, followed by the expiry as
+         * YYMMDD (years 2000-2099), 'C' or 'P' and the strike times 1000 as eight digits.
+         * Surrounding blanks are ignored. Only the error path allocates.
+         *
+         * @param text OCC symbol
+         * @return OccSymbol Parsed fields
+         * @throws std::invalid_argument If the text is not a valid OCC symbol
+         */
+        OccSymbol parse_occ_symbol(std::string_view text);
+
+    }  // namespace io
+}  // namespace iv_calculator
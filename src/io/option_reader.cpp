@@ -0,0 +1,126 @@
+#include "option_reader.h"
+
+#include "src/io/binary_format.h"
+#include "src/io/csv_reader.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+
+namespace iv_calculator {
+    namespace io {
+
+        JsonReader::JsonReader(const std::string& filepath)
+            : options_(read_json(filepath, &symbols_, &contracts_)), end_(options_.size()) {}
+
+        bool JsonReader::next(OptionData& option) {
+            if (position_ >= end_) {
+                return false;
+            }
+            option = options_[position_++];
+            return true;
+        }
+
+        bool JsonReader::skip() {
+            if (position_ >= end_) {
+                return false;
+            }
+            ++position_;
+            return true;
+        }
+
+        void JsonReader::seek_partition(std::size_t index, std::size_t count) {
+            position_ = options_.size() * index / count;
+            end_ = options_.size() * (index + 1) / count;
+        }
+
+        void JsonReader::seek(std::uint64_t position) {
+            position_ = std::min<std::size_t>(position, end_);
+        }
+
+        BinaryReader::BinaryReader(const std::string& filepath, const AsyncIoOptions& io_options)
+            : filepath_(filepath),
+              io_options_(io_options),
+              reader_(std::make_unique<AsyncFileReader>(filepath, io_options)) {
+            std::uint64_t file_size = std::filesystem::file_size(filepath);
+            if (file_size < binary_format::kHeaderSize) {
+                throw std::runtime_error("Not a binary option file: " + filepath);
+            }
+            binary_format::check_header(take(binary_format::kHeaderSize));
+            records_ = (file_size - binary_format::kHeaderSize) / binary_format::kRecordSize;
+            end_ = records_;
+        }
+
+        bool BinaryReader::next(OptionData& option) {
+            if (position_ >= end_) {
+                return false;
+            }
+            option = binary_format::decode(take(binary_format::kRecordSize));
+            ++position_;
+            return true;
+        }
+
+        bool BinaryReader::skip() {
+            if (position_ >= end_) {
+                return false;
+            }
+            take(binary_format::kRecordSize);
+            ++position_;
+            return true;
+        }
+
+        void BinaryReader::seek_partition(std::size_t index, std::size_t count) {
+            end_ = records_ * (index + 1) / count;
+            seek(records_ * index / count);
+        }
+
+        void BinaryReader::seek(std::uint64_t position) {
+            position_ = std::min(position, end_);
+            reader_ = std::make_unique<AsyncFileReader>(
+                filepath_, io_options_,
+                binary_format::kHeaderSize + position_ * binary_format::kRecordSize);
+            chunk_ = {};
+            partial_.clear();
+        }
+
+        // Contiguous view of the next size bytes; only bytes straddling two chunks are copied
+        const char* BinaryReader::take(std::size_t size) {
+            if (chunk_.size() >= size) {
+                const char* data = chunk_.data();
+                chunk_.remove_prefix(size);
+                return data;
+            }
+
+            partial_.clear();
+            while (partial_.size() < size) {
+                if (chunk_.empty()) {
+                    chunk_ = reader_->next();
+                    if (chunk_.empty()) {
+                        throw std::runtime_error("Unexpected end of file: " + filepath_);
+                    }
+                }
+                std::size_t count = std::min(size - partial_.size(), chunk_.size());
+                partial_.append(chunk_.substr(0, count));
+                chunk_.remove_prefix(count);
+            }
+            return partial_.data();
+        }
+
+        std::unique_ptr<OptionReader> make_option_reader(const std::string& format,
+                                                         const std::string& filepath,
+                                                         const CsvColumnMap& map,
+                                                         const AsyncIoOptions& io_options) {
+            if (format == "csv") {
+                return std::make_unique<CsvReader>(filepath, map, io_options);
+            }
+            if (format == "json") {
+                return std::make_unique<JsonReader>(filepath);
+            }
+            if (format == "binary") {
+                return std::make_unique<BinaryReader>(filepath, io_options);
+            }
+            throw std::invalid_argument("Unsupported input format '" + format + "'");
+        }
+
+    }  // namespace io
+}  // namespace iv_calculator
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "src/io/async_io.h"
+#include "src/io/file_io.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace iv_calculator {
+    namespace io {
+
+        struct CsvColumnMap;
+
+        /**
+         * @brief Sequential source of option records
+         */
+        class OptionReader {
+        public:
+            OptionReader() = default;
+            virtual ~OptionReader() = default;
+
+            OptionReader(const OptionReader&) = delete;
+            OptionReader& operator=(const OptionReader&) = delete;
+            OptionReader(OptionReader&&) = delete;
+            OptionReader& operator=(OptionReader&&) = delete;
+
+            /**
+             * @brief Read the next record
+             *
+             * @param option Receives the record
+             * @return bool False at end of input
+             */
+            virtual bool next(OptionData& option) = 0;
+
+            /**
+             * @brief Step over the next record without decoding it
+             *
+             * @return bool False at end of input
+             */
+            virtual bool skip() = 0;
+
+            /**
+             * @brief Restrict reading to one of several contiguous parts of the input
+             *
+             * Every record belongs to exactly one part, and the parts follow each other in
+             * input order. Must be called before the first record is read.
+             *
+             * @param index Zero-based part to read
+             * @param count Number of parts
+             */
+            virtual void seek_partition(std::size_t index, std::size_t count) = 0;
+
+            /**
+             * @brief Position after the records read so far, to continue from with seek()
+             */
+            [[nodiscard]] virtual std::uint64_t tell() const = 0;
+
+            /**
+             * @brief Continue reading at a position returned by tell()
+             *
+             * The partition, if any, must be selected first.
+             *
+             * @param position Position from an earlier reader over the same input
+             */
+            virtual void seek(std::uint64_t position) = 0;
+
+            /**
+             * @brief Underlying symbols of the records read so far, by OptionData::underlying
+             */
+            [[nodiscard]] const SymbolPool& symbols() const { return symbols_; }
+
+            /**
+             * @brief OCC contracts of the records read so far, by OptionData::contract
+             */
+            [[nodiscard]] const ContractPool& contracts() const { return contracts_; }
+
+        protected:
+            SymbolPool symbols_;
+            ContractPool contracts_;
+        };
+
+        /**
+         * @brief Reader over the records of a JSON document
+         */
+        class JsonReader : public OptionReader {
+        public:
+            /**
+             * @brief Parse a JSON file (see read_json)
+             *
+             * @param filepath Path to the JSON file
+             */
+            explicit JsonReader(const std::string& filepath);
+
+            bool next(OptionData& option) override;
+            bool skip() override;
+            void seek_partition(std::size_t index, std::size_t count) override;
+            [[nodiscard]] std::uint64_t tell() const override { return position_; }
+            void seek(std::uint64_t position) override;
+
+            /**
+             * @brief All records of the document, regardless of the partition
+             */
+            [[nodiscard]] const std::vector<OptionData>& records() const { return options_; }
+
+        private:
+            std::vector<OptionData> options_;
+            std::size_t position_ = 0;
+            std::size_t end_ = 0;
+        };
+
+        /**
+         * @brief Reader of the binary record format written by BinaryWriter
+         */
+        class BinaryReader : public OptionReader {
+        public:
+            /**
+             * @brief Open a binary file and check its header
+             *
+             * @param filepath Path to the binary file
+             * @param io_options Read-ahead backend and buffering settings
+             * @throws std::runtime_error If the file is not in the binary record format
+             */
+            explicit BinaryReader(const std::string& filepath,
+                                  const AsyncIoOptions& io_options = AsyncIoOptions());
+
+            bool next(OptionData& option) override;
+            bool skip() override;
+            void seek_partition(std::size_t index, std::size_t count) override;
+            [[nodiscard]] std::uint64_t tell() const override { return position_; }
+            void seek(std::uint64_t position) override;
+
+            /**
+             * @brief Number of records in the file
+             */
+            [[nodiscard]] std::uint64_t size() const { return records_; }
+
+        private:
+            const char* take(std::size_t size);
+
+            std::string filepath_;
+            AsyncIoOptions io_options_;
+            std::unique_ptr<AsyncFileReader> reader_;
+            std::string_view chunk_;
+            std::string partial_;  // Record straddling two read-ahead chunks
+            std::uint64_t records_ = 0;
+            std::uint64_t position_ = 0;
+            std::uint64_t end_ = 0;
+        };
+
+        /**
+         * @brief Open a reader for an input format
+         *
+         * @param format "csv", "json" or "binary"
+         * @param filepath Path to the input file
+         * @param map Header names per field of CSV input
+         * @param io_options Read-ahead backend and buffering settings of CSV and binary input
+         * @return std::unique_ptr<OptionReader> Reader for the format
+         * @throws std::invalid_argument If the format is not supported
+         */
+        std::unique_ptr<OptionReader> make_option_reader(
+            const std::string& format, const std::string& filepath, const CsvColumnMap& map,
+            const AsyncIoOptions& io_options = AsyncIoOptions());
+
+    }  // namespace io
+}  // namespace iv_calculator
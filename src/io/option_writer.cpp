@@ -0,0 +1,340 @@
+#include "option_writer.h"
+
+#include "src/io/binary_format.h"
+
+#include <array>
+#include <charconv>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace iv_calculator {
+    namespace io {
+
+        namespace {
+            // Formatted output is handed to the file in blocks of about this size
+            constexpr std::size_t kWriteChunkSize = 1 << 16;
+
+            // Opening of a JSON document before its first object
+            constexpr std::string_view kJsonOpen = "[\n";
+
+            // Whether a column is written as text, quoted in JSON
+            bool is_text_column(OutputColumn column) {
+                return column == OutputColumn::TYPE || column == OutputColumn::MODEL ||
+                       column == OutputColumn::STATUS;
+            }
+
+            // Value of one schema column, unquoted
+            void append_column(std::string& buffer, OutputColumn column,
+                               const OptionData& option, const RowResult& result) {
+                switch (column) {
+                    case OutputColumn::TYPE:
+                        buffer += option.is_call ? "Call" : "Put";
+                        break;
+                    case OutputColumn::ASSET:
+                        append_number(buffer, option.asset_price);
+                        break;
+                    case OutputColumn::STRIKE:
+                        append_number(buffer, option.strike_price);
+                        break;
+                    case OutputColumn::TIME:
+                        append_number(buffer, option.time_to_expiry);
+                        break;
+                    case OutputColumn::RATE:
+                        append_number(buffer, option.risk_free_rate);
+                        break;
+                    case OutputColumn::PRICE:
+                        append_number(buffer, option.option_price);
+                        break;
+                    case OutputColumn::VOLATILITY:
+                        append_number(buffer, option.volatility);
+                        break;
+                    case OutputColumn::MODEL:
+                        buffer += core::pricing_model_name(option.model);
+                        break;
+                    case OutputColumn::DELTA:
+                        append_number(buffer, result.greeks.delta);
+                        break;
+                    case OutputColumn::GAMMA:
+                        append_number(buffer, result.greeks.gamma);
+                        break;
+                    case OutputColumn::VEGA:
+                        append_number(buffer, result.greeks.vega);
+                        break;
+                    case OutputColumn::THETA:
+                        append_number(buffer, result.greeks.theta);
+                        break;
+                    case OutputColumn::RHO:
+                        append_number(buffer, result.greeks.rho);
+                        break;
+                    case OutputColumn::STATUS:
+                        buffer += row_status_name(result.status);
+                        break;
+                    case OutputColumn::ITERATIONS:
+                        buffer += std::to_string(result.iterations);
+                        break;
+                    case OutputColumn::TOLERANCE:
+                        append_number(buffer, result.tolerance);
+                        break;
+                    case OutputColumn::BID:
+                        append_number(buffer, option.bid_price);
+                        break;
+                    case OutputColumn::ASK:
+                        append_number(buffer, option.ask_price);
+                        break;
+                    case OutputColumn::BID_VOLATILITY:
+                        append_number(buffer, result.bid_volatility);
+                        break;
+                    case OutputColumn::MID_VOLATILITY:
+                        append_number(buffer, result.mid_volatility);
+                        break;
+                    case OutputColumn::ASK_VOLATILITY:
+                        append_number(buffer, result.ask_volatility);
+                        break;
+                    case OutputColumn::VOLATILITY_SPREAD:
+                        append_number(buffer, result.ask_volatility - result.bid_volatility);
+                        break;
+                }
+            }
+
+            // Hand buffered output to the file and wait until it is durable
+            std::uint64_t commit_buffer(AsyncFileWriter& file, std::string& buffer) {
+                file.write(buffer);
+                buffer.clear();
+                file.sync();
+                return file.size();
+            }
+        }  // namespace
+
+        // Same text as std::ostream with default flags (printf "%g")
+        void append_number(std::string& buffer, double value) {
+            std::array<char, 32> text{};
+            auto result = std::to_chars(text.data(), text.data() + text.size(), value,
+                                        std::chars_format::general, 6);
+            buffer.append(text.data(), result.ptr);
+        }
+
+        CsvWriter::CsvWriter(const std::string& filepath, bool write_model,
+                             const AsyncIoOptions& io_options, std::uint64_t resume_bytes,
+                             OutputSchema schema)
+            : file_(filepath, io_options, resume_bytes),
+              write_model_(write_model),
+              schema_(std::move(schema)) {
+            buffer_.reserve(kWriteChunkSize + 256);
+            if (resume_bytes != 0) {
+                return;
+            }
+            if (schema_.empty()) {
+                buffer_ = "Type,Asset,Strike,Time,Rate,Price,Volatility";
+                buffer_ += write_model_ ? ",Model\n" : "\n";
+                return;
+            }
+            for (std::size_t i = 0; i < schema_.columns.size(); ++i) {
+                buffer_ += i == 0 ? "" : ",";
+                buffer_ += output_column_header(schema_.columns[i]);
+            }
+            buffer_ += '\n';
+        }
+
+        void CsvWriter::write(const OptionData& option) {
+            if (!schema_.empty()) {
+                write(option, RowResult());
+                return;
+            }
+            buffer_ += option.is_call ? "Call," : "Put,";
+            append_number(buffer_, option.asset_price);
+            buffer_ += ',';
+            append_number(buffer_, option.strike_price);
+            buffer_ += ',';
+            append_number(buffer_, option.time_to_expiry);
+            buffer_ += ',';
+            append_number(buffer_, option.risk_free_rate);
+            buffer_ += ',';
+            append_number(buffer_, option.option_price);
+            buffer_ += ',';
+            append_number(buffer_, option.volatility);
+            if (write_model_) {
+                buffer_ += ',';
+                buffer_ += core::pricing_model_name(option.model);
+            }
+            buffer_ += '\n';
+
+            // Format the next block while earlier ones are in flight
+            if (buffer_.size() >= kWriteChunkSize) {
+                file_.write(buffer_);
+                buffer_.clear();
+            }
+        }
+
+        void CsvWriter::write(const OptionData& option, const RowResult& result) {
+            if (schema_.empty()) {
+                write(option);
+                return;
+            }
+            for (std::size_t i = 0; i < schema_.columns.size(); ++i) {
+                if (i != 0) {
+                    buffer_ += ',';
+                }
+                append_column(buffer_, schema_.columns[i], option, result);
+            }
+            buffer_ += '\n';
+
+            if (buffer_.size() >= kWriteChunkSize) {
+                file_.write(buffer_);
+                buffer_.clear();
+            }
+        }
+
+        std::uint64_t CsvWriter::commit() { return commit_buffer(file_, buffer_); }
+
+        void CsvWriter::close() {
+            file_.write(buffer_);
+            buffer_.clear();
+            file_.close();
+        }
+
+        // A document resumed past its opening already holds objects and needs separators
+        JsonWriter::JsonWriter(const std::string& filepath, bool write_model,
+                               const AsyncIoOptions& io_options, std::uint64_t resume_bytes,
+                               OutputSchema schema)
+            : file_(filepath, io_options, resume_bytes),
+              buffer_(resume_bytes == 0 ? kJsonOpen : std::string_view()),
+              write_model_(write_model),
+              first_(resume_bytes <= kJsonOpen.size()),
+              schema_(std::move(schema)) {}
+
+        void JsonWriter::write(const OptionData& option) {
+            if (!schema_.empty()) {
+                write(option, RowResult());
+                return;
+            }
+            // Separator after the previous object
+            if (!first_) {
+                buffer_ += ",\n";
+            }
+            first_ = false;
+
+            buffer_ += "    {\n";
+            buffer_ += R"(        "type": ")";
+            buffer_ += option.is_call ? "Call" : "Put";
+            buffer_ += "\",\n        \"asset_price\": ";
+            append_number(buffer_, option.asset_price);
+            buffer_ += ",\n        \"strike_price\": ";
+            append_number(buffer_, option.strike_price);
+            buffer_ += ",\n        \"time_to_expiry\": ";
+            append_number(buffer_, option.time_to_expiry);
+            buffer_ += ",\n        \"risk_free_rate\": ";
+            append_number(buffer_, option.risk_free_rate);
+            buffer_ += ",\n        \"option_price\": ";
+            append_number(buffer_, option.option_price);
+            buffer_ += ",\n        \"volatility\": ";
+            append_number(buffer_, option.volatility);
+            if (write_model_) {
+                buffer_ += ",\n        \"model\": \"";
+                buffer_ += core::pricing_model_name(option.model);
+                buffer_ += '"';
+            }
+            buffer_ += "\n    }";
+
+            if (buffer_.size() >= kWriteChunkSize) {
+                file_.write(buffer_);
+                buffer_.clear();
+            }
+        }
+
+        void JsonWriter::write(const OptionData& option, const RowResult& result) {
+            if (schema_.empty()) {
+                write(option);
+                return;
+            }
+            if (!first_) {
+                buffer_ += ",\n";
+            }
+            first_ = false;
+
+            buffer_ += "    {";
+            for (std::size_t i = 0; i < schema_.columns.size(); ++i) {
+                OutputColumn column = schema_.columns[i];
+                buffer_ += i == 0 ? "\n        \"" : ",\n        \"";
+                buffer_ += output_column_key(column);
+                buffer_ += "\": ";
+                if (is_text_column(column)) {
+                    buffer_ += '"';
+                    append_column(buffer_, column, option, result);
+                    buffer_ += '"';
+                } else {
+                    append_column(buffer_, column, option, result);
+                }
+            }
+            buffer_ += "\n    }";
+
+            if (buffer_.size() >= kWriteChunkSize) {
+                file_.write(buffer_);
+                buffer_.clear();
+            }
+        }
+
+        std::uint64_t JsonWriter::commit() { return commit_buffer(file_, buffer_); }
+
+        void JsonWriter::close() {
+            buffer_ += first_ ? "]" : "\n]";
+            file_.write(buffer_);
+            buffer_.clear();
+            file_.close();
+        }
+
+        BinaryWriter::BinaryWriter(const std::string& filepath, const AsyncIoOptions& io_options,
+                                   std::uint64_t resume_bytes)
+            : file_(filepath, io_options, resume_bytes) {
+            buffer_.reserve(kWriteChunkSize + binary_format::kRecordSize);
+            if (resume_bytes == 0) {
+                std::array<char, binary_format::kHeaderSize> header = binary_format::header();
+                buffer_.assign(header.data(), header.size());
+            }
+        }
+
+        void BinaryWriter::write(const OptionData& option) {
+            std::size_t size = buffer_.size();
+            buffer_.resize(size + binary_format::kRecordSize);
+            binary_format::encode(option, &buffer_[size]);
+            if (buffer_.size() >= kWriteChunkSize) {
+                file_.write(buffer_);
+                buffer_.clear();
+            }
+        }
+
+        std::uint64_t BinaryWriter::commit() { return commit_buffer(file_, buffer_); }
+
+        void BinaryWriter::close() {
+            file_.write(buffer_);
+            buffer_.clear();
+            file_.close();
+        }
+
+        std::unique_ptr<OptionWriter> make_option_writer(const std::string& format,
+                                                         const std::string& filepath,
+                                                         bool write_model,
+                                                         const AsyncIoOptions& io_options,
+                                                         std::uint64_t resume_bytes,
+                                                         const OutputSchema& schema) {
+            if (format == "csv") {
+                return std::make_unique<CsvWriter>(filepath, write_model, io_options,
+                                                   resume_bytes, schema);
+            }
+            if (format == "json") {
+                return std::make_unique<JsonWriter>(filepath, write_model, io_options,
+                                                    resume_bytes, schema);
+            }
+            if (format == "binary") {
+                if (!schema.empty()) {
+                    throw std::invalid_argument(
+                        "Binary output has a fixed record layout; output columns need csv or "
+                        "json");
+                }
+                return std::make_unique<BinaryWriter>(filepath, io_options, resume_bytes);
+            }
+            throw std::invalid_argument("Unsupported output format '" + format + "'");
+        }
+
+    }  // namespace io
+}  // namespace iv_calculator
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "src/io/async_io.h"
+#include "src/io/file_io.h"
+#include "src/io/output_schema.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace iv_calculator {
+    namespace io {
+
+        /**
+         * @brief Streaming writer of option records
+         *
+         * Records are formatted into a staging buffer and handed to the file in large
+         * blocks, so results can be written while later rows are still being computed.
+         */
+        class OptionWriter {
+        public:
+            OptionWriter() = default;
+            virtual ~OptionWriter() = default;
+
+            OptionWriter(const OptionWriter&) = delete;
+            OptionWriter& operator=(const OptionWriter&) = delete;
+            OptionWriter(OptionWriter&&) = delete;
+            OptionWriter& operator=(OptionWriter&&) = delete;
+
+            /**
+             * @brief Append one record
+             *
+             * @param option Record to write
+             */
+            virtual void write(const OptionData& option) = 0;
+
+            /**
+             * @brief Append one record together with its computed columns
+             *
+             * Writers without an output schema ignore the computed columns.
+             *
+             * @param option Record to write
+             * @param result Greeks, status and iterations of the record
+             */
+            virtual void write(const OptionData& option, const RowResult& /*result*/) {
+                write(option);
+            }
+
+            /**
+             * @brief Make every record written so far durable
+             *
+             * @return std::uint64_t Output size covering exactly those records, from which a
+             * writer can later resume
+             */
+            virtual std::uint64_t commit() = 0;
+
+            /**
+             * @brief Flush buffered records and close the file
+             */
+            virtual void close() = 0;
+        };
+
+        /**
+         * @brief CSV writer producing the Type,Asset,Strike,Time,Rate,Price,Volatility layout
+         * or the columns of an output schema
+         */
+        class CsvWriter : public OptionWriter {
+        public:
+            /**
+             * @brief Create the file and write the header
+             *
+             * @param filepath Path to the output CSV file
+             * @param write_model Append a Model column (classic layout only)
+             * @param io_options Write-behind backend and buffering settings
+             * @param resume_bytes Size returned by an earlier commit() to continue after, or
+             * zero for a new file
+             * @param schema Columns to write, empty for the classic layout
+             */
+            CsvWriter(const std::string& filepath, bool write_model,
+                      const AsyncIoOptions& io_options = AsyncIoOptions(),
+                      std::uint64_t resume_bytes = 0, OutputSchema schema = OutputSchema());
+
+            void write(const OptionData& option) override;
+            void write(const OptionData& option, const RowResult& result) override;
+            std::uint64_t commit() override;
+            void close() override;
+
+        private:
+            AsyncFileWriter file_;
+            std::string buffer_;
+            bool write_model_;
+            OutputSchema schema_;
+        };
+
+        /**
+         * @brief JSON writer producing an array of option objects, with the fields of an
+         * output schema when one is given
+         */
+        class JsonWriter : public OptionWriter {
+        public:
+            /**
+             * @brief Create the file and open the array
+             *
+             * @param filepath Path to the output JSON file
+             * @param write_model Add a "model" field to every object (classic layout only)
+             * @param io_options Write-behind backend and buffering settings
+             * @param resume_bytes Size returned by an earlier commit() to continue after, or
+             * zero for a new file
+             * @param schema Fields to write, empty for the classic layout
+             */
+            JsonWriter(const std::string& filepath, bool write_model,
+                       const AsyncIoOptions& io_options = AsyncIoOptions(),
+                       std::uint64_t resume_bytes = 0, OutputSchema schema = OutputSchema());
+
+            void write(const OptionData& option) override;
+            void write(const OptionData& option, const RowResult& result) override;
+            std::uint64_t commit() override;
+            void close() override;
+
+        private:
+            AsyncFileWriter file_;
+            std::string buffer_;
+            bool write_model_;
+            bool first_;
+            OutputSchema schema_;
+        };
+
+        /**
+         * @brief Writer of fixed-size binary records (see binary_format)
+         */
+        class BinaryWriter : public OptionWriter {
+        public:
+            /**
+             * @brief Create the file and write the header
+             *
+             * @param filepath Path to the output binary file
+             * @param io_options Write-behind backend and buffering settings
+             * @param resume_bytes Size returned by an earlier commit() to continue after, or
+             * zero for a new file
+             */
+            explicit BinaryWriter(const std::string& filepath,
+                                  const AsyncIoOptions& io_options = AsyncIoOptions(),
+                                  std::uint64_t resume_bytes = 0);
+
+            using OptionWriter::write;
+            void write(const OptionData& option) override;
+            std::uint64_t commit() override;
+            void close() override;
+
+        private:
+            AsyncFileWriter file_;
+            std::string buffer_;
+        };
+
+        /**
+         * @brief Append a number formatted like the CSV and JSON writers ("%g")
+         *
+         * @param buffer Text to append to
+         * @param value Number to format
+         */
+        void append_number(std::string& buffer, double value);
+
+        /**
+         * @brief Create a writer for an output format
+         *
+         * @param format "csv", "json" or "binary"
+         * @param filepath Path to the output file
+         * @param write_model Write the pricing model of every record (binary records always
+         * carry it)
+         * @param io_options Write-behind backend and buffering settings
+         * @param resume_bytes Size returned by an earlier commit() to continue after, or zero
+         * for a new file
+         * @param schema Columns to write, empty for the classic layout
+         * @return std::unique_ptr<OptionWriter> Writer for the format
+         * @throws std::invalid_argument If the format is not supported, or is binary and a
+         * schema is given
+         */
+        std::unique_ptr<OptionWriter> make_option_writer(
+            const std::string& format, const std::string& filepath, bool write_model,
+            const AsyncIoOptions& io_options = AsyncIoOptions(), std::uint64_t resume_bytes = 0,
+            const OutputSchema& schema = OutputSchema());
+
+    }  // namespace io
+}  // namespace iv_calculator
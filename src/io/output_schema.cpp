@@ -0,0 +1,177 @@
+#include "output_schema.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace iv_calculator {
+    namespace io {
+
+        namespace {
+            constexpr std::size_t kColumnCount = 22;
+
+            struct ColumnNames {
+                const char* header;
+                const char* key;
+            };
+
+            // Headers match the CSV reader's aliases and keys the JSON reader's fields
+            constexpr std::array<ColumnNames, kColumnCount> kColumnNames = {{
+                {"Type", "type"},
+                {"Asset", "asset_price"},
+                {"Strike", "strike_price"},
+                {"Time", "time_to_expiry"},
+                {"Rate", "risk_free_rate"},
+                {"Price", "option_price"},
+                {"Volatility", "volatility"},
+                {"Model", "model"},
+                {"Delta", "delta"},
+                {"Gamma", "gamma"},
+                {"Vega", "vega"},
+                {"Theta", "theta"},
+                {"Rho", "rho"},
+                {"Status", "status"},
+                {"Iterations", "iterations"},
+                {"Tolerance", "tolerance"},
+                {"Bid", "bid_price"},
+                {"Ask", "ask_price"},
+                {"BidVolatility", "bid_volatility"},
+                {"MidVolatility", "mid_volatility"},
+                {"AskVolatility", "ask_volatility"},
+                {"VolatilitySpread", "volatility_spread"},
+            }};
+
+            constexpr std::array<std::pair<std::string_view, OutputColumn>, kColumnCount + 1>
+                kColumnAliases = {{
+                    {"type", OutputColumn::TYPE},
+                    {"asset", OutputColumn::ASSET},
+                    {"strike", OutputColumn::STRIKE},
+                    {"time", OutputColumn::TIME},
+                    {"rate", OutputColumn::RATE},
+                    {"price", OutputColumn::PRICE},
+                    {"vol", OutputColumn::VOLATILITY},
+                    {"volatility", OutputColumn::VOLATILITY},
+                    {"model", OutputColumn::MODEL},
+                    {"delta", OutputColumn::DELTA},
+                    {"gamma", OutputColumn::GAMMA},
+                    {"vega", OutputColumn::VEGA},
+                    {"theta", OutputColumn::THETA},
+                    {"rho", OutputColumn::RHO},
+                    {"status", OutputColumn::STATUS},
+                    {"iterations", OutputColumn::ITERATIONS},
+                    {"tolerance", OutputColumn::TOLERANCE},
+                    {"bid", OutputColumn::BID},
+                    {"ask", OutputColumn::ASK},
+                    {"bid_vol", OutputColumn::BID_VOLATILITY},
+                    {"mid_vol", OutputColumn::MID_VOLATILITY},
+                    {"ask_vol", OutputColumn::ASK_VOLATILITY},
+                    {"vol_spread", OutputColumn::VOLATILITY_SPREAD},
+                }};
+
+            std::string_view trim(std::string_view text) {
+                while (!text.empty() && text.front() == ' ') {
+                    text.remove_prefix(1);
+                }
+                while (!text.empty() && text.back() == ' ') {
+                    text.remove_suffix(1);
+                }
+                return text;
+            }
+        }  // namespace
+
+        const char* row_status_name(RowStatus status) {
+            switch (status) {
+                case RowStatus::PRICED:
+                    return "priced";
+                case RowStatus::SOLVED:
+                    return "solved";
+                case RowStatus::FAILED:
+                    return "failed";
+                case RowStatus::PASSED:
+                default:
+                    return "passed";
+            }
+        }
+
+        bool OutputSchema::contains(OutputColumn column) const {
+            return std::find(columns.begin(), columns.end(), column) != columns.end();
+        }
+
+        std::uint8_t OutputSchema::greeks() const {
+            std::uint8_t flags = 0;
+            for (OutputColumn column : columns) {
+                switch (column) {
+                    case OutputColumn::DELTA:
+                        flags |= core::greek_flags::kDelta;
+                        break;
+                    case OutputColumn::GAMMA:
+                        flags |= core::greek_flags::kGamma;
+                        break;
+                    case OutputColumn::VEGA:
+                        flags |= core::greek_flags::kVega;
+                        break;
+                    case OutputColumn::THETA:
+                        flags |= core::greek_flags::kTheta;
+                        break;
+                    case OutputColumn::RHO:
+                        flags |= core::greek_flags::kRho;
+                        break;
+                    default:
+                        break;
+                }
+            }
+            return flags;
+        }
+
+        bool OutputSchema::needs_row_results() const {
+            return greeks() != 0 || contains(OutputColumn::STATUS) ||
+                   contains(OutputColumn::ITERATIONS) || contains(OutputColumn::TOLERANCE) ||
+                   needs_quotes();
+        }
+
+        bool OutputSchema::needs_quotes() const {
+            return contains(OutputColumn::BID_VOLATILITY) ||
+                   contains(OutputColumn::MID_VOLATILITY) ||
+                   contains(OutputColumn::ASK_VOLATILITY) ||
+                   contains(OutputColumn::VOLATILITY_SPREAD);
+        }
+
+        OutputSchema parse_output_schema(std::string_view spec) {
+            OutputSchema schema;
+            while (!spec.empty()) {
+                std::size_t comma = spec.find(',');
+                std::string_view name = trim(spec.substr(0, comma));
+                spec = comma == std::string_view::npos ? std::string_view()
+                                                       : spec.substr(comma + 1);
+
+                const auto* alias =
+                    std::find_if(kColumnAliases.begin(), kColumnAliases.end(),
+                                 [name](const auto& entry) { return entry.first == name; });
+                if (alias == kColumnAliases.end()) {
+                    throw std::invalid_argument("Unknown output column '" + std::string(name) +
+                                                "'");
+                }
+                if (schema.contains(alias->second)) {
+                    throw std::invalid_argument("Output column '" + std::string(name) +
+                                                "' is listed twice");
+                }
+                schema.columns.push_back(alias->second);
+            }
+            if (schema.empty()) {
+                throw std::invalid_argument("No output columns given");
+            }
+            return schema;
+        }
+
+        const char* output_column_header(OutputColumn column) {
+            return kColumnNames.at(static_cast<std::size_t>(column)).header;
+        }
+
+        const char* output_column_key(OutputColumn column) {
+            return kColumnNames.at(static_cast<std::size_t>(column)).key;
+        }
+
+    }  // namespace io
+}  // namespace iv_calculator
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "src/core/greeks.h"
+
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace iv_calculator {
+    namespace io {
+
+        /**
+         * @brief Column that can be requested in batch output
+         */
+        enum class OutputColumn : std::uint8_t {
+            TYPE,
+            ASSET,
+            STRIKE,
+            TIME,
+            RATE,
+            PRICE,
+            VOLATILITY,
+            MODEL,
+            DELTA,
+            GAMMA,
+            VEGA,
+            THETA,
+            RHO,
+            STATUS,      ///< What the engine did with the row (see RowStatus)
+            ITERATIONS,  ///< Implied volatility solver iterations
+            TOLERANCE,   ///< Convergence measure the solver reached
+            BID,
+            ASK,
+            BID_VOLATILITY,     ///< Implied volatility of the bid quote
+            MID_VOLATILITY,     ///< Implied volatility of the mid quote
+            ASK_VOLATILITY,     ///< Implied volatility of the ask quote
+            VOLATILITY_SPREAD   ///< Ask minus bid volatility
+        };
+
+        /**
+         * @brief What the batch engine did with a row
+         */
+        enum class RowStatus : std::uint8_t {
+            PASSED,  ///< Written as read
+            PRICED,  ///< Price computed from the volatility
+            SOLVED,  ///< Implied volatility computed from the price
+            FAILED   ///< Pricing or solving failed
+        };
+
+        /**
+         * @brief Get the output text of a row status
+         *
+         * @param status Row status
+         * @return const char* "passed", "priced", "solved" or "failed"
+         */
+        const char* row_status_name(RowStatus status);
+
+        /**
+         * @brief Values computed for a row besides its OptionData fields
+         */
+        struct RowResult {
+            core::Greeks greeks;  // Only the sensitivities of requested columns are set
+            RowStatus status = RowStatus::PASSED;
+            int iterations = 0;
+            double tolerance = std::numeric_limits<double>::quiet_NaN();  // Unless solved
+            // Quote volatilities, NaN unless requested and the row has both quotes
+            double bid_volatility = std::numeric_limits<double>::quiet_NaN();
+            double mid_volatility = std::numeric_limits<double>::quiet_NaN();
+            double ask_volatility = std::numeric_limits<double>::quiet_NaN();
+        };
+
+        /**
+         * @brief Declared set and order of output columns
+         *
+         * An empty schema stands for the classic layout
+         * Type,Asset,Strike,Time,Rate,Price,Volatility[,Model].
+         */
+        struct OutputSchema {
+            std::vector<OutputColumn> columns;
+
+            [[nodiscard]] bool empty() const { return columns.empty(); }
+
+            /**
+             * @brief Check whether a column is requested
+             */
+            [[nodiscard]] bool contains(OutputColumn column) const;
+
+            /**
+             * @brief core::greek_flags bits of the requested sensitivity columns
+             */
+            [[nodiscard]] std::uint8_t greeks() const;
+
+            /**
+             * @brief Check whether any column needs a RowResult
+             */
+            [[nodiscard]] bool needs_row_results() const;
+
+            /**
+             * @brief Check whether any quote volatility column is requested
+             */
+            [[nodiscard]] bool needs_quotes() const;
+        };
+
+        /**
+         * @brief Parse a column list such as "vol,delta,vega,status"
+         *
+         * Column names are type, asset, strike, time, rate, price, vol (or volatility),
+         * model, delta, gamma, vega, theta, rho, status, iterations, tolerance, bid, ask,
+         * bid_vol, mid_vol, ask_vol and vol_spread.
+         *
+         * @param spec Comma-separated column names in output order
+         * @return OutputSchema Parsed schema
+         * @throws std::invalid_argument If a name is unknown, repeated or the list is empty
+         */
+        OutputSchema parse_output_schema(std::string_view spec);
+
+        /**
+         * @brief CSV header name of a column ("Volatility", "Delta", ...)
+         */
+        const char* output_column_header(OutputColumn column);
+
+        /**
+         * @brief JSON field name of a column ("volatility", "delta", ...)
+         */
+        const char* output_column_key(OutputColumn column);
+
+    }  // namespace io
+}  // namespace iv_calculator
@@ -0,0 +1,153 @@
+#include "symbol_pool.h"
+
+#include <stdexcept>
+
+namespace iv_calculator {
+    namespace io {
+
+        SymbolPool::SymbolPool() : offsets_{0}, slots_(64) {}
+
+        namespace {
+            // Finalizer of splitmix64: every input bit affects every output bit
+            std::uint64_t mix(std::uint64_t x) {
+                x = (x ^ (x >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+                x = (x ^ (x >> 27U)) * 0x94D049BB133111EBULL;
+                return x ^ (x >> 31U);
+            }
+        }  // namespace
+
+        // FNV-1a over the bytes, finished with the mixer so short names that differ in one
+        // character land far apart
+        std::uint64_t SymbolPool::hash(std::string_view name) {
+            std::uint64_t h = 0xCBF29CE484222325ULL;
+            for (char c : name) {
+                h = (h ^ static_cast<unsigned char>(c)) * 0x100000001B3ULL;
+            }
+            return mix(h);
+        }
+
+        // Slot holding the name, or the free slot where it would go
+        std::size_t SymbolPool::slot_of(std::string_view name, std::uint64_t hash) const {
+            std::size_t mask = slots_.size() - 1;
+            for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+                const Slot& slot = slots_[i];
+                if (slot.id == 0 || (slot.hash == hash && this->name(slot.id) == name)) {
+                    return i;
+                }
+            }
+        }
+
+        std::uint32_t SymbolPool::intern(std::string_view name) {
+            if (name.empty()) {
+                return 0;
+            }
+            std::uint64_t h = hash(name);
+            std::size_t i = slot_of(name, h);
+            if (slots_[i].id != 0) {
+                return slots_[i].id;
+            }
+            auto id = static_cast<std::uint32_t>(offsets_.size());
+            storage_.append(name);
+            offsets_.push_back(static_cast<std::uint32_t>(storage_.size()));
+            slots_[i] = {h, id};
+            if (2 * size() > slots_.size()) {
+                grow();
+            }
+            return id;
+        }
+
+        std::uint32_t SymbolPool::find(std::string_view name) const {
+            return name.empty() ? 0 : slots_[slot_of(name, hash(name))].id;
+        }
+
+        std::string_view SymbolPool::name(std::uint32_t id) const {
+            if (id == 0) {
+                return {};
+            }
+            if (id >= offsets_.size()) {
+                throw std::out_of_range("Unknown symbol ID " + std::to_string(id));
+            }
+            return std::string_view(storage_).substr(offsets_[id - 1],
+                                                     offsets_[id] - offsets_[id - 1]);
+        }
+
+        void SymbolPool::grow() {
+            std::vector<Slot> slots(2 * slots_.size());
+            std::size_t mask = slots.size() - 1;
+            for (const Slot& slot : slots_) {
+                if (slot.id == 0) {
+                    continue;
+                }
+                std::size_t i = slot.hash & mask;
+                while (slots[i].id != 0) {
+                    i = (i + 1) & mask;
+                }
+                slots[i] = slot;
+            }
+            slots_.swap(slots);
+        }
+
+
+        ContractPool::ContractPool() : slots_(64) {}
+
+        std::uint64_t ContractPool::hash(const ContractKey& key) {
+            std::uint64_t h = mix(static_cast<std::uint64_t>(key.root) << 32U |
+                                  static_cast<std::uint32_t>(key.expiry_day));
+            return mix(h ^ (static_cast<std::uint64_t>(key.strike_milli) << 1U |
+                            static_cast<std::uint64_t>(key.is_call)));
+        }
+
+        std::size_t ContractPool::slot_of(const ContractKey& key, std::uint64_t hash) const {
+            std::size_t mask = slots_.size() - 1;
+            for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+                const Slot& slot = slots_[i];
+                if (slot.id == 0 || (slot.hash == hash && keys_[slot.id - 1] == key)) {
+                    return i;
+                }
+            }
+        }
+
+        std::uint32_t ContractPool::intern(const ContractKey& key) {
+            std::uint64_t h = hash(key);
+            std::size_t i = slot_of(key, h);
+            if (slots_[i].id != 0) {
+                return slots_[i].id;
+            }
+            keys_.push_back(key);
+            auto id = static_cast<std::uint32_t>(keys_.size());
+            slots_[i] = {h, id};
+            if (2 * size() > slots_.size()) {
+                grow();
+            }
+            return id;
+        }
+
+        std::uint32_t ContractPool::find(const ContractKey& key) const {
+            return slots_[slot_of(key, hash(key))].id;
+        }
+
+        const ContractKey& ContractPool::key(std::uint32_t id) const {
+            if (id == 0 || id > keys_.size()) {
+                throw std::out_of_range("Unknown contract ID " + std::to_string(id));
+            }
+            return keys_[id - 1];
+        }
+
+        void ContractPool::grow() {
+            std::vector<Slot> slots(2 * slots_.size());
+            std::size_t mask = slots.size() - 1;
+            for (const Slot& slot : slots_) {
+                if (slot.id == 0) {
+                    continue;
+                }
+                std::size_t i = slot.hash & mask;
+                while (slots[i].id != 0) {
+                    i = (i + 1) & mask;
+                }
+                slots[i] = slot;
+            }
+            slots_.swap(slots);
+        }
+
+    }  // namespace io
+}  // namespace iv_calculator
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace iv_calculator {
+    namespace io {
+
+        /**
+         * @brief Interned names with dense integer IDs
+         *
+         * IDs start at 1 in order of first appearance; 0 stands for "no name". Names are
+         * stored back to back in one buffer and found through a linear-probing table of
+         * hashes, so interning a name seen before allocates nothing and a new name only
+         * grows the shared buffers.
+         */
+        class SymbolPool {
+        public:
+            SymbolPool();
+
+            /**
+             * @brief ID of a name, adding it when new
+             *
+             * @param name Name to intern
+             * @return std::uint32_t ID of the name, 0 for an empty name
+             */
+            std::uint32_t intern(std::string_view name);
+
+            /**
+             * @brief ID of a name, 0 when it has not been interned
+             */
+            [[nodiscard]] std::uint32_t find(std::string_view name) const;
+
+            /**
+             * @brief Name of an ID; empty for 0. Valid until the next intern().
+             *
+             * @throws std::out_of_range If the ID was not issued by this pool
+             */
+            [[nodiscard]] std::string_view name(std::uint32_t id) const;
+
+            /**
+             * @brief Number of distinct names
+             */
+            [[nodiscard]] std::size_t size() const { return offsets_.size() - 1; }
+
+        private:
+            static std::uint64_t hash(std::string_view name);
+            [[nodiscard]] std::size_t slot_of(std::string_view name, std::uint64_t hash) const;
+            void grow();
+
+            struct Slot {
+                std::uint64_t hash = 0;
+                std::uint32_t id = 0;  // 0 marks a free slot
+            };
+
+            std::string storage_;                // All names back to back
+            std::vector<std::uint32_t> offsets_;  // Start of name i in storage_, plus the end
+            std::vector<Slot> slots_;            // At most half full
+        };
+
+        /**
+         * @brief Listed option contract: root, expiry date, strike and type
+         */
+        struct ContractKey {
+            std::uint32_t root = 0;          // Symbol ID of the option root, usually the underlying
+            std::int32_t expiry_day = 0;     // Expiry, days since 1970-01-01
+            std::uint32_t strike_milli = 0;  // Strike in thousandths, as in OCC symbols
+            bool is_call = true;
+
+            bool operator==(const ContractKey& other) const {
+                return root == other.root && expiry_day == other.expiry_day &&
+                       strike_milli == other.strike_milli && is_call == other.is_call;
+            }
+        };
+
+        /**
+         * @brief Interned contract keys with dense integer IDs
+         *
+         * IDs start at 1 in order of first appearance; 0 stands for "no contract". Keys are
+         * kept in one vector and found through a linear-probing table, so interning a key
+         * seen before allocates nothing.
+         */
+        class ContractPool {
+        public:
+            ContractPool();
+
+            /**
+             * @brief ID of a contract, adding it when new
+             */
+            std::uint32_t intern(const ContractKey& key);
+
+            /**
+             * @brief ID of a contract, 0 when it has not been interned
+             */
+            [[nodiscard]] std::uint32_t find(const ContractKey& key) const;
+
+            /**
+             * @brief Key of an ID
+             *
+             * @throws std::out_of_range If the ID was not issued by this pool
+             */
+            [[nodiscard]] const ContractKey& key(std::uint32_t id) const;
+
+            /**
+             * @brief Number of distinct contracts
+             */
+            [[nodiscard]] std::size_t size() const { return keys_.size(); }
+
+        private:
+            static std::uint64_t hash(const ContractKey& key);
+            [[nodiscard]] std::size_t slot_of(const ContractKey& key, std::uint64_t hash) const;
+            void grow();
+
+            struct Slot {
+                std::uint64_t hash = 0;
+                std::uint32_t id = 0;  // 0 marks a free slot
+            };
+
+            std::vector<ContractKey> keys_;  // Key of ID i + 1
+            std::vector<Slot> slots_;        // At most half full
+        };
+
+    }  // namespace io
+}  // namespace iv_calculator
@@ -0,0 +1,93 @@
+#include "src/core/bachelier.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace iv_calculator::core;
+
+TEST(BachelierTest, AtTheMoneyPrice) {
+    // Undiscounted ATM price is sigma * sqrt(T / (2 * pi))
+    double price = bachelier_price(true, 0.0, 0.0, 1.0, 0.0, 0.5);
+    EXPECT_NEAR(price, 0.5 / std::sqrt(2.0 * M_PI), 1e-12);
+}
+
+TEST(BachelierTest, PutCallParity) {
+    for (double S : {-1.0, 0.0, 0.5, 100.0}) {
+        double K = 0.25;
+        double T = 2.0;
+        double r = 0.03;
+        double call = bachelier_price(true, S, K, T, r, 0.8);
+        double put = bachelier_price(false, S, K, T, r, 0.8);
+        EXPECT_NEAR(call - put, S - K * std::exp(-r * T), 1e-12) << "S=" << S;
+    }
+}
+
+TEST(BachelierTest, VegaMatchesFiniteDifference) {
+    double h = 1e-6;
+    double up = bachelier_price(true, 0.1, 0.2, 1.5, 0.02, 0.3 + h);
+    double down = bachelier_price(true, 0.1, 0.2, 1.5, 0.02, 0.3 - h);
+    EXPECT_NEAR(bachelier_vega(0.1, 0.2, 1.5, 0.02, 0.3), (up - down) / (2 * h), 1e-8);
+}
+
+TEST(BachelierTest, ImpliedVolatilityRoundTrip) {
+    for (double S : {-0.5, 0.0, 0.01, 1.0, 100.0}) {
+        for (double sigma : {0.005, 0.3, 5.0}) {
+            // Strikes up to five standard deviations away, inverting the out-of-the-money side
+            for (double d : {-5.0, -1.0, -0.01, 0.0, 0.02, 0.7, 5.0}) {
+                double forward = S * std::exp(0.03 * 0.7);
+                double K = forward + d * sigma * std::sqrt(0.7);
+                bool is_call = K >= forward;
+                double price = bachelier_price(is_call, S, K, 0.7, 0.03, sigma);
+                double implied = bachelier_implied_volatility(is_call, S, K, 0.7, 0.03, price);
+                EXPECT_NEAR(implied, sigma, sigma * 1e-9)
+                    << "S=" << S << ", K=" << K << ", is_call=" << is_call;
+            }
+        }
+    }
+
+    // In-the-money options invert through their time value
+    double price = bachelier_price(true, 1.0, 0.8, 1.0, 0.0, 0.3);
+    EXPECT_NEAR(bachelier_implied_volatility(true, 1.0, 0.8, 1.0, 0.0, price), 0.3, 1e-9);
+}
+
+TEST(BachelierTest, BatchMatchesScalar) {
+    OptionBatch batch;
+    std::vector<double> volatility = {0.2, 0.5, 1.0, 0.2};
+    batch.push_back(true, -0.2, 0.1, 1.0, 0.01);
+    batch.push_back(false, 0.3, 0.3, 0.5, 0.02);
+    batch.push_back(true, 5.0, 4.0, 2.0, 0.0);
+    batch.push_back(true, 5.0, 4.0, 0.0, 0.0);  // Invalid row
+
+    std::vector<double> prices = bachelier_price_batch(batch, volatility);
+    for (std::size_t i = 0; i + 1 < batch.size(); ++i) {
+        EXPECT_DOUBLE_EQ(prices[i], bachelier_price(batch.is_call[i] != 0, batch.asset_price[i],
+                                                    batch.strike_price[i], batch.time_to_expiry[i],
+                                                    batch.risk_free_rate[i], volatility[i]));
+    }
+    EXPECT_TRUE(std::isnan(prices.back()));
+
+    std::vector<double> implied = bachelier_implied_volatility_batch(batch, prices);
+    for (std::size_t i = 0; i + 1 < batch.size(); ++i) {
+        EXPECT_NEAR(implied[i], volatility[i], 1e-10);
+    }
+    EXPECT_TRUE(std::isnan(implied.back()));
+}
+
+TEST(BachelierTest, ParsePricingModel) {
+    EXPECT_EQ(parse_pricing_model("Bachelier"), PricingModel::BACHELIER);
+    EXPECT_EQ(parse_pricing_model("normal"), PricingModel::BACHELIER);
+    EXPECT_EQ(parse_pricing_model("black-scholes"), PricingModel::BLACK_SCHOLES);
+    EXPECT_EQ(parse_pricing_model("BlackScholes"), PricingModel::BLACK_SCHOLES);
+    EXPECT_THROW(parse_pricing_model("heston"), std::invalid_argument);
+}
+
+TEST(BachelierTest, InvalidInputs) {
+    EXPECT_THROW(bachelier_price(true, 0.0, 0.0, 0.0, 0.0, 0.2), std::invalid_argument);
+    EXPECT_THROW(bachelier_price(true, 0.0, 0.0, 1.0, 0.0, -0.2), std::invalid_argument);
+    EXPECT_THROW(bachelier_vega(0.0, 0.0, 1.0, 0.0, 0.0), std::invalid_argument);
+
+    // A call worth less than its intrinsic value has no implied volatility
+    EXPECT_THROW(bachelier_implied_volatility(true, 1.0, 0.0, 1.0, 0.0, 0.5),
+                 std::invalid_argument);
+}
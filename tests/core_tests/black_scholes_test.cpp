@@ -1,5 +1,6 @@
 #include "src/core/black_scholes.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <gtest/gtest.h>
@@ -216,3 +217,358 @@ TEST(BlackScholesTest, InvalidInputs) {
     EXPECT_THROW(black_scholes_vega(100.0, 100.0, 0.0, 0.05, 0.2), std::invalid_argument);
     EXPECT_THROW(black_scholes_vega(100.0, 100.0, 1.0, 0.05, 0.0), std::invalid_argument);
 }
+
+TEST(BlackScholesTest, SolveReportsIterations) {
+    double price = black_scholes_price(true, 100.0, 100.0, 1.0, 0.05, 0.25);
+    for (auto method : {ImpliedVolatilityMethod::BISECTION,
+                        ImpliedVolatilityMethod::NEWTON_RAPHSON, ImpliedVolatilityMethod::BRENT}) {
+        ImpliedVolatilityResult result =
+            solve_implied_volatility(true, 100.0, 100.0, 1.0, 0.05, price, method);
+        EXPECT_EQ(result.volatility,
+                  calculate_implied_volatility(true, 100.0, 100.0, 1.0, 0.05, price, method));
+        EXPECT_GT(result.iterations, 0);
+    }
+}
+
+TEST(BlackScholesTest, BrentMethod) {
+    // Round trip across moneyness, expiry and volatility, wherever the price carries time value
+    for (double K : {60.0, 95.0, 100.0, 110.0, 180.0}) {
+        for (double T : {0.02, 0.5, 3.0}) {
+            for (double vol : {0.08, 0.3, 1.2}) {
+                double intrinsic = std::max(100.0 - K * std::exp(-0.03 * T), 0.0);
+                if (black_scholes_price(true, 100.0, K, T, 0.03, vol) - intrinsic < 1e-9) {
+                    continue;
+                }
+                TestImpliedVolatilityMethod(true, 100.0, K, T, 0.03, vol,
+                                            ImpliedVolatilityMethod::BRENT, 1e-6);
+            }
+        }
+    }
+
+    // Far fewer price evaluations than bisection
+    double price = black_scholes_price(false, 100.0, 90.0, 0.5, 0.02, 0.35);
+    ImpliedVolatilityResult brent = solve_implied_volatility(false, 100.0, 90.0, 0.5, 0.02, price,
+                                                             ImpliedVolatilityMethod::BRENT);
+    ImpliedVolatilityResult bisection = solve_implied_volatility(
+        false, 100.0, 90.0, 0.5, 0.02, price, ImpliedVolatilityMethod::BISECTION);
+    EXPECT_NEAR(brent.volatility, 0.35, 1e-9);
+    EXPECT_LT(brent.iterations * 2, bisection.iterations);
+
+    // Tiny vega: a deep out-of-the-money short-dated option is still resolved in volatility
+    double otm = black_scholes_price(true, 100.0, 130.0, 0.05, 0.01, 0.6);
+    EXPECT_NEAR(brent_implied_volatility(true, 100.0, 130.0, 0.05, 0.01, otm), 0.6, 1e-8);
+
+    // Prices outside the no-arbitrage bounds have no implied volatility
+    EXPECT_THROW(brent_implied_volatility(true, 100.0, 100.0, 1.0, 0.05, 100.5),
+                 std::invalid_argument);
+    EXPECT_THROW(brent_implied_volatility(false, 100.0, 120.0, 1.0, 0.0, 19.0),
+                 std::invalid_argument);
+}
+
+TEST(BlackScholesTest, HigherOrderMethods) {
+    // Vomma matches a central difference of vega, which is per percentage point
+    double h = 1e-5;
+    double vomma_fd = 100.0 *
+                      (black_scholes_vega(100.0, 120.0, 0.7, 0.03, 0.27 + h) -
+                       black_scholes_vega(100.0, 120.0, 0.7, 0.03, 0.27 - h)) /
+                      (2.0 * h);
+    EXPECT_NEAR(black_scholes_vomma(100.0, 120.0, 0.7, 0.03, 0.27), vomma_fd, 1e-4);
+    EXPECT_THROW(black_scholes_vomma(100.0, 100.0, 1.0, 0.05, 0.0), std::invalid_argument);
+
+    for (ImpliedVolatilityMethod method :
+         {ImpliedVolatilityMethod::HALLEY, ImpliedVolatilityMethod::HOUSEHOLDER}) {
+        TestImpliedVolatilityMethod(true, 100.0, 100.0, 1.0, 0.05, 0.2, method);
+        TestImpliedVolatilityMethod(false, 100.0, 90.0, 1.0, 0.05, 0.2, method);
+        TestImpliedVolatilityMethod(true, 100.0, 130.0, 0.5, 0.02, 0.45, method);
+        TestImpliedVolatilityMethod(false, 100.0, 100.0, 0.05, 0.05, 0.8, method);
+    }
+    EXPECT_NEAR(halley_implied_volatility(true, 100.0, 110.0, 1.0, 0.05,
+                                          black_scholes_price(true, 100.0, 110.0, 1.0, 0.05, 0.3)),
+                0.3, 1e-4);
+    EXPECT_NEAR(householder_implied_volatility(
+                    false, 100.0, 80.0, 2.0, 0.01,
+                    black_scholes_price(false, 100.0, 80.0, 2.0, 0.01, 0.5)),
+                0.5, 1e-4);
+
+    // Each order needs no more iterations over a chain than the one below it
+    auto chain_iterations = [](ImpliedVolatilityMethod method) {
+        int total = 0;
+        for (double K : {60.0, 80.0, 95.0, 100.0, 105.0, 120.0, 150.0}) {
+            for (double T : {0.05, 0.5, 2.0}) {
+                for (double vol : {0.1, 0.3, 0.9}) {
+                    double price = black_scholes_price(false, 100.0, K, T, 0.02, vol);
+                    double intrinsic = std::max(K * std::exp(-0.02 * T) - 100.0, 0.0);
+                    if (price - intrinsic < 0.01) {
+                        continue;
+                    }
+                    total +=
+                        solve_implied_volatility(false, 100.0, K, T, 0.02, price, method)
+                            .iterations;
+                }
+            }
+        }
+        return total;
+    };
+    int newton = chain_iterations(ImpliedVolatilityMethod::NEWTON_RAPHSON);
+    int halley = chain_iterations(ImpliedVolatilityMethod::HALLEY);
+    int householder = chain_iterations(ImpliedVolatilityMethod::HOUSEHOLDER);
+    EXPECT_LT(halley, newton);
+    EXPECT_LE(householder, halley);
+}
+
+TEST(BlackScholesTest, BatchBisection) {
+    EXPECT_EQ(batch_bisection_iterations(1e-10), 37);
+    EXPECT_EQ(batch_bisection_iterations(100.0), 0);
+    EXPECT_THROW(batch_bisection_iterations(0.0), std::invalid_argument);
+
+    // More options than one block of lanes, including ones Newton-Raphson cannot reach
+    OptionBatch batch;
+    std::vector<double> prices;
+    std::vector<double> expected;
+    for (double K : {80.0, 100.0, 125.0}) {
+        for (double vol : {0.05, 0.4, 8.0}) {
+            for (bool is_call : {true, false}) {
+                batch.push_back(is_call, 100.0, K, 0.5, 0.03);
+                prices.push_back(black_scholes_price(is_call, 100.0, K, 0.5, 0.03, vol));
+                expected.push_back(vol);
+            }
+        }
+    }
+    // Invalid inputs and a price above the asset have no implied volatility
+    batch.push_back(true, 100.0, 100.0, 0.0, 0.03);
+    prices.push_back(5.0);
+    batch.push_back(true, 100.0, 100.0, 1.0, 0.03);
+    prices.push_back(120.0);
+    batch.push_back(false, 100.0, 100.0, 1.0, 0.03);
+    prices.push_back(-1.0);
+
+    std::vector<double> volatility = black_scholes_implied_volatility_batch(batch, prices);
+    ASSERT_EQ(volatility.size(), batch.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        double intrinsic = batch.is_call[i] != 0
+                               ? std::max(100.0 - batch.strike_price[i] * std::exp(-0.015), 0.0)
+                               : std::max(batch.strike_price[i] * std::exp(-0.015) - 100.0, 0.0);
+        if (prices[i] - intrinsic < 1e-6) {
+            continue;  // Too little time value to pin the volatility
+        }
+        EXPECT_NEAR(volatility[i], expected[i], 1e-8) << "option " << i;
+    }
+    EXPECT_TRUE(std::isnan(volatility[expected.size()]));
+    EXPECT_TRUE(std::isnan(volatility[expected.size() + 1]));
+    EXPECT_TRUE(std::isnan(volatility[expected.size() + 2]));
+
+    EXPECT_THROW(black_scholes_implied_volatility_batch(batch, {1.0}), std::invalid_argument);
+}
+
+TEST(BlackScholesTest, ConvergenceCriteria) {
+    // A cheap out-of-the-money option: a tight price test says little about the volatility
+    double price = black_scholes_price(true, 100.0, 150.0, 0.25, 0.02, 0.3);
+    for (ImpliedVolatilityMethod method :
+         {ImpliedVolatilityMethod::BISECTION, ImpliedVolatilityMethod::NEWTON_RAPHSON,
+          ImpliedVolatilityMethod::HALLEY, ImpliedVolatilityMethod::BRENT}) {
+        SolverOptions options;
+        options.method = method;
+
+        // The default test reports the method's own measure
+        ImpliedVolatilityResult standard =
+            solve_implied_volatility(true, 100.0, 150.0, 0.25, 0.02, price, options);
+        EXPECT_GE(standard.achieved, 0.0);
+
+        options.criterion = ConvergenceCriterion::VOLATILITY;
+        options.tolerance = 1e-9;
+        ImpliedVolatilityResult in_volatility =
+            solve_implied_volatility(true, 100.0, 150.0, 0.25, 0.02, price, options);
+        EXPECT_NEAR(in_volatility.volatility, 0.3, 1e-8)
+            << implied_volatility_method_name(method);
+        EXPECT_LT(in_volatility.achieved, 1.1e-9);
+
+        options.criterion = ConvergenceCriterion::VEGA_SCALED;
+        ImpliedVolatilityResult vega_scaled =
+            solve_implied_volatility(true, 100.0, 150.0, 0.25, 0.02, price, options);
+        EXPECT_NEAR(vega_scaled.volatility, 0.3, 1e-8) << implied_volatility_method_name(method);
+        EXPECT_LT(vega_scaled.achieved, 1e-9);
+
+        // A loose relative test stops early on the expensive side of the chain
+        options.criterion = ConvergenceCriterion::RELATIVE_PRICE;
+        options.tolerance = 1e-4;
+        double itm = black_scholes_price(true, 100.0, 60.0, 0.25, 0.02, 0.3);
+        ImpliedVolatilityResult relative =
+            solve_implied_volatility(true, 100.0, 60.0, 0.25, 0.02, itm, options);
+        EXPECT_LT(relative.achieved, 1e-4);
+        EXPECT_NEAR(black_scholes_price(true, 100.0, 60.0, 0.25, 0.02, relative.volatility),
+                    itm, itm * 1e-4);
+    }
+
+    // Bisection stops on the bracket width before the price test would
+    SolverOptions bisection;
+    bisection.criterion = ConvergenceCriterion::VOLATILITY;
+    bisection.tolerance = 1e-6;
+    EXPECT_LT(solve_implied_volatility(true, 100.0, 100.0, 1.0, 0.05, 10.45, bisection).iterations,
+              solve_implied_volatility(true, 100.0, 100.0, 1.0, 0.05, 10.45).iterations);
+
+    EXPECT_EQ(parse_convergence_criterion("vol"), ConvergenceCriterion::VOLATILITY);
+    EXPECT_EQ(parse_convergence_criterion("Vega"), ConvergenceCriterion::VEGA_SCALED);
+    EXPECT_EQ(parse_convergence_criterion("relative"), ConvergenceCriterion::RELATIVE_PRICE);
+    EXPECT_THROW(parse_convergence_criterion("loose"), std::invalid_argument);
+}
+
+TEST(BlackScholesTest, AutoMethod) {
+    // Near the money goes to Householder, a far wing with little time value to Brent
+    double atm = black_scholes_price(true, 100.0, 100.0, 0.5, 0.02, 0.25);
+    EXPECT_EQ(select_implied_volatility_method(true, 100.0, 100.0, 0.5, 0.02, atm),
+              ImpliedVolatilityMethod::HOUSEHOLDER);
+    double wing = black_scholes_price(false, 100.0, 60.0, 0.05, 0.02, 0.3);
+    EXPECT_EQ(select_implied_volatility_method(false, 100.0, 60.0, 0.05, 0.02, wing),
+              ImpliedVolatilityMethod::BRENT);
+    // Prices outside the bounds are left to Brent's method to reject
+    EXPECT_EQ(select_implied_volatility_method(true, 100.0, 100.0, 1.0, 0.05, 120.0),
+              ImpliedVolatilityMethod::BRENT);
+
+    // The batch pass makes the same choices, and AUTO solves accurately in both regions
+    OptionBatch batch;
+    std::vector<double> prices;
+    for (double K : {50.0, 70.0, 90.0, 100.0, 110.0, 140.0, 200.0}) {
+        for (double T : {0.01, 0.25, 2.0}) {
+            for (double vol : {0.1, 0.4}) {
+                batch.push_back(K >= 100.0, 100.0, K, T, 0.03);  // Out of the money
+                prices.push_back(black_scholes_price(K >= 100.0, 100.0, K, T, 0.03, vol));
+            }
+        }
+    }
+    std::vector<ImpliedVolatilityMethod> methods =
+        select_implied_volatility_methods(batch, prices);
+    ASSERT_EQ(methods.size(), batch.size());
+    int routed_to_brent = 0;
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        bool is_call = batch.is_call[i] != 0;
+        double K = batch.strike_price[i];
+        double T = batch.time_to_expiry[i];
+        EXPECT_EQ(methods[i],
+                  select_implied_volatility_method(is_call, 100.0, K, T, 0.03, prices[i]));
+        routed_to_brent += methods[i] == ImpliedVolatilityMethod::BRENT ? 1 : 0;
+        if (prices[i] < 1e-12) {
+            continue;  // No time value left to invert
+        }
+        ImpliedVolatilityResult solved = solve_implied_volatility(
+            is_call, 100.0, K, T, 0.03, prices[i], ImpliedVolatilityMethod::AUTO);
+        EXPECT_EQ(solved.method, methods[i]);
+        EXPECT_NEAR(solved.volatility, i % 2 == 0 ? 0.1 : 0.4, 1e-6)
+            << "K=" << K << ", T=" << T;
+    }
+    EXPECT_GT(routed_to_brent, 0);
+    EXPECT_LT(routed_to_brent, static_cast<int>(batch.size()));
+
+    EXPECT_THROW(select_implied_volatility_methods(batch, {}), std::invalid_argument);
+}
+
+TEST(BlackScholesTest, QuoteImpliedVolatility) {
+    // Quotes priced at known volatilities are recovered on both sides of the mid
+    for (double K : {70.0, 90.0, 100.0, 115.0, 150.0}) {
+        for (double T : {0.05, 0.5, 2.0}) {
+            bool is_call = K >= 100.0;
+            double bid = black_scholes_price(is_call, 100.0, K, T, 0.03, 0.22);
+            double ask = black_scholes_price(is_call, 100.0, K, T, 0.03, 0.26);
+            if (bid < 1e-6) {
+                continue;  // No time value left to invert
+            }
+            QuoteImpliedVolatility quotes =
+                solve_quote_implied_volatility(is_call, 100.0, K, T, 0.03, bid, ask);
+            EXPECT_NEAR(quotes.bid.volatility, 0.22, 1e-8) << "K=" << K << ", T=" << T;
+            EXPECT_NEAR(quotes.ask.volatility, 0.26, 1e-8) << "K=" << K << ", T=" << T;
+            EXPECT_GT(quotes.mid.volatility, quotes.bid.volatility);
+            EXPECT_LT(quotes.mid.volatility, quotes.ask.volatility);
+            EXPECT_NEAR(quotes.spread(), 0.04, 1e-8);
+            // Started next to their roots, the sides need few iterations
+            EXPECT_LE(quotes.bid.iterations, 5);
+            EXPECT_LE(quotes.ask.iterations, 5);
+        }
+    }
+
+    // A zero bid has no volatility while the ask still solves
+    double ask = black_scholes_price(true, 100.0, 130.0, 0.25, 0.03, 0.3);
+    QuoteImpliedVolatility one_sided =
+        solve_quote_implied_volatility(true, 100.0, 130.0, 0.25, 0.03, 0.0, ask);
+    EXPECT_TRUE(std::isnan(one_sided.bid.volatility));
+    EXPECT_NEAR(one_sided.ask.volatility, 0.3, 1e-8);
+    EXPECT_TRUE(std::isnan(one_sided.spread()));
+
+    EXPECT_THROW(solve_quote_implied_volatility(true, 100.0, 100.0, 1.0, 0.03, 5.0, 4.0),
+                 std::invalid_argument);
+    EXPECT_THROW(solve_quote_implied_volatility(true, 100.0, 100.0, 1.0, 0.03, -1.0, 4.0),
+                 std::invalid_argument);
+}
+
+TEST(BlackScholesTest, ParseMethod) {
+    EXPECT_EQ(parse_implied_volatility_method("Brent"), ImpliedVolatilityMethod::BRENT);
+    EXPECT_EQ(parse_implied_volatility_method("newton-raphson"),
+              ImpliedVolatilityMethod::NEWTON_RAPHSON);
+    EXPECT_EQ(parse_implied_volatility_method("bisection"), ImpliedVolatilityMethod::BISECTION);
+    EXPECT_THROW(parse_implied_volatility_method("secant"), std::invalid_argument);
+    EXPECT_EQ(parse_implied_volatility_method("Halley"), ImpliedVolatilityMethod::HALLEY);
+    EXPECT_EQ(parse_implied_volatility_method("householder"),
+              ImpliedVolatilityMethod::HOUSEHOLDER);
+    EXPECT_STREQ(implied_volatility_method_name(ImpliedVolatilityMethod::BRENT), "brent");
+    EXPECT_STREQ(implied_volatility_method_name(ImpliedVolatilityMethod::HOUSEHOLDER),
+                 "householder");
+    EXPECT_EQ(parse_implied_volatility_method("AUTO"), ImpliedVolatilityMethod::AUTO);
+    EXPECT_STREQ(implied_volatility_method_name(ImpliedVolatilityMethod::AUTO), "auto");
+}
+
+TEST(BlackScholesTest, InitialGuess) {
+    // Newton-Raphson iterations summed over a chain, by starting point
+    auto chain_iterations = [](InitialGuess guess) {
+        int total = 0;
+        for (double K : {70.0, 85.0, 95.0, 100.0, 105.0, 115.0, 140.0}) {
+            for (double T : {0.05, 0.5, 2.0}) {
+                for (double vol : {0.1, 0.25, 0.6}) {
+                    // Skip prices too close to a bound to pin the volatility within 1e-3
+                    double price = black_scholes_price(true, 100.0, K, T, 0.02, vol);
+                    double intrinsic = std::max(100.0 - K * std::exp(-0.02 * T), 0.0);
+                    if (price - intrinsic < 0.01) {
+                        continue;
+                    }
+                    SolverOptions options;
+                    options.method = ImpliedVolatilityMethod::NEWTON_RAPHSON;
+                    options.guess = guess;
+                    ImpliedVolatilityResult result =
+                        solve_implied_volatility(true, 100.0, K, T, 0.02, price, options);
+                    EXPECT_NEAR(result.volatility, vol, 1e-3);
+                    total += result.iterations;
+                }
+            }
+        }
+        return total;
+    };
+    EXPECT_LT(chain_iterations(InitialGuess::AUTO), chain_iterations(InitialGuess::BUCKETS));
+
+    // Corrado-Miller lands close to the answer near the money
+    double atm = black_scholes_price(false, 100.0, 102.0, 0.5, 0.02, 0.3);
+    EXPECT_NEAR(initial_volatility_guess(false, 100.0, 102.0, 0.5, 0.02, atm,
+                                         InitialGuess::CORRADO_MILLER),
+                0.3, 0.01);
+
+    // A previous solution of a neighbouring strike takes precedence and needs few steps
+    double price = black_scholes_price(true, 100.0, 104.0, 1.0, 0.02, 0.31);
+    EXPECT_DOUBLE_EQ(initial_volatility_guess(true, 100.0, 104.0, 1.0, 0.02, price,
+                                              InitialGuess::AUTO, 0.3),
+                     0.3);
+    SolverOptions warm;
+    warm.method = ImpliedVolatilityMethod::NEWTON_RAPHSON;
+    warm.previous = 0.3;
+    ImpliedVolatilityResult result = solve_implied_volatility(true, 100.0, 104.0, 1.0, 0.02,
+                                                              price, warm);
+    EXPECT_NEAR(result.volatility, 0.31, 1e-5);
+    EXPECT_LE(result.iterations, 3);
+
+    // Newton-Raphson beats bisection at the money now that its step uses the full vega
+    double at_money = black_scholes_price(true, 100.0, 100.0, 1.0, 0.05, 0.2);
+    EXPECT_LT(solve_implied_volatility(true, 100.0, 100.0, 1.0, 0.05, at_money,
+                                       ImpliedVolatilityMethod::NEWTON_RAPHSON)
+                  .iterations,
+              solve_implied_volatility(true, 100.0, 100.0, 1.0, 0.05, at_money,
+                                       ImpliedVolatilityMethod::BISECTION)
+                  .iterations);
+
+    EXPECT_EQ(parse_initial_guess("Corrado-Miller"), InitialGuess::CORRADO_MILLER);
+    EXPECT_THROW(parse_initial_guess("li"), std::invalid_argument);
+}
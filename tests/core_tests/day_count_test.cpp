@@ -0,0 +1,107 @@
+#include "src/core/day_count.h"
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using namespace iv_calculator::core;
+
+// Test date conversions in both directions
+TEST(DayCountTest, CivilDaysTest) {
+    EXPECT_EQ(days_from_civil(1970, 1, 1), 0);
+    EXPECT_EQ(days_from_civil(2000, 3, 1), 11017);
+    EXPECT_EQ(days_from_civil(1969, 12, 31), -1);
+
+    for (std::int64_t day = -800; day < 80000; day += 37) {
+        int year = 0;
+        unsigned month = 0;
+        unsigned date = 0;
+        civil_from_days(day, year, month, date);
+        EXPECT_EQ(days_from_civil(year, month, date), day);
+    }
+}
+
+// Test dates and timestamps and rejected text
+TEST(DayCountTest, ParseTimestampTest) {
+    EXPECT_DOUBLE_EQ(parse_timestamp("2024-02-29"), days_from_civil(2024, 2, 29));
+    EXPECT_DOUBLE_EQ(parse_timestamp("2024-02-29T12:00"), days_from_civil(2024, 2, 29) + 0.5);
+    EXPECT_DOUBLE_EQ(parse_timestamp("2024-02-29 06:00:36"),
+                     days_from_civil(2024, 2, 29) + 0.25 + 36.0 / 86400.0);
+
+    for (const char* text : {"2023-02-29", "2024-13-01", "2024-1-01", "24-01-01", "2024-01-01T",
+                             "2024-01-01T24:00", "2024-01-01T10:00:", "2024/01/01"}) {
+        EXPECT_THROW(parse_timestamp(text), std::invalid_argument) << text;
+    }
+
+    EXPECT_DOUBLE_EQ(parse_time_of_day("16:00"), 16.0 / 24.0);
+    EXPECT_DOUBLE_EQ(parse_time_of_day("06:00:36"), 0.25 + 36.0 / 86400.0);
+    for (const char* text : {"", "16", "24:00", "16:60", "16:00:", "4:00", "16:00:00Z"}) {
+        EXPECT_THROW(parse_time_of_day(text), std::invalid_argument) << text;
+    }
+}
+
+// Test the year fraction of each convention
+TEST(DayCountTest, YearFractionTest) {
+    double start = parse_timestamp("2023-07-01");
+    double end = parse_timestamp("2024-07-01");
+    EXPECT_DOUBLE_EQ(year_fraction(DayCount::ACT_365_FIXED, start, end), 366.0 / 365.0);
+    EXPECT_DOUBLE_EQ(year_fraction(DayCount::ACT_360, start, end), 366.0 / 360.0);
+    EXPECT_DOUBLE_EQ(year_fraction(DayCount::ACT_ACT_ISDA, start, end),
+                     184.0 / 365.0 + 182.0 / 366.0);
+    EXPECT_DOUBLE_EQ(year_fraction(DayCount::THIRTY_360, start, end), 1.0);
+    EXPECT_DOUBLE_EQ(year_fraction(DayCount::ACT_ACT_ISDA, end, start),
+                     -year_fraction(DayCount::ACT_ACT_ISDA, start, end));
+
+    // 30/360 moves the 31st to the 30th
+    EXPECT_DOUBLE_EQ(year_fraction(DayCount::THIRTY_360, parse_timestamp("2024-01-31"),
+                                   parse_timestamp("2024-03-31")),
+                     60.0 / 360.0);
+
+    // Time of day counts in the ACT conventions only
+    double afternoon = parse_timestamp("2023-07-01T18:00");
+    EXPECT_DOUBLE_EQ(year_fraction(DayCount::ACT_365_FIXED, afternoon, end), 365.25 / 365.0);
+    EXPECT_DOUBLE_EQ(year_fraction(DayCount::THIRTY_360, afternoon, end), 1.0);
+
+    EXPECT_EQ(parse_day_count("ACT/365F"), DayCount::ACT_365_FIXED);
+    EXPECT_EQ(parse_day_count("30/360"), DayCount::THIRTY_360);
+    EXPECT_EQ(parse_day_count("bus252"), DayCount::BUSINESS_252);
+    EXPECT_THROW(parse_day_count("act/999"), std::invalid_argument);
+}
+
+// Test business days against a day-by-day count
+TEST(DayCountTest, HolidayCalendarTest) {
+    auto day = [](const char* text) { return static_cast<std::int64_t>(parse_timestamp(text)); };
+    HolidayCalendar calendar({day("2024-12-25"), day("2025-01-01"), day("2024-12-28"),
+                              day("2024-12-25")});
+    EXPECT_EQ(calendar.size(), 2u);  // Saturday and repeat dropped
+    EXPECT_FALSE(calendar.is_business_day(day("2024-12-25")));
+    EXPECT_FALSE(calendar.is_business_day(day("2024-12-29")));
+    EXPECT_TRUE(calendar.is_business_day(day("2024-12-27")));
+
+    for (std::int64_t from = day("2024-12-01"); from < day("2025-01-10"); from += 3) {
+        for (std::int64_t to = from; to < day("2025-02-01"); to += 5) {
+            std::int64_t expected = 0;
+            for (std::int64_t d = from + 1; d <= to; ++d) {
+                expected += calendar.is_business_day(d) ? 1 : 0;
+            }
+            EXPECT_EQ(calendar.business_days(from, to), expected);
+            EXPECT_EQ(calendar.business_days(to, from), -expected);
+        }
+    }
+    EXPECT_DOUBLE_EQ(year_fraction(DayCount::BUSINESS_252, parse_timestamp("2024-12-23T10:00"),
+                                   parse_timestamp("2025-01-03"), calendar),
+                     7.0 / 252.0);
+}
+
+// Test that each distinct pair is computed once
+TEST(DayCountTest, YearFractionCacheTest) {
+    YearFractionCache cache(DayCount::ACT_360);
+    double valuation = parse_timestamp("2026-10-16");
+    double first = parse_timestamp("2026-12-18");
+    double second = parse_timestamp("2027-03-19");
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_DOUBLE_EQ(cache.get(valuation, i % 3 == 0 ? first : second),
+                         year_fraction(DayCount::ACT_360, valuation,
+                                       i % 3 == 0 ? first : second));
+    }
+    EXPECT_EQ(cache.size(), 2u);
+}
@@ -0,0 +1,35 @@
+#include "src/core/dividends.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace iv_calculator::core;
+
+// Test which dividends count and how they are discounted
+TEST(DividendsTest, PresentValueTest) {
+    DividendSchedule schedule;
+    schedule.add(parse_timestamp("2027-03-15"), 0.5);
+    schedule.add(parse_timestamp("2026-09-15"), 0.4);  // Already ex
+    schedule.add(parse_timestamp("2026-12-15"), 0.5);
+    ASSERT_EQ(schedule.ex_dates().size(), 3u);
+    EXPECT_EQ(schedule.amounts()[0], 0.4);  // Kept in ex-date order
+
+    YearFractionCache fractions(DayCount::ACT_365_FIXED);
+    double valuation = parse_timestamp("2026-10-15");
+    double first = 61.0 / 365.0;
+    double second = 151.0 / 365.0;
+
+    EXPECT_DOUBLE_EQ(schedule.present_value(valuation, 0.1, fractions, 0.05), 0.0);
+    EXPECT_DOUBLE_EQ(schedule.present_value(valuation, 0.25, fractions, 0.05),
+                     0.5 * std::exp(-0.05 * first));
+    EXPECT_DOUBLE_EQ(schedule.present_value(valuation, 1.0, fractions, 0.05),
+                     0.5 * std::exp(-0.05 * first) + 0.5 * std::exp(-0.05 * second));
+
+    // A curve replaces the flat rate
+    YieldCurve curve({0.25, 1.0}, {0.02, 0.04});
+    EXPECT_DOUBLE_EQ(schedule.present_value(valuation, 1.0, fractions, 0.05, &curve),
+                     0.5 * curve.discount(first) + 0.5 * curve.discount(second));
+
+    // An ex-date on the expiry counts
+    EXPECT_DOUBLE_EQ(schedule.present_value(valuation, second, fractions, 0.0), 1.0);
+}
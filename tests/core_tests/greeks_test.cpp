@@ -0,0 +1,85 @@
+#include "src/core/bachelier.h"
+#include "src/core/black_scholes.h"
+#include "src/core/greeks.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using namespace iv_calculator::core;
+
+namespace {
+    using PriceFunction = double (*)(bool, double, double, double, double, double);
+
+    // Central differences of a pricing function in S, sigma, T and r
+    Greeks finite_difference_greeks(PriceFunction price, bool is_call, double S, double K,
+                                    double T, double r, double sigma) {
+        double h = 1e-4;
+        Greeks greeks;
+        double up = price(is_call, S + h, K, T, r, sigma);
+        double mid = price(is_call, S, K, T, r, sigma);
+        double down = price(is_call, S - h, K, T, r, sigma);
+        greeks.delta = (up - down) / (2 * h);
+        greeks.gamma = (up - 2 * mid + down) / (h * h);
+        greeks.vega =
+            (price(is_call, S, K, T, r, sigma + h) - price(is_call, S, K, T, r, sigma - h)) /
+            (2 * h);
+        greeks.theta =
+            -(price(is_call, S, K, T + h, r, sigma) - price(is_call, S, K, T - h, r, sigma)) /
+            (2 * h);
+        greeks.rho =
+            (price(is_call, S, K, T, r + h, sigma) - price(is_call, S, K, T, r - h, sigma)) /
+            (2 * h);
+        return greeks;
+    }
+
+    void expect_greeks_near(const Greeks& actual, const Greeks& expected) {
+        EXPECT_NEAR(actual.delta, expected.delta, 1e-6);
+        EXPECT_NEAR(actual.gamma, expected.gamma, 1e-4);
+        EXPECT_NEAR(actual.vega, expected.vega, 1e-5);
+        EXPECT_NEAR(actual.theta, expected.theta, 1e-5);
+        EXPECT_NEAR(actual.rho, expected.rho, 1e-5);
+    }
+}  // namespace
+
+TEST(GreeksTest, BlackScholesMatchesFiniteDifferences) {
+    for (bool is_call : {true, false}) {
+        for (double K : {80.0, 100.0, 125.0}) {
+            SCOPED_TRACE(::testing::Message() << "is_call=" << is_call << ", K=" << K);
+            Greeks greeks = black_scholes_greeks(is_call, 100.0, K, 0.75, 0.03, 0.25);
+            expect_greeks_near(greeks, finite_difference_greeks(black_scholes_price, is_call,
+                                                                100.0, K, 0.75, 0.03, 0.25));
+        }
+    }
+}
+
+TEST(GreeksTest, BachelierMatchesFiniteDifferences) {
+    for (bool is_call : {true, false}) {
+        for (double S : {-0.5, 0.0, 0.3}) {
+            SCOPED_TRACE(::testing::Message() << "is_call=" << is_call << ", S=" << S);
+            Greeks greeks = bachelier_greeks(is_call, S, 0.1, 1.5, 0.02, 0.4);
+            expect_greeks_near(greeks, finite_difference_greeks(bachelier_price, is_call, S,
+                                                                0.1, 1.5, 0.02, 0.4));
+        }
+    }
+}
+
+TEST(GreeksTest, VegaIsPerUnitOfVolatility) {
+    Greeks greeks = black_scholes_greeks(true, 100.0, 105.0, 0.5, 0.01, 0.3);
+    EXPECT_NEAR(greeks.vega / 100.0, black_scholes_vega(100.0, 105.0, 0.5, 0.01, 0.3), 1e-12);
+}
+
+TEST(GreeksTest, ComputesOnlyRequestedSensitivities) {
+    Greeks greeks = black_scholes_greeks(false, 100.0, 95.0, 1.0, 0.05, 0.2,
+                                         greek_flags::kDelta | greek_flags::kRho);
+    EXPECT_FALSE(std::isnan(greeks.delta));
+    EXPECT_FALSE(std::isnan(greeks.rho));
+    EXPECT_TRUE(std::isnan(greeks.gamma));
+    EXPECT_TRUE(std::isnan(greeks.vega));
+    EXPECT_TRUE(std::isnan(greeks.theta));
+}
+
+TEST(GreeksTest, RejectsInvalidInputs) {
+    EXPECT_THROW(black_scholes_greeks(true, 100.0, 100.0, 1.0, 0.05, 0.0), std::invalid_argument);
+    EXPECT_THROW(bachelier_greeks(true, 0.0, 0.0, 0.0, 0.05, 0.2), std::invalid_argument);
+}
@@ -0,0 +1,127 @@
+#include "src/core/black_scholes.h"
+#include "src/core/pde_solver.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace iv_calculator::core;
+
+namespace {
+    PdeConfig european_config() {
+        PdeConfig config;
+        config.exercise = ExerciseStyle::EUROPEAN;
+        return config;
+    }
+}  // namespace
+
+TEST(PdeSolverTest, EuropeanMatchesBlackScholes) {
+    for (double K : {80.0, 100.0, 120.0}) {
+        for (bool is_call : {true, false}) {
+            double expected = black_scholes_price(is_call, 100.0, K, 1.0, 0.05, 0.2);
+            double price = pde_option_price(is_call, 100.0, K, 1.0, 0.05, 0.2, european_config());
+            EXPECT_NEAR(price, expected, 0.01) << "is_call=" << is_call << ", K=" << K;
+        }
+    }
+}
+
+TEST(PdeSolverTest, AmericanPutReferenceValue) {
+    // Longstaff-Schwartz benchmark: S=36, K=40, T=1, r=0.06, sigma=0.2
+    double price = pde_option_price(false, 36.0, 40.0, 1.0, 0.06, 0.2);
+    EXPECT_NEAR(price, 4.478, 0.01);
+
+    // Early exercise premium is positive and the price never falls below intrinsic value
+    double european = black_scholes_price(false, 36.0, 40.0, 1.0, 0.06, 0.2);
+    EXPECT_GT(price, european);
+    EXPECT_GE(price, 4.0);
+}
+
+TEST(PdeSolverTest, AmericanCallWithoutDividendsIsEuropean) {
+    double expected = black_scholes_price(true, 100.0, 100.0, 1.0, 0.05, 0.2);
+    double price = pde_option_price(true, 100.0, 100.0, 1.0, 0.05, 0.2);
+    EXPECT_NEAR(price, expected, 0.01);
+}
+
+TEST(PdeSolverTest, RichardsonImprovesCoarseGrid) {
+    PdeConfig config = european_config();
+    config.space_steps = 40;
+    config.time_steps = 40;
+    double expected = black_scholes_price(false, 100.0, 110.0, 0.5, 0.03, 0.3);
+
+    double plain = pde_option_price(false, 100.0, 110.0, 0.5, 0.03, 0.3, config);
+    config.richardson = true;
+    double extrapolated = pde_option_price(false, 100.0, 110.0, 0.5, 0.03, 0.3, config);
+
+    EXPECT_LT(std::abs(extrapolated - expected), std::abs(plain - expected));
+}
+
+TEST(PdeSolverTest, DiscreteDividendLowersCallValue) {
+    std::vector<CashDividend> dividends = {{0.5, 2.0}};
+    double with_dividend =
+        pde_option_price(true, 100.0, 100.0, 1.0, 0.05, 0.2, european_config(), dividends);
+
+    // A European call with a cash dividend is close to the escrowed-dividend value
+    double escrowed = black_scholes_price(true, 100.0 - 2.0 * std::exp(-0.05 * 0.5), 100.0, 1.0,
+                                          0.05, 0.2);
+    EXPECT_NEAR(with_dividend, escrowed, 0.1);
+
+    // Early exercise just before the dividend makes the American call worth more
+    double american = pde_option_price(true, 100.0, 100.0, 1.0, 0.05, 0.2, PdeConfig(), dividends);
+    EXPECT_GE(american, with_dividend);
+}
+
+TEST(PdeSolverTest, BatchMatchesScalar) {
+    OptionBatch batch;
+    std::vector<double> volatility;
+    batch.push_back(true, 100.0, 90.0, 1.0, 0.05);
+    volatility.push_back(0.2);
+    batch.push_back(false, 100.0, 110.0, 1.0, 0.05);
+    volatility.push_back(0.25);
+    batch.push_back(false, 95.0, 100.0, 0.5, 0.02);
+    volatility.push_back(0.3);
+    batch.push_back(false, 100.0, 100.0, 1.0, 0.05);
+    volatility.push_back(0.35);
+    batch.push_back(true, -1.0, 100.0, 1.0, 0.05);  // Invalid row
+    volatility.push_back(0.2);
+
+    std::vector<double> prices = pde_option_price_batch(batch, volatility);
+    ASSERT_EQ(prices.size(), batch.size());
+    for (std::size_t i = 0; i + 1 < batch.size(); ++i) {
+        double expected =
+            pde_option_price(batch.is_call[i] != 0, batch.asset_price[i], batch.strike_price[i],
+                             batch.time_to_expiry[i], batch.risk_free_rate[i], volatility[i]);
+        EXPECT_NEAR(prices[i], expected, 1e-12) << "row " << i;
+    }
+    EXPECT_TRUE(std::isnan(prices.back()));
+}
+
+TEST(PdeSolverTest, ImpliedVolatilityRoundTrip) {
+    double price = pde_option_price(false, 100.0, 110.0, 1.0, 0.05, 0.25);
+    EXPECT_NEAR(pde_implied_volatility(false, 100.0, 110.0, 1.0, 0.05, price), 0.25, 1e-4);
+
+    OptionBatch batch;
+    std::vector<double> prices;
+    std::vector<double> expected = {0.15, 0.3, 0.45};
+    for (double sigma : expected) {
+        batch.push_back(false, 100.0, 100.0, 0.75, 0.04);
+        prices.push_back(pde_option_price(false, 100.0, 100.0, 0.75, 0.04, sigma));
+    }
+    std::vector<double> implied = pde_implied_volatility_batch(batch, prices);
+    ASSERT_EQ(implied.size(), expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_NEAR(implied[i], expected[i], 1e-4);
+    }
+}
+
+TEST(PdeSolverTest, InvalidInputs) {
+    EXPECT_THROW(pde_option_price(true, -100.0, 100.0, 1.0, 0.05, 0.2), std::invalid_argument);
+    EXPECT_THROW(pde_option_price(true, 100.0, 100.0, 0.0, 0.05, 0.2), std::invalid_argument);
+    EXPECT_THROW(pde_option_price(true, 100.0, 100.0, 1.0, 0.05, 0.0), std::invalid_argument);
+    EXPECT_THROW(pde_implied_volatility(true, 100.0, 100.0, 1.0, 0.05, -1.0),
+                 std::invalid_argument);
+
+    PdeConfig config;
+    config.space_steps = 1;
+    EXPECT_THROW(pde_option_price(true, 100.0, 100.0, 1.0, 0.05, 0.2, config),
+                 std::invalid_argument);
+}
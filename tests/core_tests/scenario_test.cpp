@@ -0,0 +1,131 @@
+#include "src/core/scenario.h"
+#include "src/core/black_scholes.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+using namespace iv_calculator::core;
+
+namespace {
+    // A book whose size is not a multiple of the lane width
+    struct Book {
+        OptionBatch options;
+        std::vector<double> volatility;
+        std::vector<double> quantity;
+    };
+
+    Book make_book(std::size_t size) {
+        Book book;
+        for (std::size_t k = 0; k < size; ++k) {
+            double strike = 70.0 + 5.0 * static_cast<double>(k % 13);
+            double expiry = 0.05 + 0.3 * static_cast<double>(k % 7);
+            book.options.push_back(k % 3 != 0, 100.0, strike, expiry, 0.01 * (k % 5));
+            book.volatility.push_back(0.1 + 0.05 * static_cast<double>(k % 6));
+            book.quantity.push_back(k % 4 == 0 ? -3.0 : 2.0);
+        }
+        return book;
+    }
+}  // namespace
+
+// Test evenly spaced shocks
+TEST(ScenarioTest, ShocksTest) {
+    std::vector<double> shocks = scenario_shocks(-0.2, 0.2, 5);
+    ASSERT_EQ(shocks.size(), 5u);
+    EXPECT_DOUBLE_EQ(shocks[0], -0.2);
+    EXPECT_NEAR(shocks[2], 0.0, 1e-15);
+    EXPECT_DOUBLE_EQ(shocks[4], 0.2);
+    EXPECT_EQ(scenario_shocks(0.1, 0.5, 1), std::vector<double>{0.1});
+    EXPECT_THROW(scenario_shocks(0.0, 1.0, 0), std::invalid_argument);
+}
+
+// Test every scenario against repricing each option one at a time
+TEST(ScenarioTest, RepricingTest) {
+    Book book = make_book(29);
+    ScenarioGrid grid{scenario_shocks(-0.3, 0.3, 7), scenario_shocks(-0.05, 0.1, 4)};
+    ScenarioMatrix matrix =
+        black_scholes_scenarios(book.options, book.volatility, book.quantity, grid);
+    ASSERT_EQ(matrix.spot_count, 7u);
+    ASSERT_EQ(matrix.volatility_count, 4u);
+
+    double base = 0.0;
+    for (std::size_t k = 0; k < book.options.size(); ++k) {
+        base += book.quantity[k] *
+                black_scholes_price(book.options.is_call[k] != 0, book.options.asset_price[k],
+                                    book.options.strike_price[k], book.options.time_to_expiry[k],
+                                    book.options.risk_free_rate[k], book.volatility[k]);
+    }
+    EXPECT_NEAR(matrix.base_value, base, 1e-9);
+
+    for (std::size_t i = 0; i < matrix.spot_count; ++i) {
+        for (std::size_t j = 0; j < matrix.volatility_count; ++j) {
+            double expected = 0.0;
+            for (std::size_t k = 0; k < book.options.size(); ++k) {
+                expected += book.quantity[k] *
+                            black_scholes_price(book.options.is_call[k] != 0,
+                                                book.options.asset_price[k] *
+                                                    (1.0 + grid.spot_shocks[i]),
+                                                book.options.strike_price[k],
+                                                book.options.time_to_expiry[k],
+                                                book.options.risk_free_rate[k],
+                                                book.volatility[k] + grid.volatility_shocks[j]);
+            }
+            EXPECT_NEAR(matrix.at(i, j), expected, 1e-9) << "scenario " << i << ", " << j;
+            EXPECT_NEAR(matrix.pnl(i, j), expected - base, 1e-9);
+        }
+    }
+}
+
+// Test that matrices of parts of a book add up to the matrix of the whole book
+TEST(ScenarioTest, MergeTest) {
+    Book book = make_book(20);
+    Book first = make_book(11);
+    Book second;
+    for (std::size_t k = 11; k < 20; ++k) {
+        second.options.push_back(book.options.is_call[k] != 0, book.options.asset_price[k],
+                                 book.options.strike_price[k], book.options.time_to_expiry[k],
+                                 book.options.risk_free_rate[k]);
+        second.volatility.push_back(book.volatility[k]);
+        second.quantity.push_back(book.quantity[k]);
+    }
+    ScenarioGrid grid{scenario_shocks(-0.1, 0.1, 3), scenario_shocks(0.0, 0.05, 2)};
+
+    ScenarioMatrix whole =
+        black_scholes_scenarios(book.options, book.volatility, book.quantity, grid);
+    ScenarioMatrix parts =
+        black_scholes_scenarios(first.options, first.volatility, first.quantity, grid);
+    parts.merge(black_scholes_scenarios(second.options, second.volatility, second.quantity, grid));
+    EXPECT_NEAR(parts.base_value, whole.base_value, 1e-9);
+    for (std::size_t s = 0; s < whole.value.size(); ++s) {
+        EXPECT_NEAR(parts.value[s], whole.value[s], 1e-9);
+    }
+
+    ScenarioGrid other{scenario_shocks(-0.1, 0.1, 2), scenario_shocks(0.0, 0.05, 2)};
+    EXPECT_THROW(
+        parts.merge(black_scholes_scenarios(first.options, first.volatility, first.quantity,
+                                            other)),
+        std::invalid_argument);
+}
+
+// Test shocks that take the volatility to zero and invalid inputs
+TEST(ScenarioTest, EdgeCaseTest) {
+    OptionBatch book;
+    book.push_back(true, 100.0, 90.0, 1.0, 0.0);
+    book.push_back(false, 100.0, 90.0, 1.0, 0.0);
+    ScenarioGrid grid{{0.0}, {-0.5}};
+
+    // Floored volatility prices at intrinsic value
+    ScenarioMatrix matrix = black_scholes_scenarios(book, {0.2, 0.2}, {1.0, 1.0}, grid);
+    EXPECT_NEAR(matrix.at(0, 0), 10.0, 1e-9);
+
+    // An empty book is worth nothing in every scenario
+    ScenarioMatrix empty = black_scholes_scenarios(OptionBatch(), {}, {}, grid);
+    EXPECT_EQ(empty.value, std::vector<double>{0.0});
+
+    EXPECT_THROW(black_scholes_scenarios(book, {0.2}, {1.0, 1.0}, grid), std::invalid_argument);
+    EXPECT_THROW(black_scholes_scenarios(book, {0.2, 0.0}, {1.0, 1.0}, grid),
+                 std::invalid_argument);
+    EXPECT_THROW(black_scholes_scenarios(book, {0.2, 0.2}, {1.0, 1.0}, ScenarioGrid{{-1.0}, {0.0}}),
+                 std::invalid_argument);
+}
@@ -0,0 +1,74 @@
+#include "src/core/yield_curve.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+using namespace iv_calculator::core;
+
+namespace {
+    const std::vector<double> kTimes = {0.25, 0.5, 1.0, 2.0, 5.0};
+    const std::vector<double> kRates = {0.030, 0.034, 0.0365, 0.033, 0.031};
+}  // namespace
+
+// Test that both interpolations go through the pillars
+TEST(YieldCurveTest, PillarTest) {
+    for (CurveInterpolation interpolation :
+         {CurveInterpolation::LOG_LINEAR, CurveInterpolation::MONOTONE_CONVEX}) {
+        YieldCurve curve(kTimes, kRates, interpolation);
+        for (std::size_t i = 0; i < kTimes.size(); ++i) {
+            EXPECT_NEAR(curve.zero_rate(kTimes[i]), kRates[i], 1e-15);
+            EXPECT_NEAR(curve.discount(kTimes[i]), std::exp(-kRates[i] * kTimes[i]), 1e-15);
+        }
+    }
+}
+
+// Test flat forwards between log-linear pillars
+TEST(YieldCurveTest, LogLinearTest) {
+    YieldCurve curve(kTimes, kRates, CurveInterpolation::LOG_LINEAR);
+    double forward = (kRates[2] * kTimes[2] - kRates[1] * kTimes[1]) / (kTimes[2] - kTimes[1]);
+    EXPECT_NEAR(curve.forward_rate(0.75), forward, 1e-15);
+    EXPECT_NEAR(curve.zero_rate(0.75) * 0.75, kRates[1] * 0.5 + forward * 0.25, 1e-15);
+
+    // Flat rate before the first pillar, flat forward after the last
+    EXPECT_NEAR(curve.zero_rate(0.1), kRates[0], 1e-15);
+    EXPECT_NEAR(curve.zero_rate(0.0), kRates[0], 1e-15);
+    double last = (kRates[4] * kTimes[4] - kRates[3] * kTimes[3]) / (kTimes[4] - kTimes[3]);
+    EXPECT_NEAR(curve.zero_rate(10.0) * 10.0, kRates[4] * 5.0 + last * 5.0, 1e-13);
+}
+
+// Test that monotone-convex forwards are continuous and integrate to the zero rates
+TEST(YieldCurveTest, MonotoneConvexTest) {
+    YieldCurve curve(kTimes, kRates, CurveInterpolation::MONOTONE_CONVEX);
+    for (double t : kTimes) {
+        EXPECT_NEAR(curve.forward_rate(t - 1e-9), curve.forward_rate(t + 1e-9), 1e-7) << t;
+    }
+
+    // Midpoint rule on a fine grid against r(t) t
+    double integral = 0.0;
+    double step = 1e-4;
+    for (double t = step / 2; t < 7.0; t += step) {
+        integral += curve.forward_rate(t) * step;
+        double end = t + step / 2;
+        if (std::fmod(end + 1e-9, 0.5) < 2e-9) {
+            EXPECT_NEAR(integral, curve.zero_rate(end) * end, 1e-8) << end;
+        }
+    }
+
+    // A single pillar is a flat curve
+    YieldCurve flat({1.0}, {0.02}, CurveInterpolation::MONOTONE_CONVEX);
+    EXPECT_NEAR(flat.zero_rate(0.3), 0.02, 1e-15);
+    EXPECT_NEAR(flat.forward_rate(4.0), 0.02, 1e-15);
+}
+
+// Test invalid pillars and names
+TEST(YieldCurveTest, ErrorTest) {
+    EXPECT_THROW(YieldCurve({}, {}), std::invalid_argument);
+    EXPECT_THROW(YieldCurve({1.0, 2.0}, {0.01}), std::invalid_argument);
+    EXPECT_THROW(YieldCurve({1.0, 1.0}, {0.01, 0.02}), std::invalid_argument);
+    EXPECT_THROW(YieldCurve({0.0, 1.0}, {0.01, 0.02}), std::invalid_argument);
+    EXPECT_EQ(parse_curve_interpolation("monotone-convex"), CurveInterpolation::MONOTONE_CONVEX);
+    EXPECT_EQ(parse_curve_interpolation("LogLinear"), CurveInterpolation::LOG_LINEAR);
+    EXPECT_THROW(parse_curve_interpolation("cubic"), std::invalid_argument);
+}
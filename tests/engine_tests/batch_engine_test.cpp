@@ -0,0 +1,809 @@
+#include "src/core/black_scholes.h"
+#include "src/core/greeks.h"
+#include "src/core/pde_solver.h"
+#include "src/engine/batch_engine.h"
+#include "src/io/file_io.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace iv_calculator;
+using namespace iv_calculator::engine;
+
+// Temporary file paths for testing
+const std::string kTempBatchInput = "temp_batch_input.csv";
+const std::string kTempBatchOutput = "temp_batch_output.csv";
+const std::string kTempBatchJsonOutput = "temp_batch_output.json";
+const std::string kTempBatchBinaryInput = "temp_batch_input.bin";
+const std::string kTempBatchBinaryOutput = "temp_batch_output.bin";
+
+namespace {
+    void write_file(const std::string& path, const std::string& contents) {
+        std::ofstream file(path);
+        file << contents;
+    }
+
+    std::string read_file(const std::string& path) {
+        std::ifstream file(path);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+}  // namespace
+
+// Test fixture for batch engine tests
+class BatchEngineTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::remove(kTempBatchInput.c_str());
+        std::remove(kTempBatchOutput.c_str());
+        std::remove(kTempBatchJsonOutput.c_str());
+        std::remove(kTempBatchBinaryInput.c_str());
+        std::remove(kTempBatchBinaryOutput.c_str());
+    }
+};
+
+// Test the deprecated --batch layout with its trailing price marker
+TEST_F(BatchEngineTest, LegacyLayoutTest) {
+    write_file(kTempBatchInput,
+               "Type,Asset,Strike,Time,Rate,Value\n"
+               "Call,100,100,1,0.05,10.45\n"
+               "Call,100,100,1,0.05,0.2,vol\n"
+               "Put,100,100,1,0.05,5.57,price\n"
+               "Call,100\n"
+               "Call,100,100,1,0.05,-1\n");
+
+    BatchConfig config;
+    config.input_file = kTempBatchInput;
+    config.output_file = kTempBatchOutput;
+    config.legacy = true;
+
+    std::ostringstream out;
+    std::ostringstream err;
+    BatchStats stats = run_batch(config, out, err);
+    EXPECT_EQ(stats.rows, 5u);
+    EXPECT_EQ(stats.processed, 3u);
+    EXPECT_EQ(stats.errors, 2u);
+    EXPECT_NE(out.str().find("Processed 3 items with 2 errors."), std::string::npos);
+    EXPECT_EQ(out.str().find("Loaded"), std::string::npos);
+
+    // Failed rows are left out of the output
+    auto options = io::read_csv(kTempBatchOutput);
+    ASSERT_EQ(options.size(), 3u);
+    EXPECT_NEAR(options[0].volatility, 0.2, 1e-3);
+    EXPECT_NEAR(options[1].option_price,
+                core::black_scholes_price(true, 100, 100, 1, 0.05, 0.2), 1e-4);
+    EXPECT_DOUBLE_EQ(options[1].volatility, 0.2);
+    EXPECT_FALSE(options[2].is_call);
+    EXPECT_NEAR(options[2].volatility, 0.2, 1e-3);
+}
+
+// Test that legacy mode matches cells and reports a missing file as the original --batch did
+TEST_F(BatchEngineTest, LegacyBaselineTest) {
+    write_file(kTempBatchInput,
+               "Type,Asset,Strike,Time,Rate,Value\n"
+               "Call,100,100,1,0.05,0.2,Price\n"
+               "C,100,100,1,0.05,0.2,vol\n");
+
+    BatchConfig config;
+    config.input_file = kTempBatchInput;
+    config.output_file = kTempBatchOutput;
+    config.legacy = true;
+
+    std::ostringstream out;
+    std::ostringstream err;
+    BatchStats stats = run_batch(config, out, err);
+    EXPECT_EQ(stats.processed, 2u);
+
+    // Only a lower-case "price" marks a price, and only "call" or "Call" a call
+    auto options = io::read_csv(kTempBatchOutput);
+    ASSERT_EQ(options.size(), 2u);
+    EXPECT_DOUBLE_EQ(options[0].volatility, 0.2);
+    EXPECT_NEAR(options[0].option_price,
+                core::black_scholes_price(true, 100, 100, 1, 0.05, 0.2), 1e-4);
+    EXPECT_FALSE(options[1].is_call);
+
+    config.input_file = "missing_batch_input.csv";
+    try {
+        run_batch(config, out, err);
+        FAIL() << "Expected std::runtime_error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_STREQ(e.what(), "Could not open input file 'missing_batch_input.csv'");
+    }
+}
+
+// Test that the row count is printed ahead of the per-row lines of a one-chunk input
+TEST_F(BatchEngineTest, LoadedLineOrderTest) {
+    write_file(kTempBatchInput, "Type,Asset,Strike,Time,Rate,Price,Volatility\n"
+                                "Call,100,100,1,0.05,,0.2\n");
+
+    BatchConfig config;
+    config.input_file = kTempBatchInput;
+
+    std::ostringstream out;
+    std::ostringstream err;
+    run_batch(config, out, err);
+    std::size_t loaded = out.str().find("Loaded 1 options from " + kTempBatchInput);
+    ASSERT_NE(loaded, std::string::npos);
+    EXPECT_LT(loaded, out.str().find("Option:"));
+}
+
+// Test that multi-threaded chunked runs keep input order and match single-row results
+TEST_F(BatchEngineTest, ChunkedParallelRunTest) {
+    std::ostringstream input;
+    input << "Type,Asset,Strike,Time,Rate,Price,Volatility\n";
+    for (int i = 0; i < 1000; ++i) {
+        double strike = 80.0 + (i % 41);
+        if (i % 3 == 0) {
+            input << "Put," << 100 << "," << strike << ",0.5,0.03,," << 0.1 + (i % 7) * 0.05
+                  << "\n";
+        } else {
+            double price = core::black_scholes_price(true, 100, strike, 0.5, 0.03, 0.25);
+            input << "Call," << 100 << "," << strike << ",0.5,0.03," << price << ",\n";
+        }
+    }
+    write_file(kTempBatchInput, input.str());
+
+    BatchConfig config;
+    config.input_file = kTempBatchInput;
+    config.output_file = kTempBatchJsonOutput;
+    config.output_format = "json";
+    config.threads = 4;
+    config.chunk_rows = 97;
+    config.verbose = false;
+
+    std::ostringstream out;
+    std::ostringstream err;
+    BatchStats stats = run_batch(config, out, err);
+    EXPECT_EQ(stats.rows, 1000u);
+    EXPECT_EQ(stats.processed, 1000u);
+    EXPECT_EQ(stats.errors, 0u);
+    EXPECT_EQ(out.str().find("Option:"), std::string::npos);
+
+    auto options = io::read_json(kTempBatchJsonOutput);
+    ASSERT_EQ(options.size(), 1000u);
+    for (int i = 0; i < 1000; ++i) {
+        double strike = 80.0 + (i % 41);
+        EXPECT_DOUBLE_EQ(options[i].strike_price, strike);
+        if (i % 3 == 0) {
+            EXPECT_NEAR(options[i].option_price,
+                        core::black_scholes_price(false, 100, strike, 0.5, 0.03,
+                                                  0.1 + (i % 7) * 0.05),
+                        1e-4);
+        } else {
+            EXPECT_NEAR(options[i].volatility, 0.25, 1e-3);
+        }
+    }
+}
+
+// Test the model override and the model column of the output
+TEST_F(BatchEngineTest, ModelOverrideTest) {
+    write_file(kTempBatchInput, "Type,Asset,Strike,Time,Rate,Price,Volatility\n"
+                                "Call,0.01,0.02,1,0,,0.005\n");
+
+    BatchConfig config;
+    config.input_file = kTempBatchInput;
+    config.output_file = kTempBatchOutput;
+    config.model = core::PricingModel::BACHELIER;
+
+    std::ostringstream out;
+    std::ostringstream err;
+    run_batch(config, out, err);
+    EXPECT_NE(out.str().find("model=Bachelier"), std::string::npos);
+    EXPECT_NE(read_file(kTempBatchOutput).find(",Model\n"), std::string::npos);
+
+    auto options = io::read_csv(kTempBatchOutput);
+    ASSERT_EQ(options.size(), 1u);
+    EXPECT_EQ(options[0].model, core::PricingModel::BACHELIER);
+    EXPECT_NEAR(options[0].option_price, core::bachelier_price(true, 0.01, 0.02, 1, 0, 0.005),
+                1e-9);
+}
+
+// Test output column parsing
+TEST_F(BatchEngineTest, OutputSchemaParseTest) {
+    io::OutputSchema schema = io::parse_output_schema("vol, delta,vega,status");
+    ASSERT_EQ(schema.columns.size(), 4u);
+    EXPECT_EQ(schema.columns[0], io::OutputColumn::VOLATILITY);
+    EXPECT_EQ(schema.greeks(), core::greek_flags::kDelta | core::greek_flags::kVega);
+    EXPECT_TRUE(schema.needs_row_results());
+    EXPECT_FALSE(io::parse_output_schema("strike,price").needs_row_results());
+
+    EXPECT_THROW(io::parse_output_schema("vol,sigma"), std::invalid_argument);
+    EXPECT_THROW(io::parse_output_schema("vol,volatility"), std::invalid_argument);
+    EXPECT_THROW(io::parse_output_schema(""), std::invalid_argument);
+}
+
+// Test that declared columns are written and computed
+TEST_F(BatchEngineTest, OutputColumnsTest) {
+    write_file(kTempBatchInput, "Type,Asset,Strike,Time,Rate,Price,Volatility\n"
+                                "Call,100,100,1,0.05,10.45,\n"
+                                "Put,100,110,1,0.05,,0.3\n"
+                                "Call,100,100,1,0.05,200,\n");
+
+    BatchConfig config;
+    config.input_file = kTempBatchInput;
+    config.output_file = kTempBatchOutput;
+    config.columns = io::parse_output_schema("strike,vol,delta,status,iterations");
+    config.verbose = false;
+
+    std::ostringstream out;
+    std::ostringstream err;
+    run_batch(config, out, err);
+
+    std::vector<std::string> lines;
+    std::stringstream output(read_file(kTempBatchOutput));
+    for (std::string line; std::getline(output, line);) {
+        lines.push_back(line);
+    }
+    ASSERT_EQ(lines.size(), 4u);
+    EXPECT_EQ(lines[0], "Strike,Volatility,Delta,Status,Iterations");
+
+    double volatility = core::calculate_implied_volatility(true, 100, 100, 1, 0.05, 10.45);
+    std::ostringstream expected;
+    expected << "100," << volatility << ','
+             << core::black_scholes_greeks(true, 100, 100, 1, 0.05, volatility).delta
+             << ",solved,"
+             << core::solve_implied_volatility(true, 100, 100, 1, 0.05, 10.45).iterations;
+    EXPECT_EQ(lines[1], expected.str());
+    EXPECT_EQ(lines[2].rfind("110,0.3,", 0), 0u);
+    EXPECT_NE(lines[2].find(",priced,0"), std::string::npos);
+    // A price above the asset has no implied volatility
+    EXPECT_EQ(lines[3].substr(lines[3].find(",failed")), ",failed,0");
+
+    // Binary records cannot carry extra columns
+    config.output_format = "binary";
+    EXPECT_THROW(run_batch(config, out, err), std::invalid_argument);
+
+    // Shard merges and delta baselines cannot read column files back
+    config.output_format = "csv";
+    config.shard = {0, 2, ShardMode::RANGE};
+    EXPECT_THROW(run_batch(config, out, err), std::invalid_argument);
+    config.shard = ShardSpec();
+    config.delta = DeltaConfig();
+    config.delta->baseline_file = kTempBatchOutput;
+    EXPECT_THROW(run_batch(config, out, err), std::invalid_argument);
+}
+
+// Test that columns which do not need a result skip its computation
+TEST_F(BatchEngineTest, LazyColumnsTest) {
+    write_file(kTempBatchInput, "Type,Asset,Strike,Time,Rate,Price,Volatility\n"
+                                "Call,100,100,1,0.05,10.45,\n");
+
+    BatchConfig config;
+    config.input_file = kTempBatchInput;
+    config.output_file = kTempBatchJsonOutput;
+    config.output_format = "json";
+    config.columns = io::parse_output_schema("type,strike,price");
+
+    std::ostringstream out;
+    std::ostringstream err;
+    BatchStats stats = run_batch(config, out, err);
+    EXPECT_EQ(stats.processed, 1u);
+    EXPECT_EQ(out.str().find("implied volatility"), std::string::npos);
+    EXPECT_EQ(read_file(kTempBatchJsonOutput), "[\n"
+                                               "    {\n"
+                                               "        \"type\": \"Call\",\n"
+                                               "        \"strike_price\": 100,\n"
+                                               "        \"option_price\": 10.45\n"
+                                               "    }\n"
+                                               "]");
+}
+
+// Test that rows Newton-Raphson does not converge on are finished by the batch bisection
+TEST_F(BatchEngineTest, BulkFallbackTest) {
+    // A volatility of 8 lies beyond the range Newton-Raphson steps within
+    double high = core::black_scholes_price(false, 100, 10, 0.1, 0.05, 8.0);
+    std::ostringstream input;
+    input.precision(17);
+    input << "Type,Asset,Strike,Time,Rate,Price,Volatility\n"
+          << "Call,100,100,1,0.05,10.45,\n"
+          << "Put,100,10,0.1,0.05," << high << ",\n"
+          << "Call,100,100,1,0.05,200,\n";
+    write_file(kTempBatchInput, input.str());
+
+    BatchConfig config;
+    config.input_file = kTempBatchInput;
+    config.output_file = kTempBatchOutput;
+    config.columns = io::parse_output_schema("strike,vol,status,iterations");
+    config.solver.method = core::ImpliedVolatilityMethod::NEWTON_RAPHSON;
+
+    std::ostringstream out;
+    std::ostringstream err;
+    BatchStats stats = run_batch(config, out, err);
+    EXPECT_EQ(stats.processed, 2u);
+    EXPECT_EQ(stats.errors, 1u);
+
+    std::vector<std::string> lines;
+    std::stringstream output(read_file(kTempBatchOutput));
+    for (std::string line; std::getline(output, line);) {
+        lines.push_back(line);
+    }
+    ASSERT_EQ(lines.size(), 4u);
+    EXPECT_NE(lines[1].find(",solved,"), std::string::npos);
+    std::ostringstream expected;
+    expected << "10,8,solved," << 100 + core::batch_bisection_iterations();
+    EXPECT_EQ(lines[2], expected.str());
+    // A price above the asset fails the bisection too, after the Newton-Raphson iterations
+    EXPECT_EQ(lines[3].substr(lines[3].find(",failed")), ",failed,100");
+
+    // The deferred row is reported after the rest of its slice
+    std::string console = out.str();
+    EXPECT_LT(console.find("K=100"), console.find("K=10,"));
+}
+
+// Test the convergence settings and the achieved tolerance column
+TEST_F(BatchEngineTest, ToleranceColumnTest) {
+    write_file(kTempBatchInput, "Type,Asset,Strike,Time,Rate,Price,Volatility\n"
+                                "Call,100,100,1,0.05,10.45,\n"
+                                "Put,100,110,1,0.05,,0.3\n");
+
+    BatchConfig config;
+    config.input_file = kTempBatchInput;
+    config.output_file = kTempBatchOutput;
+    config.columns = io::parse_output_schema("vol,status,tolerance");
+    config.solver.method = core::ImpliedVolatilityMethod::NEWTON_RAPHSON;
+    config.solver.criterion = core::ConvergenceCriterion::VOLATILITY;
+    config.solver.tolerance = 1e-9;
+    config.verbose = false;
+
+    std::ostringstream out;
+    std::ostringstream err;
+    run_batch(config, out, err);
+
+    core::ImpliedVolatilityResult solved =
+        core::solve_implied_volatility(true, 100, 100, 1, 0.05, 10.45, config.solver);
+    EXPECT_LT(solved.achieved, 1e-9);
+    std::ostringstream expected;
+    expected << "Volatility,Status,Tolerance\n"
+             << solved.volatility << ",solved," << solved.achieved << '\n'
+             << "0.3,priced,nan\n";
+    EXPECT_EQ(read_file(kTempBatchOutput), expected.str());
+}
+
+// Test that AUTO routes rows per region and counts the methods it used
+TEST_F(BatchEngineTest, AutoMethodTest) {
+    double wing = core::black_scholes_price(false, 100, 60, 0.05, 0.02, 0.3);
+    std::ostringstream input;
+    input.precision(17);
+    input << "Type,Asset,Strike,Time,Rate,Price,Volatility\n"
+          << "Call,100,100,1,0.05,10.45,\n"
+          << "Call,100,105,1,0.05,8.02,\n"
+          << "Put,100,60,0.05,0.02," << wing << ",\n"
+          << "Put,100,110,1,0.05,,0.3\n";
+    write_file(kTempBatchInput, input.str());
+
+    BatchConfig config;
+    config.input_file = kTempBatchInput;
+    config.output_file = kTempBatchOutput;
+    config.solver.method = core::ImpliedVolatilityMethod::AUTO;
+
+    std::ostringstream out;
+    std::ostringstream err;
+    BatchStats stats = run_batch(config, out, err);
+    EXPECT_EQ(stats.processed, 4u);
+    EXPECT_EQ(stats.methods[static_cast<std::size_t>(core::ImpliedVolatilityMethod::HOUSEHOLDER)],
+              2u);
+    EXPECT_EQ(stats.methods[static_cast<std::size_t>(core::ImpliedVolatilityMethod::BRENT)], 1u);
+    EXPECT_NE(out.str().find("Implied volatility methods: brent 1 householder 2"),
+              std::string::npos);
+}
+
+// Test that AUTO classifies a quote-only row by its mid price
+TEST_F(BatchEngineTest, AutoMethodMidPriceTest) {
+    write_file(kTempBatchInput, "Type,Asset,Strike,Time,Rate,Price,Volatility,Bid,Ask\n"
+                                "Call,100,100,1,0.05,,,10.2,10.7\n");
+
+    BatchConfig config;
+    config.input_file = kTempBatchInput;
+    config.solver.method = core::ImpliedVolatilityMethod::AUTO;
+    config.verbose = false;
+
+    std::ostringstream out;
+    std::ostringstream err;
+    BatchStats stats = run_batch(config, out, err);
+    EXPECT_EQ(stats.processed, 1u);
+    EXPECT_EQ(stats.methods[static_cast<std::size_t>(core::ImpliedVolatilityMethod::HOUSEHOLDER)],
+              1u);
+    EXPECT_EQ(stats.methods[static_cast<std::size_t>(core::ImpliedVolatilityMethod::BRENT)], 0u);
+}
+
+// Test that quoted rows get bid, mid and ask volatilities and a quote-only row its mid price
+TEST_F(BatchEngineTest, QuoteVolatilityTest) {
+    write_file(kTempBatchInput, "Type,Asset,Strike,Time,Rate,Price,Volatility,Bid,Ask\n"
+                                "Call,100,100,1,0.05,,,10.2,10.7\n"
+                                "Put,100,110,1,0.05,10.1,,9.9,10.3\n"
+                                "Call,100,120,1,0.05,2.5,,,\n");
+
+    BatchConfig config;
+    config.input_file = kTempBatchInput;
+    config.output_file = kTempBatchOutput;
+    config.columns = io::parse_output_schema("price,vol,bid_vol,mid_vol,ask_vol,vol_spread");
+    config.verbose = false;
+
+    std::ostringstream out;
+    std::ostringstream err;
+    BatchStats stats = run_batch(config, out, err);
+    EXPECT_EQ(stats.processed, 3u);
+
+    core::QuoteImpliedVolatility call =
+        core::solve_quote_implied_volatility(true, 100, 100, 1, 0.05, 10.2, 10.7);
+    core::QuoteImpliedVolatility put =
+        core::solve_quote_implied_volatility(false, 100, 110, 1, 0.05, 9.9, 10.3);
+    double put_vol = core::calculate_implied_volatility(false, 100, 110, 1, 0.05, 10.1);
+    double wing_vol = core::calculate_implied_volatility(true, 100, 120, 1, 0.05, 2.5);
+    std::ostringstream expected;
+    expected << "Price,Volatility,BidVolatility,MidVolatility,AskVolatility,VolatilitySpread\n"
+             << "10.45," << call.mid.volatility << ',' << call.bid.volatility << ','
+             << call.mid.volatility << ',' << call.ask.volatility << ',' << call.spread() << '\n'
+             << "10.1," << put_vol << ',' << put.bid.volatility << ',' << put.mid.volatility
+             << ',' << put.ask.volatility << ',' << put.spread() << '\n'
+             << "2.5," << wing_vol << ",nan,nan,nan,nan\n";
+    EXPECT_EQ(read_file(kTempBatchOutput), expected.str());
+}
+
+// Test that repeated quotes are combined so each contract is solved once
+TEST_F(BatchEngineTest, QuoteAggregationTest) {
+    write_file(kTempBatchInput, "Type,Asset,Strike,Time,Rate,Bid,Ask\n"
+                                "Call,100,100,1,0.05,10.2,10.8\n"
+                                "Put,100,110,1,0.05,9.9,10.4\n"
+                                "Call,100,100,1,0.05,10.3,10.9\n"
+                                "Call,100,100,1,0.05,10.1,10.6\n");
+
+    BatchConfig config;
+    config.input_file = kTempBatchInput;
+    config.output_file = kTempBatchOutput;
+    config.columns = io::parse_output_schema("type,strike,bid,ask,price");
+    config.aggregation = QuoteAggregation::BEST;
+    config.verbose = false;
+
+    std::ostringstream out;
+    std::ostringstream err;
+    BatchStats stats = run_batch(config, out, err);
+    EXPECT_EQ(stats.rows, 4u);
+    EXPECT_EQ(stats.processed, 2u);
+    EXPECT_NE(out.str().find("Aggregated 4 quotes into 2 contracts"), std::string::npos);
+    EXPECT_EQ(read_file(kTempBatchOutput), "Type,Strike,Bid,Ask,Price\n"
+                                           "Call,100,10.3,10.6,10.45\n"
+                                           "Put,110,9.9,10.4,10.15\n");
+
+    config.checkpoint_file = "temp_quote_checkpoint.ckpt";
+    EXPECT_THROW(run_batch(config, out, err), std::invalid_argument);
+
+    config.checkpoint_file.clear();
+    config.shard = {0, 2, ShardMode::HASH};
+    EXPECT_THROW(run_batch(config, out, err), std::invalid_argument);
+}
+
+// Test that positions are rolled up by underlying and expiry in the same run as the solve
+TEST_F(BatchEngineTest, RiskRollupTest) {
+    const std::string risk_file = "temp_batch_risk.json";
+    write_file(kTempBatchInput, "Type,Asset,Strike,Time,Rate,Price,Volatility,Quantity\n"
+                                "Call,100,100,1,0.05,10.45,,10\n"
+                                "Put,100,110,1,0.05,,0.3,-5\n"
+                                "Call,100,120,0.1,0.05,,0.2,\n"
+                                "Call,50,50,0.1,0.05,,0.25,2\n");
+
+    BatchConfig config;
+    config.input_file = kTempBatchInput;
+    config.output_file = kTempBatchOutput;
+    config.columns = io::parse_output_schema("price");  // Volatilities are solved anyway
+    config.risk_file = risk_file;
+    config.risk_format = "json";
+    config.threads = 2;
+    config.chunk_rows = 2;
+    config.verbose = false;
+
+    std::ostringstream out;
+    std::ostringstream err;
+    run_batch(config, out, err);
+    EXPECT_NE(out.str().find("Risk rollup of 3 positions in 2 groups"), std::string::npos);
+
+    double call_vol = core::calculate_implied_volatility(true, 100, 100, 1, 0.05, 10.45);
+    core::Greeks call = core::black_scholes_greeks(true, 100, 100, 1, 0.05, call_vol);
+    core::Greeks put = core::black_scholes_greeks(false, 100, 110, 1, 0.05, 0.3);
+    core::Greeks small = core::black_scholes_greeks(true, 50, 50, 0.1, 0.05, 0.25);
+    std::string json = read_file(risk_file);
+    std::remove(risk_file.c_str());
+    auto field = [&json](std::size_t group, const std::string& name) {
+        std::size_t at = 0;
+        for (std::size_t i = 0; i <= group; ++i) {
+            at = json.find("{", at + 1);
+        }
+        at = json.find("\"" + name + "\": ", at) + name.size() + 4;
+        return std::stod(json.substr(at));
+    };
+    EXPECT_EQ(field(0, "underlying"), 50.0);
+    EXPECT_NEAR(field(0, "delta"), 2 * small.delta, 1e-5);
+    EXPECT_EQ(field(1, "positions"), 2.0);
+    EXPECT_EQ(field(1, "quantity"), 5.0);
+    EXPECT_NEAR(field(1, "delta"), 10 * call.delta - 5 * put.delta, 1e-4);
+    EXPECT_NEAR(field(1, "vega"), 10 * call.vega - 5 * put.vega, 1e-3);
+
+    // Rows with a symbol are grouped and written by it
+    write_file(kTempBatchInput, "Symbol,Type,Asset,Strike,Time,Rate,Price,Volatility,Quantity\n"
+                                "SPY,Call,100,100,1,0.05,,0.2,1\n"
+                                "SPY,Call,101,100,1,0.05,,0.2,1\n"
+                                "QQQ,Put,50,50,1,0.05,,0.3,2\n");
+    config.risk_format = "csv";
+    out.str("");
+    run_batch(config, out, err);
+    EXPECT_NE(out.str().find("Risk rollup of 3 positions in 2 groups"), std::string::npos);
+    std::string csv = read_file(risk_file);
+    std::remove(risk_file.c_str());
+    EXPECT_EQ(csv.find("\nSPY,1Y,2,2,"), csv.find('\n'));
+    EXPECT_NE(csv.find("\nQQQ,1Y,1,2,"), std::string::npos);
+}
+
+// Test the scenario P&L matrix of the positions
+TEST_F(BatchEngineTest, ScenarioTest) {
+    const std::string scenario_file = "temp_batch_scenarios.csv";
+    write_file(kTempBatchInput, "Type,Asset,Strike,Time,Rate,Price,Volatility,Quantity\n"
+                                "Call,100,100,1,0.05,10.45,,10\n"
+                                "Put,100,110,1,0.05,,0.3,-5\n"
+                                "Call,100,120,0.1,0.05,,0.2,\n");
+
+    BatchConfig config;
+    config.input_file = kTempBatchInput;
+    config.scenarios = ScenarioConfig{parse_scenario_grid("spot=-0.1:0.1:3"), scenario_file};
+    config.threads = 2;
+    config.chunk_rows = 2;
+    config.verbose = false;
+
+    std::ostringstream out;
+    std::ostringstream err;
+    run_batch(config, out, err);
+    EXPECT_NE(out.str().find("Scenario P&L of 2 positions over 3x1 shocks"), std::string::npos);
+
+    double call_vol = core::calculate_implied_volatility(true, 100, 100, 1, 0.05, 10.45);
+    auto book = [call_vol](double S) {
+        return 10 * core::black_scholes_price(true, S, 100, 1, 0.05, call_vol) -
+               5 * core::black_scholes_price(false, S, 110, 1, 0.05, 0.3);
+    };
+    std::istringstream csv(read_file(scenario_file));
+    std::remove(scenario_file.c_str());
+    std::string line;
+    std::getline(csv, line);
+    EXPECT_EQ(line, "SpotShock,0");
+    for (double S : {90.0, 100.0, 110.0}) {
+        std::getline(csv, line);
+        std::size_t comma = line.find(',');
+        EXPECT_DOUBLE_EQ(std::stod(line.substr(0, comma)) + 1, S / 100);
+        EXPECT_NEAR(std::stod(line.substr(comma + 1)), book(S) - book(100), 1e-4);
+    }
+
+    config.checkpoint_file = "temp_batch_scenarios.checkpoint";
+    config.output_file = kTempBatchOutput;
+    EXPECT_THROW(run_batch(config, out, err), std::invalid_argument);
+}
+
+// Test times to expiry computed from expiry dates
+TEST_F(BatchEngineTest, ExpiryDateTest) {
+    write_file(kTempBatchInput, "Type,Asset,Strike,Expiry,Rate,Volatility,Valuation\n"
+                                "Call,100,100,2027-10-16,0.05,0.2,\n"
+                                "Call,100,100,2027-10-16,0.05,0.2,2027-04-16\n"
+                                "Call,100,100,2027-10-16T12:00,0.05,0.2,2027-04-16\n");
+
+    BatchConfig config;
+    config.input_file = kTempBatchInput;
+    config.output_file = kTempBatchOutput;
+    config.output_format = "json";
+    config.columns = io::parse_output_schema("time,price");
+    config.day_count = core::DayCount::ACT_360;
+    config.valuation_time = core::parse_timestamp("2026-10-16");
+    config.verbose = false;
+
+    std::ostringstream out;
+    std::ostringstream err;
+    BatchStats stats = run_batch(config, out, err);
+    EXPECT_EQ(stats.processed, 3u);
+    std::string json = read_file(kTempBatchOutput);
+    // A bare date expires at the 16:00 cut-off, an explicit time at that time
+    EXPECT_NE(json.find("\"time_to_expiry\": 1.01574"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"time_to_expiry\": 0.510185"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"time_to_expiry\": 0.509722"), std::string::npos) << json;
+
+    config.expiry_cutoff = 0;  // Midnight
+    run_batch(config, out, err);
+    json = read_file(kTempBatchOutput);
+    EXPECT_NE(json.find("\"time_to_expiry\": 1.01389"), std::string::npos) << json;  // 365/360
+    EXPECT_NE(json.find("\"time_to_expiry\": 0.508333"), std::string::npos) << json;  // 183/360
+    config.expiry_cutoff = 1;
+    EXPECT_THROW(run_batch(config, out, err), std::invalid_argument);
+    config.expiry_cutoff = 16.0 / 24.0;
+
+    config.valuation_time = 0;
+    EXPECT_THROW(run_batch(config, out, err), std::invalid_argument);
+}
+
+// Test OCC symbols aggregated by contract ID and timed from their expiry dates
+TEST_F(BatchEngineTest, OccSymbolTest) {
+    write_file(kTempBatchInput, "OSI,Asset,Rate,Bid,Ask\n"
+                                "AAPL  271015C00100000,100,0.05,10.2,10.8\n"
+                                "AAPL  271015P00110000,100,0.05,9.9,10.4\n"
+                                "AAPL  271015C00100000,100,0.05,10.1,10.6\n");
+
+    BatchConfig config;
+    config.input_file = kTempBatchInput;
+    config.output_file = kTempBatchOutput;
+    config.columns = io::parse_output_schema("type,strike,time,bid,ask");
+    config.aggregation = QuoteAggregation::BEST;
+    config.valuation_time = core::parse_timestamp("2026-10-15T16:00");  // A close to a close
+    config.verbose = false;
+
+    std::ostringstream out;
+    std::ostringstream err;
+    BatchStats stats = run_batch(config, out, err);
+    EXPECT_EQ(stats.processed, 2u);
+    EXPECT_EQ(read_file(kTempBatchOutput), "Type,Strike,Time,Bid,Ask\n"
+                                           "Call,100,1,10.2,10.6\n"
+                                           "Put,110,1,9.9,10.4\n");
+}
+
+// Test rates taken from a yield curve instead of a rate column
+TEST_F(BatchEngineTest, YieldCurveTest) {
+    const std::string curve_file = "temp_batch_curve.csv";
+    write_file(curve_file, "Time,Rate\n# Pillars\n0.5,0.02\n2,0.04\n");
+    write_file(kTempBatchInput, "Type,Asset,Strike,Time,Volatility\n"
+                                "Call,100,100,1,0.2\n"
+                                "Put,100,90,1,0.2\n"
+                                "Call,100,100,0.25,0.2\n");
+
+    BatchConfig config;
+    config.input_file = kTempBatchInput;
+    config.output_file = kTempBatchOutput;
+    config.output_format = "json";
+    config.columns = io::parse_output_schema("rate,price");
+    config.curve_file = curve_file;
+    config.verbose = false;
+
+    std::ostringstream out;
+    std::ostringstream err;
+    BatchStats stats = run_batch(config, out, err);
+    std::remove(curve_file.c_str());
+    EXPECT_EQ(stats.processed, 3u);
+
+    // Flat forward of 0.0466667 from 0.5 to 2 years, flat 2% before 0.5
+    double one_year = (0.02 * 0.5 + (0.08 - 0.01) / 1.5 * 0.5) / 1.0;
+    std::string json = read_file(kTempBatchOutput);
+    EXPECT_NE(json.find("\"risk_free_rate\": 0.0333333"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"risk_free_rate\": 0.02,"), std::string::npos) << json;
+    std::ostringstream price;
+    price << core::black_scholes_price(true, 100, 100, 1, one_year, 0.2);
+    EXPECT_NE(json.find("\"option_price\": " + price.str()), std::string::npos) << json;
+}
+
+// Test escrowed dividends in pricing and implied volatility
+TEST_F(BatchEngineTest, DividendTest) {
+    const std::string dividend_file = "temp_batch_dividends.csv";
+    write_file(dividend_file, "Symbol,ExDate,Amount\nXYZ,2027-01-15,1.5\nXYZ,2028-01-15,1.5\n");
+    double valuation = core::parse_timestamp("2026-10-15");
+    double ex_time = (core::parse_timestamp("2027-01-15") - valuation) / 365.0;
+    double pv = 1.5 * std::exp(-0.05 * ex_time);
+    double price = core::black_scholes_price(true, 100 - pv, 100, 1, 0.05, 0.25);
+    std::ostringstream input;
+    input << "Symbol,Type,Asset,Strike,Time,Rate,Price,Volatility\n"
+          << "XYZ,Call,100,100,1,0.05,," << 0.25 << '\n'
+          << "XYZ,Call,100,100,1,0.05," << price << ",\n"
+          << "ABC,Call,100,100,1,0.05,,0.25\n";
+    write_file(kTempBatchInput, input.str());
+
+    BatchConfig config;
+    config.input_file = kTempBatchInput;
+    config.output_file = kTempBatchOutput;
+    config.output_format = "json";
+    config.columns = io::parse_output_schema("asset,price,volatility");
+    config.dividend_file = dividend_file;
+    config.valuation_time = valuation;
+    config.verbose = false;
+
+    std::ostringstream out;
+    std::ostringstream err;
+    run_batch(config, out, err);
+
+    std::string json = read_file(kTempBatchOutput);
+    auto field = [&json](std::size_t row, const std::string& name) {
+        std::size_t at = 0;
+        for (std::size_t i = 0; i <= row; ++i) {
+            at = json.find("{", at + 1);
+        }
+        at = json.find("\"" + name + "\": ", at) + name.size() + 4;
+        return std::stod(json.substr(at));
+    };
+    EXPECT_EQ(field(0, "asset_price"), 100.0);  // Written unadjusted
+    EXPECT_NEAR(field(0, "option_price"), price, 1e-4);
+    EXPECT_NEAR(field(1, "volatility"), 0.25, 1e-5);
+    EXPECT_NEAR(field(2, "option_price"),
+                core::black_scholes_price(true, 100, 100, 1, 0.05, 0.25), 1e-4);
+
+    config.valuation_time = 0;
+    EXPECT_THROW(run_batch(config, out, err), std::invalid_argument);
+    std::remove(dividend_file.c_str());
+}
+
+// Test error handling
+// Test that American rows are priced and inverted together on the finite-difference grid
+TEST_F(BatchEngineTest, AmericanExerciseTest) {
+    core::PdeConfig grid;
+    double american = core::pde_option_price(false, 100, 110, 1, 0.05, 0.3, grid);
+    double european = core::black_scholes_price(false, 100, 110, 1, 0.05, 0.3);
+    ASSERT_GT(american, european + 0.1);
+
+    std::vector<io::OptionData> options(4);
+    for (io::OptionData& option : options) {
+        option.is_call = false;
+        option.asset_price = 100;
+        option.strike_price = 110;
+        option.time_to_expiry = 1;
+        option.risk_free_rate = 0.05;
+        option.exercise = core::ExerciseStyle::AMERICAN;
+    }
+    options[0].option_price = american;
+    options[1].volatility = 0.3;
+    options[2].option_price = american;
+    options[2].model = core::PricingModel::BACHELIER;
+    options[3].time_to_expiry = 0.5;  // Another expiry in the same batch
+    options[3].volatility = 0.25;
+    ASSERT_TRUE(io::write_binary(kTempBatchBinaryInput, options));
+
+    BatchConfig config;
+    config.input_file = kTempBatchBinaryInput;
+    config.input_format = "binary";
+    config.output_file = kTempBatchBinaryOutput;
+    config.output_format = "binary";
+    std::ostringstream out;
+    std::ostringstream err;
+    BatchStats stats = run_batch(config, out, err);
+    EXPECT_EQ(stats.errors, 1u);
+    EXPECT_NE(err.str().find("Black-Scholes model only"), std::string::npos);
+
+    std::vector<io::OptionData> results = io::read_binary(kTempBatchBinaryOutput);
+    ASSERT_EQ(results.size(), 4u);
+    EXPECT_EQ(results[0].exercise, core::ExerciseStyle::AMERICAN);
+    EXPECT_NEAR(results[0].volatility, 0.3, 1e-4);
+    EXPECT_NEAR(results[1].option_price, american, 1e-9);
+    EXPECT_NEAR(results[3].option_price,
+                core::pde_option_price(false, 100, 110, 0.5, 0.05, 0.25, grid), 1e-9);
+
+    // The grid settings reach the solver
+    config.pde.space_steps = 100;
+    config.pde.time_steps = 50;
+    config.pde.richardson = true;
+    run_batch(config, out, err);
+    results = io::read_binary(kTempBatchBinaryOutput);
+    ASSERT_EQ(results.size(), 4u);
+    EXPECT_NEAR(results[1].option_price,
+                core::pde_option_price(false, 100, 110, 1, 0.05, 0.3, config.pde), 1e-9);
+    EXPECT_NEAR(results[1].option_price, american, 1e-2);
+    config.pde.space_steps = 2;
+    EXPECT_THROW(run_batch(config, out, err), std::invalid_argument);
+    config.pde = core::PdeConfig();
+
+    // Sensitivities of American rows are not available
+    config.output_file = kTempBatchOutput;
+    config.output_format = "csv";
+    config.columns = io::parse_output_schema("type,vol,delta");
+    stats = run_batch(config, out, err);
+    EXPECT_EQ(stats.errors, 4u);
+}
+
+TEST_F(BatchEngineTest, ErrorTest) {
+    BatchConfig config;
+    config.input_file = "nonexistent_file.csv";
+    std::ostringstream out;
+    std::ostringstream err;
+    EXPECT_THROW(run_batch(config, out, err), std::runtime_error);
+
+    write_file(kTempBatchInput, "Type,Asset,Strike,Time,Rate,Price\nCall,abc,100,1,0.05,10\n");
+    config.input_file = kTempBatchInput;
+    config.output_format = "xml";
+    EXPECT_THROW(run_batch(config, out, err), std::invalid_argument);
+
+    // Outside legacy mode a malformed record stops the run
+    config.output_format = "csv";
+    EXPECT_THROW(run_batch(config, out, err), std::invalid_argument);
+}
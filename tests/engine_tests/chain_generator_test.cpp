@@ -0,0 +1,166 @@
+#include "src/engine/chain_generator.h"
+#include "src/io/csv_reader.h"
+#include "src/io/file_io.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace iv_calculator;
+using namespace iv_calculator::engine;
+
+// Temporary file path for testing
+const std::string kTempGeneratorOutput = "temp_generator_output";
+
+namespace {
+    std::string read_file(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    GeneratorConfig small_config(const std::string& format) {
+        GeneratorConfig config;
+        config.rows = 5000;
+        config.output_file = kTempGeneratorOutput;
+        config.output_format = format;
+        config.expiry_days = {30, 365};
+        config.strikes = 11;
+        config.block_rows = 700;
+        return config;
+    }
+}  // namespace
+
+// Test that the file depends on the seed only, not on threads or block size
+TEST(ChainGeneratorTest, DeterministicTest) {
+    std::ostringstream out;
+    GeneratorConfig config = small_config("csv");
+    config.threads = 1;
+    generate_chains(config, out);
+    std::string single = read_file(kTempGeneratorOutput);
+
+    config.threads = 4;
+    config.block_rows = 333;
+    generate_chains(config, out);
+    EXPECT_EQ(read_file(kTempGeneratorOutput), single);
+
+    config.seed = 2;
+    generate_chains(config, out);
+    EXPECT_NE(read_file(kTempGeneratorOutput), single);
+    std::remove(kTempGeneratorOutput.c_str());
+}
+
+// Test the chain layout and prices of a CSV file
+TEST(ChainGeneratorTest, ChainLayoutTest) {
+    std::ostringstream out;
+    GeneratorConfig config = small_config("csv");
+    GeneratorStats stats = generate_chains(config, out);
+    EXPECT_EQ(stats.rows, 5000u);
+    EXPECT_EQ(stats.invalid, 0u);
+    EXPECT_NE(out.str().find("Generated 5000 rows"), std::string::npos);
+
+    io::CsvReader reader(kTempGeneratorOutput);
+    std::vector<io::OptionData> options;
+    io::OptionData option;
+    while (reader.next(option)) {
+        options.push_back(option);
+    }
+    ASSERT_EQ(options.size(), 5000u);
+
+    // 2 expiries x 11 strikes x call and put per underlying
+    EXPECT_EQ(reader.symbols().name(options[0].underlying), "AAA");
+    EXPECT_EQ(reader.symbols().name(options[43].underlying), "AAA");
+    EXPECT_EQ(reader.symbols().name(options[44].underlying), "AAB");
+    EXPECT_EQ(reader.symbols().size(), (5000u + 43) / 44);
+    EXPECT_TRUE(options[0].is_call);
+    EXPECT_FALSE(options[1].is_call);
+    EXPECT_DOUBLE_EQ(options[0].strike_price, options[1].strike_price);
+    EXPECT_LT(options[0].strike_price, options[2].strike_price);
+    EXPECT_NEAR(options[0].time_to_expiry, 30.0 / 365.0, 1e-6);
+    EXPECT_NEAR(options[22].time_to_expiry, 1.0, 1e-6);
+
+    for (const io::OptionData& row : options) {
+        EXPECT_GE(row.option_price, 0.01);
+        EXPECT_LE(row.bid_price, row.option_price);
+        EXPECT_GT(row.ask_price, row.option_price);
+        double forward_strike =
+            row.strike_price * std::exp(-row.risk_free_rate * row.time_to_expiry);
+        double lower = std::max(
+            row.is_call ? row.asset_price - forward_strike : forward_strike - row.asset_price, 0.0);
+        double upper = row.is_call ? row.asset_price : forward_strike;
+        EXPECT_GT(row.option_price, lower);
+        EXPECT_LT(row.option_price, upper);
+    }
+    std::remove(kTempGeneratorOutput.c_str());
+}
+
+// Test that every format reads back with the same rows
+TEST(ChainGeneratorTest, FormatTest) {
+    std::ostringstream out;
+    GeneratorConfig config = small_config("binary");
+    config.invalid_share = 0.1;
+    GeneratorStats stats = generate_chains(config, out);
+    EXPECT_GT(stats.invalid, 350u);
+    EXPECT_LT(stats.invalid, 650u);
+    std::vector<io::OptionData> binary = io::read_binary(kTempGeneratorOutput);
+    ASSERT_EQ(binary.size(), 5000u);
+
+    config.output_format = "json";
+    generate_chains(config, out);
+    std::vector<io::OptionData> json = io::read_json(kTempGeneratorOutput);
+    ASSERT_EQ(json.size(), 5000u);
+
+    std::size_t invalid = 0;
+    for (std::size_t i = 0; i < json.size(); ++i) {
+        EXPECT_EQ(json[i].is_call, binary[i].is_call);
+        EXPECT_NEAR(json[i].strike_price, binary[i].strike_price, 1e-4 * binary[i].strike_price);
+        EXPECT_NEAR(json[i].option_price, binary[i].option_price,
+                    1e-4 * std::abs(binary[i].option_price));
+        const io::OptionData& row = binary[i];
+        double forward_strike =
+            row.strike_price * std::exp(-row.risk_free_rate * row.time_to_expiry);
+        double lower = std::max(
+            row.is_call ? row.asset_price - forward_strike : forward_strike - row.asset_price, 0.0);
+        double upper = row.is_call ? row.asset_price : forward_strike;
+        EXPECT_GT(row.option_price, 0.0);
+        invalid += row.option_price <= lower || row.option_price >= upper ? 1 : 0;
+    }
+    EXPECT_EQ(invalid, stats.invalid);
+
+    // One object per line
+    config.output_format = "ndjson";
+    generate_chains(config, out);
+    std::string ndjson = read_file(kTempGeneratorOutput);
+    EXPECT_EQ(std::count(ndjson.begin(), ndjson.end(), '\n'), 5000);
+    EXPECT_EQ(ndjson.rfind("{\"symbol\": \"AAA\", \"type\": \"Call\"", 0), 0u);
+
+    config.rows = 0;
+    config.output_format = "json";
+    generate_chains(config, out);
+    EXPECT_TRUE(io::read_json(kTempGeneratorOutput).empty());
+    std::remove(kTempGeneratorOutput.c_str());
+}
+
+// Test rejected settings
+TEST(ChainGeneratorTest, ErrorTest) {
+    EXPECT_EQ(parse_expiry_days("7,30.5,365"), (std::vector<double>{7, 30.5, 365}));
+    EXPECT_THROW(parse_expiry_days(""), std::invalid_argument);
+    EXPECT_THROW(parse_expiry_days("7,,30"), std::invalid_argument);
+    EXPECT_THROW(parse_expiry_days("7,-1"), std::invalid_argument);
+
+    std::ostringstream out;
+    GeneratorConfig config = small_config("parquet");
+    EXPECT_THROW(generate_chains(config, out), std::invalid_argument);
+    config = small_config("csv");
+    config.strikes = 0;
+    EXPECT_THROW(generate_chains(config, out), std::invalid_argument);
+    config = small_config("csv");
+    config.invalid_share = 1.5;
+    EXPECT_THROW(generate_chains(config, out), std::invalid_argument);
+}
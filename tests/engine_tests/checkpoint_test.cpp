@@ -0,0 +1,152 @@
+#include "src/engine/batch_engine.h"
+#include "src/engine/checkpoint.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+using namespace iv_calculator;
+using namespace iv_calculator::engine;
+
+// Temporary file paths for testing
+const std::string kTempCheckpointInput = "temp_checkpoint_input.csv";
+const std::string kTempCheckpointOutput = "temp_checkpoint_output";
+const std::string kTempReferenceOutput = "temp_checkpoint_reference";
+const std::string kTempCheckpointFile = "temp_checkpoint.state";
+
+namespace {
+    constexpr int kRows = 4000;
+    constexpr int kBadRow = 2500;
+
+    // Every other row is priced, the rest are inverted; one asset cell can be corrupted
+    void write_input(bool corrupt) {
+        std::ofstream file(kTempCheckpointInput);
+        file << "Type,Asset,Strike,Time,Rate,Price,Volatility\n";
+        for (int i = 0; i < kRows; ++i) {
+            file << "Call," << (corrupt && i == kBadRow ? "abc" : "100") << ',' << 60 + i % 80
+                 << ",0.5,0.01,";
+            if (i % 2 == 0) {
+                file << ",0.25\n";
+            } else {
+                file << 42 - i % 40 * 0.5 << ",\n";
+            }
+        }
+    }
+
+    std::string read_file(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    BatchConfig make_config(const std::string& format) {
+        BatchConfig config;
+        config.input_file = kTempCheckpointInput;
+        config.output_file = kTempCheckpointOutput;
+        config.output_format = format;
+        config.chunk_rows = 300;
+        config.checkpoint_file = kTempCheckpointFile;
+        config.checkpoint_rows = 600;
+        config.threads = 2;
+        config.verbose = false;
+        return config;
+    }
+}  // namespace
+
+// Test fixture for checkpoint tests
+class CheckpointTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::remove(kTempCheckpointInput.c_str());
+        std::remove(kTempCheckpointOutput.c_str());
+        std::remove(kTempReferenceOutput.c_str());
+        std::remove(kTempCheckpointFile.c_str());
+    }
+};
+
+// Test that checkpoint files round-trip
+TEST_F(CheckpointTest, SaveLoadTest) {
+    EXPECT_FALSE(load_checkpoint(kTempCheckpointFile).has_value());
+
+    Checkpoint checkpoint;
+    checkpoint.job = "input=a.csv;size=10";
+    checkpoint.input_position = 123456789012ULL;
+    checkpoint.input_ordinal = 77;
+    checkpoint.output_bytes = 4096;
+    checkpoint.write_model = true;
+    checkpoint.rows = 70;
+    checkpoint.processed = 68;
+    checkpoint.errors = 2;
+    save_checkpoint(kTempCheckpointFile, checkpoint);
+
+    auto loaded = load_checkpoint(kTempCheckpointFile);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->job, checkpoint.job);
+    EXPECT_EQ(loaded->input_position, checkpoint.input_position);
+    EXPECT_EQ(loaded->input_ordinal, checkpoint.input_ordinal);
+    EXPECT_EQ(loaded->output_bytes, checkpoint.output_bytes);
+    EXPECT_TRUE(loaded->write_model);
+    EXPECT_EQ(loaded->rows, 70u);
+    EXPECT_EQ(loaded->processed, 68u);
+    EXPECT_EQ(loaded->errors, 2u);
+
+    std::ofstream(kTempCheckpointFile) << "iv_calculator checkpoint 1\nrows=x\n";
+    EXPECT_THROW(load_checkpoint(kTempCheckpointFile), std::runtime_error);
+}
+
+// Test that a run interrupted midway resumes to the output of an uninterrupted run
+TEST_F(CheckpointTest, ResumeTest) {
+    for (const std::string format : {"csv", "json", "binary"}) {
+        SCOPED_TRACE(format);
+        write_input(false);
+        BatchConfig reference = make_config(format);
+        reference.output_file = kTempReferenceOutput;
+        reference.checkpoint_file.clear();
+        std::ostringstream out;
+        std::ostringstream err;
+        run_batch(reference, out, err);
+
+        // The corrupted row stops the run after several checkpoints
+        auto modified = std::filesystem::last_write_time(kTempCheckpointInput);
+        write_input(true);
+        std::filesystem::last_write_time(kTempCheckpointInput, modified);
+        BatchConfig config = make_config(format);
+        EXPECT_THROW(run_batch(config, out, err), std::invalid_argument);
+        auto checkpoint = load_checkpoint(kTempCheckpointFile);
+        ASSERT_TRUE(checkpoint.has_value());
+        EXPECT_GT(checkpoint->rows, 0u);
+        EXPECT_LE(checkpoint->rows, static_cast<std::size_t>(kBadRow));
+
+        // Repair the row in place and resume
+        write_input(false);
+        std::filesystem::last_write_time(kTempCheckpointInput, modified);
+        config.resume = true;
+        BatchStats stats = run_batch(config, out, err);
+        EXPECT_EQ(stats.rows, static_cast<std::size_t>(kRows));
+        EXPECT_EQ(stats.processed, static_cast<std::size_t>(kRows));
+        EXPECT_EQ(read_file(kTempCheckpointOutput), read_file(kTempReferenceOutput));
+        EXPECT_FALSE(std::filesystem::exists(kTempCheckpointFile));
+    }
+}
+
+// Test that a checkpoint of another input is refused
+TEST_F(CheckpointTest, MismatchTest) {
+    write_input(false);
+    Checkpoint checkpoint;
+    checkpoint.job = "input=other.csv";
+    save_checkpoint(kTempCheckpointFile, checkpoint);
+
+    BatchConfig config = make_config("csv");
+    config.resume = true;
+    std::ostringstream out;
+    std::ostringstream err;
+    EXPECT_THROW(run_batch(config, out, err), std::runtime_error);
+
+    // Without resume the stale checkpoint is ignored and replaced
+    config.resume = false;
+    EXPECT_EQ(run_batch(config, out, err).processed, static_cast<std::size_t>(kRows));
+}
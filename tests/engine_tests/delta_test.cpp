@@ -0,0 +1,190 @@
+#include "src/engine/batch_engine.h"
+#include "src/engine/delta.h"
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace iv_calculator;
+using namespace iv_calculator::engine;
+
+// Temporary file paths for testing
+const std::string kTempDeltaInput = "temp_delta_input.csv";
+const std::string kTempDeltaBaseline = "temp_delta_baseline";
+const std::string kTempDeltaOutput = "temp_delta_output.csv";
+const std::string kTempChangeLog = "temp_delta_changes.csv";
+
+namespace {
+    constexpr int kRows = 1000;
+
+    // Calls with one strike each; the prices of the listed rows are raised by bump
+    void write_input(const std::vector<int>& rows, const std::vector<int>& bumped = {},
+                     double bump = 0.0) {
+        std::ofstream file(kTempDeltaInput);
+        file << "Type,Asset,Strike,Time,Rate,Price,Volatility\n";
+        for (int i : rows) {
+            double price = 10.0 + i % 7 * 0.25;
+            for (int row : bumped) {
+                if (row == i) {
+                    price += bump;
+                }
+            }
+            file << "Call,100," << 50 + i << ",0.5,0.01," << price << ",\n";
+        }
+    }
+
+    std::vector<int> all_rows() {
+        std::vector<int> rows;
+        for (int i = 0; i < kRows; ++i) {
+            rows.push_back(i);
+        }
+        return rows;
+    }
+
+    std::vector<std::string> read_lines(const std::string& path) {
+        std::ifstream file(path);
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(file, line)) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    BatchConfig make_config(const std::string& output, const std::string& format) {
+        BatchConfig config;
+        config.input_file = kTempDeltaInput;
+        config.output_file = output;
+        config.output_format = format;
+        config.chunk_rows = 128;
+        config.threads = 2;
+        config.verbose = false;
+        return config;
+    }
+
+    DeltaConfig make_delta(const std::string& format, DeltaKey key) {
+        DeltaConfig delta;
+        delta.baseline_file = kTempDeltaBaseline;
+        delta.baseline_format = format;
+        delta.key = key;
+        delta.change_log_file = kTempChangeLog;
+        return delta;
+    }
+}  // namespace
+
+// Test fixture for delta output tests
+class DeltaTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::remove(kTempDeltaInput.c_str());
+        std::remove(kTempDeltaBaseline.c_str());
+        std::remove(kTempDeltaOutput.c_str());
+        std::remove(kTempChangeLog.c_str());
+    }
+
+    std::stringstream out_;
+    std::stringstream err_;
+};
+
+// Test delta key names
+TEST_F(DeltaTest, ParseKeyTest) {
+    EXPECT_EQ(parse_delta_key("row"), DeltaKey::ROW);
+    EXPECT_EQ(parse_delta_key("contract"), DeltaKey::CONTRACT);
+    EXPECT_THROW(parse_delta_key("symbol"), std::invalid_argument);
+}
+
+// Test that an unchanged rerun against a CSV baseline publishes nothing
+TEST_F(DeltaTest, UnchangedRunTest) {
+    write_input(all_rows());
+    run_batch(make_config(kTempDeltaBaseline, "csv"), out_, err_);
+
+    BatchConfig config = make_config(kTempDeltaOutput, "csv");
+    config.delta = make_delta("csv", DeltaKey::ROW);
+    BatchStats stats = run_batch(config, out_, err_);
+
+    EXPECT_EQ(stats.delta.unchanged, static_cast<std::size_t>(kRows));
+    EXPECT_EQ(stats.delta.changed, 0U);
+    EXPECT_EQ(stats.delta.added, 0U);
+    EXPECT_EQ(stats.delta.removed, 0U);
+    EXPECT_EQ(read_lines(kTempDeltaOutput).size(), 1U);  // Header only
+    EXPECT_EQ(read_lines(kTempChangeLog).size(), 1U);
+}
+
+// Test that only moved rows are written and logged when keyed by row
+TEST_F(DeltaTest, RowKeyTest) {
+    write_input(all_rows());
+    run_batch(make_config(kTempDeltaBaseline, "csv"), out_, err_);
+
+    // Rows 10 and 500 move, row 700 moves by less than the thresholds, one row is added
+    std::vector<int> rows = all_rows();
+    rows.push_back(kRows);
+    write_input(rows, {10, 500}, 0.5);
+    BatchConfig config = make_config(kTempDeltaOutput, "csv");
+    config.delta = make_delta("csv", DeltaKey::ROW);
+    BatchStats stats = run_batch(config, out_, err_);
+
+    EXPECT_EQ(stats.delta.changed, 2U);
+    EXPECT_EQ(stats.delta.added, 1U);
+    EXPECT_EQ(stats.delta.unchanged, static_cast<std::size_t>(kRows - 2));
+
+    std::vector<std::string> output = read_lines(kTempDeltaOutput);
+    ASSERT_EQ(output.size(), 4U);
+    EXPECT_EQ(output[1].rfind("Call,100,60,", 0), 0U);
+    EXPECT_EQ(output[2].rfind("Call,100,550,", 0), 0U);
+    EXPECT_EQ(output[3].rfind("Call,100,1050,", 0), 0U);
+
+    std::vector<std::string> log = read_lines(kTempChangeLog);
+    ASSERT_EQ(log.size(), 4U);
+    EXPECT_EQ(log[0],
+              "Row,Change,Type,Strike,Time,Volatility,PreviousVolatility,Price,PreviousPrice");
+    EXPECT_EQ(log[1].rfind("10,changed,Call,60,0.5,", 0), 0U);
+    EXPECT_EQ(log[2].rfind("500,changed,Call,550,0.5,", 0), 0U);
+    EXPECT_EQ(log[3].rfind("1000,added,Call,1050,0.5,", 0), 0U);
+    // An added result has no previous values
+    EXPECT_EQ(log[3].find(",,"), log[3].rfind(",,"));
+}
+
+// Test that a contract key matches reordered rows against a binary baseline
+TEST_F(DeltaTest, ContractKeyTest) {
+    write_input(all_rows());
+    run_batch(make_config(kTempDeltaBaseline, "binary"), out_, err_);
+
+    // Reverse the rows, drop the first contract and move one
+    std::vector<int> rows;
+    for (int i = kRows - 1; i > 0; --i) {
+        rows.push_back(i);
+    }
+    write_input(rows, {300}, 1.0);
+    BatchConfig config = make_config(kTempDeltaOutput, "csv");
+    config.delta = make_delta("binary", DeltaKey::CONTRACT);
+    BatchStats stats = run_batch(config, out_, err_);
+
+    EXPECT_EQ(stats.delta.changed, 1U);
+    EXPECT_EQ(stats.delta.added, 0U);
+    EXPECT_EQ(stats.delta.removed, 1U);
+    EXPECT_EQ(stats.delta.unchanged, static_cast<std::size_t>(kRows - 2));
+
+    std::vector<std::string> output = read_lines(kTempDeltaOutput);
+    ASSERT_EQ(output.size(), 2U);
+    EXPECT_EQ(output[1].rfind("Call,100,350,", 0), 0U);
+
+    std::vector<std::string> log = read_lines(kTempChangeLog);
+    ASSERT_EQ(log.size(), 3U);
+    EXPECT_EQ(log[1].rfind("699,changed,Call,350,", 0), 0U);
+    EXPECT_EQ(log[2].rfind(",removed,Call,50,0.5,,", 0), 0U);
+}
+
+// Test that delta output is rejected with checkpoints
+TEST_F(DeltaTest, RejectsCheckpointTest) {
+    write_input(all_rows());
+    run_batch(make_config(kTempDeltaBaseline, "csv"), out_, err_);
+
+    BatchConfig config = make_config(kTempDeltaOutput, "csv");
+    config.delta = make_delta("csv", DeltaKey::ROW);
+    config.checkpoint_file = kTempDeltaOutput + ".checkpoint";
+    EXPECT_THROW(run_batch(config, out_, err_), std::invalid_argument);
+}
@@ -0,0 +1,117 @@
+#include "src/engine/quote_aggregator.h"
+#include "src/io/file_io.h"
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+using namespace iv_calculator;
+using namespace iv_calculator::engine;
+
+namespace {
+    io::OptionData quote(bool is_call, double strike, double bid, double ask, double price = 0) {
+        io::OptionData option;
+        option.is_call = is_call;
+        option.asset_price = 100.0;
+        option.strike_price = strike;
+        option.time_to_expiry = 0.5;
+        option.risk_free_rate = 0.02;
+        option.bid_price = bid;
+        option.ask_price = ask;
+        option.option_price = price;
+        return option;
+    }
+}  // namespace
+
+// Test that the best bid and offer are taken across venues, in first-seen order
+TEST(QuoteAggregatorTest, BestBidOfferTest) {
+    std::vector<io::OptionData> quotes = {
+        quote(true, 100, 5.0, 5.4, 5.2), quote(false, 100, 4.1, 4.5),
+        quote(true, 100, 5.1, 5.6, 5.3), quote(true, 105, 3.0, 3.3),
+        quote(true, 100, 0.0, 5.3),      quote(false, 100, 4.2, 0.0)};
+
+    std::vector<io::OptionData> contracts =
+        aggregate_quotes(quotes, QuoteAggregation::BEST, 1);
+    ASSERT_EQ(contracts.size(), 3u);
+
+    EXPECT_TRUE(contracts[0].is_call);
+    EXPECT_DOUBLE_EQ(contracts[0].strike_price, 100.0);
+    EXPECT_DOUBLE_EQ(contracts[0].bid_price, 5.1);
+    EXPECT_DOUBLE_EQ(contracts[0].ask_price, 5.3);
+    EXPECT_DOUBLE_EQ(contracts[0].option_price, 0.0);  // From the last row
+
+    EXPECT_FALSE(contracts[1].is_call);
+    EXPECT_DOUBLE_EQ(contracts[1].bid_price, 4.2);
+    EXPECT_DOUBLE_EQ(contracts[1].ask_price, 4.5);  // A missing ask does not win
+
+    EXPECT_DOUBLE_EQ(contracts[2].strike_price, 105.0);
+
+    // The last row of each contract is kept as it is
+    contracts = aggregate_quotes(quotes, QuoteAggregation::LAST, 1);
+    ASSERT_EQ(contracts.size(), 3u);
+    EXPECT_DOUBLE_EQ(contracts[0].bid_price, 0.0);
+    EXPECT_DOUBLE_EQ(contracts[0].ask_price, 5.3);
+    EXPECT_DOUBLE_EQ(contracts[1].ask_price, 0.0);
+
+    EXPECT_EQ(aggregate_quotes(quotes, QuoteAggregation::NONE).size(), quotes.size());
+}
+
+// Test that quotes of one symbol are combined across spot snapshots
+TEST(QuoteAggregatorTest, SpotSnapshotTest) {
+    std::vector<io::OptionData> quotes = {quote(true, 190, 5.0, 5.4), quote(true, 190, 5.1, 5.6),
+                                          quote(true, 190, 5.0, 5.3)};
+    quotes[1].asset_price = 100.05;
+    quotes[2].asset_price = 100.02;
+
+    // Without a symbol the spot tells the underlyings apart
+    EXPECT_EQ(aggregate_quotes(quotes, QuoteAggregation::BEST, 1).size(), 3u);
+
+    for (io::OptionData& option : quotes) {
+        option.underlying = 1;
+    }
+    std::vector<io::OptionData> contracts =
+        aggregate_quotes(quotes, QuoteAggregation::BEST, 1);
+    ASSERT_EQ(contracts.size(), 1u);
+    EXPECT_DOUBLE_EQ(contracts[0].asset_price, 100.02);  // From the last row
+    EXPECT_DOUBLE_EQ(contracts[0].bid_price, 5.1);
+    EXPECT_DOUBLE_EQ(contracts[0].ask_price, 5.3);
+
+    // Another symbol is another contract
+    quotes[2].underlying = 2;
+    EXPECT_EQ(aggregate_quotes(quotes, QuoteAggregation::BEST, 1).size(), 2u);
+}
+
+// Test that per-thread tables merge to the single-threaded result
+TEST(QuoteAggregatorTest, ThreadCountTest) {
+    std::vector<io::OptionData> quotes;
+    for (int i = 0; i < 200000; ++i) {
+        int contract = (i * 7919) % 5003;  // Repeats spread over the whole input
+        double bid = 1.0 + (i % 13) * 0.01;
+        quotes.push_back(quote(contract % 2 == 0, 50.0 + contract, bid, bid + 0.1 + (i % 7) * 0.01,
+                               i));
+    }
+
+    std::vector<io::OptionData> single = aggregate_quotes(quotes, QuoteAggregation::BEST, 1);
+    ASSERT_EQ(single.size(), 5003u);
+    for (unsigned threads : {2U, 3U, 8U}) {
+        std::vector<io::OptionData> parallel =
+            aggregate_quotes(quotes, QuoteAggregation::BEST, threads);
+        ASSERT_EQ(parallel.size(), single.size());
+        for (std::size_t i = 0; i < single.size(); ++i) {
+            EXPECT_EQ(parallel[i].strike_price, single[i].strike_price);
+            EXPECT_EQ(parallel[i].bid_price, single[i].bid_price);
+            EXPECT_EQ(parallel[i].ask_price, single[i].ask_price);
+            EXPECT_EQ(parallel[i].option_price, single[i].option_price);
+        }
+    }
+    EXPECT_DOUBLE_EQ(single[0].bid_price, 1.12);
+    EXPECT_DOUBLE_EQ(single[0].ask_price, 1.1);
+}
+
+// Test aggregation names
+TEST(QuoteAggregatorTest, ParseTest) {
+    EXPECT_EQ(parse_quote_aggregation("none"), QuoteAggregation::NONE);
+    EXPECT_EQ(parse_quote_aggregation("bbo"), QuoteAggregation::BEST);
+    EXPECT_EQ(parse_quote_aggregation("last"), QuoteAggregation::LAST);
+    EXPECT_THROW(parse_quote_aggregation("first"), std::invalid_argument);
+}
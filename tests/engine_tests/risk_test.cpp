@@ -0,0 +1,192 @@
+#include "src/engine/risk.h"
+#include "src/core/greeks.h"
+#include "src/io/file_io.h"
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace iv_calculator;
+using namespace iv_calculator::engine;
+
+// Temporary file path for testing
+const std::string kTempRiskOutput = "temp_risk_output.csv";
+
+namespace {
+    io::OptionData position(double asset, double time, double quantity) {
+        io::OptionData option;
+        option.asset_price = asset;
+        option.strike_price = asset;
+        option.time_to_expiry = time;
+        option.quantity = quantity;
+        return option;
+    }
+
+    core::Greeks unit_greeks(double delta) {
+        core::Greeks greeks;
+        greeks.delta = delta;
+        greeks.gamma = 0.01;
+        greeks.vega = 0.4;
+        greeks.theta = -5.0;
+        greeks.rho = 0.3;
+        return greeks;
+    }
+}  // namespace
+
+// Test that compensation keeps the low-order terms a plain sum drops
+TEST(RiskTest, CompensatedSumTest) {
+    CompensatedSum sum;
+    double plain = 0.0;
+    for (double value : {1e16, 1.0, -1e16}) {
+        sum.add(value);
+        plain += value;
+    }
+    EXPECT_EQ(plain, 0.0);
+    EXPECT_EQ(sum.value(), 1.0);
+
+    // Many small terms on a large one
+    CompensatedSum many;
+    many.add(1e8);
+    for (int i = 0; i < 1000000; ++i) {
+        many.add(0.1);
+    }
+    EXPECT_NEAR(many.value(), 1e8 + 1e5, 1e-7);
+
+    // Merged partials match one sum
+    CompensatedSum first;
+    CompensatedSum second;
+    first.add(1e16);
+    second.add(1.0);
+    second.add(-1e16);
+    first.add(second);
+    EXPECT_EQ(first.value(), 1.0);
+}
+
+// Test the expiry buckets
+TEST(RiskTest, ExpiryBucketTest) {
+    EXPECT_STREQ(expiry_bucket_name(expiry_bucket(1.0 / 365.0)), "1W");
+    EXPECT_STREQ(expiry_bucket_name(expiry_bucket(7.0 / 365.0)), "1W");
+    EXPECT_STREQ(expiry_bucket_name(expiry_bucket(0.05)), "1M");
+    EXPECT_STREQ(expiry_bucket_name(expiry_bucket(0.25)), "3M");
+    EXPECT_STREQ(expiry_bucket_name(expiry_bucket(0.9)), "1Y");
+    EXPECT_STREQ(expiry_bucket_name(expiry_bucket(5.0)), "2Y+");
+}
+
+// Test that partial rollups merge to the totals of one rollup, sorted by group
+TEST(RiskTest, RollupTest) {
+    std::vector<io::OptionData> positions = {position(100, 0.5, 10), position(50, 0.5, -4),
+                                             position(100, 0.4, 2), position(100, 2.5, 1),
+                                             position(50, 0.5, 3)};
+    RiskRollup whole;
+    RiskRollup first;
+    RiskRollup second;
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        core::Greeks greeks = unit_greeks(0.1 * static_cast<double>(i + 1));
+        whole.add(positions[i], greeks);
+        (i < 2 ? first : second).add(positions[i], greeks);
+    }
+    first.merge(second);
+    EXPECT_EQ(first.positions(), 5u);
+
+    std::vector<RiskTotals> totals = first.totals();
+    ASSERT_EQ(totals.size(), 3u);
+    EXPECT_EQ(totals[0].asset_price, 50.0);
+    EXPECT_EQ(totals[0].positions, 2u);
+    EXPECT_DOUBLE_EQ(totals[0].quantity.value(), -1.0);
+    EXPECT_DOUBLE_EQ(totals[0].delta.value(), -4 * 0.2 + 3 * 0.5);
+    EXPECT_EQ(totals[1].asset_price, 100.0);
+    EXPECT_STREQ(expiry_bucket_name(totals[1].expiry_bucket), "6M");
+    EXPECT_DOUBLE_EQ(totals[1].delta.value(), 10 * 0.1 + 2 * 0.3);
+    EXPECT_DOUBLE_EQ(totals[1].theta.value(), -60.0);
+    EXPECT_STREQ(expiry_bucket_name(totals[2].expiry_bucket), "2Y+");
+
+    std::vector<RiskTotals> single = whole.totals();
+    ASSERT_EQ(single.size(), totals.size());
+    for (std::size_t i = 0; i < totals.size(); ++i) {
+        EXPECT_EQ(single[i].delta.value(), totals[i].delta.value());
+        EXPECT_EQ(single[i].vega.value(), totals[i].vega.value());
+    }
+}
+
+// Test that rows with a symbol are grouped by it whatever their asset price
+TEST(RiskTest, SymbolGroupTest) {
+    io::SymbolPool symbols;
+    io::OptionData moved = position(101, 0.5, 2);
+    moved.underlying = symbols.intern("SPY");
+    io::OptionData before = position(100, 0.5, 3);
+    before.underlying = moved.underlying;
+
+    RiskRollup rollup;
+    rollup.add(position(100, 0.5, 10), unit_greeks(0.5));
+    rollup.add(moved, unit_greeks(0.5));
+    rollup.add(before, unit_greeks(0.5));
+    std::vector<RiskTotals> totals = rollup.totals();
+    ASSERT_EQ(totals.size(), 2u);
+    EXPECT_EQ(totals[0].underlying, 0u);
+    EXPECT_EQ(totals[0].asset_price, 100.0);
+    EXPECT_EQ(totals[1].underlying, moved.underlying);
+    EXPECT_EQ(totals[1].positions, 2u);
+    EXPECT_DOUBLE_EQ(totals[1].quantity.value(), 5.0);
+}
+
+// Test the CSV rollup file
+TEST(RiskTest, WriteTest) {
+    io::SymbolPool symbols;
+    io::OptionData listed = position(200, 2.5, -1);
+    listed.underlying = symbols.intern("SPY");
+    RiskRollup rollup;
+    rollup.add(position(100, 0.5, 10), unit_greeks(0.5));
+    rollup.add(listed, unit_greeks(0.5));
+    write_risk_rollup(kTempRiskOutput, "csv", rollup.totals(), symbols);
+
+    std::ifstream file(kTempRiskOutput);
+    std::stringstream content;
+    content << file.rdbuf();
+    EXPECT_EQ(content.str(), "Underlying,Expiry,Positions,Quantity,Delta,Gamma,Vega,Theta,Rho\n"
+                             "100,6M,1,10,5,0.1,4,-50,3\n"
+                             "SPY,2Y+,1,-1,-0.5,-0.01,-0.4,5,-0.3\n");
+    std::remove(kTempRiskOutput.c_str());
+
+    EXPECT_THROW(write_risk_rollup(kTempRiskOutput, "binary", rollup.totals(), symbols),
+                 std::invalid_argument);
+}
+
+// Test parsing of shock grids
+TEST(RiskTest, ScenarioGridTest) {
+    core::ScenarioGrid grid = parse_scenario_grid("spot=-0.2:0.2:5,vol=-0.1:0.1:3");
+    EXPECT_EQ(grid.spot_shocks.size(), 5u);
+    EXPECT_DOUBLE_EQ(grid.spot_shocks.front(), -0.2);
+    EXPECT_EQ(grid.volatility_shocks.size(), 3u);
+    EXPECT_DOUBLE_EQ(grid.volatility_shocks.back(), 0.1);
+
+    core::ScenarioGrid spot_only = parse_scenario_grid("spot=-0.1:0.1:3");
+    EXPECT_EQ(spot_only.volatility_shocks, std::vector<double>{0.0});
+
+    for (const char* spec : {"spot=-0.1:0.1", "spot=-0.1:0.1:0", "spot=a:0.1:3",
+                             "rate=0:1:2", "spot=0:1:2,spot=0:1:2", "spot=-1:0:3",
+                             "spot=0:1:2.5"}) {
+        EXPECT_THROW(parse_scenario_grid(spec), std::invalid_argument) << spec;
+    }
+}
+
+// Test the CSV P&L matrix
+TEST(RiskTest, WriteScenarioTest) {
+    core::ScenarioGrid grid{{-0.1, 0.1}, {0.0, 0.05}};
+    core::ScenarioMatrix matrix;
+    matrix.spot_count = 2;
+    matrix.volatility_count = 2;
+    matrix.base_value = 10;
+    matrix.value = {8, 9, 12, 13.5};
+    write_scenario_matrix(kTempRiskOutput, grid, matrix);
+
+    std::ifstream file(kTempRiskOutput);
+    std::stringstream content;
+    content << file.rdbuf();
+    EXPECT_EQ(content.str(), "SpotShock,0,0.05\n"
+                             "-0.1,-2,-1\n"
+                             "0.1,2,3.5\n");
+    std::remove(kTempRiskOutput.c_str());
+}
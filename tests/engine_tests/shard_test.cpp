@@ -0,0 +1,164 @@
+#include "src/engine/batch_engine.h"
+#include "src/engine/shard.h"
+#include "src/io/file_io.h"
+#include "src/io/option_reader.h"
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace iv_calculator;
+using namespace iv_calculator::engine;
+
+// Temporary file paths for testing
+const std::string kTempShardInput = "temp_shard_input.csv";
+const std::string kTempMergeOutput = "temp_merge_output.csv";
+
+namespace {
+    constexpr int kRows = 3000;
+
+    std::string shard_output(std::size_t index) {
+        return "temp_shard_output_" + std::to_string(index) + ".bin";
+    }
+
+    // Rows of varying width, with a blank line and CRLF endings mixed in
+    void write_input() {
+        std::ofstream file(kTempShardInput, std::ios::binary);
+        file << "Type,Asset,Strike,Time,Rate,Price,Volatility\r\n";
+        for (int i = 0; i < kRows; ++i) {
+            file << (i % 2 == 0 ? "Call," : "Put,") << 100 << ',' << 50 + i << ",0.5,0.01,,"
+                 << 0.1 + (i % 9) * 0.05 << (i % 5 == 0 ? "\r\n" : "\n");
+            if (i == 1000) {
+                file << '\n';
+            }
+        }
+    }
+
+    // Run every shard into its own binary file
+    std::vector<std::string> run_shards(std::size_t count, ShardMode mode) {
+        std::vector<std::string> outputs;
+        for (std::size_t index = 0; index < count; ++index) {
+            BatchConfig config;
+            config.input_file = kTempShardInput;
+            config.output_file = shard_output(index);
+            config.output_format = "binary";
+            config.io_options.block_size = 4096;
+            config.chunk_rows = 333;
+            config.verbose = false;
+            config.shard = ShardSpec{index, count, mode};
+
+            std::ostringstream out;
+            std::ostringstream err;
+            BatchStats stats = run_batch(config, out, err);
+            EXPECT_EQ(stats.errors, 0u);
+            outputs.push_back(config.output_file);
+        }
+        return outputs;
+    }
+
+    void expect_original_order(const std::vector<io::OptionData>& options) {
+        ASSERT_EQ(options.size(), static_cast<std::size_t>(kRows));
+        for (int i = 0; i < kRows; ++i) {
+            EXPECT_DOUBLE_EQ(options[i].strike_price, 50 + i);
+            EXPECT_EQ(options[i].is_call, i % 2 == 0);
+            EXPECT_DOUBLE_EQ(options[i].volatility, 0.1 + (i % 9) * 0.05);
+        }
+    }
+}  // namespace
+
+// Test fixture for shard tests
+class ShardTest : public ::testing::Test {
+protected:
+    void SetUp() override { write_input(); }
+
+    void TearDown() override {
+        std::remove(kTempShardInput.c_str());
+        std::remove(kTempMergeOutput.c_str());
+        for (std::size_t index = 0; index < 7; ++index) {
+            std::remove(shard_output(index).c_str());
+        }
+    }
+};
+
+// Test parsing of shard arguments
+TEST(ShardSpecTest, ParseTest) {
+    ShardSpec shard = parse_shard_spec("2/5");
+    EXPECT_EQ(shard.index, 2u);
+    EXPECT_EQ(shard.count, 5u);
+    EXPECT_EQ(shard.mode, ShardMode::RANGE);
+    EXPECT_EQ(parse_shard_mode("hash"), ShardMode::HASH);
+
+    EXPECT_THROW(parse_shard_spec("5/5"), std::invalid_argument);
+    EXPECT_THROW(parse_shard_spec("1/0"), std::invalid_argument);
+    EXPECT_THROW(parse_shard_spec("1"), std::invalid_argument);
+    EXPECT_THROW(parse_shard_spec("-1/2"), std::invalid_argument);
+    EXPECT_THROW(parse_shard_mode("random"), std::invalid_argument);
+}
+
+// Test that byte-range shards cover every record once and merge back in order
+TEST_F(ShardTest, RangeShardMergeTest) {
+    for (std::size_t count : {1, 2, 7}) {
+        std::vector<std::string> outputs = run_shards(count, ShardMode::RANGE);
+
+        MergeConfig merge;
+        merge.input_files = outputs;
+        merge.input_format = "binary";
+        merge.output_file = kTempMergeOutput;
+        std::ostringstream out;
+        EXPECT_EQ(merge_shards(merge, out), static_cast<std::size_t>(kRows));
+        expect_original_order(io::read_csv(kTempMergeOutput));
+    }
+}
+
+// Test that hash shards are reordered into the original order
+TEST_F(ShardTest, HashShardMergeTest) {
+    std::vector<std::string> outputs = run_shards(3, ShardMode::HASH);
+    for (const std::string& output : outputs) {
+        EXPECT_GT(io::read_binary(output).size(), static_cast<std::size_t>(kRows / 5));
+    }
+
+    MergeConfig merge;
+    merge.input_files = outputs;
+    merge.input_format = "binary";
+    merge.output_file = kTempMergeOutput;
+    merge.mode = ShardMode::HASH;
+    std::ostringstream out;
+    EXPECT_EQ(merge_shards(merge, out), static_cast<std::size_t>(kRows));
+    expect_original_order(io::read_csv(kTempMergeOutput));
+
+    // Shards listed out of order do not replay the partition
+    std::swap(merge.input_files[0], merge.input_files[1]);
+    EXPECT_THROW(merge_shards(merge, out), std::runtime_error);
+}
+
+// Test record-range partitions of JSON and binary readers
+TEST_F(ShardTest, RecordPartitionTest) {
+    std::vector<io::OptionData> options(10);
+    for (std::size_t i = 0; i < options.size(); ++i) {
+        options[i].strike_price = static_cast<double>(i);
+    }
+    ASSERT_TRUE(io::write_binary(shard_output(0), options));
+
+    io::BinaryReader reader(shard_output(0));
+    reader.seek_partition(1, 3);
+    io::OptionData option;
+    std::vector<double> strikes;
+    while (reader.next(option)) {
+        strikes.push_back(option.strike_price);
+    }
+    EXPECT_EQ(strikes, (std::vector<double>{3, 4, 5}));
+}
+
+// Test that the deprecated layout cannot be sharded
+TEST_F(ShardTest, LegacyShardTest) {
+    BatchConfig config;
+    config.input_file = kTempShardInput;
+    config.legacy = true;
+    config.shard = parse_shard_spec("0/2");
+    std::ostringstream out;
+    std::ostringstream err;
+    EXPECT_THROW(run_batch(config, out, err), std::invalid_argument);
+}
@@ -0,0 +1,124 @@
+#include "src/io/async_io.h"
+#include "src/io/file_io.h"
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace iv_calculator::io;
+
+// Temporary file paths for testing
+const std::string kTempAsyncFile = "temp_async_test.bin";
+const std::string kTempAsyncCsvFile = "temp_async_test.csv";
+
+namespace {
+    std::string make_pattern(std::size_t size) {
+        std::string data(size, '\0');
+        for (std::size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<char>('a' + (i * 7 + i / 13) % 26);
+        }
+        return data;
+    }
+
+    std::string read_all(const std::string& filepath, const AsyncIoOptions& options) {
+        AsyncFileReader reader(filepath, options);
+        std::string data;
+        for (std::string_view chunk = reader.next(); !chunk.empty(); chunk = reader.next()) {
+            data.append(chunk);
+        }
+        return data;
+    }
+}  // namespace
+
+// Test fixture for asynchronous IO tests
+class AsyncIoTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::remove(kTempAsyncFile.c_str());
+        std::remove(kTempAsyncCsvFile.c_str());
+    }
+};
+
+// Round trip through every backend, with and without O_DIRECT
+TEST_F(AsyncIoTest, RoundTripTest) {
+    const std::string data = make_pattern(100000);
+
+    for (IoBackend backend : {IoBackend::AUTO, IoBackend::IO_URING, IoBackend::STREAM}) {
+        for (bool direct : {false, true}) {
+            AsyncIoOptions options;
+            options.backend = backend;
+            options.block_size = 4096;
+            options.queue_depth = 3;
+            options.direct_io = direct;
+
+            try {
+                AsyncFileWriter writer(kTempAsyncFile, options);
+                // Uneven pieces so writes straddle block boundaries
+                std::size_t offset = 0;
+                std::size_t piece = 1;
+                while (offset < data.size()) {
+                    std::size_t n = std::min(piece, data.size() - offset);
+                    writer.write(std::string_view(data).substr(offset, n));
+                    offset += n;
+                    piece = piece * 3 % 9001 + 1;
+                }
+                writer.close();
+            } catch (const std::runtime_error& e) {
+                // Explicit io_uring is allowed to be unavailable on this kernel
+                ASSERT_EQ(backend, IoBackend::IO_URING) << e.what();
+                continue;
+            }
+
+            EXPECT_EQ(read_all(kTempAsyncFile, options), data)
+                << "backend=" << static_cast<int>(backend) << ", direct=" << direct;
+        }
+    }
+}
+
+// Test reading and writing an empty file
+TEST_F(AsyncIoTest, EmptyFileTest) {
+    AsyncFileWriter writer(kTempAsyncFile);
+    writer.close();
+    EXPECT_TRUE(read_all(kTempAsyncFile, AsyncIoOptions()).empty());
+}
+
+// Test CSV lines that straddle read-ahead chunks
+TEST_F(AsyncIoTest, CsvAcrossChunksTest) {
+    std::vector<OptionData> options(2000);
+    for (std::size_t i = 0; i < options.size(); ++i) {
+        options[i].is_call = i % 2 == 0;
+        options[i].asset_price = 100.0 + static_cast<double>(i % 17);
+        options[i].strike_price = 90.0 + static_cast<double>(i % 23);
+        options[i].time_to_expiry = 0.5;
+        options[i].risk_free_rate = 0.03;
+        options[i].option_price = 4.25;
+        options[i].volatility = 0.2;
+    }
+
+    AsyncIoOptions io_options;
+    io_options.block_size = 4096;
+    ASSERT_TRUE(write_csv(kTempAsyncCsvFile, options, io_options));
+
+    auto read_options = read_csv(kTempAsyncCsvFile, io_options);
+    ASSERT_EQ(read_options.size(), options.size());
+    for (std::size_t i = 0; i < options.size(); ++i) {
+        EXPECT_EQ(read_options[i].is_call, options[i].is_call);
+        EXPECT_DOUBLE_EQ(read_options[i].asset_price, options[i].asset_price);
+        EXPECT_DOUBLE_EQ(read_options[i].strike_price, options[i].strike_price);
+    }
+}
+
+// Test error handling when file doesn't exist
+TEST(AsyncIoErrorTest, NonexistentFileTest) {
+    EXPECT_THROW(AsyncFileReader("nonexistent_file.bin"), std::runtime_error);
+}
+
+// Test backend names accepted on the command line
+TEST(AsyncIoErrorTest, ParseBackendTest) {
+    EXPECT_EQ(parse_io_backend("io_uring"), IoBackend::IO_URING);
+    EXPECT_EQ(parse_io_backend("stream"), IoBackend::STREAM);
+    EXPECT_EQ(parse_io_backend("AUTO"), IoBackend::AUTO);
+    EXPECT_THROW(parse_io_backend("mmap"), std::invalid_argument);
+}
@@ -0,0 +1,95 @@
+#include "src/io/compact_option.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace iv_calculator;
+using namespace iv_calculator::io;
+
+namespace {
+    std::vector<OptionData> sample_options() {
+        std::vector<OptionData> options(3);
+        options[0].asset_price = 101.25;
+        options[0].strike_price = 95.0;
+        options[0].time_to_expiry = 0.25;
+        options[0].risk_free_rate = 0.05;
+        options[0].option_price = 8.5;
+
+        options[1].is_call = false;
+        options[1].asset_price = -0.002;
+        options[1].strike_price = 0.001;
+        options[1].time_to_expiry = 2.0;
+        options[1].volatility = 0.0065;
+        options[1].model = core::PricingModel::BACHELIER;
+
+        options[2].is_call = false;
+        options[2].exercise = core::ExerciseStyle::AMERICAN;
+        options[2].asset_price = 40.0;
+        options[2].strike_price = 45.0;
+        options[2].time_to_expiry = 0.75;
+        options[2].risk_free_rate = -0.005;
+        options[2].option_price = 6.1;
+        options[2].volatility = 0.3;
+        return options;
+    }
+}  // namespace
+
+// Test the size and the flag packing of the compact record
+TEST(CompactOptionTest, PackedFlagsTest) {
+    EXPECT_EQ(sizeof(PackedOption), 40u);
+
+    auto options = sample_options();
+    EXPECT_EQ(pack_option_flags(options[0]), option_flags::kCall);
+    EXPECT_EQ(pack_option_flags(options[1]),
+              option_flags::kQuoteIsVolatility | (1U << option_flags::kModelShift));
+    EXPECT_EQ(pack_option_flags(options[2]), option_flags::kAmerican);
+}
+
+// Test that packing keeps the inputs up to float precision of time and rate
+TEST(CompactOptionTest, PackedRoundTripTest) {
+    for (const OptionData& option : sample_options()) {
+        OptionData unpacked = unpack_option(pack_option(option));
+        EXPECT_EQ(unpacked.is_call, option.is_call);
+        EXPECT_EQ(unpacked.exercise, option.exercise);
+        EXPECT_EQ(unpacked.model, option.model);
+        EXPECT_DOUBLE_EQ(unpacked.asset_price, option.asset_price);
+        EXPECT_DOUBLE_EQ(unpacked.strike_price, option.strike_price);
+        EXPECT_FLOAT_EQ(static_cast<float>(unpacked.time_to_expiry),
+                        static_cast<float>(option.time_to_expiry));
+        EXPECT_NEAR(unpacked.risk_free_rate, option.risk_free_rate, 1e-9);
+    }
+
+    // A row is either priced or inverted, so only its quote survives
+    auto options = sample_options();
+    EXPECT_DOUBLE_EQ(unpack_option(pack_option(options[0])).option_price, 8.5);
+    EXPECT_DOUBLE_EQ(unpack_option(pack_option(options[1])).volatility, 0.0065);
+    EXPECT_DOUBLE_EQ(unpack_option(pack_option(options[2])).option_price, 6.1);
+    EXPECT_DOUBLE_EQ(unpack_option(pack_option(options[2])).volatility, 0);
+}
+
+// Test the columnar layout and its separate result columns
+TEST(CompactOptionTest, ColumnsTest) {
+    auto options = sample_options();
+    OptionColumns columns = to_columns(options);
+    ASSERT_EQ(columns.size(), 3u);
+    EXPECT_DOUBLE_EQ(columns.quote[1], 0.0065);
+
+    // Results written to the result columns come back as price and volatility
+    columns.volatility[0] = 0.21;
+    columns.option_price[1] = 0.0042;
+    auto rows = to_options(columns);
+    ASSERT_EQ(rows.size(), 3u);
+    EXPECT_DOUBLE_EQ(rows[0].option_price, 8.5);
+    EXPECT_DOUBLE_EQ(rows[0].volatility, 0.21);
+    EXPECT_DOUBLE_EQ(rows[1].option_price, 0.0042);
+    EXPECT_DOUBLE_EQ(rows[1].volatility, 0.0065);
+    EXPECT_DOUBLE_EQ(rows[2].volatility, 0.3);
+    EXPECT_EQ(rows[2].exercise, core::ExerciseStyle::AMERICAN);
+    EXPECT_EQ(rows[1].model, core::PricingModel::BACHELIER);
+
+    core::OptionBatch batch = columns.batch();
+    ASSERT_EQ(batch.size(), 3u);
+    EXPECT_EQ(batch.is_call[0], 1);
+    EXPECT_EQ(batch.is_call[2], 0);
+    EXPECT_DOUBLE_EQ(batch.strike_price[2], 45.0);
+}
@@ -0,0 +1,222 @@
+#include "src/io/csv_reader.h"
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace iv_calculator::io;
+
+// Temporary file path for testing
+const std::string kTempCsvReaderFile = "temp_csv_reader_test.csv";
+
+namespace {
+    void write_file(const std::string& contents) {
+        std::ofstream file(kTempCsvReaderFile, std::ios::binary);
+        file << contents;
+    }
+}  // namespace
+
+// Test fixture for CSV reader tests
+class CsvReaderTest : public ::testing::Test {
+protected:
+    void TearDown() override { std::remove(kTempCsvReaderFile.c_str()); }
+};
+
+// Test that a wide vendor file projects onto the named columns in any order
+TEST_F(CsvReaderTest, HeaderProjectionTest) {
+    write_file(
+        "Symbol,Exchange,Rate,Bid,Ask,Time,Strike,Underlying,Description,Mid,OptionType,Volume\n"
+        "AAPL,X,0.05,9.9,10.1,1,100,100,\"Apple, Inc. call\",10,C,17\n"
+        "AAPL,X,0.04,5.5,5.7,0.5,95,101,\"Apple, Inc. put\",5.6,put,3\n");
+
+    auto options = read_csv(kTempCsvReaderFile, CsvColumnMap());
+    ASSERT_EQ(options.size(), 2u);
+
+    EXPECT_TRUE(options[0].is_call);
+    EXPECT_DOUBLE_EQ(options[0].asset_price, 100.0);
+    EXPECT_DOUBLE_EQ(options[0].strike_price, 100.0);
+    EXPECT_DOUBLE_EQ(options[0].time_to_expiry, 1.0);
+    EXPECT_DOUBLE_EQ(options[0].risk_free_rate, 0.05);
+    EXPECT_DOUBLE_EQ(options[0].option_price, 10.0);
+    EXPECT_DOUBLE_EQ(options[0].bid_price, 9.9);
+    EXPECT_DOUBLE_EQ(options[0].ask_price, 10.1);
+
+    EXPECT_FALSE(options[1].is_call);
+    EXPECT_DOUBLE_EQ(options[1].asset_price, 101.0);
+    EXPECT_DOUBLE_EQ(options[1].option_price, 5.6);
+    EXPECT_DOUBLE_EQ(options[1].ask_price, 5.7);
+}
+
+// Test expiry and valuation dates standing in for the time column
+TEST_F(CsvReaderTest, ExpiryDateTest) {
+    write_file("Type,Asset,Strike,Expiry,Rate,Price,AsOf\n"
+               "Call,100,100,2026-12-18,0.05,10,2026-10-16T15:30\n"
+               "Put,100,100,2027-01-15,0.05,5,\n");
+
+    auto options = read_csv(kTempCsvReaderFile, CsvColumnMap());
+    ASSERT_EQ(options.size(), 2u);
+    EXPECT_DOUBLE_EQ(options[0].expiry_date, iv_calculator::core::parse_timestamp("2026-12-18"));
+    EXPECT_DOUBLE_EQ(options[0].valuation_time,
+                     iv_calculator::core::parse_timestamp("2026-10-16T15:30"));
+    EXPECT_DOUBLE_EQ(options[0].time_to_expiry, 0.0);  // Computed by the engine
+    EXPECT_DOUBLE_EQ(options[1].valuation_time, 0.0);
+
+    write_file("Type,Asset,Strike,Expiry,Rate,Price\nCall,100,100,2026-13-01,0.05,10\n");
+    EXPECT_THROW(read_csv(kTempCsvReaderFile, CsvColumnMap()), std::invalid_argument);
+}
+
+// Test OCC symbols standing in for type, strike and expiry
+TEST_F(CsvReaderTest, OccSymbolTest) {
+    write_file("OSI,Asset,Rate,Price\n"
+               "AAPL  260116C00190000,200,0.05,15\n"
+               "AAPL  260116P00190000,200,0.05,4\n"
+               "AAPL  260116C00190000,201,0.05,16\n"
+               "MSFT  261218P00410500,400,0.05,20\n");
+
+    CsvReader reader(kTempCsvReaderFile);
+    std::vector<OptionData> options;
+    OptionData option;
+    while (reader.next(option)) {
+        options.push_back(option);
+    }
+    ASSERT_EQ(options.size(), 4u);
+    EXPECT_TRUE(options[0].is_call);
+    EXPECT_FALSE(options[1].is_call);
+    EXPECT_DOUBLE_EQ(options[0].strike_price, 190.0);
+    EXPECT_DOUBLE_EQ(options[3].strike_price, 410.5);
+    EXPECT_DOUBLE_EQ(options[0].expiry_date, iv_calculator::core::parse_timestamp("2026-01-16"));
+
+    // Repeats of a contract share its ID; roots are interned as underlyings
+    EXPECT_EQ(options[0].contract, 1u);
+    EXPECT_EQ(options[1].contract, 2u);
+    EXPECT_EQ(options[2].contract, 1u);
+    EXPECT_EQ(options[3].contract, 3u);
+    EXPECT_EQ(reader.symbols().name(options[3].underlying), "MSFT");
+    EXPECT_EQ(reader.contracts().key(3).strike_milli, 410500u);
+    EXPECT_EQ(reader.contracts().key(3).root, options[3].underlying);
+
+    // A symbol column names the underlying of an adjusted root
+    CsvSchema schema = resolve_csv_schema("Symbol,OccSymbol,Asset,Rate,Price", CsvColumnMap());
+    SymbolPool symbols;
+    ContractPool contracts;
+    option = parse_csv_record("AAPL,AAPL1 260116C00095000,200,0.05,15", schema, &symbols,
+                              &contracts);
+    EXPECT_EQ(symbols.name(option.underlying), "AAPL");
+    EXPECT_EQ(symbols.name(contracts.key(option.contract).root), "AAPL1");
+
+    write_file("OSI,Asset,Rate,Price\nAAPL  261316C00190000,200,0.05,15\n");
+    EXPECT_THROW(read_csv(kTempCsvReaderFile, CsvColumnMap()), std::invalid_argument);
+}
+
+// Test that columns after the last needed one are never parsed
+TEST_F(CsvReaderTest, UnneededColumnsSkippedTest) {
+    CsvSchema schema = resolve_csv_schema("type,asset,strike,time,rate,price,comment,junk",
+                                          CsvColumnMap());
+    EXPECT_TRUE(schema.from_header);
+    EXPECT_EQ(schema.columns.size(), 6u);
+
+    OptionData option = parse_csv_record("Call,100,105,0.5,0.01,3.2,not a number,x", schema);
+    EXPECT_DOUBLE_EQ(option.strike_price, 105.0);
+    EXPECT_DOUBLE_EQ(option.option_price, 3.2);
+
+    // Skipped runs step over quoted cells, including escaped quotes and commas
+    schema = resolve_csv_schema("Type,Note,Id,Asset,Strike,Time,Rate,Price", CsvColumnMap());
+    option = parse_csv_record(R"(Put,"say ""hi"", twice",12345678901234,99.5,100,1,0.02,7)",
+                              schema);
+    EXPECT_FALSE(option.is_call);
+    EXPECT_DOUBLE_EQ(option.asset_price, 99.5);
+    EXPECT_DOUBLE_EQ(option.option_price, 7.0);
+}
+
+// Test number formats handled by the fast path and the fallback
+TEST_F(CsvReaderTest, NumberFormatsTest) {
+    CsvSchema schema = CsvSchema::positional();
+    OptionData option = parse_csv_record("call, +1.5 ,-0.0001,2.5e-1,0.1234567890123456789,.5",
+                                         schema);
+    EXPECT_DOUBLE_EQ(option.asset_price, 1.5);
+    EXPECT_DOUBLE_EQ(option.strike_price, -0.0001);
+    EXPECT_DOUBLE_EQ(option.time_to_expiry, 0.25);
+    EXPECT_DOUBLE_EQ(option.risk_free_rate, 0.1234567890123456789);
+    EXPECT_DOUBLE_EQ(option.option_price, 0.5);
+}
+
+// Test an explicit mapping from the command line
+TEST_F(CsvReaderTest, ExplicitMappingTest) {
+    write_file(
+        "cp_flag,spot_px,strike_px,yrs,r_cont,last\r\n"
+        "CALL,100,110,0.25,0.02,1.5\r\n"
+        "\r\n"
+        "P,100,90,0.25,0.02,0.8\r\n");
+
+    CsvColumnMap map = parse_csv_column_map(
+        "type=cp_flag,asset=spot_px,strike=strike_px,time=yrs,rate=r_cont,price=last");
+    EXPECT_TRUE(map.user_defined);
+
+    auto options = read_csv(kTempCsvReaderFile, map);
+    ASSERT_EQ(options.size(), 2u);
+    EXPECT_TRUE(options[0].is_call);
+    EXPECT_DOUBLE_EQ(options[0].strike_price, 110.0);
+    EXPECT_DOUBLE_EQ(options[0].option_price, 1.5);
+    EXPECT_FALSE(options[1].is_call);
+    EXPECT_DOUBLE_EQ(options[1].option_price, 0.8);
+}
+
+// Test that an unrecognised header falls back to the positional layout
+TEST_F(CsvReaderTest, PositionalFallbackTest) {
+    write_file("a,b,c,d,e,f,g,h\nPut,100,100,1,0.05,5.57,0.2,Bachelier\n");
+
+    CsvReader reader(kTempCsvReaderFile);
+    EXPECT_FALSE(reader.schema().from_header);
+
+    OptionData option;
+    ASSERT_TRUE(reader.next(option));
+    EXPECT_FALSE(option.is_call);
+    EXPECT_DOUBLE_EQ(option.option_price, 5.57);
+    EXPECT_DOUBLE_EQ(option.volatility, 0.2);
+    EXPECT_EQ(option.model, iv_calculator::core::PricingModel::BACHELIER);
+    EXPECT_FALSE(reader.next(option));
+
+    // A recognised header missing a required field is an error, not data
+    EXPECT_THROW(resolve_csv_schema("Symbol,Asset,Rate,Price", CsvColumnMap()),
+                 std::runtime_error);
+    EXPECT_THROW(resolve_csv_schema("Type,Volatility,Delta", CsvColumnMap()),
+                 std::runtime_error);
+}
+
+// Test streaming in batches across small read-ahead chunks
+TEST_F(CsvReaderTest, ReadBatchTest) {
+    std::string contents = "Type,Asset,Strike,Time,Rate,Price\n";
+    for (int i = 0; i < 1000; ++i) {
+        contents += "Call," + std::to_string(100 + i) + ",100,1,0.05,10\n";
+    }
+    write_file(contents);
+
+    AsyncIoOptions io_options;
+    io_options.block_size = 4096;
+    CsvReader reader(kTempCsvReaderFile, CsvColumnMap(), io_options);
+
+    std::vector<OptionData> options;
+    while (reader.read_batch(options, 64) > 0) {
+    }
+    ASSERT_EQ(options.size(), 1000u);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_DOUBLE_EQ(options[i].asset_price, 100.0 + i);
+    }
+    EXPECT_EQ(reader.line_number(), 1001u);
+}
+
+// Test error handling
+TEST_F(CsvReaderTest, ErrorTest) {
+    // A user-defined map must resolve every required field
+    EXPECT_THROW(resolve_csv_schema("Type,Asset,Strike,Time,Rate",
+                                    parse_csv_column_map("asset=Spot")),
+                 std::runtime_error);
+    EXPECT_THROW(parse_csv_column_map("bogus=Spot"), std::invalid_argument);
+    EXPECT_THROW(parse_csv_column_map("asset"), std::invalid_argument);
+
+    write_file("Type,Asset,Strike,Time,Rate,Price\nCall,abc,100,1,0.05,10\n");
+    EXPECT_THROW(read_csv(kTempCsvReaderFile, CsvColumnMap()), std::invalid_argument);
+}
@@ -71,7 +71,7 @@ protected:
 TEST_F(FileIOTest, ReadCsvTest) {
     auto options = read_csv(kTempCsvFile);
 
-    ASSERT_EQ(options.size(), 2) << "Should have read 2 options from file";
+    ASSERT_EQ(options.size(), 2u) << "Should have read 2 options from file";
 
     // Check first option (Call)
     EXPECT_TRUE(options[0].is_call);
@@ -122,7 +122,7 @@ TEST_F(FileIOTest, WriteCsvTest) {
     // Read the file back in
     auto read_options = read_csv(kTempCsvFile);
 
-    ASSERT_EQ(read_options.size(), 2) << "Should have read 2 options from file";
+    ASSERT_EQ(read_options.size(), 2u) << "Should have read 2 options from file";
 
     // Check first option (Call)
     EXPECT_TRUE(read_options[0].is_call);
@@ -143,6 +143,33 @@ TEST_F(FileIOTest, WriteCsvTest) {
     EXPECT_DOUBLE_EQ(read_options[1].volatility, 0.15);
 }
 
+// Test the optional pricing model column
+TEST_F(FileIOTest, ModelColumnCsvTest) {
+    std::vector<OptionData> options(2);
+    options[0].asset_price = -0.5;
+    options[0].strike_price = 0.0;
+    options[0].time_to_expiry = 1.0;
+    options[0].option_price = 0.1;
+    options[0].model = iv_calculator::core::PricingModel::BACHELIER;
+    options[1].asset_price = 100.0;
+    options[1].strike_price = 100.0;
+    options[1].time_to_expiry = 1.0;
+    options[1].option_price = 10.0;
+
+    EXPECT_TRUE(write_csv(kTempCsvFile, options));
+    auto read_options = read_csv(kTempCsvFile);
+
+    ASSERT_EQ(read_options.size(), 2u);
+    EXPECT_EQ(read_options[0].model, iv_calculator::core::PricingModel::BACHELIER);
+    EXPECT_DOUBLE_EQ(read_options[0].asset_price, -0.5);
+    EXPECT_EQ(read_options[1].model, iv_calculator::core::PricingModel::BLACK_SCHOLES);
+
+    // Without the column every row defaults to Black-Scholes
+    auto default_options = read_json(kTempJsonFile);
+    ASSERT_EQ(default_options.size(), 2u);
+    EXPECT_EQ(default_options[0].model, iv_calculator::core::PricingModel::BLACK_SCHOLES);
+}
+
 // Test error handling when file doesn't exist
 TEST(FileIOErrorTest, NonexistentFileTest) {
     const std::string nonexistent = "nonexistent_file.csv";
@@ -153,7 +180,7 @@ TEST(FileIOErrorTest, NonexistentFileTest) {
 TEST_F(FileIOTest, ReadJsonTest) {
     auto options = read_json(kTempJsonFile);
 
-    ASSERT_EQ(options.size(), 2) << "Should have read 2 options from JSON file";
+    ASSERT_EQ(options.size(), 2u) << "Should have read 2 options from JSON file";
 
     // Check first option (Call)
     EXPECT_TRUE(options[0].is_call);
@@ -204,7 +231,7 @@ TEST_F(FileIOTest, WriteJsonTest) {
     // Read the file back in
     auto read_options = read_json(kTempJsonFile);
 
-    ASSERT_EQ(read_options.size(), 2) << "Should have read 2 options from JSON file";
+    ASSERT_EQ(read_options.size(), 2u) << "Should have read 2 options from JSON file";
 
     // Check first option (Call)
     EXPECT_TRUE(read_options[0].is_call);
@@ -252,3 +279,40 @@ TEST(FileIOErrorTest, NonexistentJsonFileTest) {
     const std::string nonexistent = "nonexistent_file.json";
     EXPECT_THROW(read_json(nonexistent), std::runtime_error);
 }
+
+// Test that binary files round-trip every field exactly
+TEST_F(FileIOTest, BinaryRoundTripTest) {
+    const std::string binary_file = "temp_test.bin";
+    std::vector<OptionData> options(3);
+    options[0].asset_price = 100.0;
+    options[0].strike_price = 1.0 / 3.0;
+    options[0].volatility = 0.123456789012345;
+    options[1].is_call = false;
+    options[1].asset_price = -0.25;
+    options[1].model = iv_calculator::core::PricingModel::BACHELIER;
+    options[1].exercise = iv_calculator::core::ExerciseStyle::AMERICAN;
+    options[2].option_price = 1e-300;
+
+    EXPECT_TRUE(write_binary(binary_file, options));
+    auto read_options = read_binary(binary_file);
+    std::remove(binary_file.c_str());
+
+    ASSERT_EQ(read_options.size(), 3u);
+    for (std::size_t i = 0; i < options.size(); ++i) {
+        EXPECT_EQ(read_options[i].is_call, options[i].is_call);
+        EXPECT_EQ(read_options[i].asset_price, options[i].asset_price);
+        EXPECT_EQ(read_options[i].strike_price, options[i].strike_price);
+        EXPECT_EQ(read_options[i].time_to_expiry, options[i].time_to_expiry);
+        EXPECT_EQ(read_options[i].risk_free_rate, options[i].risk_free_rate);
+        EXPECT_EQ(read_options[i].option_price, options[i].option_price);
+        EXPECT_EQ(read_options[i].volatility, options[i].volatility);
+        EXPECT_EQ(read_options[i].model, options[i].model);
+        EXPECT_EQ(read_options[i].exercise, options[i].exercise);
+    }
+}
+
+// Test that files in another format are rejected as binary input
+TEST_F(FileIOTest, BinaryHeaderTest) {
+    EXPECT_THROW(read_binary(kTempCsvFile), std::runtime_error);
+    EXPECT_THROW(read_binary("nonexistent_file.bin"), std::runtime_error);
+}
@@ -0,0 +1,42 @@
+#include "src/core/day_count.h"
+#include "src/io/occ_symbol.h"
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using namespace iv_calculator::io;
+using iv_calculator::core::days_from_civil;
+
+// Test the padded and compact forms
+TEST(OccSymbolTest, ParseTest) {
+    OccSymbol occ = parse_occ_symbol("AAPL  240119C00190000");
+    EXPECT_EQ(occ.root, "AAPL");
+    EXPECT_EQ(occ.expiry_day, days_from_civil(2024, 1, 19));
+    EXPECT_EQ(occ.strike_milli, 190000u);
+    EXPECT_TRUE(occ.is_call);
+
+    occ = parse_occ_symbol(" SPXW251231P05432500\r");
+    EXPECT_EQ(occ.root, "SPXW");
+    EXPECT_EQ(occ.expiry_day, days_from_civil(2025, 12, 31));
+    EXPECT_EQ(occ.strike_milli, 5432500u);
+    EXPECT_FALSE(occ.is_call);
+
+    // Adjusted roots carry a digit and use all six characters
+    occ = parse_occ_symbol("BRKB12280301C00000500");
+    EXPECT_EQ(occ.root, "BRKB12");
+    EXPECT_EQ(occ.expiry_day, days_from_civil(2028, 3, 1));
+    EXPECT_EQ(occ.strike_milli, 500u);
+}
+
+// Test that malformed symbols are rejected
+TEST(OccSymbolTest, InvalidTest) {
+    EXPECT_THROW(parse_occ_symbol(""), std::invalid_argument);
+    EXPECT_THROW(parse_occ_symbol("240119C00190000"), std::invalid_argument);      // No root
+    EXPECT_THROW(parse_occ_symbol("TOOLONGR240119C00190000"), std::invalid_argument);
+    EXPECT_THROW(parse_occ_symbol("AA PL240119C00190000"), std::invalid_argument);
+    EXPECT_THROW(parse_occ_symbol("AAPL  240119X00190000"), std::invalid_argument);
+    EXPECT_THROW(parse_occ_symbol("AAPL  241319C00190000"), std::invalid_argument);  // Month
+    EXPECT_THROW(parse_occ_symbol("AAPL  250229C00190000"), std::invalid_argument);  // Not leap
+    EXPECT_THROW(parse_occ_symbol("AAPL  240119C0019000A"), std::invalid_argument);
+    EXPECT_NO_THROW(parse_occ_symbol("AAPL  240229C00190000"));
+}
@@ -0,0 +1,56 @@
+#include "src/io/symbol_pool.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+using namespace iv_calculator::io;
+
+// Test IDs in order of first appearance and lookups
+TEST(SymbolPoolTest, InternTest) {
+    SymbolPool pool;
+    EXPECT_EQ(pool.intern(""), 0u);
+    EXPECT_EQ(pool.intern("AAPL"), 1u);
+    EXPECT_EQ(pool.intern("MSFT"), 2u);
+    EXPECT_EQ(pool.intern("AAPL"), 1u);
+    EXPECT_EQ(pool.size(), 2u);
+    EXPECT_EQ(pool.name(2), "MSFT");
+    EXPECT_EQ(pool.name(0), "");
+    EXPECT_EQ(pool.find("MSFT"), 2u);
+    EXPECT_EQ(pool.find("IBM"), 0u);
+    EXPECT_THROW(static_cast<void>(pool.name(3)), std::out_of_range);
+}
+
+// Test that IDs and names survive the table growing
+TEST(SymbolPoolTest, GrowthTest) {
+    SymbolPool pool;
+    for (int i = 0; i < 10000; ++i) {
+        EXPECT_EQ(pool.intern("SYM" + std::to_string(i)), static_cast<std::uint32_t>(i + 1));
+    }
+    for (int i = 0; i < 10000; i += 7) {
+        EXPECT_EQ(pool.find("SYM" + std::to_string(i)), static_cast<std::uint32_t>(i + 1));
+        EXPECT_EQ(pool.name(static_cast<std::uint32_t>(i + 1)), "SYM" + std::to_string(i));
+    }
+}
+
+// Test contract IDs, lookups and growth
+TEST(SymbolPoolTest, ContractPoolTest) {
+    ContractPool pool;
+    ContractKey call{1, 19741, 190000, true};
+    ContractKey put{1, 19741, 190000, false};
+    EXPECT_EQ(pool.intern(call), 1u);
+    EXPECT_EQ(pool.intern(put), 2u);
+    EXPECT_EQ(pool.intern(call), 1u);
+    EXPECT_EQ(pool.find(put), 2u);
+    EXPECT_EQ(pool.find({2, 19741, 190000, true}), 0u);
+    EXPECT_TRUE(pool.key(2) == put);
+    EXPECT_THROW(static_cast<void>(pool.key(0)), std::out_of_range);
+    EXPECT_THROW(static_cast<void>(pool.key(3)), std::out_of_range);
+
+    for (std::uint32_t strike = 0; strike < 5000; ++strike) {
+        pool.intern({3, 20000, strike * 500, strike % 2 == 0});
+    }
+    EXPECT_EQ(pool.size(), 5002u);
+    EXPECT_EQ(pool.find({3, 20000, 4321 * 500, false}), 4321u + 3);
+}